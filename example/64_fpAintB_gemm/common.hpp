@@ -19,6 +19,7 @@
 #include "ck/library/utility/fill.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_weight_quantization.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_fpAintB_gemm.hpp"
 
@@ -60,21 +61,10 @@ struct UnsignedWeightPreprocessor<int8_t>
     using SignedWeight   = Tensor<int8_t>;
     static UnsignedWeight convert(SignedWeight const& Input)
     {
+        UnsignedWeight Output(Input.mDesc);
 
-        UnsignedWeight Output = Input.template CopyAsType<uint8_t>();
-
-        auto f_kn = [&](auto k, auto n) {
-            const uint8_t adder = 128;
-            int8_t v_signed_weight;
-            uint8_t v_unsigned_weight;
-
-            ck::tensor_operation::element_wise::PassThrough{}(v_signed_weight, Input(k, n));
-            v_unsigned_weight = ck::type_convert<uint8_t>(v_signed_weight) + adder;
-            Output(k, n)      = v_unsigned_weight;
-        };
-
-        make_ParallelTensorFunctor(f_kn, Input.mDesc.GetLengths()[0], Input.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
+        ck::utils::to_unsigned_weight_n(
+            Output.mData.data(), Input.mData.data(), Input.mData.size());
 
         return Output;
     }
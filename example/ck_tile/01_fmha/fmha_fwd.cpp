@@ -568,192 +568,141 @@ bool run(const ck_tile::ArgParser& arg_parser)
 
     bool pass = true;
 
-    for(ck_tile::index_t wb = 0; wb < batch; ++wb)
-    {
-        const ck_tile::index_t real_seqlen_q = seqstart_q_host[wb + 1] - seqstart_q_host[wb];
-        const ck_tile::index_t real_seqlen_k = seqstart_k_host[wb + 1] - seqstart_k_host[wb];
-
-        // adjust matrix index according to the mode
-        const ck_tile::index_t b            = (mode == mode_enum::batch ? wb : 0);
-        const ck_tile::index_t query_offset = (mode == mode_enum::batch ? 0 : seqstart_q_host[wb]);
-        const ck_tile::index_t key_offset   = (mode == mode_enum::batch ? 0 : seqstart_k_host[wb]);
-
-        const auto v_host_ref_lengths =
-            std::array<ck_tile::index_t, 3>{nhead, hdim_v, real_seqlen_k};
-        const auto v_host_ref_strides =
-            is_v_rowmajor
-                ? std::array<ck_tile::index_t, 3>{hdim_v * real_seqlen_k, 1, hdim_v}
-                : std::array<ck_tile::index_t, 3>{hdim_v * real_seqlen_k, real_seqlen_k, 1};
+    // reference on the whole problem, every tensor in [shape_batch, nhead, seqlen, hdim] order
+    ck_tile::HostTensor<QDataType> q_host_ref({shape_batch, nhead, shape_seqlen_q, hdim_q});
+    ck_tile::HostTensor<KDataType> k_host_ref({shape_batch, nhead_k, shape_seqlen_k, hdim_q});
+    ck_tile::HostTensor<VDataType> v_host_ref({shape_batch, nhead_k, shape_seqlen_k, hdim_v});
+    ck_tile::HostTensor<ODataType> o_host_ref({shape_batch, nhead, shape_seqlen_q, hdim_v});
+    ck_tile::HostTensor<SMPLComputeDataType> lse_host_ref({shape_batch, nhead, shape_seqlen_q});
 
-        ck_tile::HostTensor<QDataType> q_host_ref({nhead, real_seqlen_q, hdim_q});
-        ck_tile::HostTensor<KDataType> k_host_ref({nhead, real_seqlen_k, hdim_q});
-        ck_tile::HostTensor<VDataType> v_host_ref(v_host_ref_lengths, v_host_ref_strides);
-        ck_tile::HostTensor<ODataType> o_host_ref({nhead, real_seqlen_q, hdim_v});
+    // clang-format off
+    // permute
+    if(i_perm) q_host_ref.ForEach([&](auto& self, auto i) { self(i) = q_host(i[0], i[1], i[2], i[3]); });
+    else       q_host_ref.ForEach([&](auto& self, auto i) { self(i) = q_host(i[0], i[2], i[1], i[3]); });
+
+    if(i_perm) k_host_ref.ForEach([&](auto& self, auto i) { self(i) = k_host(i[0], i[1], i[2], i[3]); });
+    else       k_host_ref.ForEach([&](auto& self, auto i) { self(i) = k_host(i[0], i[2], i[1], i[3]); });
+
+    if (is_v_rowmajor) {
+        //                                                             v_host: [b, h_k, s, d]
+        if(i_perm) v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(i[0], i[1], i[2], i[3]); });
+        //                                                             v_host: [b, s, h_k, d]
+        else       v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(i[0], i[2], i[1], i[3]); });
+    }
+    else {
+        //                                                             v_host: [b, h_k, d, s]
+        if(i_perm) v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(i[0], i[1], i[3], i[2]); });
+        //                                                             v_host: [b, d, h_k, s]
+        else       v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(i[0], i[3], i[1], i[2]); });
+    }
+    // clang-format on
 
-        ck_tile::HostTensor<SMPLComputeDataType> s_host_ref({nhead, real_seqlen_q, real_seqlen_k});
-        ck_tile::HostTensor<PDataType> p_host_ref({nhead, real_seqlen_q, real_seqlen_k});
-        ck_tile::HostTensor<SMPLComputeDataType> lse_host_ref({nhead, real_seqlen_q});
+    // the reference takes the sequence boundaries in group mode only
+    const std::vector<int32_t> seqstart_q_ref =
+        (mode == mode_enum::batch ? std::vector<int32_t>{} : seqstart_q_host);
+    const std::vector<int32_t> seqstart_k_ref =
+        (mode == mode_enum::batch ? std::vector<int32_t>{} : seqstart_k_host);
+
+    auto run_reference = [&](auto make_mask, auto make_bias) {
+        ck_tile::reference_fmha_fwd<QDataType,
+                                    KDataType,
+                                    VDataType,
+                                    SaccDataType,
+                                    SMPLComputeDataType,
+                                    PDataType,
+                                    OaccDataType,
+                                    ODataType>(q_host_ref,
+                                               k_host_ref,
+                                               v_host_ref,
+                                               o_host_ref,
+                                               scale_s,
+                                               seqstart_q_ref,
+                                               seqstart_k_ref,
+                                               make_mask,
+                                               make_bias,
+                                               p_compute_element_func,
+                                               oacc_element_func,
+                                               lse_host_ref);
+    };
 
-        ck_tile::index_t nr = nhead / nhead_k;
+    // elementwise bias, [1, 1, seqlen_q, seqlen_k] shared by every head
+    auto make_elementwise_bias = [&](auto wb, auto /* i_h */, auto, auto) {
+        const ck_tile::index_t query_offset = (mode == mode_enum::batch ? 0 : seqstart_q_host[wb]);
+        const ck_tile::index_t key_offset   = (mode == mode_enum::batch ? 0 : seqstart_k_host[wb]);
 
-        // clang-format off
-        // permute
-        if(i_perm) q_host_ref.ForEach([&](auto& self, auto i) { self(i) = q_host(b, i[0], i[1] + query_offset, i[2]); });
-        else       q_host_ref.ForEach([&](auto& self, auto i) { self(i) = q_host(b, i[1] + query_offset, i[0], i[2]); });
+        return [&, query_offset, key_offset](ck_tile::index_t i_q, ck_tile::index_t i_k) {
+            return i_perm ? bias_host(0, 0, i_q + query_offset, i_k + key_offset)
+                          : bias_host(0, i_q + query_offset, 0, i_k + key_offset);
+        };
+    };
 
-        if(i_perm) k_host_ref.ForEach([&](auto& self, auto i) { self(i) = k_host(b, i[0] / nr, i[1] + key_offset, i[2]); });
-        else       k_host_ref.ForEach([&](auto& self, auto i) { self(i) = k_host(b, i[1] + key_offset, i[0] / nr, i[2]); });
+    // alibi construct elementwise bias to verify
+    auto make_alibi_bias = [&](auto wb, auto i_h, auto real_seqlen_q, auto real_seqlen_k) {
+        auto alibi_host = [&]() {
+            if(mask.type != mask_enum::no_mask)
+            {
+                return ck_tile::make_alibi_from_lr_mask<SaccDataType, true>(
+                    0,
+                    mask.left,
+                    mask.right,
+                    real_seqlen_q,
+                    real_seqlen_k,
+                    static_cast<ck_tile::GenericAttentionMaskEnum>(mask.type));
+            }
+            else
+            {
+                return ck_tile::Alibi<SaccDataType, true>{
+                    0, real_seqlen_q, real_seqlen_k, ck_tile::AlibiMode::VERTICAL};
+            }
+        }();
 
-        if (is_v_rowmajor) {
-            //                                                             v_host_ref: [nhead, hdim, seq], v_host: [b, h_k, s, d]
-            if(i_perm) v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(b, i[0] / nr, i[2] + key_offset, i[1]); });
-            //                                                             v_host_ref: [nhead, hdim, seq], v_host: [b, s, h_k, d]
-            else       v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(b, i[2] + key_offset, i[0] / nr, i[1]); });
-        }
-        else {
-            if(i_perm) v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(b, i[0] / nr, i[1], i[2] + key_offset); });
-            else       v_host_ref.ForEach([&](auto& self, auto i) { self(i) = v_host(b, i[1], i[0] / nr, i[2] + key_offset); });
-        }
-        // clang-format on
+        auto i_b_slope   = bias.rank_info == 0 ? 0 : wb;
+        alibi_host.slope = alibi_slope_host(i_b_slope, i_h);
 
-        // reference
-        ck_tile::reference_batched_gemm<QDataType, KDataType, SaccDataType, SMPLComputeDataType>(
-            q_host_ref,
-            k_host_ref,
-            s_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            ck_tile::scales(scale_s));
+        return [alibi_host](ck_tile::index_t i_r, ck_tile::index_t i_c) mutable {
+            SaccDataType pixel = 0;
+            alibi_host.update(pixel, i_r, i_c);
+            return pixel;
+        };
+    };
 
+    auto run_reference_with_bias = [&](auto make_mask) {
         if(bias.type == bias_enum::elementwise_bias)
-        {
-            // elementwise bias
-            ck_tile::HostTensor<BiasDataType> bias_host_ref({1, real_seqlen_q, real_seqlen_k});
-            // clang-format off
-            if(i_perm)
-                bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, 0, i[1] + query_offset, i[2] + key_offset); });
-            else
-                bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, i[1] + query_offset, 0, i[2] + key_offset); });
-            // clang-format on
-
-            // broadcast from [1, real_seqlen_q, real_seqlen_k] to [nhead, real_seqlen_q,
-            // real_seqlen_k]
-            ck_tile::reference_batched_elementwise<SMPLComputeDataType,
-                                                   BiasDataType,
-                                                   SMPLComputeDataType,
-                                                   SMPLComputeDataType>(
-                s_host_ref, bias_host_ref, s_host_ref);
-        }
+            run_reference(make_mask, make_elementwise_bias);
         else if(bias.type == bias_enum::alibi)
-        {
-            // alibi construct elementwise bias to verify
-            auto alibi_host = [&]() {
-                if(mask.type != mask_enum::no_mask)
-                {
-                    return ck_tile::make_alibi_from_lr_mask<SaccDataType, true>(
-                        0,
-                        mask.left,
-                        mask.right,
-                        real_seqlen_q,
-                        real_seqlen_k,
-                        static_cast<ck_tile::GenericAttentionMaskEnum>(mask.type));
-                }
-                else
-                {
-                    return ck_tile::Alibi<SaccDataType, true>{
-                        0, real_seqlen_q, real_seqlen_k, ck_tile::AlibiMode::VERTICAL};
-                }
-            }();
-
-            ck_tile::HostTensor<SaccDataType> alibi_bias_host_ref(
-                {nhead, real_seqlen_q, real_seqlen_k});
-            auto i_b_slope = bias.rank_info == 0 ? 0 : wb;
-            for(auto i_h = 0; i_h < nhead; i_h++)
-            {
-                SaccDataType current_slope = alibi_slope_host(i_b_slope, i_h);
-                alibi_host.slope           = current_slope;
-                for(auto i_r = 0; i_r < real_seqlen_q; i_r++)
-                {
-                    for(auto i_c = 0; i_c < real_seqlen_k; i_c++)
-                    {
-                        SaccDataType pixel = 0;
-                        alibi_host.update(pixel, i_r, i_c);
-                        alibi_bias_host_ref(i_h, i_r, i_c) = pixel;
-                    }
-                }
-            }
-            // [nhead, real_seqlen_q, real_seqlen_k]
-            ck_tile::reference_batched_elementwise<SMPLComputeDataType,
-                                                   SaccDataType,
-                                                   SMPLComputeDataType,
-                                                   SMPLComputeDataType>(
-                s_host_ref, alibi_bias_host_ref, s_host_ref);
-        }
-
-        if(mask.type == mask_enum::no_mask)
-        {
-            ck_tile::reference_batched_masking<SaccDataType>(
-                s_host_ref, FmhaMasks::NoMask{real_seqlen_q, real_seqlen_k});
-        }
-        else if(mask.type == mask_enum::window_generic)
-        {
-            ck_tile::reference_batched_masking<SaccDataType>(
-                s_host_ref,
-                ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
-                    mask.left, mask.right, real_seqlen_q, real_seqlen_k));
-        }
+            run_reference(make_mask, make_alibi_bias);
         else
-        {
-            // if left window size is negative, means causal
-            // else means generic (for current batch)
-            if(mask.left < 0)
-                ck_tile::reference_batched_masking<SaccDataType>(
-                    s_host_ref,
-                    ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::CausalMask>(
-                        mask.left,
-                        mask.right,
-                        real_seqlen_q,
-                        real_seqlen_k,
-                        mask.type == mask_enum::mask_top_left));
-            else
-                ck_tile::reference_batched_masking<SaccDataType>(
-                    s_host_ref,
-                    ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
-                        mask.left,
-                        mask.right,
-                        real_seqlen_q,
-                        real_seqlen_k,
-                        mask.type == mask_enum::mask_top_left));
-        }
-        if(lse)
-        {
-            ck_tile::reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
-                s_host_ref, p_host_ref, p_compute_element_func, lse_host_ref);
-        }
-        else
-        {
-            ck_tile::reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
-                s_host_ref, p_host_ref, p_compute_element_func);
-        }
+            run_reference(make_mask, ck_tile::reference_fmha_no_bias{});
+    };
 
-        ck_tile::reference_batched_gemm<PDataType, VDataType, OaccDataType, ODataType>(
-            p_host_ref,
-            v_host_ref,
-            o_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            oacc_element_func);
+    dispatch_mask_factory(mask, run_reference_with_bias);
+
+    for(ck_tile::index_t wb = 0; wb < batch; ++wb)
+    {
+        const ck_tile::index_t real_seqlen_q = seqstart_q_host[wb + 1] - seqstart_q_host[wb];
+        const ck_tile::index_t real_seqlen_k = seqstart_k_host[wb + 1] - seqstart_k_host[wb];
+
+        // adjust matrix index according to the mode
+        const ck_tile::index_t b            = (mode == mode_enum::batch ? wb : 0);
+        const ck_tile::index_t query_offset = (mode == mode_enum::batch ? 0 : seqstart_q_host[wb]);
 
         ck_tile::HostTensor<ODataType> o_host_result({nhead, real_seqlen_q, hdim_v});
+        ck_tile::HostTensor<ODataType> o_host_expected({nhead, real_seqlen_q, hdim_v});
         // clang-format off
         // permute
         if(o_perm) o_host_result.ForEach([&](auto& self, auto idx) { self(idx) = o_host(b, idx[0], idx[1] + query_offset, idx[2]); });
         else       o_host_result.ForEach([&](auto& self, auto idx) { self(idx) = o_host(b, idx[1] + query_offset, idx[0], idx[2]); });
         // clang-format on
+        o_host_expected.ForEach([&](auto& self, auto idx) {
+            self(idx) = o_host_ref(b, idx[0], idx[1] + query_offset, idx[2]);
+        });
 
         auto [rtol, atol] = get_elimit<DataType>(init_method);
-        bool cur_pass     = ck_tile::check_err(
-            o_host_result, o_host_ref, std::string("OUT Error: Incorrect results!"), rtol, atol);
+        bool cur_pass     = ck_tile::check_err(o_host_result,
+                                           o_host_expected,
+                                           std::string("OUT Error: Incorrect results!"),
+                                           rtol,
+                                           atol);
         pass &= cur_pass;
         if(!cur_pass)
         {
@@ -769,19 +718,23 @@ bool run(const ck_tile::ArgParser& arg_parser)
         if(lse)
         {
             ck_tile::HostTensor<SMPLComputeDataType> lse_host_result({nhead, real_seqlen_q});
+            ck_tile::HostTensor<SMPLComputeDataType> lse_host_expected({nhead, real_seqlen_q});
             lse_host_result.ForEach([&](auto& self, auto idx) {
                 self(idx) = lse_host(b, idx[0], idx[1] + query_offset);
             });
+            lse_host_expected.ForEach([&](auto& self, auto idx) {
+                self(idx) = lse_host_ref(b, idx[0], idx[1] + query_offset);
+            });
 
             bool lse_pass = ck_tile::check_err(lse_host_result,
-                                               lse_host_ref,
+                                               lse_host_expected,
                                                "LSE Error: Incorrect results!",
                                                rtol,
                                                atol,
                                                /* allow_infinity_ref = */ true);
 
             pass &= lse_pass;
-            if(!cur_pass)
+            if(!lse_pass)
             {
                 std::cerr << "LSE mismatch found at batch: " << wb << std::endl
                           << "\tseqlen_q: " << real_seqlen_q << std::endl
@@ -155,3 +155,43 @@ struct mask_info
         return os;
     }
 };
+
+// calls f with the factory (seqlen_q, seqlen_k) -> mask of one sequence, which is what the fmha
+// host references (ck_tile::reference_fmha_fwd/bwd) take
+template <typename F>
+void dispatch_mask_factory(const mask_info& mask, F&& f)
+{
+    using NoMask      = ck_tile::GenericAttentionMask<false>;
+    using GenericMask = ck_tile::GenericAttentionMask<true, true>;
+    using CausalMask  = ck_tile::GenericAttentionMask<true, false>;
+
+    if(mask.type == mask_enum::no_mask)
+    {
+        f([](ck_tile::index_t seqlen_q, ck_tile::index_t seqlen_k) {
+            return NoMask{seqlen_q, seqlen_k};
+        });
+    }
+    else if(mask.type == mask_enum::window_generic)
+    {
+        f([=](ck_tile::index_t seqlen_q, ck_tile::index_t seqlen_k) {
+            return ck_tile::make_generic_attention_mask_from_lr_window<GenericMask>(
+                mask.left, mask.right, seqlen_q, seqlen_k);
+        });
+    }
+    // if left window size is negative, means causal
+    else if(mask.left < 0)
+    {
+        f([=](ck_tile::index_t seqlen_q, ck_tile::index_t seqlen_k) {
+            return ck_tile::make_generic_attention_mask_from_lr_window<CausalMask>(
+                mask.left, mask.right, seqlen_q, seqlen_k, mask.type == mask_enum::mask_top_left);
+        });
+    }
+    // else means generic (for current batch)
+    else
+    {
+        f([=](ck_tile::index_t seqlen_q, ck_tile::index_t seqlen_k) {
+            return ck_tile::make_generic_attention_mask_from_lr_window<GenericMask>(
+                mask.left, mask.right, seqlen_q, seqlen_k, mask.type == mask_enum::mask_top_left);
+        });
+    }
+}
@@ -15,6 +15,10 @@
 // export CK_LOGGING=ON or CK_LOGGING=1 or CK_LOGGING=ENABLED
 CK_DECLARE_ENV_VAR_BOOL(CK_LOGGING)
 
+// environment variable for the device operations that support it to choose the swizzle of their
+// block to C tile map with ck::utility::choose_block_to_ctile_swizzle() instead of the default
+CK_DECLARE_ENV_VAR_BOOL(CK_AUTO_TILE_SWIZZLE)
+
 // to do: add various levels of logging with CK_LOG_LEVEL
 
 #define CK_TIME_KERNEL 1
@@ -158,7 +162,9 @@ CK_DECLARE_ENV_VAR_BOOL(CK_LOGGING)
 #define CK_USE_AMD_LDS_DIRECT_LOAD_INLINE_ASM 1
 
 // set stochastic rounding as default for f8 conversions
+#ifndef CK_USE_SR_F8_CONVERSION
 #define CK_USE_SR_F8_CONVERSION 1
+#endif
 
 // block synchronization only s_wait lgkmcnt(0), not vmcnt(0)
 #define CK_EXPERIMENTAL_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM 1
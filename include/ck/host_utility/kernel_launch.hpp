@@ -4,10 +4,73 @@
 #pragma once
 
 #include <hip/hip_runtime.h>
+#include <vector>
 
 #include "ck/ck.hpp"
 #include "ck/stream_config.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/timing_stats.hpp"
+
+namespace ck {
+namespace utility {
+
+// Statistics mode of launch_and_time_kernel: every repetition is timed between its own pair of
+// events, which are recorded back to back so that the launches are not serialized by the host
+template <typename Launch>
+float time_repetitions(const StreamConfig& stream_config, Launch launch)
+{
+    const int nrepeat = stream_config.nrepeat_;
+    std::vector<hipEvent_t> events(nrepeat + 1);
+
+    for(auto& event : events)
+    {
+        hip_check_error(hipEventCreate(&event));
+    }
+
+    hip_check_error(hipDeviceSynchronize());
+    hip_check_error(hipEventRecord(events[0], stream_config.stream_id_));
+
+    for(int i = 0; i < nrepeat; ++i)
+    {
+        launch();
+        hip_check_error(hipEventRecord(events[i + 1], stream_config.stream_id_));
+    }
+
+    hip_check_error(hipEventSynchronize(events.back()));
+
+    auto& recorder = stream_config.timing_recorder_ != nullptr ? *stream_config.timing_recorder_
+                                                               : get_default_timing_recorder();
+
+    const auto& stats = recorder.Record(
+        nrepeat,
+        [&](int i) {
+            float time = 0;
+            hip_check_error(hipEventElapsedTime(&time, events[i], events[i + 1]));
+            return time;
+        },
+        stream_config.outlier_threshold_);
+
+    for(auto& event : events)
+    {
+        hip_check_error(hipEventDestroy(event));
+    }
+
+    if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
+    {
+        printf("min %f, median %f, p90 %f, p99 %f, stddev %f ms, %d outliers\n",
+               stats.min,
+               stats.median,
+               stats.p90,
+               stats.p99,
+               stats.stddev,
+               stats.outliers);
+    }
+
+    return stats.median;
+}
+
+} // namespace utility
+} // namespace ck
 
 template <typename... Args, typename F>
 float launch_and_time_kernel(const StreamConfig& stream_config,
@@ -45,6 +108,15 @@ float launch_and_time_kernel(const StreamConfig& stream_config,
         {
             printf("Start running %d times...\n", nrepeat);
         }
+
+        if(stream_config.time_stats_)
+        {
+            return ck::utility::time_repetitions(stream_config, [&] {
+                kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+                hip_check_error(hipGetLastError());
+            });
+        }
+
         hipEvent_t start, stop;
 
         hip_check_error(hipEventCreate(&start));
@@ -121,6 +193,16 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
         {
             printf("Start running %d times...\n", nrepeat);
         }
+
+        if(stream_config.time_stats_)
+        {
+            return ck::utility::time_repetitions(stream_config, [&] {
+                preprocess();
+                kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+                hip_check_error(hipGetLastError());
+            });
+        }
+
         hipEvent_t start, stop;
 
         hip_check_error(hipEventCreate(&start));
@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/grid/block_to_ctile_map.hpp"
+
+namespace ck {
+namespace utility {
+
+struct L2ReuseOptions
+{
+    uint64_t cache_bytes = 4 * 1024 * 1024; // of one cache
+    uint32_t ways        = 16;
+    uint32_t line_bytes  = 128;
+    // caches of their own, e.g. one per XCD, the workgroups go to them round robin
+    uint32_t num_caches = 1;
+    // k steps simulated per wave, the traffic of the others is extrapolated from them; 0 for all
+    index_t max_ksteps = 0;
+};
+
+// A set associative cache with LRU replacement, of cache line indices
+class LruCacheModel
+{
+    public:
+    explicit LruCacheModel(const L2ReuseOptions& options)
+        : mWays(std::max<uint32_t>(options.ways, 1)),
+          mNumSets(std::max<uint64_t>(
+              options.cache_bytes / std::max<uint32_t>(options.line_bytes, 1) / mWays, 1)),
+          mLines(mNumSets * mWays, std::numeric_limits<uint64_t>::max())
+    {
+    }
+
+    // Whether line is cached, it becomes the most recently used line of its set either way
+    bool Access(uint64_t line)
+    {
+        const auto set  = mLines.begin() + (line % mNumSets) * mWays;
+        const auto it   = std::find(set, set + mWays, line);
+        const bool hit  = it != set + mWays;
+        const auto last = hit ? it : set + mWays - 1;
+
+        std::move_backward(set, last, last + 1);
+        *set = line;
+
+        return hit;
+    }
+
+    private:
+    uint64_t mWays;
+    uint64_t mNumSets;
+    std::vector<uint64_t> mLines; // sets of ways, from the most to the least recently used
+};
+
+// A GEMM that reads A[M, K] and B[K, N] in tiles of MPerBlock x KPerBlock and KPerBlock x NPerBlock
+struct L2ReuseProblem
+{
+    index_t M;
+    index_t N;
+    index_t K;
+    index_t MPerBlock;
+    index_t NPerBlock;
+    index_t KPerBlock;
+    index_t a_bytes; // of an element
+    index_t b_bytes;
+    bool a_k_contiguous; // A is RowMajor
+    bool b_k_contiguous; // B is ColumnMajor
+    index_t num_slots;   // workgroups that run at the same time, CUs times occupancy
+    // leading dimensions in elements, 0 for packed A or B
+    index_t lda = 0;
+    index_t ldb = 0;
+};
+
+struct L2ReuseSimulation
+{
+    uint64_t accesses   = 0; // cache lines of A and B read by the workgroups
+    uint64_t misses     = 0;
+    uint64_t dram_bytes = 0; // misses times the line size
+    double hit_rate     = 0;
+};
+
+namespace detail {
+
+// The lines of rows [outer_begin, outer_end) x columns [inner_begin, inner_end) of a matrix
+// with leading dimension ld, starting at byte base
+inline void access_l2_lines(LruCacheModel& cache,
+                            L2ReuseSimulation& sim,
+                            uint64_t base,
+                            uint64_t line_bytes,
+                            uint64_t ld,
+                            uint64_t elem_bytes,
+                            uint64_t outer_begin,
+                            uint64_t outer_end,
+                            uint64_t inner_begin,
+                            uint64_t inner_end)
+{
+    if(inner_begin >= inner_end)
+    {
+        return;
+    }
+
+    for(uint64_t o = outer_begin; o < outer_end; ++o)
+    {
+        const uint64_t first = (base + (o * ld + inner_begin) * elem_bytes) / line_bytes;
+        const uint64_t last  = (base + (o * ld + inner_end) * elem_bytes - 1) / line_bytes;
+        for(uint64_t line = first; line <= last; ++line)
+        {
+            ++sim.accesses;
+            sim.misses += cache.Access(line) ? 0 : 1;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Replays the A and B reads of a block to C tile map through a model of the L2 cache
+ *
+ * The workgroups run in waves of num_slots in the order of their ids, and the tile of each one
+ * is the CalculateBottomIndex() of the map. The workgroups of a wave step through K together,
+ * and at every step each one reads its KPerBlock slices of the A and B panels, in cache lines of
+ * the matrices with leading dimensions lda and ldb, from the cache it runs on. What the cache
+ * misses is read from DRAM.
+ *
+ * The caches of a wave mostly hold the k steps it just read, so for a long K the first
+ * max_ksteps of every wave predict the traffic of the rest well, at a fraction of the cost.
+ */
+template <typename Block2CTileMap>
+L2ReuseSimulation simulate_l2_reuse(const Block2CTileMap& map,
+                                    const L2ReuseProblem& problem,
+                                    const L2ReuseOptions& options = {})
+{
+    const uint64_t M         = problem.M;
+    const uint64_t N         = problem.N;
+    const uint64_t K         = problem.K;
+    const uint64_t line      = std::max<uint32_t>(options.line_bytes, 1);
+    const uint64_t lda       = problem.lda > 0 ? problem.lda : problem.a_k_contiguous ? K : M;
+    const uint64_t ldb       = problem.ldb > 0 ? problem.ldb : problem.b_k_contiguous ? K : N;
+    const uint64_t a_lines =
+        math::integer_divide_ceil((problem.a_k_contiguous ? M : K) * lda * problem.a_bytes, line);
+    const index_t grid_size  = map.CalculateGridSize(problem.M, problem.N);
+    const index_t num_slots  = std::max<index_t>(problem.num_slots, 1);
+    const index_t num_ksteps = math::integer_divide_ceil(problem.K, problem.KPerBlock);
+    const index_t simulated_ksteps =
+        options.max_ksteps > 0 ? std::min(options.max_ksteps, num_ksteps) : num_ksteps;
+
+    std::vector<LruCacheModel> caches(std::max<uint32_t>(options.num_caches, 1),
+                                      LruCacheModel(options));
+
+    std::vector<index_t> m0(grid_size), n0(grid_size);
+    for(index_t block_id = 0; block_id < grid_size; ++block_id)
+    {
+        const auto idx = map.CalculateBottomIndex(make_multi_index(block_id));
+
+        m0[block_id] = idx[Number<0>{}];
+        n0[block_id] = idx[Number<1>{}];
+    }
+
+    L2ReuseSimulation sim;
+    for(index_t wave_begin = 0; wave_begin < grid_size; wave_begin += num_slots)
+    {
+        const index_t wave_end       = std::min(wave_begin + num_slots, grid_size);
+        const uint64_t wave_accesses = sim.accesses;
+        const uint64_t wave_misses   = sim.misses;
+
+        for(index_t kstep = 0; kstep < simulated_ksteps; ++kstep)
+        {
+            const uint64_t k_begin = uint64_t(kstep) * problem.KPerBlock;
+            const uint64_t k_end   = std::min<uint64_t>(k_begin + problem.KPerBlock, K);
+
+            for(index_t block_id = wave_begin; block_id < wave_end; ++block_id)
+            {
+                auto& cache = caches[block_id % caches.size()];
+
+                const uint64_t m_begin = uint64_t(m0[block_id]) * problem.MPerBlock;
+                const uint64_t m_end   = std::min<uint64_t>(m_begin + problem.MPerBlock, M);
+                const uint64_t n_begin = uint64_t(n0[block_id]) * problem.NPerBlock;
+                const uint64_t n_end   = std::min<uint64_t>(n_begin + problem.NPerBlock, N);
+
+                if(problem.a_k_contiguous)
+                {
+                    detail::access_l2_lines(
+                        cache, sim, 0, line, lda, problem.a_bytes, m_begin, m_end, k_begin, k_end);
+                }
+                else
+                {
+                    detail::access_l2_lines(
+                        cache, sim, 0, line, lda, problem.a_bytes, k_begin, k_end, m_begin, m_end);
+                }
+
+                // B after A, from a line of its own
+                if(problem.b_k_contiguous)
+                {
+                    detail::access_l2_lines(cache,
+                                            sim,
+                                            a_lines * line,
+                                            line,
+                                            ldb,
+                                            problem.b_bytes,
+                                            n_begin,
+                                            n_end,
+                                            k_begin,
+                                            k_end);
+                }
+                else
+                {
+                    detail::access_l2_lines(cache,
+                                            sim,
+                                            a_lines * line,
+                                            line,
+                                            ldb,
+                                            problem.b_bytes,
+                                            k_begin,
+                                            k_end,
+                                            n_begin,
+                                            n_end);
+                }
+            }
+        }
+
+        if(simulated_ksteps < num_ksteps)
+        {
+            const auto extrapolate = [&](uint64_t& count, uint64_t wave_begin_count) {
+                count = wave_begin_count +
+                        (count - wave_begin_count) * num_ksteps / simulated_ksteps;
+            };
+            extrapolate(sim.accesses, wave_accesses);
+            extrapolate(sim.misses, wave_misses);
+        }
+    }
+
+    sim.dram_bytes = sim.misses * line;
+    sim.hit_rate   = sim.accesses > 0 ? 1. - double(sim.misses) / sim.accesses : 0;
+
+    return sim;
+}
+
+/**
+ * @brief The M01 of BlockToCTileMap_M00_N0_M01Adapt, or N01 of BlockToCTileMap_N00_M0_N01Adapt,
+ * with the least simulated DRAM traffic
+ *
+ * Tries the powers of 2 up to the number of tiles along M or N, whichever is larger. Ties go to
+ * the smaller swizzle.
+ */
+template <typename Block2CTileMap>
+index_t choose_block_to_ctile_swizzle(const L2ReuseProblem& problem,
+                                      const L2ReuseOptions& options = {})
+{
+    const index_t M0 = math::integer_divide_ceil(problem.M, problem.MPerBlock);
+    const index_t N0 = math::integer_divide_ceil(problem.N, problem.NPerBlock);
+
+    index_t best_swizzle     = 1;
+    uint64_t best_dram_bytes = std::numeric_limits<uint64_t>::max();
+    for(index_t swizzle = 1;; swizzle *= 2)
+    {
+        const Block2CTileMap map(problem.M, problem.N, swizzle);
+        const uint64_t dram_bytes = simulate_l2_reuse(map, problem, options).dram_bytes;
+
+        if(dram_bytes < best_dram_bytes)
+        {
+            best_dram_bytes = dram_bytes;
+            best_swizzle    = swizzle;
+        }
+
+        if(swizzle >= std::max(M0, N0))
+        {
+            break;
+        }
+    }
+
+    return best_swizzle;
+}
+
+} // namespace utility
+} // namespace ck
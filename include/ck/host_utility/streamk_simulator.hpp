@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ck/tensor_operation/gpu/grid/block_to_ctile_map.hpp"
+
+namespace ck {
+namespace utility {
+
+// A k-range of one C tile that a workgroup accumulates, in k iterations of KPerBlock
+struct StreamKWorkItem
+{
+    uint32_t block_idx;
+    uint32_t tile_idx;
+    uint32_t k_iter_begin;
+    uint32_t k_iter_end;
+    bool partial; // written by a stream-K block, so it has to be reduced with the other parts
+};
+
+// Cost, in k iterations of one workgroup, of the work other than the main loop
+struct StreamKCostOptions
+{
+    double tile_store    = 1; // writing a C tile
+    double partial_store = 2; // writing a partial tile, an atomic add or an accumulator tile
+    double partial_load  = 1; // reading an accumulator tile in a reduction workgroup
+};
+
+struct StreamKSimulation
+{
+    std::vector<StreamKWorkItem> work_items; // in the order of the workgroups
+    uint32_t grid_size        = 0;
+    uint32_t sk_blocks        = 0;
+    uint32_t dp_blocks        = 0;
+    uint32_t reduction_blocks = 0;
+
+    // the workgroups go in launch order to the least loaded CU
+    std::vector<double> cu_load;
+    double makespan       = 0; // load of the most loaded CU
+    double tail_imbalance = 0; // makespan over the average load, minus 1
+
+    uint32_t partial_tiles = 0; // C tiles that are reduced from partial tiles
+    uint32_t partials      = 0; // partial tiles written by the stream-K blocks
+    // bytes of partial tile traffic, for StreamKReductionStrategy::Atomic: clearing C and the
+    // read-modify-write of every partial tile; for Reduction: writing and reading back every
+    // partial tile as accumulator
+    uint64_t atomic_bytes    = 0;
+    uint64_t reduction_bytes = 0;
+};
+
+/**
+ * @brief Replays the workgroups of a BlockToCTileMap_GemmStreamK on the host
+ *
+ * Every workgroup walks its k iterations from the last one down, as the kernel does, and each
+ * walk through a tile becomes a work item. The load of a workgroup is its k iterations plus the
+ * stores of StreamKCostOptions, and for the Reduction strategy a reduction workgroup per partial
+ * tile loads its parts and stores the tile.
+ */
+template <typename Block2CTileMap>
+StreamKSimulation simulate_streamk(const Block2CTileMap& map,
+                                   uint32_t m,
+                                   uint32_t n,
+                                   uint32_t num_cu,
+                                   uint32_t c_bytes,
+                                   uint32_t acc_bytes,
+                                   const StreamKCostOptions& options = {})
+{
+    constexpr bool reduction =
+        Block2CTileMap::ReductionStrategy == StreamKReductionStrategy::Reduction;
+
+    StreamKSimulation sim;
+    sim.grid_size        = map.get_grid_dims().x;
+    sim.sk_blocks        = map.sk_num_blocks;
+    sim.dp_blocks        = map.reduction_start_block_idx - map.dp_start_block_idx;
+    sim.reduction_blocks = reduction ? map.get_sk_tiles() : 0;
+
+    const uint32_t num_tiles  = math::integer_divide_ceil(m, Block2CTileMap::MPerBlock) *
+                                math::integer_divide_ceil(n, Block2CTileMap::NPerBlock);
+    const uint64_t tile_elems = uint64_t(Block2CTileMap::MPerBlock) * Block2CTileMap::NPerBlock;
+
+    std::vector<uint32_t> parts(num_tiles, 0);
+    std::vector<double> block_load(sim.grid_size, 0);
+
+    for(uint32_t block_idx = 0; block_idx < map.reduction_start_block_idx; ++block_idx)
+    {
+        const bool is_sk_block = block_idx < map.sk_num_blocks;
+        if(!is_sk_block && block_idx < map.dp_start_block_idx)
+        {
+            continue; // padding
+        }
+
+        uint32_t iter_start, iter_end;
+        map.get_block_itr(block_idx, iter_start, iter_end);
+        const uint32_t total_iter_length = iter_end - iter_start;
+
+        while(iter_end > iter_start)
+        {
+            const uint32_t length =
+                map.get_current_iter_length(iter_start, iter_end, total_iter_length);
+            uint32_t tile_idx, iter_offset;
+            map.get_tile_idx_with_offset(iter_end - 1, tile_idx, iter_offset);
+
+            sim.work_items.push_back(
+                {block_idx, tile_idx, iter_offset + 1 - length, iter_offset + 1, is_sk_block});
+
+            block_load[block_idx] +=
+                length + (is_sk_block ? options.partial_store : options.tile_store);
+            if(is_sk_block && tile_idx < num_tiles)
+            {
+                ++parts[tile_idx];
+                ++sim.partials;
+            }
+
+            iter_end -= length;
+        }
+    }
+
+    sim.partial_tiles = static_cast<uint32_t>(
+        std::count_if(parts.begin(), parts.end(), [](uint32_t p) { return p > 0; }));
+
+    // the reduction workgroups take the partial tiles in order
+    for(uint32_t i = 0, tile_idx = 0; i < sim.reduction_blocks && tile_idx < num_tiles; ++tile_idx)
+    {
+        if(parts[tile_idx] > 0)
+        {
+            block_load[map.reduction_start_block_idx + i++] =
+                parts[tile_idx] * options.partial_load + options.tile_store;
+        }
+    }
+
+    sim.atomic_bytes    = uint64_t(m) * n * c_bytes + 2 * sim.partials * tile_elems * c_bytes;
+    sim.reduction_bytes = 2 * sim.partials * tile_elems * acc_bytes;
+
+    // list scheduling of the workgroups, in launch order, on the least loaded CU, the first one of
+    // equally loaded CUs
+    using CuLoad = std::pair<double, uint32_t>;
+    std::priority_queue<CuLoad, std::vector<CuLoad>, std::greater<CuLoad>> earliest_free;
+    for(uint32_t cu = 0; cu < std::max<uint32_t>(num_cu, 1); ++cu)
+    {
+        earliest_free.push({0., cu});
+    }
+    for(const double load : block_load)
+    {
+        auto [cu_load, cu] = earliest_free.top();
+        earliest_free.pop();
+        earliest_free.push({cu_load + load, cu});
+    }
+
+    sim.cu_load.assign(earliest_free.size(), 0.);
+    for(; !earliest_free.empty(); earliest_free.pop())
+    {
+        sim.cu_load[earliest_free.top().second] = earliest_free.top().first;
+    }
+
+    sim.makespan = *std::max_element(sim.cu_load.begin(), sim.cu_load.end());
+    const double mean =
+        std::accumulate(sim.cu_load.begin(), sim.cu_load.end(), 0.) / sim.cu_load.size();
+    sim.tail_imbalance = mean > 0 ? sim.makespan / mean - 1 : 0;
+
+    return sim;
+}
+
+/**
+ * @brief The number of stream-K blocks with the smallest simulated makespan
+ *
+ * Tries no stream-K blocks (data parallel only), the count of the map's own heuristic, the whole
+ * waves of num_cu blocks and up to max_candidates counts evenly spread from 1 up to one per
+ * workgroup slot, as long as each stream-K block gets min_k_iters_per_sk_block iterations. Ties go
+ * to the smaller count, which has less partial tile traffic. The result is meant for the sk_blocks
+ * argument of the map constructor, and is cached per problem since it is chosen in MakeArgument.
+ */
+template <typename Block2CTileMap>
+uint32_t choose_streamk_sk_blocks(uint32_t m,
+                                  uint32_t n,
+                                  uint32_t k,
+                                  uint32_t num_cu,
+                                  uint32_t occupancy,
+                                  uint32_t c_bytes,
+                                  uint32_t acc_bytes,
+                                  const StreamKCostOptions& options = {},
+                                  uint32_t max_candidates           = 64)
+{
+    using Key = std::tuple<uint32_t,
+                           uint32_t,
+                           uint32_t,
+                           uint32_t,
+                           uint32_t,
+                           uint32_t,
+                           uint32_t,
+                           double,
+                           double,
+                           double,
+                           uint32_t>;
+    static std::map<Key, uint32_t> cache;
+    static std::mutex cache_mutex;
+
+    const Key key{m,
+                  n,
+                  k,
+                  num_cu,
+                  occupancy,
+                  c_bytes,
+                  acc_bytes,
+                  options.tile_store,
+                  options.partial_store,
+                  options.partial_load,
+                  max_candidates};
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        const auto it = cache.find(key);
+        if(it != cache.end())
+        {
+            return it->second;
+        }
+    }
+
+    // with a single stream-K block it takes all the iterations of the stream-K tiles
+    const uint32_t sk_total_iters =
+        Block2CTileMap(m, n, k, num_cu, occupancy, 1).get_sk_total_iters();
+    const uint32_t max_sk_blocks =
+        std::min(num_cu * occupancy, sk_total_iters / Block2CTileMap::min_k_iters_per_sk_block);
+
+    std::vector<uint32_t> candidates{0};
+    const uint32_t heuristic_sk_blocks = Block2CTileMap(m, n, k, num_cu, occupancy).sk_num_blocks;
+    if(heuristic_sk_blocks <= max_sk_blocks)
+    {
+        candidates.push_back(heuristic_sk_blocks);
+    }
+    for(uint32_t sk_blocks = num_cu; num_cu > 0 && sk_blocks <= max_sk_blocks; sk_blocks += num_cu)
+    {
+        candidates.push_back(sk_blocks);
+    }
+    const uint32_t stride = std::max<uint32_t>(
+        math::integer_divide_ceil(max_sk_blocks, std::max<uint32_t>(max_candidates, 1)), 1);
+    for(uint32_t sk_blocks = 1; sk_blocks <= max_sk_blocks; sk_blocks += stride)
+    {
+        candidates.push_back(sk_blocks);
+    }
+    if(max_sk_blocks > 0)
+    {
+        candidates.push_back(max_sk_blocks);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    uint32_t best_sk_blocks = 0;
+    double best_makespan    = std::numeric_limits<double>::max();
+    for(const uint32_t sk_blocks : candidates)
+    {
+        const Block2CTileMap map(m, n, k, num_cu, occupancy, sk_blocks);
+        const double makespan =
+            simulate_streamk(map, m, n, num_cu, c_bytes, acc_bytes, options).makespan;
+
+        if(makespan < best_makespan)
+        {
+            best_makespan  = makespan;
+            best_sk_blocks = sk_blocks;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache.emplace(key, best_sk_blocks);
+    return best_sk_blocks;
+}
+
+} // namespace utility
+} // namespace ck
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ck {
+namespace utility {
+
+struct TimingStats
+{
+    int count    = 0; // samples kept after the outlier filter
+    int outliers = 0; // samples dropped by the outlier filter
+    float mean   = 0;
+    float min    = 0;
+    float median = 0;
+    float p90    = 0;
+    float p99    = 0;
+    float max    = 0;
+    float stddev = 0;
+};
+
+/**
+ * @brief Statistics of per-iteration kernel timings
+ *
+ * The samples are kept in a buffer that is reused across timings, so that the recorder can live
+ * next to a StreamConfig and be handed to every launch. Samples further than outlier_threshold
+ * scaled MADs (1.4826 * median absolute deviation, an estimate of the standard deviation) away
+ * from the median are dropped before the statistics are computed.
+ */
+struct TimingRecorder
+{
+    // Time nrepeat iterations, get_time(i) returns the time of iteration i in ms
+    template <typename GetTime>
+    const TimingStats& Record(int nrepeat, GetTime&& get_time, float outlier_threshold)
+    {
+        samples_.clear();
+        for(int i = 0; i < nrepeat; ++i)
+        {
+            samples_.push_back(get_time(i));
+        }
+
+        return Compute(outlier_threshold);
+    }
+
+    const TimingStats& Compute(float outlier_threshold)
+    {
+        stats_ = TimingStats{};
+        if(samples_.empty())
+        {
+            return stats_;
+        }
+
+        sorted_ = samples_;
+        std::sort(sorted_.begin(), sorted_.end());
+
+        if(outlier_threshold > 0)
+        {
+            const float median = GetPercentile(sorted_, 50);
+
+            deviations_.clear();
+            for(float x : sorted_)
+            {
+                deviations_.push_back(std::abs(x - median));
+            }
+            std::sort(deviations_.begin(), deviations_.end());
+
+            // with more than half of the samples equal, every other sample would be an outlier
+            const float mad = GetPercentile(deviations_, 50);
+            // with a threshold below 1 / 1.4826 every sample can be an outlier, then none is
+            const float limit  = outlier_threshold * 1.4826f * mad;
+            const auto outlier = [&](float x) { return std::abs(x - median) > limit; };
+            if(mad > 0 && !std::all_of(sorted_.begin(), sorted_.end(), outlier))
+            {
+                sorted_.erase(std::remove_if(sorted_.begin(), sorted_.end(), outlier),
+                              sorted_.end());
+            }
+        }
+
+        double sum = 0;
+        for(float x : sorted_)
+        {
+            sum += x;
+        }
+        const double mean = sum / sorted_.size();
+
+        double square_sum = 0;
+        for(float x : sorted_)
+        {
+            square_sum += (x - mean) * (x - mean);
+        }
+
+        stats_.count    = static_cast<int>(sorted_.size());
+        stats_.outliers = static_cast<int>(samples_.size() - sorted_.size());
+        stats_.mean     = static_cast<float>(mean);
+        stats_.min      = sorted_.front();
+        stats_.median   = GetPercentile(sorted_, 50);
+        stats_.p90      = GetPercentile(sorted_, 90);
+        stats_.p99      = GetPercentile(sorted_, 99);
+        stats_.max      = sorted_.back();
+        stats_.stddev =
+            sorted_.size() > 1 ? static_cast<float>(std::sqrt(square_sum / (sorted_.size() - 1)))
+                               : 0.f;
+
+        return stats_;
+    }
+
+    // Linear interpolation between the closest ranks of sorted samples
+    static float GetPercentile(const std::vector<float>& sorted, float percentile)
+    {
+        if(sorted.empty())
+        {
+            return 0;
+        }
+
+        const float rank       = percentile / 100 * (sorted.size() - 1);
+        const std::size_t low  = static_cast<std::size_t>(rank);
+        const std::size_t high = std::min(low + 1, sorted.size() - 1);
+
+        return sorted[low] + (rank - low) * (sorted[high] - sorted[low]);
+    }
+
+    // The samples of the last timing, in iteration order
+    const std::vector<float>& GetSamples() const { return samples_; }
+
+    const TimingStats& GetStats() const { return stats_; }
+
+    private:
+    std::vector<float> samples_;
+    std::vector<float> sorted_;
+    std::vector<float> deviations_;
+    TimingStats stats_;
+};
+
+// Used by the launches of a StreamConfig that does not bring its own recorder
+inline TimingRecorder& get_default_timing_recorder()
+{
+    static thread_local TimingRecorder recorder;
+    return recorder;
+}
+
+} // namespace utility
+} // namespace ck
@@ -6,6 +6,8 @@
 #include <hip/hip_runtime.h>
 #include <hip/hip_fp16.h>
 
+#include "ck/host_utility/timing_stats.hpp"
+
 struct StreamConfig
 {
     hipStream_t stream_id_ = nullptr;
@@ -16,4 +18,11 @@ struct StreamConfig
 
     bool flush_cache   = false;
     int rotating_count = 1;
+
+    // statistics mode: time every repetition on its own, drop the repetitions further than
+    // outlier_threshold_ scaled MADs from the median (0 keeps all) and return the median; the full
+    // statistics are left in timing_recorder_, or in get_default_timing_recorder() if it is null
+    bool time_stats_                              = false;
+    float outlier_threshold_                      = 3.5f;
+    ck::utility::TimingRecorder* timing_recorder_ = nullptr;
 };
@@ -250,7 +250,7 @@ struct DeviceGemmDpp : public DeviceGemm<ALayout,
             << MPerDpp << ", "
             << NPerDpp << ", "
             << MDppPerWave << ", "
-            << MDppPerWave << ", "
+            << NDppPerWave << ", "
             << ABlockTransferSrcScalarPerVector << ", "
             << ABlockTransferDstScalarPerVector_K1 << ", "
             << BBlockTransferSrcScalarPerVector << ", "
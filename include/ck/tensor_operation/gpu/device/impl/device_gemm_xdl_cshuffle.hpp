@@ -4,7 +4,10 @@
 #pragma once
 
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <tuple>
 
 #include "ck/utility/common_header.hpp"
 #include "ck/tensor_description/tensor_descriptor.hpp"
@@ -15,6 +18,8 @@
 #include "ck/tensor_operation/gpu/grid/gridwise_gemm_xdl_cshuffle_v1.hpp"
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
+#include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/l2_reuse_simulator.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -215,6 +220,87 @@ struct DeviceGemm_Xdl_CShuffle : public DeviceGemm<ALayout,
         return IsSupportedArgument(*dynamic_cast<const Argument*>(p_arg));
     }
 
+    // With CK_AUTO_TILE_SWIZZLE set, the M01 of the block to C tile map with the least DRAM
+    // traffic in a simulation of the L2 cache, see ck::utility::choose_block_to_ctile_swizzle().
+    // The device properties are queried once per device and the M01 is chosen once per device and
+    // problem, since the simulation takes up to seconds for large problems.
+    static void ChooseTileSwizzle(Argument& arg)
+    {
+        if(!ck::EnvIsEnabled(CK_ENV(CK_AUTO_TILE_SWIZZLE)))
+        {
+            return;
+        }
+
+        struct DeviceL2
+        {
+            utility::L2ReuseOptions options;
+            index_t num_slots;
+        };
+        using ProblemKey = std::tuple<int, index_t, index_t, index_t, index_t, index_t>;
+
+        static std::map<int, DeviceL2> devices;
+        static std::map<ProblemKey, index_t> swizzles;
+        static std::mutex cache_mutex;
+
+        hipDevice_t dev;
+        hip_check_error(hipGetDevice(&dev));
+
+        const ProblemKey key{dev, arg.M, arg.N, arg.K, arg.StrideA, arg.StrideB};
+        std::unique_lock<std::mutex> lock(cache_mutex);
+        if(const auto it = swizzles.find(key); it != swizzles.end())
+        {
+            arg.M01 = it->second;
+            return;
+        }
+
+        auto device = devices.find(dev);
+        if(device == devices.end())
+        {
+            int occupancy;
+            hip_check_error(hipOccupancyMaxActiveBlocksPerMultiprocessor(
+                &occupancy, kernel_gemm_xdl_cshuffle_v1<GridwiseGemm, true>, BlockSize, 0));
+
+            hipDeviceProp_t dev_prop;
+            hip_check_error(hipGetDeviceProperties(&dev_prop, dev));
+
+            DeviceL2 device_l2;
+            device_l2.options.cache_bytes = dev_prop.l2CacheSize;
+            device_l2.options.max_ksteps  = 8;
+            // the XCDs of gfx94x have an L2 each, l2CacheSize is that of one
+            const std::string device_name = ck::get_device_name();
+            if(device_name == "gfx940" || device_name == "gfx941" || device_name == "gfx942")
+            {
+                device_l2.options.num_caches = 8;
+            }
+            device_l2.num_slots = dev_prop.multiProcessorCount * occupancy;
+
+            device = devices.emplace(dev, device_l2).first;
+        }
+        const DeviceL2 device_l2 = device->second;
+        lock.unlock();
+
+        const utility::L2ReuseProblem problem{
+            arg.M,
+            arg.N,
+            arg.K,
+            MPerBlock,
+            NPerBlock,
+            KPerBlock,
+            sizeof(ADataType),
+            sizeof(BDataType),
+            is_same_v<ALayout, tensor_layout::gemm::RowMajor>,
+            is_same_v<BLayout, tensor_layout::gemm::ColumnMajor>,
+            device_l2.num_slots,
+            arg.StrideA,
+            arg.StrideB};
+
+        arg.M01 = utility::choose_block_to_ctile_swizzle<typename GridwiseGemm::Block2CTileMap>(
+            problem, device_l2.options);
+
+        lock.lock();
+        swizzles.emplace(key, arg.M01);
+    }
+
     static auto MakeArgument(const ADataType* p_a,
                              const BDataType* p_b,
                              CDataType* p_c,
@@ -228,7 +314,10 @@ struct DeviceGemm_Xdl_CShuffle : public DeviceGemm<ALayout,
                              BElementwiseOperation,
                              CElementwiseOperation)
     {
-        return Argument{p_a, p_b, p_c, M, N, K, StrideA, StrideB, StrideC};
+        auto arg = Argument{p_a, p_b, p_c, M, N, K, StrideA, StrideB, StrideC};
+        ChooseTileSwizzle(arg);
+
+        return arg;
     }
 
     static auto MakeInvoker() { return Invoker{}; }
@@ -247,15 +336,18 @@ struct DeviceGemm_Xdl_CShuffle : public DeviceGemm<ALayout,
                                                       BElementwiseOperation,
                                                       CElementwiseOperation) override
     {
-        return std::make_unique<Argument>(static_cast<const ADataType*>(p_a),
-                                          static_cast<const BDataType*>(p_b),
-                                          static_cast<CDataType*>(p_c),
-                                          M,
-                                          N,
-                                          K,
-                                          StrideA,
-                                          StrideB,
-                                          StrideC);
+        auto arg = std::make_unique<Argument>(static_cast<const ADataType*>(p_a),
+                                              static_cast<const BDataType*>(p_b),
+                                              static_cast<CDataType*>(p_c),
+                                              M,
+                                              N,
+                                              K,
+                                              StrideA,
+                                              StrideB,
+                                              StrideC);
+        ChooseTileSwizzle(*arg);
+
+        return arg;
     }
 
     // polymorphic
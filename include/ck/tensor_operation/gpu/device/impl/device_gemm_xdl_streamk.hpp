@@ -16,6 +16,7 @@
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/streamk_simulator.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -256,6 +257,22 @@ struct DeviceGemmXdlStreamK : public DeviceGemmStreamK<ALayout,
         return IsSupportedArgument(*dynamic_cast<const Argument*>(p_arg));
     }
 
+    // NumSKBlocks for the number of stream-K blocks with the best simulated load balance, see
+    // ck::utility::choose_streamk_sk_blocks(), instead of the heuristic of the block mapping
+    static constexpr uint32_t AutoNumSKBlocks = 0xfffffffe;
+
+    static uint32_t
+    GetNumSKBlocks(index_t M, index_t N, index_t K, int num_cu, int occupancy, uint32_t NumSKBlocks)
+    {
+        if(NumSKBlocks != AutoNumSKBlocks)
+        {
+            return NumSKBlocks;
+        }
+
+        return utility::choose_streamk_sk_blocks<typename GridwiseGemm::Block2CTileMap>(
+            M, N, K, num_cu, occupancy, sizeof(CDataType), sizeof(AccDataType));
+    }
+
     static auto MakeArgument(const ADataType* p_a,
                              const BDataType* p_b,
                              CDataType* p_c,
@@ -296,7 +313,7 @@ struct DeviceGemmXdlStreamK : public DeviceGemmStreamK<ALayout,
                         StrideC,
                         static_cast<uint32_t>(num_cu),
                         static_cast<uint32_t>(occupancy),
-                        NumSKBlocks};
+                        GetNumSKBlocks(M, N, K, num_cu, occupancy, NumSKBlocks)};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
@@ -342,7 +359,12 @@ struct DeviceGemmXdlStreamK : public DeviceGemmStreamK<ALayout,
                                           StrideC,
                                           static_cast<uint32_t>(num_cu),
                                           static_cast<uint32_t>(occupancy),
-                                          static_cast<uint32_t>(NumSKBlocks));
+                                          GetNumSKBlocks(M,
+                                                         N,
+                                                         K,
+                                                         num_cu,
+                                                         occupancy,
+                                                         static_cast<uint32_t>(NumSKBlocks)));
     }
 
     // polymorphic
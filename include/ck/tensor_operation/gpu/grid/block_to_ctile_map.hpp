@@ -1190,7 +1190,7 @@ struct BlockToCTileMap_GemmStreamK
         return __builtin_amdgcn_readfirstlane(blockIdx.x);
     }
 
-    __device__ void
+    __host__ __device__ void
     get_block_itr(uint32_t block_idx, uint32_t& iter_start, uint32_t& iter_end) const
     {
         if(block_idx < sk_num_big_blocks)
@@ -1213,20 +1213,26 @@ struct BlockToCTileMap_GemmStreamK
         }
     }
 
-    __device__ uint32_t get_current_iter_length(uint32_t iter_start,
-                                                uint32_t iter_end,
-                                                uint32_t total_iter_length) const
+    __host__ __device__ uint32_t get_current_iter_length(uint32_t iter_start,
+                                                         uint32_t iter_end,
+                                                         uint32_t total_iter_length) const
     {
         uint32_t iter_length_mod, iter_length_quo /*unused*/;
         k_iters_per_tile.divmod(iter_end, iter_length_quo, iter_length_mod);
+        // a block may span several whole tiles, but walks them one tile at a time
         uint32_t current_iter_length = math::min(
-            iter_length_mod == 0 ? (iter_end - iter_start) : iter_length_mod, total_iter_length);
+            iter_length_mod == 0 ? math::min(iter_end - iter_start, k_iters_per_tile.get())
+                                 : iter_length_mod,
+            total_iter_length);
         return current_iter_length;
     }
 
-    __device__ uint32_t get_tile_idx(uint32_t iter) const { return k_iters_per_tile.div(iter); }
+    __host__ __device__ uint32_t get_tile_idx(uint32_t iter) const
+    {
+        return k_iters_per_tile.div(iter);
+    }
 
-    __device__ void
+    __host__ __device__ void
     get_tile_idx_with_offset(uint32_t iter, uint32_t& tile_idx, uint32_t& iter_offset) const
     {
         k_iters_per_tile.divmod(iter, tile_idx, iter_offset);
@@ -449,7 +449,8 @@ struct GridwiseGemm_k0mk1_k0nk1_mn_xdl_cshuffle_v1
                       << "AK0:" << AK0 << ", "
                       << "BK0:" << BK0 << ", "
                       << "MBlock: " << MBlock << ", "
-                      << "NBlock: " << NBlock << "}" << std::endl;
+                      << "NBlock: " << NBlock << ", "
+                      << "M01: " << M01 << "}" << std::endl;
         }
 
         index_t M;
@@ -465,6 +466,7 @@ struct GridwiseGemm_k0mk1_k0nk1_mn_xdl_cshuffle_v1
         index_t BK0;
         index_t MBlock;
         index_t NBlock;
+        index_t M01 = 8; // of Block2CTileMap
     };
 
     // Argument
@@ -712,7 +714,7 @@ struct GridwiseGemm_k0mk1_k0nk1_mn_xdl_cshuffle_v1
         const CElementwiseOperation c_element_op{};
 
         // divide block work by [M, N]
-        const auto block_2_ctile_map = Block2CTileMap{problem.M, problem.N};
+        const auto block_2_ctile_map = Block2CTileMap{problem.M, problem.N, problem.M01};
 
         const auto block_work_idx =
             block_2_ctile_map.CalculateBottomIndex(make_multi_index(get_block_1d_id()));
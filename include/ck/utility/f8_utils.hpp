@@ -120,15 +120,19 @@ In this case, the fp16 mantissa should be shift left by 1 */
         mantissa += (1 << in_mant); // Add the implicit 1 into mantissa
     }
 
-    bool midpoint = (mantissa & ((1 << (in_mant - out_mant + exponent_diff)) - 1)) ==
-                    (1 << (in_mant - out_mant + exponent_diff - 1));
+    // Shifting by 32 bits or more is undefined. Only fp32 inputs far below the f8 denormal range
+    // get there, and they round to zero whatever the shifted out bits are, so the counts are
+    // clamped to 31.
+    const int mid_shift =
+        in_mant - out_mant + exponent_diff < 31 ? in_mant - out_mant + exponent_diff : 31;
+    bool midpoint = (mantissa & ((1u << mid_shift) - 1)) == (1u << (mid_shift - 1));
     /* This part is a bit tricky. The judgment of whether it is a tie needs to be done before we
  shift right as shift right could rip off some residual part and make something not midpoint look
  like midpoint. For example, the fp16 number 0x1002 (0 00100 0000000010), it is larger than
  midpoint, but after shift right by 4 bits, it would look like midpoint. */
 
     if(exponent_diff > 0)
-        mantissa >>= exponent_diff;
+        mantissa >>= exponent_diff < 31 ? exponent_diff : 31;
     else if(exponent_diff == -1)
         mantissa <<= -exponent_diff;
     bool implicit_one = mantissa & (1 << in_mant);
@@ -4,16 +4,24 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
 #include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
 #include "ck_tile/host/ranges.hpp"
 
 namespace ck_tile {
@@ -35,6 +43,409 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
     return os << "]";
 }
 
+struct check_err_config
+{
+    // number of mismatches recorded in check_err_result::mismatches
+    std::size_t max_num_mismatch = 5;
+    // stop at the first mismatch when only the verdict is needed, the statistics then only cover
+    // the elements compared so far
+    bool stop_at_first_error = false;
+    // row-major lengths of the compared tensors, used to report mismatches as multi-indices
+    std::vector<std::size_t> lengths;
+    std::size_t num_thread = std::max(std::thread::hardware_concurrency(), 1u);
+};
+
+struct check_err_result
+{
+    // bin 0 counts the exact matches and bin k > 0 the errors of [2^(k-1), 2^k) units in the last
+    // place of ref in the compared type, larger errors go to the last bin. Elements where out or
+    // ref is not finite are not binned
+    static constexpr std::size_t num_ulp_bin = 32;
+
+    struct mismatch
+    {
+        std::size_t index;
+        std::vector<std::size_t> multi_index;
+        double out;
+        double ref;
+    };
+
+    bool pass                 = true;
+    std::size_t num_element   = 0;
+    std::size_t err_count     = 0;
+    std::size_t out_nan_count = 0;
+    std::size_t out_inf_count = 0;
+    std::size_t ref_nan_count = 0;
+    std::size_t ref_inf_count = 0;
+    double max_abs_err        = 0;
+    double max_rel_err        = 0;
+    // over the elements where both out and ref are finite
+    double mean_abs_err = 0;
+    std::array<std::size_t, num_ulp_bin> ulp_histogram{};
+    // the first mismatches in index order
+    std::vector<mismatch> mismatches;
+
+    explicit operator bool() const { return pass; }
+};
+
+namespace detail {
+
+template <typename T>
+CK_TILE_HOST double to_double(const T& x)
+{
+    if constexpr(std::is_integral_v<T> || std::is_same_v<T, double>)
+        return static_cast<double>(x);
+    else
+        return type_convert<float>(x);
+}
+
+// unbiased exponent of a finite non-zero double
+CK_TILE_HOST int double_exponent(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+
+    return static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+}
+
+// exponent of the unit in the last place of a value of type T with magnitude |r|
+template <typename T>
+CK_TILE_HOST int ulp_exponent(double r)
+{
+    int mant = 0;
+    int bias = 0;
+
+    if constexpr(std::is_same_v<T, double>)
+    {
+        mant = 52;
+        bias = 1023;
+    }
+    else if constexpr(std::is_same_v<T, bf16_t>)
+    {
+        mant = 7;
+        bias = 127;
+    }
+    else if constexpr(std::is_same_v<T, float> || std::is_same_v<T, half_t> ||
+                      std::is_same_v<T, fp8_t> || std::is_same_v<T, bf8_t>)
+    {
+        mant = numeric_traits<T>::mant;
+        bias = numeric_traits<T>::bias;
+    }
+    else
+    {
+        return 0; // integers
+    }
+
+    return (r > 0 ? std::max(double_exponent(r), 1 - bias) : 1 - bias) - mant;
+}
+
+struct check_err_partial
+{
+    check_err_result result;
+    double sum_abs_err       = 0;
+    std::size_t finite_count = 0;
+};
+
+// Single pass comparison behind check_err_stats(), is_error(o, r, o_value, r_value, err) decides
+// whether the raw elements o and r (with the double values o_value and r_value) are a mismatch.
+// Random access ranges are split into fixed chunks and merged in order, so the result does not
+// depend on the thread count
+template <typename Range, typename RefRange, typename IsError>
+CK_TILE_HOST check_err_result check_err_stats(const Range& out,
+                                            const RefRange& ref,
+                                            IsError is_error,
+                                            const check_err_config& config = {})
+{
+    using T = ranges::range_value_t<Range>;
+
+    if(std::size(out) != std::size(ref))
+        throw std::runtime_error("wrong! out.size() != ref.size()");
+
+    constexpr std::size_t block = 256;
+    constexpr std::size_t chunk = 1 << 16;
+
+    const std::size_t n = std::size(out);
+    std::atomic<bool> failed{false};
+
+    // compare the elements [begin, end) starting at it_out and it_ref
+    auto compare = [&](auto it_out, auto it_ref, std::size_t begin, std::size_t end) {
+        check_err_partial partial;
+        auto& result = partial.result;
+
+        T o_raw[block], r_raw[block];
+        double o[block], r[block], err[block];
+        bool error[block];
+        int bin[block];
+
+        for(std::size_t b = begin; b < end; b += block)
+        {
+            if(config.stop_at_first_error && failed.load(std::memory_order_relaxed))
+                break;
+
+            const std::size_t size = std::min(block, end - b);
+
+            for(std::size_t j = 0; j < size; ++j, ++it_out, ++it_ref)
+            {
+                o_raw[j] = *it_out;
+                r_raw[j] = *it_ref;
+                o[j]     = to_double(o_raw[j]);
+                r[j]     = to_double(r_raw[j]);
+            }
+
+            // the reductions are kept in kLanes independent accumulators so that they can be
+            // vectorized without reordering floating point additions
+            constexpr std::size_t kLanes = 4;
+            constexpr double max_value   = std::numeric_limits<double>::max();
+
+            double sum_abs_err[kLanes] = {};
+            double max_abs_err[kLanes] = {};
+            double max_rel_err[kLanes] = {};
+            double num_finite_[kLanes] = {};
+            double num_exact_[kLanes]  = {};
+
+            for(std::size_t j = size; j < (size + kLanes - 1) / kLanes * kLanes; ++j)
+            {
+                o[j] = 0;
+                r[j] = 0;
+            }
+
+            for(std::size_t j0 = 0; j0 < size; j0 += kLanes)
+            {
+                for(std::size_t l = 0; l < kLanes; ++l)
+                {
+                    const std::size_t j = j0 + l;
+                    // the lanes past size only pad the last step and are not counted
+                    const bool valid = j < size;
+                    // o - r is not finite exactly when o or r is not
+                    const double e = std::abs(o[j] - r[j]);
+
+                    err[j] = valid && e <= max_value ? e : 0;
+
+                    sum_abs_err[l] += err[j];
+                    max_abs_err[l] = std::max(max_abs_err[l], err[j]);
+                    max_rel_err[l] =
+                        std::max(max_rel_err[l], std::abs(r[j]) > 0 ? err[j] / std::abs(r[j]) : 0);
+                    num_finite_[l] += valid && e <= max_value ? 1 : 0;
+                    num_exact_[l] += valid && e <= 0 ? 1 : 0;
+                }
+            }
+
+            std::size_t num_error = 0;
+            for(std::size_t j = 0; j < size; ++j)
+            {
+                error[j] = is_error(o_raw[j], r_raw[j], o[j], r[j], std::abs(o[j] - r[j]));
+                num_error += error[j];
+            }
+
+            std::size_t num_finite = 0;
+            std::size_t num_exact  = 0;
+            for(std::size_t l = 0; l < kLanes; ++l)
+            {
+                partial.sum_abs_err += sum_abs_err[l];
+                result.max_abs_err = std::max(result.max_abs_err, max_abs_err[l]);
+                result.max_rel_err = std::max(result.max_rel_err, max_rel_err[l]);
+                num_finite += static_cast<std::size_t>(num_finite_[l]);
+                num_exact += static_cast<std::size_t>(num_exact_[l]);
+            }
+
+            // exact matches are counted above, the histogram is only scattered into for the
+            // elements with an error
+            result.ulp_histogram[0] += num_exact;
+            if(num_exact != num_finite)
+            {
+                for(std::size_t j = 0; j < size; ++j)
+                {
+                    bin[j] = std::clamp<int>(double_exponent(err[j]) -
+                                                 ulp_exponent<T>(std::abs(r[j])) + 1,
+                                             1,
+                                             check_err_result::num_ulp_bin - 1);
+                }
+                for(std::size_t j = 0; j < size; ++j)
+                    if(err[j] > 0)
+                        ++result.ulp_histogram[bin[j]];
+            }
+
+            partial.finite_count += num_finite;
+
+            if(num_finite != size)
+            {
+                for(std::size_t j = 0; j < size; ++j)
+                {
+                    result.out_nan_count += std::isnan(o[j]);
+                    result.out_inf_count += std::isinf(o[j]);
+                    result.ref_nan_count += std::isnan(r[j]);
+                    result.ref_inf_count += std::isinf(r[j]);
+                }
+            }
+
+            if(num_error != 0)
+            {
+                for(std::size_t j = 0; j < size; ++j)
+                {
+                    if(error[j] && result.err_count++ < config.max_num_mismatch)
+                        result.mismatches.push_back({b + j, {}, o[j], r[j]});
+                }
+
+                result.pass = false;
+            }
+
+            result.num_element += size;
+
+            if(!result.pass)
+                failed.store(true, std::memory_order_relaxed);
+        }
+
+        return partial;
+    };
+
+    std::vector<check_err_partial> partials;
+
+    if constexpr(std::is_base_of_v<
+                     std::random_access_iterator_tag,
+                     typename std::iterator_traits<decltype(std::begin(out))>::iterator_category> &&
+                 std::is_base_of_v<
+                     std::random_access_iterator_tag,
+                     typename std::iterator_traits<decltype(std::begin(ref))>::iterator_category>)
+    {
+        partials.resize((n + chunk - 1) / chunk);
+
+        auto f = [&](auto c) {
+            const std::size_t begin = c * chunk;
+            const auto offset       = static_cast<std::ptrdiff_t>(begin);
+
+            partials[c] = compare(std::begin(out) + offset,
+                                  std::begin(ref) + offset,
+                                  begin,
+                                  std::min(begin + chunk, n));
+        };
+
+        if(!partials.empty())
+            make_ParallelTensorFunctor(f, partials.size())(
+                std::min(config.num_thread, partials.size()));
+    }
+    else
+    {
+        partials.push_back(compare(std::begin(out), std::begin(ref), 0, n));
+    }
+
+    check_err_result result;
+    double sum_abs_err       = 0;
+    std::size_t finite_count = 0;
+
+    for(auto& partial : partials)
+    {
+        const auto& p = partial.result;
+
+        result.pass = result.pass && p.pass;
+        result.num_element += p.num_element;
+        result.err_count += p.err_count;
+        result.out_nan_count += p.out_nan_count;
+        result.out_inf_count += p.out_inf_count;
+        result.ref_nan_count += p.ref_nan_count;
+        result.ref_inf_count += p.ref_inf_count;
+        result.max_abs_err = std::max(result.max_abs_err, p.max_abs_err);
+        result.max_rel_err = std::max(result.max_rel_err, p.max_rel_err);
+        for(std::size_t k = 0; k < check_err_result::num_ulp_bin; ++k)
+            result.ulp_histogram[k] += p.ulp_histogram[k];
+
+        for(auto& mismatch : partial.result.mismatches)
+            if(result.mismatches.size() < config.max_num_mismatch)
+                result.mismatches.push_back(std::move(mismatch));
+
+        sum_abs_err += partial.sum_abs_err;
+        finite_count += partial.finite_count;
+    }
+
+    result.mean_abs_err = finite_count > 0 ? sum_abs_err / finite_count : 0;
+
+    if(!config.lengths.empty())
+    {
+        for(auto& mismatch : result.mismatches)
+        {
+            mismatch.multi_index.resize(config.lengths.size());
+
+            std::size_t i = mismatch.index;
+            for(std::size_t d = config.lengths.size(); d-- > 0;)
+            {
+                mismatch.multi_index[d] = i % config.lengths[d];
+                i /= config.lengths[d];
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace detail
+
+CK_TILE_HOST auto make_is_infinity_error(bool allow_infinity_ref)
+{
+    return [=](double o, double r) {
+        const bool either_not_finite      = !std::isfinite(o) || !std::isfinite(r);
+        const bool both_infinite_and_same =
+            std::isinf(o) && std::isinf(r) && std::signbit(o) == std::signbit(r);
+
+        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
+    };
+}
+
+// Single pass comparison of out against ref with the criteria of check_err(): floating point
+// elements fail when |out - ref| > atol + rtol * |ref| or either is not finite (unless both are
+// the same infinity and allow_infinity_ref is set), integers when |out - ref| > atol
+template <typename Range, typename RefRange>
+std::enable_if_t<std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>>,
+                 check_err_result>
+    CK_TILE_HOST check_err_stats(const Range& out,
+                                 const RefRange& ref,
+                                 double rtol,
+                                 double atol,
+                                 bool allow_infinity_ref       = false,
+                                 const check_err_config& config = {})
+{
+    using T = ranges::range_value_t<Range>;
+
+    if constexpr(std::is_integral_v<T>)
+    {
+        return detail::check_err_stats(
+            out,
+            ref,
+            [=](const T& o, const T& r, double, double, double) {
+                return std::abs(static_cast<int64_t>(o) - static_cast<int64_t>(r)) > atol;
+            },
+            config);
+    }
+    else
+    {
+        const auto is_infinity_error = make_is_infinity_error(allow_infinity_ref);
+
+        return detail::check_err_stats(
+            out,
+            ref,
+            [=](const T&, const T&, double o, double r, double err) {
+                return err > atol + rtol * std::abs(r) || is_infinity_error(o, r);
+            },
+            config);
+    }
+}
+
+CK_TILE_HOST void
+report_check_err(std::ostream& os, const std::string& msg, const check_err_result& result)
+{
+    for(const auto& mismatch : result.mismatches)
+    {
+        os << msg << std::setw(12) << std::setprecision(7) << " out[" << mismatch.index
+           << "] != ref[" << mismatch.index << "]: " << mismatch.out << " != " << mismatch.ref
+           << std::endl;
+    }
+
+    const float error_percent = static_cast<float>(result.err_count) /
+                                static_cast<float>(std::max<std::size_t>(result.num_element, 1)) *
+                                100.f;
+    os << "max err: " << result.max_abs_err;
+    os << ", number of errors: " << result.err_count;
+    os << ", " << error_percent << "% wrong values" << std::endl;
+}
+
 template <typename Range, typename RefRange>
 typename std::enable_if<
     std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
@@ -55,43 +466,11 @@ check_err(const Range& out,
         return false;
     }
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite      = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same = std::isinf(o) && std::isinf(r) && (o == r);
-
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+    const auto result = check_err_stats(out, ref, rtol, atol, allow_infinity_ref);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<double>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = *std::next(std::begin(out), i);
-        const double r = *std::next(std::begin(ref), i);
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -113,44 +492,11 @@ check_err(const Range& out,
         return false;
     }
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite      = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same = std::isinf(o) && std::isinf(r) && (o == r);
-
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+    const auto result = check_err_stats(out, ref, rtol, atol, allow_infinity_ref);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
 
-    bool res{true};
-    int err_count = 0;
-    double err    = 0;
-    // TODO: This is a hack. We should have proper specialization for bf16_t data type.
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -172,43 +518,11 @@ check_err(const Range& out,
         return false;
     }
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite      = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same = std::isinf(o) && std::isinf(r) && (o == r);
-
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+    const auto result = check_err_stats(out, ref, rtol, atol, allow_infinity_ref);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = static_cast<double>(std::numeric_limits<ranges::range_value_t<Range>>::min());
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -233,37 +547,11 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
         return false;
     }
 
-    bool res{true};
-    int err_count   = 0;
-    int64_t err     = 0;
-    int64_t max_err = std::numeric_limits<int64_t>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const int64_t o = *std::next(std::begin(out), i);
-        const int64_t r = *std::next(std::begin(ref), i);
-        err             = std::abs(o - r);
+    const auto result = check_err_stats(out, ref, 0, atol);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
 
-        if(err > atol)
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << " out[" << i << "] != ref[" << i << "]: " << o << " != " << r
-                          << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -284,12 +572,7 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
         return false;
     }
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite      = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same = std::isinf(o) && std::isinf(r) && (o == r);
-
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+    const auto is_infinity_error = make_is_infinity_error(allow_infinity_ref);
 
     static const auto get_rounding_point_distance = [](fp8_t o, fp8_t r) -> unsigned {
         static const auto get_sign_bit = [](fp8_t v) -> bool {
@@ -306,36 +589,16 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
         }
     };
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const fp8_t o_fp8   = *std::next(std::begin(out), i);
-        const fp8_t r_fp8   = *std::next(std::begin(ref), i);
-        const double o_fp64 = type_convert<float>(o_fp8);
-        const double r_fp64 = type_convert<float>(r_fp8);
-        err                 = std::abs(o_fp64 - r_fp64);
-        if(!(less_equal<double>{}(err, atol) ||
-             get_rounding_point_distance(o_fp8, r_fp8) <= max_rounding_point_distance) ||
-           is_infinity_error(o_fp64, r_fp64))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o_fp64 << " != " << r_fp64 << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    const auto result = detail::check_err_stats(
+        out, ref, [=](fp8_t o_fp8, fp8_t r_fp8, double o_fp64, double r_fp64, double err) {
+            return !(less_equal<double>{}(err, atol) ||
+                     get_rounding_point_distance(o_fp8, r_fp8) <= max_rounding_point_distance) ||
+                   is_infinity_error(o_fp64, r_fp64);
+        });
+    if(!result)
+        report_check_err(std::cerr, msg, result);
+
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -356,39 +619,11 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
         return false;
     }
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite      = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same = std::isinf(o) && std::isinf(r) && (o == r);
+    const auto result = check_err_stats(out, ref, rtol, atol, allow_infinity_ref);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
 
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
-
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    return result.pass;
 }
 
 } // namespace ck_tile
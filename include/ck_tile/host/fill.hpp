@@ -4,17 +4,160 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <optional>
 #include <random>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
 #include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
 
 namespace ck_tile {
 
+namespace detail {
+
+// Counter-based Philox4x32-10 generator (Salmon et al., "Parallel Random Numbers: As Easy as 1,
+// 2, 3", SC'11). Writes the kLanes blocks with counters [counter, counter + kLanes) of the
+// stream of seed; every block is a pure function of (seed, counter)
+template <std::size_t kLanes>
+CK_TILE_HOST void
+philox4x32(uint64_t seed, uint64_t counter, std::array<uint32_t, 4> (&out)[kLanes])
+{
+    constexpr uint32_t m0 = 0xD2511F53;
+    constexpr uint32_t m1 = 0xCD9E8D57;
+    constexpr uint32_t w0 = 0x9E3779B9;
+    constexpr uint32_t w1 = 0xBB67AE85;
+
+    // one array per word so that the rounds vectorize over the lanes
+    uint32_t c0[kLanes], c1[kLanes], c2[kLanes], c3[kLanes];
+    for(std::size_t l = 0; l < kLanes; ++l)
+    {
+        c0[l] = static_cast<uint32_t>(counter + l);
+        c1[l] = static_cast<uint32_t>((counter + l) >> 32);
+        c2[l] = 0;
+        c3[l] = 0;
+    }
+
+    uint32_t k0 = static_cast<uint32_t>(seed);
+    uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+    for(int round = 0; round < 10; ++round)
+    {
+        for(std::size_t l = 0; l < kLanes; ++l)
+        {
+            const uint64_t p0 = uint64_t{m0} * c0[l];
+            const uint64_t p1 = uint64_t{m1} * c2[l];
+
+            const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+            const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+
+            c0[l] = n0;
+            c1[l] = static_cast<uint32_t>(p1);
+            c2[l] = n2;
+            c3[l] = static_cast<uint32_t>(p0);
+        }
+
+        k0 += w0;
+        k1 += w1;
+    }
+
+    for(std::size_t l = 0; l < kLanes; ++l)
+        out[l] = {c0[l], c1[l], c2[l], c3[l]};
+}
+
+// uniform float in [0, 1) from the upper 24 bits
+CK_TILE_HOST float philox_uniform(uint32_t x)
+{
+    return static_cast<float>(x >> 8) * (1.f / 16777216.f);
+}
+
+// two normal samples from two uniform words (Box-Muller), u1 is taken from (0, 1]
+CK_TILE_HOST std::array<float, 2> philox_normal(uint32_t x0, uint32_t x1)
+{
+    const float u1 = static_cast<float>((x0 >> 8) + 1) * (1.f / 16777216.f);
+    const float u2 = philox_uniform(x1);
+    const float r  = std::sqrt(-2.f * std::log(u1));
+    const float t  = 6.2831853071795864f * u2;
+    return {r * std::cos(t), r * std::sin(t)};
+}
+
+// Fill [first, last) with the elements [index_offset, index_offset + n) of the stream of seed,
+// element i being lane i % 4 of gen(block i / 4), where gen maps a Philox block to 4 values.
+// Random access ranges are split over the host threads, the values only depend on (seed, i) so
+// the result does not depend on the thread count
+template <typename ForwardIter, typename Gen>
+CK_TILE_HOST void
+philox_fill(ForwardIter first, ForwardIter last, uint64_t seed, std::size_t index_offset, Gen gen)
+{
+    constexpr std::size_t kLanes = 8;
+
+    auto fill_n = [&](ForwardIter it, std::size_t begin, std::size_t end) {
+        std::array<uint32_t, 4> blocks[kLanes];
+        decltype(gen(blocks[0])) values[kLanes];
+
+        // groups of kLanes blocks, the first and the last one clipped to [begin, end)
+        for(std::size_t group = begin / (4 * kLanes) * (4 * kLanes); group < end;
+            group += 4 * kLanes)
+        {
+            philox4x32(seed, group / 4, blocks);
+            for(std::size_t l = 0; l < kLanes; ++l)
+                values[l] = gen(blocks[l]);
+
+            if(group >= begin && group + 4 * kLanes <= end)
+            {
+                for(std::size_t l = 0; l < kLanes; ++l)
+                    for(std::size_t j = 0; j < 4; ++j, ++it)
+                        *it = values[l][j];
+                continue;
+            }
+
+            const std::size_t i_end = std::min(group + 4 * kLanes, end);
+            for(std::size_t i = std::max(group, begin); i < i_end; ++i, ++it)
+                *it = values[(i - group) / 4][i % 4];
+        }
+    };
+
+    const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+
+    if constexpr(std::is_base_of_v<std::random_access_iterator_tag,
+                                   typename std::iterator_traits<ForwardIter>::iterator_category>)
+    {
+        constexpr std::size_t chunk = 1 << 16;
+
+        auto f = [&](auto i_chunk) {
+            const std::size_t begin = i_chunk * chunk;
+            const std::size_t end   = std::min(begin + chunk, n);
+            fill_n(first + static_cast<std::ptrdiff_t>(begin),
+                   index_offset + begin,
+                   index_offset + end);
+        };
+
+        const std::size_t num_chunk  = (n + chunk - 1) / chunk;
+        const std::size_t num_thread = std::min<std::size_t>(
+            std::max(std::thread::hardware_concurrency(), 1u), std::max<std::size_t>(num_chunk, 1));
+
+        if(num_chunk > 0)
+            make_ParallelTensorFunctor(f, num_chunk)(num_thread);
+    }
+    else
+    {
+        fill_n(first, index_offset, index_offset + n);
+    }
+}
+
+} // namespace detail
+
+// The random fills draw element i of the range from the counter-based Philox4x32 stream of
+// seed_, so a value only depends on (seed_, i): ranges are filled in parallel with the same
+// result for any thread count, and the three argument form regenerates the elements
+// [index_offset, index_offset + (last - first)) of a larger tensor on its own. Without a seed
+// a random one is drawn for every call.
+
 template <typename T>
 struct FillUniformDistribution
 {
@@ -23,11 +166,21 @@ struct FillUniformDistribution
     std::optional<uint32_t> seed_{11939};
 
     template <typename ForwardIter>
-    void operator()(ForwardIter first, ForwardIter last) const
+    void operator()(ForwardIter first, ForwardIter last, std::size_t index_offset = 0) const
     {
-        std::mt19937 gen(seed_.has_value() ? *seed_ : std::random_device{}());
-        std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(first, last, [&dis, &gen]() { return ck_tile::type_convert<T>(dis(gen)); });
+        const float a = a_;
+        const float d = b_ - a_;
+        auto value    = [=](uint32_t x) {
+            return ck_tile::type_convert<T>(a + d * detail::philox_uniform(x));
+        };
+        detail::philox_fill(first,
+                            last,
+                            seed_.has_value() ? *seed_ : std::random_device{}(),
+                            index_offset,
+                            [=](const std::array<uint32_t, 4>& r) {
+                                return std::array<T, 4>{
+                                    value(r[0]), value(r[1]), value(r[2]), value(r[3])};
+                            });
     }
 
     template <typename ForwardRange>
@@ -49,11 +202,21 @@ struct FillNormalDistribution
     std::optional<uint32_t> seed_{11939};
 
     template <typename ForwardIter>
-    void operator()(ForwardIter first, ForwardIter last) const
+    void operator()(ForwardIter first, ForwardIter last, std::size_t index_offset = 0) const
     {
-        std::mt19937 gen(seed_.has_value() ? *seed_ : std::random_device{}());
-        std::normal_distribution<float> dis(mean_, std::sqrt(variance_));
-        std::generate(first, last, [&dis, &gen]() { return ck_tile::type_convert<T>(dis(gen)); });
+        const float mean   = mean_;
+        const float stddev = std::sqrt(variance_);
+        auto value         = [=](float z) { return ck_tile::type_convert<T>(mean + stddev * z); };
+        detail::philox_fill(first,
+                            last,
+                            seed_.has_value() ? *seed_ : std::random_device{}(),
+                            index_offset,
+                            [=](const std::array<uint32_t, 4>& r) {
+                                const auto z01 = detail::philox_normal(r[0], r[1]);
+                                const auto z23 = detail::philox_normal(r[2], r[3]);
+                                return std::array<T, 4>{
+                                    value(z01[0]), value(z01[1]), value(z23[0]), value(z23[1])};
+                            });
     }
 
     template <typename ForwardRange>
@@ -94,12 +257,21 @@ struct FillUniformDistributionIntegerValue
     std::optional<uint32_t> seed_{11939};
 
     template <typename ForwardIter>
-    void operator()(ForwardIter first, ForwardIter last) const
+    void operator()(ForwardIter first, ForwardIter last, std::size_t index_offset = 0) const
     {
-        std::mt19937 gen(seed_.has_value() ? *seed_ : std::random_device{}());
-        std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(
-            first, last, [&dis, &gen]() { return ck_tile::type_convert<T>(std::round(dis(gen))); });
+        const float a = a_;
+        const float d = b_ - a_;
+        auto value    = [=](uint32_t x) {
+            return ck_tile::type_convert<T>(std::round(a + d * detail::philox_uniform(x)));
+        };
+        detail::philox_fill(first,
+                            last,
+                            seed_.has_value() ? *seed_ : std::random_device{}(),
+                            index_offset,
+                            [=](const std::array<uint32_t, 4>& r) {
+                                return std::array<T, 4>{
+                                    value(r[0]), value(r[1]), value(r[2]), value(r[3])};
+                            });
     }
 
     template <typename ForwardRange>
@@ -121,12 +293,23 @@ struct FillNormalDistributionIntegerValue
     std::optional<uint32_t> seed_{11939};
 
     template <typename ForwardIter>
-    void operator()(ForwardIter first, ForwardIter last) const
+    void operator()(ForwardIter first, ForwardIter last, std::size_t index_offset = 0) const
     {
-        std::mt19937 gen(seed_.has_value() ? *seed_ : std::random_device{}());
-        std::normal_distribution<float> dis(mean_, std::sqrt(variance_));
-        std::generate(
-            first, last, [&dis, &gen]() { return ck_tile::type_convert<T>(std::round(dis(gen))); });
+        const float mean   = mean_;
+        const float stddev = std::sqrt(variance_);
+        auto value         = [=](float z) {
+            return ck_tile::type_convert<T>(std::round(mean + stddev * z));
+        };
+        detail::philox_fill(first,
+                            last,
+                            seed_.has_value() ? *seed_ : std::random_device{}(),
+                            index_offset,
+                            [=](const std::array<uint32_t, 4>& r) {
+                                const auto z01 = detail::philox_normal(r[0], r[1]);
+                                const auto z23 = detail::philox_normal(r[2], r[3]);
+                                return std::array<T, 4>{
+                                    value(z01[0]), value(z01[1]), value(z23[0]), value(z23[1])};
+                            });
     }
 
     template <typename ForwardRange>
@@ -6,8 +6,10 @@
 #include "ck_tile/core/config.hpp"
 #include "ck_tile/host/stream_config.hpp"
 #include "ck_tile/host/hip_check_error.hpp"
+#include "ck_tile/host/timing_stats.hpp"
 #include <hip/hip_runtime.h>
 #include <cstddef>
+#include <vector>
 
 namespace ck_tile {
 template <int MaxThreadPerBlock, int MinBlockPerCu, typename Kernel, typename... Args>
@@ -19,6 +21,53 @@ __launch_bounds__(MaxThreadPerBlock, MinBlockPerCu)
     f(args...);
 }
 
+// statistics mode of the launches: every repetition is timed between its own pair of events,
+// recorded back to back so that the launches are not serialized by the host
+template <typename Launch>
+CK_TILE_HOST float time_repetitions(const stream_config& s, int nrepeat, Launch launch)
+{
+    std::vector<hipEvent_t> events(nrepeat + 1);
+    for(auto& event : events)
+        HIP_CHECK_ERROR(hipEventCreate(&event));
+
+    HIP_CHECK_ERROR(hipDeviceSynchronize());
+    HIP_CHECK_ERROR(hipEventRecord(events[0], s.stream_id_));
+
+    for(int i = 0; i < nrepeat; ++i)
+    {
+        launch();
+        HIP_CHECK_ERROR(hipEventRecord(events[i + 1], s.stream_id_));
+    }
+
+    HIP_CHECK_ERROR(hipEventSynchronize(events.back()));
+
+    auto& recorder =
+        s.timing_recorder_ != nullptr ? *s.timing_recorder_ : default_timing_recorder();
+
+    const auto& stats = recorder.record(
+        nrepeat,
+        [&](int i) {
+            float time = 0;
+            HIP_CHECK_ERROR(hipEventElapsedTime(&time, events[i], events[i + 1]));
+            return time;
+        },
+        s.outlier_threshold_);
+
+    for(auto& event : events)
+        HIP_CHECK_ERROR(hipEventDestroy(event));
+
+#if CK_TILE_DEBUG_LOG
+    printf("min %f, median %f, p90 %f, p99 %f, stddev %f ms, %d outliers\n",
+           stats.min,
+           stats.median,
+           stats.p90,
+           stats.p99,
+           stats.stddev,
+           stats.outliers);
+#endif
+    return stats.median;
+}
+
 template <typename... Args, typename F>
 CK_TILE_HOST float launch_and_time_kernel(const stream_config& s,
                                           F kernel,
@@ -38,6 +87,14 @@ CK_TILE_HOST float launch_and_time_kernel(const stream_config& s,
         }
 
         const int nrepeat = s.nrepeat_;
+        if(s.time_stats_)
+        {
+            return time_repetitions(s, nrepeat, [&] {
+                kernel<<<grid_dim, block_dim, lds_byte, s.stream_id_>>>(args...);
+                hip_check_error(hipGetLastError());
+            });
+        }
+
         hipEvent_t start, stop;
 
         HIP_CHECK_ERROR(hipEventCreate(&start));
@@ -107,6 +164,15 @@ CK_TILE_HOST float launch_and_time_kernel_with_preprocess(const stream_config& s
 #if CK_TILE_DEBUG_LOG
         printf("Start running %d times...\n", nrepeat);
 #endif
+        if(s.time_stats_)
+        {
+            return time_repetitions(s, nrepeat, [&] {
+                preprocess();
+                kernel<<<grid_dim, block_dim, lds_byte, s.stream_id_>>>(args...);
+                hip_check_error(hipGetLastError());
+            });
+        }
+
         hipEvent_t start, stop;
 
         HIP_CHECK_ERROR(hipEventCreate(&start));
@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ck_tile {
+
+// dropout factory of reference_fmha_bwd() without any dropout
+struct reference_fmha_no_dropout
+{
+};
+
+// Backward of the attention computed by reference_fmha_fwd(), given O, LSE and dO:
+//
+//   P  = exp(scale_s * Q * K^T + bias - LSE), zero where masked
+//   Z  = keep / (1 - p_drop), the dropout of P in the forward pass (1 without dropout)
+//   dV = (P * Z)^T * dO
+//   dS = P * (dO * V^T * Z - rowsum(dO * O))
+//   dQ = scale_s * dS * K,  dK = scale_s * dS^T * Q
+//
+// P is recomputed tile by tile from LSE, so no seqlen_q x seqlen_k buffer is allocated. dK/dV
+// are accumulated by one work item per (sequence, head_k, key tile), which owns those rows and
+// walks every q-head sharing the key head, dQ by one work item per (sequence, head, query tile).
+// Nothing is written by two work items, so no atomics or reductions are needed.
+//
+// Tensors follow reference_fmha_fwd(): q/o/do/dq [batch, nhead, seqlen_q, hdim],
+// k/v/dk/dv [batch, nhead_k, seqlen_k, hdim] and lse [batch, nhead, seqlen_q], which is the LSE
+// layout written by the fmha_fwd example. seqstart_q/seqstart_k, make_mask and make_bias have
+// the meaning of reference_fmha_fwd(), masks built from mask_info (causal, window) work as is.
+//
+// make_dropout(i_batch, i_head, seqlen_q, seqlen_k) returns a callable keep(i_q, i_k), with
+// indices relative to the sequence, telling whether the forward pass kept P[i_q, i_k]. The kept
+// elements were scaled by 1 / (1 - p_drop), and O must be the output of that forward pass. The
+// bias gradient is not covered.
+template <typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename ODataType,
+          typename OGradDataType,
+          typename LSEDataType,
+          typename AccDataType,
+          typename QGradDataType,
+          typename KGradDataType,
+          typename VGradDataType,
+          typename MaskFactory,
+          typename BiasFactory    = reference_fmha_no_bias,
+          typename DropoutFactory = reference_fmha_no_dropout>
+CK_TILE_HOST void reference_fmha_bwd(const HostTensor<QDataType>& q_b_h_s_d,
+                                     const HostTensor<KDataType>& k_b_h_s_d,
+                                     const HostTensor<VDataType>& v_b_h_s_d,
+                                     const HostTensor<ODataType>& o_b_h_s_d,
+                                     const HostTensor<LSEDataType>& lse_b_h_s,
+                                     const HostTensor<OGradDataType>& do_b_h_s_d,
+                                     HostTensor<QGradDataType>& dq_b_h_s_d,
+                                     HostTensor<KGradDataType>& dk_b_h_s_d,
+                                     HostTensor<VGradDataType>& dv_b_h_s_d,
+                                     float scale_s,
+                                     const std::vector<int32_t>& seqstart_q,
+                                     const std::vector<int32_t>& seqstart_k,
+                                     const MaskFactory& make_mask,
+                                     const BiasFactory& make_bias       = {},
+                                     const DropoutFactory& make_dropout = {},
+                                     float p_drop                       = 0.f)
+{
+    constexpr bool kHasDropout = !std::is_same_v<DropoutFactory, reference_fmha_no_dropout>;
+
+    constexpr index_t kTileQ = 32;
+    constexpr index_t kTileK = 64;
+
+    const index_t nhead   = q_b_h_s_d.mDesc.get_lengths()[1];
+    const index_t nhead_k = k_b_h_s_d.mDesc.get_lengths()[1];
+    const index_t hdim_q  = q_b_h_s_d.mDesc.get_lengths()[3];
+    const index_t hdim_v  = v_b_h_s_d.mDesc.get_lengths()[3];
+
+    if(nhead_k <= 0 || nhead % nhead_k != 0)
+    {
+        throw std::runtime_error("wrong! nhead is not a multiple of nhead_k");
+    }
+
+    const index_t nr = nhead / nhead_k;
+
+    const auto sequences = detail::make_fmha_sequences(
+        q_b_h_s_d.mDesc.get_lengths(), k_b_h_s_d.mDesc.get_lengths(), seqstart_q, seqstart_k);
+    const index_t batch = static_cast<index_t>(sequences.size());
+
+    const AccDataType scale     = ck_tile::type_convert<AccDataType>(scale_s);
+    const AccDataType rp_undrop = ck_tile::type_convert<AccDataType>(1.f / (1.f - p_drop));
+
+    // D = rowsum(dO * O), [batch, nhead, seqlen_q] like lse
+    HostTensor<AccDataType> d_b_h_s(lse_b_h_s.mDesc.get_lengths());
+
+    auto f_d = [&](auto i_b, auto i_h, auto i_s) {
+        AccDataType d = 0;
+        for(index_t i_d = 0; i_d < hdim_v; ++i_d)
+            d += ck_tile::type_convert<AccDataType>(do_b_h_s_d(i_b, i_h, i_s, i_d)) *
+                 ck_tile::type_convert<AccDataType>(o_b_h_s_d(i_b, i_h, i_s, i_d));
+        d_b_h_s(i_b, i_h, i_s) = d;
+    };
+
+    make_ParallelTensorFunctor(f_d,
+                               d_b_h_s.mDesc.get_lengths()[0],
+                               d_b_h_s.mDesc.get_lengths()[1],
+                               d_b_h_s.mDesc.get_lengths()[2])(std::thread::hardware_concurrency());
+
+    // K and V of keys [i_k0, i_k0 + cols) converted to AccDataType, row-major for the
+    // accumulation of dQ and transposed for the scores and dP
+    struct KVTile
+    {
+        std::vector<AccDataType> k, kt, vt;
+
+        KVTile(index_t hdim_q, index_t hdim_v)
+            : k(kTileK * hdim_q), kt(hdim_q * kTileK), vt(hdim_v * kTileK)
+        {
+        }
+    };
+
+    auto load_kv_tile = [&](KVTile& tile, const detail::fmha_sequence& seq, index_t i_h_k,
+                            index_t i_k0, index_t cols) {
+        for(index_t j = 0; j < cols; ++j)
+        {
+            const index_t i_k = seq.k_offset + i_k0 + j;
+            for(index_t d = 0; d < hdim_q; ++d)
+            {
+                const AccDataType v =
+                    ck_tile::type_convert<AccDataType>(k_b_h_s_d(seq.i_b, i_h_k, i_k, d));
+                tile.k[j * hdim_q + d]  = v;
+                tile.kt[d * kTileK + j] = v;
+            }
+            for(index_t d = 0; d < hdim_v; ++d)
+                tile.vt[d * kTileK + j] =
+                    ck_tile::type_convert<AccDataType>(v_b_h_s_d(seq.i_b, i_h_k, i_k, d));
+        }
+    };
+
+    // P * Z and dS of one query row against the key tile. q and dout are the converted rows of Q
+    // and dO, valid marks the visible keys
+    auto row_p_ds = [&](const KVTile& tile, auto& bias, auto& keep, const AccDataType* q,
+                        const AccDataType* dout, AccDataType lse, AccDataType d,
+                        const char* valid, index_t i_q, index_t i_k0, index_t cols,
+                        AccDataType* p, AccDataType* ds) {
+        std::fill(p, p + cols, AccDataType{0});
+        std::fill(ds, ds + cols, AccDataType{0});
+
+        for(index_t i_d = 0; i_d < hdim_q; ++i_d)
+            for(index_t j = 0; j < cols; ++j)
+                p[j] += q[i_d] * tile.kt[i_d * kTileK + j];
+
+        for(index_t i_d = 0; i_d < hdim_v; ++i_d)
+            for(index_t j = 0; j < cols; ++j)
+                ds[j] += dout[i_d] * tile.vt[i_d * kTileK + j];
+
+        for(index_t j = 0; j < cols; ++j)
+        {
+            if(!valid[j])
+            {
+                p[j]  = 0;
+                ds[j] = 0;
+                continue;
+            }
+
+            AccDataType s = scale * p[j];
+            if constexpr(!std::is_same_v<BiasFactory, reference_fmha_no_bias>)
+                s += ck_tile::type_convert<AccDataType>(bias(i_q, i_k0 + j));
+
+            p[j] = ck_tile::exp(s - lse);
+            if constexpr(kHasDropout)
+            {
+                const AccDataType z = keep(i_q, i_k0 + j) ? rp_undrop : AccDataType{0};
+
+                ds[j] = p[j] * (ds[j] * z - d);
+                p[j] *= z;
+            }
+            else
+            {
+                ds[j] = p[j] * (ds[j] - d);
+            }
+        }
+    };
+
+    auto make_row_bias = [&](index_t wb, index_t i_h, const detail::fmha_sequence& seq) {
+        if constexpr(std::is_same_v<BiasFactory, reference_fmha_no_bias>)
+            return make_bias;
+        else
+            return make_bias(wb, i_h, seq.seqlen_q, seq.seqlen_k);
+    };
+
+    auto make_row_keep = [&](index_t wb, index_t i_h, const detail::fmha_sequence& seq) {
+        if constexpr(kHasDropout)
+            return make_dropout(wb, i_h, seq.seqlen_q, seq.seqlen_k);
+        else
+            return make_dropout;
+    };
+
+    // dK, dV: one work item per (sequence, head_k, key tile)
+    struct KeyItem
+    {
+        index_t wb, i_h_k, i_k0;
+    };
+
+    std::vector<KeyItem> key_items;
+    for(index_t wb = 0; wb < batch; ++wb)
+        for(index_t i_h_k = 0; i_h_k < nhead_k; ++i_h_k)
+            for(index_t i_k0 = 0; i_k0 < sequences[wb].seqlen_k; i_k0 += kTileK)
+                key_items.push_back({wb, i_h_k, i_k0});
+
+    auto f_dkdv = [&](auto i_item) {
+        const index_t wb    = key_items[i_item].wb;
+        const index_t i_h_k = key_items[i_item].i_h_k;
+        const index_t i_k0  = key_items[i_item].i_k0;
+        const auto& seq     = sequences[wb];
+        const index_t cols  = min(kTileK, seq.seqlen_k - i_k0);
+
+        const auto mask = make_mask(seq.seqlen_q, seq.seqlen_k);
+
+        KVTile tile(hdim_q, hdim_v);
+        load_kv_tile(tile, seq, i_h_k, i_k0, cols);
+
+        std::vector<AccDataType> dk_acc(cols * hdim_q, 0);
+        std::vector<AccDataType> dv_acc(cols * hdim_v, 0);
+        std::vector<AccDataType> q(hdim_q), dout(hdim_v), p(kTileK), ds(kTileK);
+        std::vector<char> valid(kTileQ * kTileK);
+
+        for(index_t i_h = i_h_k * nr; i_h < (i_h_k + 1) * nr; ++i_h)
+        {
+            [[maybe_unused]] auto bias = make_row_bias(wb, i_h, seq);
+            [[maybe_unused]] auto keep = make_row_keep(wb, i_h, seq);
+
+            for(index_t i_q0 = 0; i_q0 < seq.seqlen_q; i_q0 += kTileQ)
+            {
+                const index_t rows = min(kTileQ, seq.seqlen_q - i_q0);
+
+                if(!detail::fmha_tile_mask<kTileQ, kTileK>(mask, i_q0, rows, i_k0, cols, valid))
+                    continue;
+
+                for(index_t i = 0; i < rows; ++i)
+                {
+                    const index_t i_q = seq.q_offset + i_q0 + i;
+
+                    for(index_t d = 0; d < hdim_q; ++d)
+                        q[d] = ck_tile::type_convert<AccDataType>(q_b_h_s_d(seq.i_b, i_h, i_q, d));
+                    for(index_t d = 0; d < hdim_v; ++d)
+                        dout[d] =
+                            ck_tile::type_convert<AccDataType>(do_b_h_s_d(seq.i_b, i_h, i_q, d));
+
+                    row_p_ds(tile,
+                             bias,
+                             keep,
+                             q.data(),
+                             dout.data(),
+                             ck_tile::type_convert<AccDataType>(lse_b_h_s(seq.i_b, i_h, i_q)),
+                             d_b_h_s(seq.i_b, i_h, i_q),
+                             &valid[i * kTileK],
+                             i_q0 + i,
+                             i_k0,
+                             cols,
+                             p.data(),
+                             ds.data());
+
+                    for(index_t j = 0; j < cols; ++j)
+                    {
+                        for(index_t d = 0; d < hdim_v; ++d)
+                            dv_acc[j * hdim_v + d] += p[j] * dout[d];
+                        for(index_t d = 0; d < hdim_q; ++d)
+                            dk_acc[j * hdim_q + d] += ds[j] * q[d];
+                    }
+                }
+            }
+        }
+
+        for(index_t j = 0; j < cols; ++j)
+        {
+            const index_t i_k = seq.k_offset + i_k0 + j;
+            for(index_t d = 0; d < hdim_q; ++d)
+                dk_b_h_s_d(seq.i_b, i_h_k, i_k, d) =
+                    ck_tile::type_convert<KGradDataType>(scale * dk_acc[j * hdim_q + d]);
+            for(index_t d = 0; d < hdim_v; ++d)
+                dv_b_h_s_d(seq.i_b, i_h_k, i_k, d) =
+                    ck_tile::type_convert<VGradDataType>(dv_acc[j * hdim_v + d]);
+        }
+    };
+
+    make_ParallelTensorFunctor(f_dkdv, key_items.size())(std::thread::hardware_concurrency());
+
+    // dQ: one work item per (sequence, head, query tile)
+    struct QueryItem
+    {
+        index_t wb, i_h, i_q0;
+    };
+
+    std::vector<QueryItem> query_items;
+    for(index_t wb = 0; wb < batch; ++wb)
+        for(index_t i_h = 0; i_h < nhead; ++i_h)
+            for(index_t i_q0 = 0; i_q0 < sequences[wb].seqlen_q; i_q0 += kTileQ)
+                query_items.push_back({wb, i_h, i_q0});
+
+    auto f_dq = [&](auto i_item) {
+        const index_t wb   = query_items[i_item].wb;
+        const index_t i_h  = query_items[i_item].i_h;
+        const index_t i_q0 = query_items[i_item].i_q0;
+        const auto& seq    = sequences[wb];
+        const index_t rows = min(kTileQ, seq.seqlen_q - i_q0);
+
+        const auto mask            = make_mask(seq.seqlen_q, seq.seqlen_k);
+        [[maybe_unused]] auto bias = make_row_bias(wb, i_h, seq);
+        [[maybe_unused]] auto keep = make_row_keep(wb, i_h, seq);
+
+        // converted rows of Q and dO, LSE and D of the tile
+        std::vector<AccDataType> q(rows * hdim_q), dout(rows * hdim_v), lse(rows), d(rows);
+        for(index_t i = 0; i < rows; ++i)
+        {
+            const index_t i_q = seq.q_offset + i_q0 + i;
+            for(index_t i_d = 0; i_d < hdim_q; ++i_d)
+                q[i * hdim_q + i_d] =
+                    ck_tile::type_convert<AccDataType>(q_b_h_s_d(seq.i_b, i_h, i_q, i_d));
+            for(index_t i_d = 0; i_d < hdim_v; ++i_d)
+                dout[i * hdim_v + i_d] =
+                    ck_tile::type_convert<AccDataType>(do_b_h_s_d(seq.i_b, i_h, i_q, i_d));
+            lse[i] = ck_tile::type_convert<AccDataType>(lse_b_h_s(seq.i_b, i_h, i_q));
+            d[i]   = d_b_h_s(seq.i_b, i_h, i_q);
+        }
+
+        KVTile tile(hdim_q, hdim_v);
+        std::vector<AccDataType> dq_acc(rows * hdim_q, 0);
+        std::vector<AccDataType> p(kTileK), ds(kTileK);
+        std::vector<char> valid(kTileQ * kTileK);
+
+        // like reference_fmha_fwd(), skip the key tiles out of the range of the mask
+        const auto k_range  = mask.GetTileRangeAlongX(i_q0, number<kTileQ>{}, number<kTileK>{});
+        const index_t k_end = min(k_range.at(number<1>{}), seq.seqlen_k);
+
+        for(index_t i_k0 = k_range.at(number<0>{}); i_k0 < k_end; i_k0 += kTileK)
+        {
+            const index_t cols = min(kTileK, seq.seqlen_k - i_k0);
+
+            if(!detail::fmha_tile_mask<kTileQ, kTileK>(mask, i_q0, rows, i_k0, cols, valid))
+                continue;
+
+            load_kv_tile(tile, seq, i_h / nr, i_k0, cols);
+
+            for(index_t i = 0; i < rows; ++i)
+            {
+                row_p_ds(tile,
+                         bias,
+                         keep,
+                         &q[i * hdim_q],
+                         &dout[i * hdim_v],
+                         lse[i],
+                         d[i],
+                         &valid[i * kTileK],
+                         i_q0 + i,
+                         i_k0,
+                         cols,
+                         p.data(),
+                         ds.data());
+
+                AccDataType* dq_row = &dq_acc[i * hdim_q];
+                for(index_t j = 0; j < cols; ++j)
+                    for(index_t i_d = 0; i_d < hdim_q; ++i_d)
+                        dq_row[i_d] += ds[j] * tile.k[j * hdim_q + i_d];
+            }
+        }
+
+        for(index_t i = 0; i < rows; ++i)
+            for(index_t i_d = 0; i_d < hdim_q; ++i_d)
+                dq_b_h_s_d(seq.i_b, i_h, seq.q_offset + i_q0 + i, i_d) =
+                    ck_tile::type_convert<QGradDataType>(scale * dq_acc[i * hdim_q + i_d]);
+    };
+
+    make_ParallelTensorFunctor(f_dq, query_items.size())(std::thread::hardware_concurrency());
+}
+} // namespace ck_tile
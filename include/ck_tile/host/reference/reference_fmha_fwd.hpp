@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ck_tile {
+
+// bias factory of reference_fmha_fwd() without any bias
+struct reference_fmha_no_bias
+{
+};
+
+namespace detail {
+
+// one sequence of an fmha problem: batch index into the tensors, seqlen offsets and seqlens
+struct fmha_sequence
+{
+    index_t i_b, q_offset, k_offset, seqlen_q, seqlen_k;
+};
+
+// sequences of [batch, nhead, seqlen, hdim] tensors, every batch in batch mode (empty seqstart)
+// or the packed sequences of batch 0 in group mode
+CK_TILE_HOST std::vector<fmha_sequence>
+make_fmha_sequences(const std::vector<std::size_t>& q_lengths,
+                    const std::vector<std::size_t>& k_lengths,
+                    const std::vector<int32_t>& seqstart_q,
+                    const std::vector<int32_t>& seqstart_k)
+{
+    std::vector<fmha_sequence> sequences;
+
+    if(seqstart_q.empty())
+    {
+        for(std::size_t b = 0; b < q_lengths[0]; ++b)
+            sequences.push_back({static_cast<index_t>(b),
+                                 0,
+                                 0,
+                                 static_cast<index_t>(q_lengths[2]),
+                                 static_cast<index_t>(k_lengths[2])});
+        return sequences;
+    }
+
+    if(seqstart_q.size() != seqstart_k.size() || seqstart_q.size() < 2)
+    {
+        throw std::runtime_error("wrong! seqstart_q and seqstart_k do not describe one batch");
+    }
+
+    for(std::size_t wb = 0; wb + 1 < seqstart_q.size(); ++wb)
+        sequences.push_back({0,
+                             seqstart_q[wb],
+                             seqstart_k[wb],
+                             seqstart_q[wb + 1] - seqstart_q[wb],
+                             seqstart_k[wb + 1] - seqstart_k[wb]});
+    return sequences;
+}
+
+// marks the visible elements of the [i_q0, i_q0 + rows) x [i_k0, i_k0 + cols) tile of a mask in
+// valid (rows of kTileK), false if there is none. Only the tiles on the edge of the mask are
+// checked element by element, the others are visible as a whole
+template <index_t kTileQ, index_t kTileK, typename Mask>
+CK_TILE_HOST bool fmha_tile_mask(const Mask& mask,
+                                 index_t i_q0,
+                                 index_t rows,
+                                 index_t i_k0,
+                                 index_t cols,
+                                 std::vector<char>& valid)
+{
+    if(!Mask::IsMasking || !mask.IsEdgeTile(i_q0, i_k0, number<kTileQ>{}, number<kTileK>{}))
+    {
+        std::fill(valid.begin(), valid.end(), 1);
+        return true;
+    }
+
+    bool any_valid = false;
+    for(index_t i = 0; i < rows; ++i)
+        for(index_t j = 0; j < cols; ++j)
+        {
+            const bool v          = !mask.IsOutOfBound(i_q0 + i, i_k0 + j);
+            valid[i * kTileK + j] = v;
+            any_valid |= v;
+        }
+    return any_valid;
+}
+
+} // namespace detail
+
+// Forward attention O = softmax(scale_s * Q * K^T + bias, mask) * V, computed tile by tile with
+// the online softmax, so that the memory footprint does not depend on seqlen_k.
+//
+// q_b_h_s_d [batch, nhead, seqlen_q, hdim_q], k_b_h_s_d [batch, nhead_k, seqlen_k, hdim_q],
+// v_b_h_s_d [batch, nhead_k, seqlen_k, hdim_v], o_b_h_s_d [batch, nhead, seqlen_q, hdim_v] and
+// lse_b_h_s [batch, nhead, seqlen_q]. nhead must be a multiple of nhead_k (MQA/GQA).
+//
+// In batch mode seqstart_q/seqstart_k are empty. In group mode all sequences are packed along
+// the seqlen dimension of a single batch, sequence i covers [seqstart[i], seqstart[i + 1]).
+//
+// make_mask(seqlen_q, seqlen_k) returns the mask of one sequence, a GenericAttentionMask or
+// SimplifiedGenericAttentionMask: key tiles out of its GetTileRangeAlongX() are skipped and only
+// its IsEdgeTile() tiles are masked element by element with IsOutOfBound(i_q, i_k).
+// make_bias(i_batch, i_head, seqlen_q, seqlen_k) returns a callable bias(i_q, i_k) added to the
+// scaled scores, with indices relative to the sequence.
+//
+// P is quantized to PDataType before the second gemm like the device kernel does, i.e. as
+// exp(s - running_max) and before the division by the row sum. Rows with every element masked
+// produce O = oacc_element_op(0) and LSE = -inf.
+template <typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename SaccDataType,
+          typename SMPLComputeDataType,
+          typename PDataType,
+          typename OaccDataType,
+          typename ODataType,
+          typename MaskFactory,
+          typename BiasFactory   = reference_fmha_no_bias,
+          typename PElementOp    = ck_tile::identity,
+          typename OAccElementOp = ck_tile::identity>
+CK_TILE_HOST void reference_fmha_fwd(
+    const HostTensor<QDataType>& q_b_h_s_d,
+    const HostTensor<KDataType>& k_b_h_s_d,
+    const HostTensor<VDataType>& v_b_h_s_d,
+    HostTensor<ODataType>& o_b_h_s_d,
+    float scale_s,
+    const std::vector<int32_t>& seqstart_q,
+    const std::vector<int32_t>& seqstart_k,
+    const MaskFactory& make_mask,
+    const BiasFactory& make_bias                                                  = {},
+    const PElementOp& p_element_op                                                = {},
+    const OAccElementOp& oacc_element_op                                          = {},
+    std::optional<std::reference_wrapper<HostTensor<SMPLComputeDataType>>> lse_b_h_s = std::nullopt)
+{
+    // rows of Q per work item and keys per inner step
+    constexpr index_t kTileQ = 32;
+    constexpr index_t kTileK = 64;
+
+    const index_t nhead   = q_b_h_s_d.mDesc.get_lengths()[1];
+    const index_t nhead_k = k_b_h_s_d.mDesc.get_lengths()[1];
+    const index_t hdim_q  = q_b_h_s_d.mDesc.get_lengths()[3];
+    const index_t hdim_v  = v_b_h_s_d.mDesc.get_lengths()[3];
+
+    if(nhead_k <= 0 || nhead % nhead_k != 0)
+    {
+        throw std::runtime_error("wrong! nhead is not a multiple of nhead_k");
+    }
+
+    const index_t nr = nhead / nhead_k;
+
+    const auto sequences = detail::make_fmha_sequences(
+        q_b_h_s_d.mDesc.get_lengths(), k_b_h_s_d.mDesc.get_lengths(), seqstart_q, seqstart_k);
+    const index_t batch = static_cast<index_t>(sequences.size());
+
+    // one work item per (sequence, head, q-tile)
+    struct WorkItem
+    {
+        index_t wb, i_h, i_q0;
+    };
+
+    std::vector<WorkItem> items;
+    for(index_t wb = 0; wb < batch; ++wb)
+        for(index_t i_h = 0; i_h < nhead; ++i_h)
+            for(index_t i_q0 = 0; i_q0 < sequences[wb].seqlen_q; i_q0 += kTileQ)
+                items.push_back({wb, i_h, i_q0});
+
+    const SMPLComputeDataType neg_inf = -ck_tile::numeric<SMPLComputeDataType>::infinity();
+
+    auto f = [&](auto i_item) {
+        const index_t wb    = items[i_item].wb;
+        const index_t i_h   = items[i_item].i_h;
+        const index_t i_q0  = items[i_item].i_q0;
+        const auto& seq     = sequences[wb];
+        const index_t i_h_k = i_h / nr;
+        const index_t rows  = min(kTileQ, seq.seqlen_q - i_q0);
+
+        const auto mask = make_mask(seq.seqlen_q, seq.seqlen_k);
+        [[maybe_unused]] auto bias = [&]() {
+            if constexpr(std::is_same_v<BiasFactory, reference_fmha_no_bias>)
+                return make_bias;
+            else
+                return make_bias(wb, i_h, seq.seqlen_q, seq.seqlen_k);
+        }();
+
+        // Q tile [rows, hdim_q], K tile transposed [hdim_q, kTileK], V tile [kTileK, hdim_v]
+        std::vector<SaccDataType> q_tile(rows * hdim_q);
+        std::vector<SaccDataType> kt_tile(hdim_q * kTileK);
+        std::vector<OaccDataType> v_tile(kTileK * hdim_v);
+        std::vector<SaccDataType> s_acc(kTileK);
+        std::vector<SMPLComputeDataType> s_row(kTileK);
+        std::vector<OaccDataType> p_row(kTileK);
+        std::vector<char> valid(rows * kTileK);
+
+        // running max, running sum and unnormalized output of every row
+        std::vector<SMPLComputeDataType> m_run(rows, neg_inf);
+        std::vector<SMPLComputeDataType> l_run(rows, 0);
+        std::vector<OaccDataType> o_acc(rows * hdim_v, 0);
+
+        for(index_t i = 0; i < rows; ++i)
+            for(index_t d = 0; d < hdim_q; ++d)
+                q_tile[i * hdim_q + d] = ck_tile::type_convert<SaccDataType>(
+                    q_b_h_s_d(seq.i_b, i_h, seq.q_offset + i_q0 + i, d));
+
+        // like the kernels, skip the key tiles out of the range of the mask for this q tile
+        const auto k_range  = mask.GetTileRangeAlongX(i_q0, number<kTileQ>{}, number<kTileK>{});
+        const index_t k_end = min(k_range.at(number<1>{}), seq.seqlen_k);
+
+        for(index_t i_k0 = k_range.at(number<0>{}); i_k0 < k_end; i_k0 += kTileK)
+        {
+            const index_t cols = min(kTileK, seq.seqlen_k - i_k0);
+
+            if(!detail::fmha_tile_mask<kTileQ, kTileK>(mask, i_q0, rows, i_k0, cols, valid))
+                continue;
+
+            for(index_t j = 0; j < cols; ++j)
+            {
+                const index_t i_k = seq.k_offset + i_k0 + j;
+                for(index_t d = 0; d < hdim_q; ++d)
+                    kt_tile[d * kTileK + j] =
+                        ck_tile::type_convert<SaccDataType>(k_b_h_s_d(seq.i_b, i_h_k, i_k, d));
+                for(index_t d = 0; d < hdim_v; ++d)
+                    v_tile[j * hdim_v + d] =
+                        ck_tile::type_convert<OaccDataType>(v_b_h_s_d(seq.i_b, i_h_k, i_k, d));
+            }
+
+            for(index_t i = 0; i < rows; ++i)
+            {
+                const char* row_valid = &valid[i * kTileK];
+
+                // S = Q * K^T, the reduction over hdim stays sequential for every score
+                std::fill(s_acc.begin(), s_acc.begin() + cols, SaccDataType{0});
+                for(index_t d = 0; d < hdim_q; ++d)
+                {
+                    const SaccDataType q = q_tile[i * hdim_q + d];
+                    for(index_t j = 0; j < cols; ++j)
+                        s_acc[j] += q * kt_tile[d * kTileK + j];
+                }
+
+                SMPLComputeDataType m_tile = neg_inf;
+                for(index_t j = 0; j < cols; ++j)
+                {
+                    if(!row_valid[j])
+                        continue;
+
+                    SMPLComputeDataType s =
+                        ck_tile::type_convert<SMPLComputeDataType>(scale_s * s_acc[j]);
+                    if constexpr(!std::is_same_v<BiasFactory, reference_fmha_no_bias>)
+                        s += ck_tile::type_convert<SMPLComputeDataType>(
+                            bias(i_q0 + i, i_k0 + j));
+
+                    s_row[j] = s;
+                    m_tile   = m_tile < s ? s : m_tile;
+                }
+
+                // nothing of this row survives in the current tile
+                if(std::isinf(m_tile) && m_tile < 0)
+                    continue;
+
+                const SMPLComputeDataType m_old = m_run[i];
+                const SMPLComputeDataType m_new = m_old < m_tile ? m_tile : m_old;
+
+                if(m_old < m_new)
+                {
+                    const SMPLComputeDataType rescale = ck_tile::exp(m_old - m_new);
+
+                    l_run[i] *= rescale;
+                    for(index_t d = 0; d < hdim_v; ++d)
+                        o_acc[i * hdim_v + d] *= ck_tile::type_convert<OaccDataType>(rescale);
+                    m_run[i] = m_new;
+                }
+
+                for(index_t j = 0; j < cols; ++j)
+                {
+                    if(!row_valid[j])
+                    {
+                        p_row[j] = 0;
+                        continue;
+                    }
+
+                    const SMPLComputeDataType p = ck_tile::exp(s_row[j] - m_new);
+
+                    l_run[i] += p;
+                    p_row[j] = ck_tile::type_convert<OaccDataType>(
+                        ck_tile::type_convert<PDataType>(p_element_op(p)));
+                }
+
+                // O += P * V
+                OaccDataType* o_row = &o_acc[i * hdim_v];
+                for(index_t j = 0; j < cols; ++j)
+                {
+                    const OaccDataType p = p_row[j];
+                    for(index_t d = 0; d < hdim_v; ++d)
+                        o_row[d] += p * v_tile[j * hdim_v + d];
+                }
+            }
+        }
+
+        for(index_t i = 0; i < rows; ++i)
+        {
+            const index_t i_q = seq.q_offset + i_q0 + i;
+
+            // if sum is zero (fully masked row) don't divide
+            const SMPLComputeDataType l = l_run[i];
+            const OaccDataType inv_l    = ck_tile::type_convert<OaccDataType>(
+                l > SMPLComputeDataType{0} ? SMPLComputeDataType{1} / l : SMPLComputeDataType{1});
+
+            for(index_t d = 0; d < hdim_v; ++d)
+                o_b_h_s_d(seq.i_b, i_h, i_q, d) = ck_tile::type_convert<ODataType>(
+                    oacc_element_op(o_acc[i * hdim_v + d] * inv_l));
+
+            if(lse_b_h_s)
+            {
+                // a fully masked row keeps max = -inf, report it as 0 + log(0) = -inf
+                const SMPLComputeDataType m =
+                    std::isinf(m_run[i]) ? SMPLComputeDataType{0} : m_run[i];
+                lse_b_h_s->get()(seq.i_b, i_h, i_q) = m + ck_tile::log(l);
+            }
+        }
+    };
+
+    make_ParallelTensorFunctor(f, items.size())(std::thread::hardware_concurrency());
+}
+} // namespace ck_tile
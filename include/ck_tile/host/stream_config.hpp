@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "ck_tile/host/timing_stats.hpp"
 #include <hip/hip_runtime.h>
 
 namespace ck_tile {
@@ -13,5 +14,12 @@ struct stream_config
     int log_level_         = 0;
     int cold_niters_       = 3;
     int nrepeat_           = 10;
+
+    // statistics mode: time every repetition on its own, drop the outliers (see timing_recorder)
+    // and return the median; the statistics are left in timing_recorder_, or in
+    // default_timing_recorder() if it is null
+    bool time_stats_                  = false;
+    float outlier_threshold_          = 3.5f;
+    timing_recorder* timing_recorder_ = nullptr;
 };
 } // namespace ck_tile
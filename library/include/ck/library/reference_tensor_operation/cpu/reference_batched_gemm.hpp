@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <future>
 #include <iostream>
 #include <sstream>
 
@@ -93,6 +94,15 @@ struct ReferenceBatchedGemm : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        // Run on a host thread so that the caller can set up device work meanwhile. The tensors
+        // referred to by arg must outlive the returned future.
+        std::future<float> RunAsync(const Argument& arg) const
+        {
+            return std::async(std::launch::async, [invoker = *this, arg]() mutable {
+                return invoker.Run(arg);
+            });
+        }
     };
 
     static constexpr bool IsValidCompilationParameter()
@@ -214,6 +224,15 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        // Run on a host thread so that the caller can set up device work meanwhile. The tensors
+        // referred to by arg must outlive the returned future.
+        std::future<float> RunAsync(const Argument& arg) const
+        {
+            return std::async(std::launch::async, [invoker = *this, arg]() mutable {
+                return invoker.Run(arg);
+            });
+        }
     };
 
     static constexpr bool IsValidCompilationParameter()
@@ -338,6 +357,15 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        // Run on a host thread so that the caller can set up device work meanwhile. The tensors
+        // referred to by arg must outlive the returned future.
+        std::future<float> RunAsync(const Argument& arg) const
+        {
+            return std::async(std::launch::async, [invoker = *this, arg]() mutable {
+                return invoker.Run(arg);
+            });
+        }
     };
 
     static constexpr bool IsValidCompilationParameter()
@@ -5,6 +5,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <future>
 #include <numeric>
 #include <type_traits>
 #include <vector>
@@ -369,6 +370,15 @@ struct ReferenceConvFwd : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        // Run on a host thread so that the caller can set up device work meanwhile. The tensors
+        // referred to by arg must outlive the returned future.
+        std::future<float> RunAsync(const Argument& arg) const
+        {
+            return std::async(std::launch::async, [invoker = *this, arg]() mutable {
+                return invoker.Run(arg);
+            });
+        }
     };
 
     template <typename... Args,
@@ -3,11 +3,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <sstream>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/element/combined_element_wise_operation.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_element_wise.hpp"
+#include "ck/library/utility/host_permute.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 
 namespace ck {
@@ -37,13 +42,48 @@ struct ReferenceElementwise : public device::BaseOperator
     {
         using Argument = ReferenceElementwise::Argument;
 
+        // every tensor shares the packed layout of b, so the op can be applied on flat spans
+        static bool IsFlatLayout(const Argument& arg)
+        {
+            const auto& b_desc = arg.b_tensor_.mDesc;
+
+            if(b_desc.GetElementSize() != b_desc.GetElementSpaceSize())
+                return false;
+
+            return std::all_of(arg.a_tensors_.begin(), arg.a_tensors_.end(), [&](const auto& a) {
+                return a.GetLengths() == b_desc.GetLengths() &&
+                       a.GetStrides() == b_desc.GetStrides();
+            });
+        }
+
         float Run(const Argument& arg)
         {
+            if constexpr(NumATensors == 1 || NumATensors == 2)
+            {
+                if(IsFlatLayout(arg))
+                {
+                    if constexpr(NumATensors == 1)
+                        ck::utils::elementwise_n(arg.element_op_,
+                                                 arg.b_tensor_.data(),
+                                                 arg.a_tensors_[0].data(),
+                                                 arg.b_tensor_.GetElementSize());
+                    else
+                        ck::utils::elementwise_n(arg.element_op_,
+                                                 arg.b_tensor_.data(),
+                                                 arg.a_tensors_[0].data(),
+                                                 arg.a_tensors_[1].data(),
+                                                 arg.b_tensor_.GetElementSize());
+                    return 0;
+                }
+            }
+
             if constexpr(NumATensors == 1)
             {
-                arg.b_tensor_.ForEach([&](auto& self, auto idx) {
-                    arg.element_op_(self(idx), arg.a_tensors_[0](idx));
-                });
+                // a and b differ in layout only, e.g. NCHW -> NHWC
+                std::vector<std::size_t> identity(arg.b_tensor_.GetLengths().size());
+                std::iota(identity.begin(), identity.end(), 0);
+
+                ck::utils::permute(arg.b_tensor_, arg.a_tensors_[0], identity, arg.element_op_);
             }
             else if constexpr(NumATensors == 2)
             {
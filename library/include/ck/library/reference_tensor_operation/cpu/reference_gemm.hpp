@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <future>
 #include <iostream>
 #include <sstream>
 
@@ -57,8 +58,46 @@ struct ReferenceGemm : public device::BaseOperator
     {
         using Argument = ReferenceGemm::Argument;
 
+        // Pass-through operands enter the float accumulation below as type_convert<float>(x), so
+        // they can be widened once up front, with the same products
+        template <typename DataType, typename ComputeType, typename ElementOp>
+        static constexpr bool is_widened_operand_v =
+            is_same_v<AccDataType, float> &&
+            (is_same_v<ElementOp, ck::tensor_operation::element_wise::PassThrough> ||
+             is_same_v<ElementOp, ck::tensor_operation::element_wise::ConvertBF16RTN>) &&
+            (is_same_v<ComputeType, DataType> || is_same_v<ComputeType, float>);
+
         float Run(const Argument& arg)
         {
+            if constexpr(is_widened_operand_v<ADataType, ComputeTypeA, AElementwiseOperation> &&
+                         is_widened_operand_v<BDataType, ComputeTypeB, BElementwiseOperation>)
+            {
+                const auto a_m_k = arg.a_m_k_.template CopyAsType<float>();
+                const auto b_k_n = arg.b_k_n_.template CopyAsType<float>();
+
+                auto f_mk_kn_mn = [&](auto m, auto n) {
+                    const int K = a_m_k.mDesc.GetLengths()[1];
+
+                    float v_acc = 0;
+
+                    for(int k = 0; k < K; ++k)
+                        v_acc += a_m_k(m, k) * b_k_n(k, n);
+
+                    CDataType v_c = 0;
+
+                    arg.c_element_op_(v_c, v_acc);
+
+                    arg.c_m_n_(m, n) = v_c;
+                };
+
+                make_ParallelTensorFunctor(f_mk_kn_mn,
+                                           arg.c_m_n_.mDesc.GetLengths()[0],
+                                           arg.c_m_n_.mDesc.GetLengths()[1])(
+                    std::thread::hardware_concurrency());
+
+                return 0;
+            }
+
             auto f_mk_kn_mn = [&](auto m, auto n) {
                 const int K = arg.a_m_k_.mDesc.GetLengths()[1];
 
@@ -112,6 +151,15 @@ struct ReferenceGemm : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        // Run on a host thread so that the caller can set up device work meanwhile. The tensors
+        // referred to by arg must outlive the returned future.
+        std::future<float> RunAsync(const Argument& arg) const
+        {
+            return std::async(std::launch::async, [invoker = *this, arg]() mutable {
+                return invoker.Run(arg);
+            });
+        }
     };
 
     static constexpr bool IsValidCompilationParameter()
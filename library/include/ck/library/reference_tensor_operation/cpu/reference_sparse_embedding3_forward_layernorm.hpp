@@ -3,14 +3,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <algorithm>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_parallel.hpp"
+#include "ck/library/utility/host_simd.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -24,6 +30,10 @@ template <typename EmbType,
           typename OutType>
 struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
 {
+    static constexpr ck::index_t NumEmbeddings = 3;
+
+    using EmbeddingRows = std::array<const EmbType*, NumEmbeddings>;
+
     struct Argument : public device::BaseArgument
     {
         Argument(Tensor<OutType>& output,
@@ -40,9 +50,8 @@ struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
                  ck::index_t IndexLength,
                  AccDataType epsilon)
             : output_(output),
-              emb_a_(emb_a),
-              emb_b_(emb_b),
-              emb_c_(emb_c),
+              p_embs_{emb_a.mData.data(), emb_b.mData.data(), emb_c.mData.data()},
+              emb_row_strides_{GetRowStride(emb_a), GetRowStride(emb_b), GetRowStride(emb_c)},
               index_a_(index_a),
               index_b_(index_b),
               index_c_(index_c),
@@ -54,15 +63,59 @@ struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
               epsilon_(epsilon)
         {
         }
+
+        // embedding tables given as packed row-major [NumRows, EmbeddingDim] arrays, e.g. the
+        // data of a ck::utils::MappedFile, so that tables larger than host memory can be used
+        Argument(Tensor<OutType>& output,
+                 const EmbType* p_emb_a,
+                 const EmbType* p_emb_b,
+                 const EmbType* p_emb_c,
+                 const Tensor<IndexType>& index_a,
+                 const Tensor<IndexType>& index_b,
+                 const Tensor<IndexType>& index_c,
+                 const Tensor<GammaDataType>& gamma,
+                 const Tensor<BetaDataType>& beta,
+                 ck::index_t NumRows,
+                 ck::index_t EmbeddingDim,
+                 ck::index_t IndexLength,
+                 AccDataType epsilon)
+            : output_(output),
+              p_embs_{p_emb_a, p_emb_b, p_emb_c},
+              emb_row_strides_{static_cast<std::size_t>(EmbeddingDim),
+                               static_cast<std::size_t>(EmbeddingDim),
+                               static_cast<std::size_t>(EmbeddingDim)},
+              index_a_(index_a),
+              index_b_(index_b),
+              index_c_(index_c),
+              gamma_(gamma),
+              beta_(beta),
+              NumRows_(NumRows),
+              EmbeddingDim_(EmbeddingDim),
+              IndexLength_(IndexLength),
+              epsilon_(epsilon)
+        {
+        }
+
+        static std::size_t GetRowStride(const Tensor<EmbType>& emb)
+        {
+            const auto strides = emb.mDesc.GetStrides();
+
+            if(strides.size() != 2 || strides[1] != 1)
+            {
+                throw std::runtime_error("wrong! embedding rows must be contiguous");
+            }
+
+            return strides[0];
+        }
+
         Tensor<OutType>& output_;
-        const Tensor<EmbType> emb_a_;
-        const Tensor<EmbType> emb_b_;
-        const Tensor<EmbType> emb_c_;
-        const Tensor<IndexType> index_a_;
-        const Tensor<IndexType> index_b_;
-        const Tensor<IndexType> index_c_;
-        const Tensor<GammaDataType> gamma_;
-        const Tensor<BetaDataType> beta_;
+        EmbeddingRows p_embs_;
+        std::array<std::size_t, NumEmbeddings> emb_row_strides_;
+        const Tensor<IndexType>& index_a_;
+        const Tensor<IndexType>& index_b_;
+        const Tensor<IndexType>& index_c_;
+        const Tensor<GammaDataType>& gamma_;
+        const Tensor<BetaDataType>& beta_;
         ck::index_t NumRows_;
         ck::index_t EmbeddingDim_;
         ck::index_t IndexLength_;
@@ -70,69 +123,189 @@ struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
     };
 
     // Invoker
+    //
+    // Tokens are split over host threads. For every token the three gathered rows are summed
+    // into a per-thread row buffer, which also yields sum(x) and sum(x * x), and the buffer is
+    // normalized while it is still in L1. The rows of a later token are prefetched while the
+    // current one is processed, since the gathers are random and miss in cache.
     struct Invoker : public device::BaseInvoker
     {
-        float Run(const Argument& arg)
+        static constexpr std::size_t PrefetchDistance = 2;  // tokens
+        static constexpr std::size_t TokensPerThread  = 16; // minimal work per thread
+
+        static constexpr bool IsVectorized =
+            std::is_same_v<AccDataType, float> &&
+            (std::is_same_v<EmbType, float> || std::is_same_v<EmbType, half_t>);
+
+        static void PrefetchRows(const EmbeddingRows& rows, std::size_t D)
         {
-            ck::index_t D = arg.EmbeddingDim_;
-            ck::index_t L = arg.IndexLength_;
-            ck::index_t E = arg.NumRows_;
+            constexpr std::size_t cache_line = 64;
 
-            Tensor<AccDataType> accumulator({L, D});
+            for(const EmbType* p_row : rows)
+            {
+                const char* p = reinterpret_cast<const char*>(p_row);
+                for(std::size_t b = 0; b < D * sizeof(EmbType); b += cache_line)
+                    __builtin_prefetch(p + b);
+            }
+        }
 
-            Tensor<AccDataType> mean({L});
-            Tensor<AccDataType> var({L});
+        // x = row_a + row_b + row_c, returns {sum(x), sum(x * x)}
+        static std::pair<AccDataType, AccDataType>
+        GatherSum(AccDataType* p_x, const EmbeddingRows& rows, std::size_t D)
+        {
+            AccDataType sum   = 0;
+            AccDataType sqsum = 0;
 
-            accumulator.SetZero();
+            if constexpr(IsVectorized)
+            {
+                namespace simd = ck::utils::simd;
 
-            auto f_emb_per_row = [&](auto idx) {
-                IndexType idx_a = arg.index_a_(idx);
-                IndexType idx_b = arg.index_b_(idx);
-                IndexType idx_c = arg.index_c_(idx);
+                simd::vfloat vsum   = {};
+                simd::vfloat vsqsum = {};
 
-                if(!((idx_a < E) && (idx_b < E) && (idx_c < E)))
+                std::size_t d = 0;
+                for(; d + simd::FloatLanes <= D; d += simd::FloatLanes)
                 {
-                    throw(std::runtime_error("wrong! out of range"));
+                    const simd::vfloat x = simd::load(rows[0] + d) + simd::load(rows[1] + d) +
+                                           simd::load(rows[2] + d);
+                    simd::store(p_x + d, x);
+                    vsum += x;
+                    vsqsum += x * x;
                 }
 
-                for(auto d = 0; d < D; d++)
+                if(d < D)
                 {
-                    auto v_a = ck::type_convert<AccDataType>(arg.emb_a_(idx_a, d));
-                    auto v_b = ck::type_convert<AccDataType>(arg.emb_b_(idx_b, d));
-                    auto v_c = ck::type_convert<AccDataType>(arg.emb_c_(idx_c, d));
+                    // the zero filled lanes do not change the sums
+                    const std::size_t n  = D - d;
+                    const simd::vfloat x = simd::load_partial(rows[0] + d, n) +
+                                           simd::load_partial(rows[1] + d, n) +
+                                           simd::load_partial(rows[2] + d, n);
+                    simd::store_partial(p_x + d, x, n);
+                    vsum += x;
+                    vsqsum += x * x;
+                }
 
-                    accumulator(idx, d) += v_a + v_b + v_c;
+                sum   = simd::reduce_add(vsum);
+                sqsum = simd::reduce_add(vsqsum);
+            }
+            else
+            {
+                for(std::size_t d = 0; d < D; ++d)
+                {
+                    const AccDataType x = ck::type_convert<AccDataType>(rows[0][d]) +
+                                          ck::type_convert<AccDataType>(rows[1][d]) +
+                                          ck::type_convert<AccDataType>(rows[2][d]);
+                    p_x[d] = x;
+                    sum += x;
+                    sqsum += x * x;
                 }
-            };
-            make_ParallelTensorFunctor(f_emb_per_row, L)(std::thread::hardware_concurrency());
+            }
+
+            return {sum, sqsum};
+        }
 
-            // layernorm
-            for(auto idx = 0; idx < L; ++idx)
+        // x = (x - mean) / sd * gamma + beta
+        static void Normalize(AccDataType* p_x,
+                              const AccDataType* p_gamma,
+                              const AccDataType* p_beta,
+                              AccDataType mean,
+                              AccDataType sd,
+                              std::size_t D)
+        {
+            if constexpr(IsVectorized)
             {
-                mean(idx) = 0;
-                var(idx)  = 0;
+                namespace simd = ck::utils::simd;
 
-                for(auto d = 0; d < D; ++d)
+                std::size_t d = 0;
+                for(; d + simd::FloatLanes <= D; d += simd::FloatLanes)
                 {
-                    auto x_val = accumulator(idx, d);
-                    mean(idx) += x_val;
-                    var(idx) += x_val * x_val;
+                    const simd::vfloat x = simd::load(p_x + d);
+                    simd::store(p_x + d,
+                                (x - mean) / sd * simd::load(p_gamma + d) + simd::load(p_beta + d));
                 }
 
-                mean(idx) = mean(idx) / D;
-                var(idx)  = (var(idx) / D) - (mean(idx) * mean(idx));
+                if(d < D)
+                {
+                    const std::size_t n  = D - d;
+                    const simd::vfloat x = simd::load_partial(p_x + d, n);
+                    simd::store_partial(p_x + d,
+                                        (x - mean) / sd * simd::load_partial(p_gamma + d, n) +
+                                            simd::load_partial(p_beta + d, n),
+                                        n);
+                }
             }
+            else
+            {
+                for(std::size_t d = 0; d < D; ++d)
+                    p_x[d] = (p_x[d] - mean) / sd * p_gamma[d] + p_beta[d];
+            }
+        }
 
-            for(auto idx = 0; idx < L; ++idx)
+        float Run(const Argument& arg)
+        {
+            const std::size_t D = arg.EmbeddingDim_;
+            const std::size_t L = arg.IndexLength_;
+            const IndexType E   = arg.NumRows_;
+
+            const std::array<const Tensor<IndexType>*, NumEmbeddings> indices{
+                &arg.index_a_, &arg.index_b_, &arg.index_c_};
+
+            // resolve and check every gather up front, the worker threads must not throw
+            std::vector<EmbeddingRows> rows(L);
+            for(std::size_t l = 0; l < L; ++l)
             {
-                for(auto d = 0; d < D; ++d)
+                for(ck::index_t i = 0; i < NumEmbeddings; ++i)
                 {
-                    auto x_val          = accumulator(idx, d);
-                    auto y_val          = (x_val - mean(idx)) / sqrt(var(idx) + arg.epsilon_);
-                    y_val               = (y_val * arg.gamma_(d)) + arg.beta_(d);
-                    arg.output_(idx, d) = ck::type_convert<OutType>(y_val);
+                    const IndexType idx = (*indices[i])(l);
+
+                    if(!(idx >= 0 && idx < E))
+                    {
+                        throw(std::runtime_error("wrong! out of range"));
+                    }
+
+                    rows[l][i] = arg.p_embs_[i] + static_cast<std::size_t>(idx) *
+                                                       arg.emb_row_strides_[i];
                 }
             }
+
+            std::vector<AccDataType> gamma(D);
+            std::vector<AccDataType> beta(D);
+            for(std::size_t d = 0; d < D; ++d)
+            {
+                gamma[d] = ck::type_convert<AccDataType>(arg.gamma_(d));
+                beta[d]  = ck::type_convert<AccDataType>(arg.beta_(d));
+            }
+
+            const std::size_t out_stride = arg.output_.mDesc.GetStrides()[1];
+
+            auto f_tokens = [&](std::size_t begin, std::size_t end) {
+                std::vector<AccDataType> x(D);
+
+                for(std::size_t l = begin; l < end; ++l)
+                {
+                    if(l + PrefetchDistance < end)
+                    {
+                        PrefetchRows(rows[l + PrefetchDistance], D);
+                    }
+
+                    const auto [sum, sqsum] = GatherSum(x.data(), rows[l], D);
+
+                    const AccDataType mean = sum / D;
+                    const AccDataType var  = (sqsum / D) - (mean * mean);
+                    const AccDataType sd   = std::sqrt(var + arg.epsilon_);
+
+                    Normalize(x.data(), gamma.data(), beta.data(), mean, sd, D);
+
+                    OutType* p_out =
+                        arg.output_.mData.data() + arg.output_.mDesc.GetOffsetFromMultiIndex(l, 0);
+                    for(std::size_t d = 0; d < D; ++d)
+                        p_out[d * out_stride] = ck::type_convert<OutType>(x[d]);
+                }
+            };
+
+            ck::utils::parallel_for(
+                L, f_tokens, ck::utils::get_host_num_thread(), TokensPerThread);
+
             return 0;
         }
 
@@ -180,6 +353,35 @@ struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
                         epsilon);
     }
 
+    static auto MakeArgument(Tensor<OutType>& output,
+                             const EmbType* p_emb_a,
+                             const EmbType* p_emb_b,
+                             const EmbType* p_emb_c,
+                             const Tensor<IndexType>& index_a,
+                             const Tensor<IndexType>& index_b,
+                             const Tensor<IndexType>& index_c,
+                             const Tensor<GammaDataType>& gamma,
+                             const Tensor<BetaDataType>& beta,
+                             ck::index_t NumRows,
+                             ck::index_t EmbeddingDim,
+                             ck::index_t IndexLength,
+                             AccDataType epsilon)
+    {
+        return Argument(output,
+                        p_emb_a,
+                        p_emb_b,
+                        p_emb_c,
+                        index_a,
+                        index_b,
+                        index_c,
+                        gamma,
+                        beta,
+                        NumRows,
+                        EmbeddingDim,
+                        IndexLength,
+                        epsilon);
+    }
+
     static auto MakeInvoker() { return Invoker{}; }
 
     virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
@@ -1,8 +1,10 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
+#include <memory>
+#include <string>
 #include <vector>
 #include <type_traits>
 
@@ -13,10 +15,35 @@ namespace tensor_operation {
 namespace device {
 namespace instance {
 
+// An instance that is not constructed yet: its type string and how to construct it
+template <typename BaseOp>
+struct DeviceOperationInstanceDescriptor
+{
+    std::string type_string;
+    std::unique_ptr<BaseOp> (*make)() = nullptr;
+};
+
+namespace detail {
+
+// Set by DeviceOperationInstanceRegistry while it collects the descriptors of the BaseOp instances
+template <typename BaseOp>
+inline thread_local std::vector<DeviceOperationInstanceDescriptor<BaseOp>>* descriptor_sink =
+    nullptr;
+
+template <typename BaseOp, typename NewOpInstance>
+std::unique_ptr<BaseOp> make_device_operation_instance()
+{
+    return std::make_unique<NewOpInstance>();
+}
+
+} // namespace detail
+
 template <typename BaseOp, typename NewOpInstances>
 void add_device_operation_instances(std::vector<std::unique_ptr<BaseOp>>& op_instances,
                                     const NewOpInstances& new_op_instances)
 {
+    auto* const descriptors = detail::descriptor_sink<BaseOp>;
+
     ck::static_for<0, std::tuple_size_v<NewOpInstances>, 1>{}([&](auto i) {
         const auto new_op_instance = std::get<i>(new_op_instances);
 
@@ -25,7 +52,16 @@ void add_device_operation_instances(std::vector<std::unique_ptr<BaseOp>>& op_ins
         static_assert(std::is_base_of_v<BaseOp, NewOpInstance>,
                       "wrong! NewOpInstance should be derived from BaseOp");
 
-        op_instances.push_back(std::make_unique<NewOpInstance>(new_op_instance));
+        if(descriptors != nullptr)
+        {
+            descriptors->push_back(
+                {new_op_instance.GetTypeString(),
+                 &detail::make_device_operation_instance<BaseOp, NewOpInstance>});
+        }
+        else
+        {
+            op_instances.push_back(std::make_unique<NewOpInstance>(new_op_instance));
+        }
     });
 }
 
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+#include "ck/library/tensor_operation_instance/add_device_operation_instance.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+struct AnyDescriptor
+{
+    template <typename Descriptor>
+    bool operator()(const Descriptor&) const
+    {
+        return true;
+    }
+};
+
+// The GemmSpecialization, printed as the first template argument of the type string
+struct MatchGemmSpecialization
+{
+    GemmSpecialization spec;
+
+    template <typename Descriptor>
+    bool operator()(const Descriptor& d) const
+    {
+        const std::string s   = "<" + getGemmSpecializationString(spec);
+        const std::size_t pos = d.type_string.find(s);
+
+        return pos != std::string::npos && pos + s.size() < d.type_string.size() &&
+               (d.type_string[pos + s.size()] == ',' || d.type_string[pos + s.size()] == '>');
+    }
+};
+
+// A "Name: value" field printed after the template arguments, e.g. {"BlkTile", "256x128x64"} or
+// {"BlkGemmPipelineVersion", "v3"}
+struct MatchTypeStringField
+{
+    std::string name;
+    std::string value;
+
+    template <typename Descriptor>
+    bool operator()(const Descriptor& d) const
+    {
+        const std::string& s    = d.type_string;
+        const std::string field = name + ": " + value;
+
+        for(std::size_t pos = s.find(field); pos != std::string::npos;
+            pos = s.find(field, pos + 1))
+        {
+            const std::size_t end = pos + field.size();
+            if((pos == 0 || !std::isalnum(static_cast<unsigned char>(s[pos - 1]))) &&
+               (end == s.size() || s[end] == ',' || s[end] == ' '))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+/**
+ * @brief The instances of DeviceOp as descriptors, collected once from its
+ * DeviceOperationInstanceFactory
+ *
+ * The instances that the factory adds with add_device_operation_instances() are described by
+ * their type string and constructor only, so they can be filtered, e.g. by GemmSpecialization,
+ * tile or pipeline, before any of them is constructed, and only the chosen ones are constructed.
+ * Instances that a factory constructs by other means are described after the others, and
+ * constructing one of them runs the factory again.
+ */
+template <typename DeviceOp>
+class DeviceOperationInstanceRegistry
+{
+    public:
+    using Descriptor    = DeviceOperationInstanceDescriptor<DeviceOp>;
+    using InstancePtrs  = std::vector<std::unique_ptr<DeviceOp>>;
+    using GetInstancesF = std::function<InstancePtrs()>;
+
+    explicit DeviceOperationInstanceRegistry(GetInstancesF get_instances)
+        : mGetInstances(std::move(get_instances))
+    {
+        const auto others = Collect(mDescriptors);
+
+        mNumRegistered = mDescriptors.size();
+        for(const auto& op_ptr : others)
+        {
+            mDescriptors.push_back({op_ptr->GetTypeString(), nullptr});
+        }
+    }
+
+    static const DeviceOperationInstanceRegistry& GetDefault()
+    {
+        static const DeviceOperationInstanceRegistry registry(
+            [] { return DeviceOperationInstanceFactory<DeviceOp>::GetInstances(); });
+
+        return registry;
+    }
+
+    const std::vector<Descriptor>& GetDescriptors() const { return mDescriptors; }
+
+    template <typename Predicate>
+    std::vector<const Descriptor*> Filter(Predicate predicate) const
+    {
+        std::vector<const Descriptor*> found;
+        for(const auto& d : mDescriptors)
+        {
+            if(predicate(d))
+            {
+                found.push_back(&d);
+            }
+        }
+
+        return found;
+    }
+
+    // d is one of GetDescriptors()
+    std::unique_ptr<DeviceOp> MakeInstance(const Descriptor& d) const
+    {
+        if(d.make != nullptr)
+        {
+            return d.make();
+        }
+
+        std::vector<Descriptor> registered;
+        auto others = Collect(registered);
+
+        const auto i = static_cast<std::size_t>(&d - mDescriptors.data()) - mNumRegistered;
+        return i < others.size() ? std::move(others[i]) : nullptr;
+    }
+
+    // The instances that predicate accepts, in the order of the factory
+    template <typename Predicate = AnyDescriptor>
+    InstancePtrs GetInstances(Predicate predicate = {}) const
+    {
+        InstancePtrs op_ptrs;
+        for(const auto* d : Filter(predicate))
+        {
+            op_ptrs.push_back(MakeInstance(*d));
+        }
+
+        return op_ptrs;
+    }
+
+    private:
+    // Runs the factory with the descriptors of add_device_operation_instances() going to
+    // descriptors, returns the instances it constructed by other means
+    InstancePtrs Collect(std::vector<Descriptor>& descriptors) const
+    {
+        struct SinkGuard
+        {
+            std::vector<Descriptor>* previous = detail::descriptor_sink<DeviceOp>;
+            ~SinkGuard() { detail::descriptor_sink<DeviceOp> = previous; }
+        } guard;
+
+        detail::descriptor_sink<DeviceOp> = &descriptors;
+        return mGetInstances();
+    }
+
+    GetInstancesF mGetInstances;
+    std::vector<Descriptor> mDescriptors;
+    std::size_t mNumRegistered = 0;
+};
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
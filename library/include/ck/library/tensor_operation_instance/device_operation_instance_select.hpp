@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ck/host_utility/device_prop.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_registry.hpp"
+#include "ck/library/utility/tuning_db.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// Maps DeviceOp to the operation, data type and layout of its tuning records, specialized next to
+// the DeviceOperationInstanceFactory of the operations that can be tuned:
+//   static utils::TuningKey Get(const std::string& arch);
+template <typename DeviceOp>
+struct DeviceOperationTuningKey;
+
+struct TuningProblem
+{
+    // in the order of the ckProfiler arguments of the operation, e.g. M, N, K, StrideA, StrideB,
+    // StrideC for GEMM
+    std::vector<std::int64_t> shape;
+    // the current device if empty
+    std::string arch;
+};
+
+struct AnyInstance
+{
+    template <typename DeviceOp>
+    bool operator()(DeviceOp&) const
+    {
+        return true;
+    }
+};
+
+/**
+ * @brief The tuned instance of DeviceOp for a problem
+ *
+ * Looks the problem up in the tuning database and returns the instance of the tuning record with
+ * the same shape, or else of the nearest tuned shape, that is_supported accepts. Without a usable
+ * record the first instance that is_supported accepts is returned, nullptr if there is none.
+ * is_supported gets the instance and usually checks IsSupportedArgument() of the argument made
+ * for the problem.
+ */
+template <typename DeviceOp, typename IsSupported = AnyInstance>
+std::unique_ptr<DeviceOp> Select(const TuningProblem& problem,
+                                 IsSupported is_supported  = {},
+                                 const utils::TuningDb& db = utils::TuningDb::GetDefault())
+{
+    // only the instances that are tried are constructed
+    const auto& registry    = DeviceOperationInstanceRegistry<DeviceOp>::GetDefault();
+    const auto& descriptors = registry.GetDescriptors();
+
+    const auto key = DeviceOperationTuningKey<DeviceOp>::Get(
+        problem.arch.empty() ? ck::get_device_name() : problem.arch);
+
+    for(const auto* record : db.Lookup(key, problem.shape))
+    {
+        for(const auto& d : descriptors)
+        {
+            if(d.type_string != record->instance)
+            {
+                continue;
+            }
+            if(auto op_ptr = registry.MakeInstance(d); op_ptr != nullptr && is_supported(*op_ptr))
+            {
+                return op_ptr;
+            }
+        }
+    }
+
+    for(const auto& d : descriptors)
+    {
+        if(auto op_ptr = registry.MakeInstance(d); op_ptr != nullptr && is_supported(*op_ptr))
+        {
+            return op_ptr;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
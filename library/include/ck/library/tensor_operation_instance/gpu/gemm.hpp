@@ -11,6 +11,7 @@
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 
 #include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_select.hpp"
 
 #ifdef DL_KERNELS
 #include "gemm_dl.inc"
@@ -348,6 +349,49 @@ struct DeviceOperationInstanceFactory<
     }
 };
 
+// data type and layout as the arguments of ckProfiler gemm
+template <typename ALayout,
+          typename BLayout,
+          typename CLayout,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType>
+struct DeviceOperationTuningKey<
+    ck::tensor_operation::device::DeviceGemm<ALayout,
+                                             BLayout,
+                                             CLayout,
+                                             ADataType,
+                                             BDataType,
+                                             CDataType,
+                                             ck::tensor_operation::element_wise::PassThrough,
+                                             ck::tensor_operation::element_wise::PassThrough,
+                                             ck::tensor_operation::element_wise::PassThrough>>
+{
+    static utils::TuningKey Get(const std::string& arch)
+    {
+        std::string data_type;
+        if constexpr(is_same_v<ADataType, BDataType> && is_same_v<ADataType, CDataType>)
+        {
+            data_type = is_same_v<ADataType, F32>    ? "0"
+                        : is_same_v<ADataType, F16>  ? "1"
+                        : is_same_v<ADataType, BF16> ? "2"
+                        : is_same_v<ADataType, I8>   ? "3"
+                        : is_same_v<ADataType, F8>   ? "4"
+                                                     : "";
+        }
+
+        std::string layout;
+        if constexpr(is_same_v<CLayout, Row>)
+        {
+            // 0: mk_kn_mn, 1: mk_nk_mn, 2: km_kn_mn, 3: km_nk_mn
+            layout = std::to_string((is_same_v<ALayout, Col> ? 2 : 0) +
+                                    (is_same_v<BLayout, Col> ? 1 : 0));
+        }
+
+        return {arch, "gemm", data_type, layout};
+    }
+};
+
 } // namespace instance
 } // namespace device
 } // namespace tensor_operation
@@ -4,12 +4,18 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -18,11 +24,422 @@
 #include "ck/utility/type.hpp"
 #include "ck/host_utility/io.hpp"
 
+#include "ck/library/utility/host_parallel.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 namespace ck {
 namespace utils {
 
+struct CheckErrConfig
+{
+    // number of mismatches recorded in CheckErrResult::mismatches
+    std::size_t max_num_mismatch = 5;
+    // stop at the first mismatch when only the verdict is needed, the statistics then only cover
+    // the elements compared so far
+    bool stop_at_first_error = false;
+    // row-major lengths of the compared tensors, used to report mismatches as multi-indices
+    std::vector<std::size_t> lengths;
+    std::size_t num_thread = get_host_num_thread();
+};
+
+struct CheckErrResult
+{
+    // bin 0 counts the exact matches and bin k > 0 the errors of [2^(k-1), 2^k) units in the last
+    // place of ref in the compared type, larger errors go to the last bin. Elements where out or
+    // ref is not finite are not binned
+    static constexpr std::size_t NumUlpBin = 32;
+
+    struct Mismatch
+    {
+        std::size_t index;
+        std::vector<std::size_t> multi_index;
+        double out;
+        double ref;
+    };
+
+    bool pass                 = true;
+    std::size_t num_element   = 0;
+    std::size_t err_count     = 0;
+    std::size_t out_nan_count = 0;
+    std::size_t out_inf_count = 0;
+    std::size_t ref_nan_count = 0;
+    std::size_t ref_inf_count = 0;
+    double max_abs_err        = 0;
+    double max_rel_err        = 0;
+    // elements where both out and ref are finite, and their mean absolute error
+    std::size_t num_finite = 0;
+    double mean_abs_err    = 0;
+    std::array<std::size_t, NumUlpBin> ulp_histogram{};
+    // the first mismatches in index order
+    std::vector<Mismatch> mismatches;
+
+    explicit operator bool() const { return pass; }
+};
+
+namespace detail {
+
+template <typename T>
+double to_double(const T& x)
+{
+    if constexpr(std::is_same_v<T, bhalf_t> || std::is_same_v<T, f8_t> || std::is_same_v<T, bf8_t>)
+        return type_convert<float>(x);
+    else
+        return static_cast<double>(x);
+}
+
+// unbiased exponent of a finite non-zero double
+inline int double_exponent(double x)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+
+    return static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+}
+
+// exponent of the unit in the last place of a value of type T with magnitude |r|
+template <typename T>
+int ulp_exponent(double r)
+{
+    int mant = 0;
+    int bias = 0;
+
+    if constexpr(std::is_same_v<T, double>)
+    {
+        mant = 52;
+        bias = 1023;
+    }
+    else if constexpr(std::is_same_v<T, bhalf_t>)
+    {
+        mant = 7;
+        bias = 127;
+    }
+    else if constexpr(std::is_same_v<T, float> || std::is_same_v<T, half_t> ||
+                      std::is_same_v<T, f8_t> || std::is_same_v<T, bf8_t>)
+    {
+        mant = NumericUtils<T>::mant;
+        bias = NumericUtils<T>::bias;
+    }
+    else
+    {
+        return 0; // integers
+    }
+
+    return (r > 0 ? std::max(double_exponent(r), 1 - bias) : 1 - bias) - mant;
+}
+
+// add the statistics of part, whose indices start at index_offset, to result
+inline void merge_check_err_result(CheckErrResult& result,
+                                   CheckErrResult&& part,
+                                   std::size_t index_offset,
+                                   std::size_t max_num_mismatch)
+{
+    const std::size_t num_finite = result.num_finite + part.num_finite;
+    if(num_finite > 0)
+    {
+        result.mean_abs_err = (result.mean_abs_err * static_cast<double>(result.num_finite) +
+                               part.mean_abs_err * static_cast<double>(part.num_finite)) /
+                              static_cast<double>(num_finite);
+    }
+
+    result.pass = result.pass && part.pass;
+    result.num_element += part.num_element;
+    result.num_finite = num_finite;
+    result.err_count += part.err_count;
+    result.out_nan_count += part.out_nan_count;
+    result.out_inf_count += part.out_inf_count;
+    result.ref_nan_count += part.ref_nan_count;
+    result.ref_inf_count += part.ref_inf_count;
+    result.max_abs_err = std::max(result.max_abs_err, part.max_abs_err);
+    result.max_rel_err = std::max(result.max_rel_err, part.max_rel_err);
+    for(std::size_t k = 0; k < CheckErrResult::NumUlpBin; ++k)
+        result.ulp_histogram[k] += part.ulp_histogram[k];
+
+    for(auto& mismatch : part.mismatches)
+    {
+        if(result.mismatches.size() == max_num_mismatch)
+            break;
+
+        mismatch.index += index_offset;
+        result.mismatches.push_back(std::move(mismatch));
+    }
+}
+
+// fill the multi-indices of the mismatches from the row-major lengths of the compared tensors
+inline void set_mismatch_multi_index(CheckErrResult& result,
+                                     const std::vector<std::size_t>& lengths)
+{
+    if(lengths.empty())
+        return;
+
+    for(auto& mismatch : result.mismatches)
+    {
+        mismatch.multi_index.resize(lengths.size());
+
+        std::size_t i = mismatch.index;
+        for(std::size_t d = lengths.size(); d-- > 0;)
+        {
+            mismatch.multi_index[d] = i % lengths[d];
+            i /= lengths[d];
+        }
+    }
+}
+
+// Compare out against ref in one pass and collect the statistics of CheckErrResult.
+// is_error(o, r, o_value, r_value, err) decides whether the raw elements o and r, with the double
+// values o_value and r_value, are a mismatch. Random access ranges are split into fixed chunks
+// compared by the host thread pool and merged in order, so the result does not depend on the
+// thread count. Each chunk converts blocks of elements to double first and only revisits the
+// elements of a block one by one when it holds errors, inexact or non-finite values.
+template <typename Range, typename RefRange, typename IsError>
+CheckErrResult check_err_stats(const Range& out,
+                               const RefRange& ref,
+                               IsError is_error,
+                               const CheckErrConfig& config = {})
+{
+    using T = ranges::range_value_t<Range>;
+
+    if(std::size(out) != std::size(ref))
+        throw std::runtime_error("wrong! out.size() != ref.size()");
+
+    constexpr std::size_t block = 256;
+    constexpr std::size_t chunk = 1 << 16;
+
+    const std::size_t n = std::size(out);
+    std::atomic<bool> failed{false};
+
+    // compare the elements [begin, end) starting at it_out and it_ref
+    auto compare = [&](auto it_out, auto it_ref, std::size_t begin, std::size_t end) {
+        CheckErrResult result;
+        double sum = 0;
+
+        T o_raw[block], r_raw[block];
+        double o[block], r[block], err[block];
+        bool error[block];
+        int bin[block];
+
+        for(std::size_t b = begin; b < end; b += block)
+        {
+            if(config.stop_at_first_error && failed.load(std::memory_order_relaxed))
+                break;
+
+            const std::size_t size = std::min(block, end - b);
+
+            for(std::size_t j = 0; j < size; ++j, ++it_out, ++it_ref)
+            {
+                o_raw[j] = *it_out;
+                r_raw[j] = *it_ref;
+                o[j]     = to_double(o_raw[j]);
+                r[j]     = to_double(r_raw[j]);
+            }
+
+            // the reductions are kept in Lanes independent accumulators so that they can be
+            // vectorized without reordering floating point additions
+            constexpr std::size_t Lanes = 4;
+            constexpr double max_value  = std::numeric_limits<double>::max();
+
+            double sum_abs_err[Lanes] = {};
+            double max_abs_err[Lanes] = {};
+            double max_rel_err[Lanes] = {};
+            double num_finite_[Lanes] = {};
+            double num_exact_[Lanes]  = {};
+
+            for(std::size_t j = size; j < (size + Lanes - 1) / Lanes * Lanes; ++j)
+            {
+                o[j] = 0;
+                r[j] = 0;
+            }
+
+            for(std::size_t j0 = 0; j0 < size; j0 += Lanes)
+            {
+                for(std::size_t l = 0; l < Lanes; ++l)
+                {
+                    const std::size_t j = j0 + l;
+                    // the lanes past size only pad the last step and are not counted
+                    const bool valid = j < size;
+                    // o - r is not finite exactly when o or r is not
+                    const double e = std::abs(o[j] - r[j]);
+
+                    err[j] = valid && e <= max_value ? e : 0;
+
+                    sum_abs_err[l] += err[j];
+                    max_abs_err[l] = std::max(max_abs_err[l], err[j]);
+                    max_rel_err[l] =
+                        std::max(max_rel_err[l], std::abs(r[j]) > 0 ? err[j] / std::abs(r[j]) : 0);
+                    num_finite_[l] += valid && e <= max_value ? 1 : 0;
+                    num_exact_[l] += valid && e <= 0 ? 1 : 0;
+                }
+            }
+
+            std::size_t num_error = 0;
+            for(std::size_t j = 0; j < size; ++j)
+            {
+                error[j] = is_error(o_raw[j], r_raw[j], o[j], r[j], std::abs(o[j] - r[j]));
+                num_error += error[j];
+            }
+
+            std::size_t num_finite = 0;
+            std::size_t num_exact  = 0;
+            for(std::size_t l = 0; l < Lanes; ++l)
+            {
+                sum += sum_abs_err[l];
+                result.max_abs_err = std::max(result.max_abs_err, max_abs_err[l]);
+                result.max_rel_err = std::max(result.max_rel_err, max_rel_err[l]);
+                num_finite += static_cast<std::size_t>(num_finite_[l]);
+                num_exact += static_cast<std::size_t>(num_exact_[l]);
+            }
+
+            // exact matches are counted above, the histogram is only scattered into for the
+            // elements with an error
+            result.ulp_histogram[0] += num_exact;
+            if(num_exact != num_finite)
+            {
+                for(std::size_t j = 0; j < size; ++j)
+                {
+                    bin[j] = std::clamp<int>(double_exponent(err[j]) -
+                                                 ulp_exponent<T>(std::abs(r[j])) + 1,
+                                             1,
+                                             CheckErrResult::NumUlpBin - 1);
+                }
+                for(std::size_t j = 0; j < size; ++j)
+                    if(err[j] > 0)
+                        ++result.ulp_histogram[bin[j]];
+            }
+
+            result.num_finite += num_finite;
+
+            if(num_finite != size)
+            {
+                for(std::size_t j = 0; j < size; ++j)
+                {
+                    result.out_nan_count += std::isnan(o[j]);
+                    result.out_inf_count += std::isinf(o[j]);
+                    result.ref_nan_count += std::isnan(r[j]);
+                    result.ref_inf_count += std::isinf(r[j]);
+                }
+            }
+
+            if(num_error != 0)
+            {
+                for(std::size_t j = 0; j < size; ++j)
+                {
+                    if(error[j] && result.err_count++ < config.max_num_mismatch)
+                        result.mismatches.push_back({b + j, {}, o[j], r[j]});
+                }
+
+                result.pass = false;
+            }
+
+            result.num_element += size;
+
+            if(!result.pass)
+                failed.store(true, std::memory_order_relaxed);
+        }
+
+        result.mean_abs_err =
+            result.num_finite > 0 ? sum / static_cast<double>(result.num_finite) : 0;
+
+        return result;
+    };
+
+    std::vector<CheckErrResult> partials;
+
+    if constexpr(std::is_base_of_v<
+                     std::random_access_iterator_tag,
+                     typename std::iterator_traits<decltype(std::begin(out))>::iterator_category> &&
+                 std::is_base_of_v<
+                     std::random_access_iterator_tag,
+                     typename std::iterator_traits<decltype(std::begin(ref))>::iterator_category>)
+    {
+        partials.resize((n + chunk - 1) / chunk);
+
+        parallel_for(
+            partials.size(),
+            [&](std::size_t chunk_begin, std::size_t chunk_end) {
+                for(std::size_t c = chunk_begin; c < chunk_end; ++c)
+                {
+                    const std::size_t begin = c * chunk;
+                    const auto offset       = static_cast<std::ptrdiff_t>(begin);
+
+                    partials[c] = compare(std::begin(out) + offset,
+                                          std::begin(ref) + offset,
+                                          begin,
+                                          std::min(begin + chunk, n));
+                }
+            },
+            config.num_thread,
+            1,
+            1);
+    }
+    else
+    {
+        partials.push_back(compare(std::begin(out), std::begin(ref), 0, n));
+    }
+
+    CheckErrResult result;
+    for(auto& partial : partials)
+        merge_check_err_result(result, std::move(partial), 0, config.max_num_mismatch);
+
+    set_mismatch_multi_index(result, config.lengths);
+
+    return result;
+}
+
+} // namespace detail
+
+// Single pass comparison of out against ref with the criteria of check_err(): floating point
+// elements fail when |out - ref| > atol + rtol * |ref| or either is not finite, integers when
+// |out - ref| > atol
+template <typename Range, typename RefRange>
+std::enable_if_t<std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>>,
+                 CheckErrResult>
+check_err_stats(const Range& out,
+                const RefRange& ref,
+                double rtol,
+                double atol,
+                const CheckErrConfig& config = {})
+{
+    using T = ranges::range_value_t<Range>;
+
+    if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bhalf_t>)
+    {
+        return detail::check_err_stats(
+            out,
+            ref,
+            [=](const T& o, const T& r, double, double, double) {
+                return std::abs(static_cast<int64_t>(o) - static_cast<int64_t>(r)) > atol;
+            },
+            config);
+    }
+    else
+    {
+        return detail::check_err_stats(
+            out,
+            ref,
+            [=](const T&, const T&, double o, double r, double err) {
+                return err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r);
+            },
+            config);
+    }
+}
+
+inline void
+report_check_err(std::ostream& os, const std::string& msg, const CheckErrResult& result)
+{
+    for(const auto& mismatch : result.mismatches)
+    {
+        os << msg << std::setw(12) << std::setprecision(7) << " out[" << mismatch.index
+           << "] != ref[" << mismatch.index << "]: " << mismatch.out << " != " << mismatch.ref
+           << std::endl;
+    }
+
+    const float error_percent = static_cast<float>(result.err_count) /
+                                static_cast<float>(std::max<std::size_t>(result.num_element, 1)) *
+                                100.f;
+    os << "max err: " << result.max_abs_err;
+    os << ", number of errors: " << result.err_count;
+    os << ", " << error_percent << "% wrong values" << std::endl;
+}
+
 template <typename Range, typename RefRange>
 typename std::enable_if<
     std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
@@ -42,36 +459,11 @@ check_err(const Range& out,
         return false;
     }
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<double>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = *std::next(std::begin(out), i);
-        const double r = *std::next(std::begin(ref), i);
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    const auto result = check_err_stats(out, ref, rtol, atol);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
+
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -92,37 +484,11 @@ check_err(const Range& out,
         return false;
     }
 
-    bool res{true};
-    int err_count = 0;
-    double err    = 0;
-    // TODO: This is a hack. We should have proper specialization for bhalf_t data type.
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    const auto result = check_err_stats(out, ref, rtol, atol);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
+
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -143,36 +509,11 @@ check_err(const Range& out,
         return false;
     }
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<ranges::range_value_t<Range>>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    const auto result = check_err_stats(out, ref, rtol, atol);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
+
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -197,37 +538,11 @@ check_err(const Range& out,
         return false;
     }
 
-    bool res{true};
-    int err_count   = 0;
-    int64_t err     = 0;
-    int64_t max_err = std::numeric_limits<int64_t>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const int64_t o = *std::next(std::begin(out), i);
-        const int64_t r = *std::next(std::begin(ref), i);
-        err             = std::abs(o - r);
+    const auto result = check_err_stats(out, ref, 0, atol);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
 
-        if(err > atol)
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << " out[" << i << "] != ref[" << i << "]: " << o << " != " << r
-                          << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -247,32 +562,11 @@ check_err(const Range& out,
         return false;
     }
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    const auto result = check_err_stats(out, ref, rtol, atol);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
+
+    return result.pass;
 }
 
 template <typename Range, typename RefRange>
@@ -292,32 +586,11 @@ check_err(const Range& out,
         return false;
     }
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    const auto result = check_err_stats(out, ref, rtol, atol);
+    if(!result)
+        report_check_err(std::cerr, msg, result);
+
+    return result.pass;
 }
 
 } // namespace utils
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_mapped_file.hpp"
+
+namespace ck {
+namespace utils {
+
+// statistics of one chunk of a streaming comparison, the mismatch indices are relative to offset
+struct CheckErrChunk
+{
+    std::size_t index;
+    std::size_t offset;
+    std::size_t size;
+    const CheckErrResult& result;
+};
+
+struct StreamingCheckErrConfig
+{
+    // elements compared at a time, one chunk of out and one of ref are held in memory
+    std::size_t chunk_size = std::size_t{1} << 24;
+    // error budget, the comparison stops after the chunk that exceeds it
+    std::size_t max_err_count = std::numeric_limits<std::size_t>::max();
+    // settings of the comparison of a chunk, lengths apply to the whole tensor
+    CheckErrConfig check_config;
+    // called after each chunk, e.g. to log the chunk statistics
+    std::function<void(const CheckErrChunk&)> on_chunk;
+};
+
+// Source of the elements [offset, offset + count) of a tensor of T stored in a file from
+// byte_offset on. The pages are dropped from the resident set once copied, so a file larger than
+// the host memory can be streamed through.
+template <typename T>
+auto make_mapped_file_source(const MappedFile& file, std::size_t byte_offset = 0)
+{
+    file.AdviseSequentialAccess();
+
+    return [&file, byte_offset](std::size_t offset, std::size_t count, T* p_dst) {
+        if(file.GetElementCount<T>(byte_offset) < offset + count)
+        {
+            throw std::runtime_error("wrong! mapped file holds too few elements");
+        }
+
+        const std::size_t begin = byte_offset + offset * sizeof(T);
+
+        std::memcpy(p_dst, static_cast<const char*>(file.GetBuffer()) + begin, count * sizeof(T));
+        file.ReleasePages(begin, count * sizeof(T));
+    };
+}
+
+// source reading from a range held in memory
+template <typename Range>
+auto make_range_source(const Range& range)
+{
+    return [&range](std::size_t offset, std::size_t count, auto* p_dst) {
+        std::copy_n(std::next(std::begin(range), offset), count, p_dst);
+    };
+}
+
+// Compare num_element elements of T chunk by chunk with the criteria of check_err_stats(), out
+// and ref being sources called as source(offset, count, T* dst) to produce a chunk. Memory use is
+// bounded by the chunk size rather than the tensor size. The returned statistics cover the chunks
+// compared before the error budget ran out.
+template <typename T, typename OutSource, typename RefSource>
+CheckErrResult check_err_streaming(std::size_t num_element,
+                                   OutSource&& out_source,
+                                   RefSource&& ref_source,
+                                   double rtol,
+                                   double atol,
+                                   const StreamingCheckErrConfig& config = {})
+{
+    if(config.chunk_size == 0)
+    {
+        throw std::runtime_error("wrong! chunk size is 0");
+    }
+
+    CheckErrConfig check_config = config.check_config;
+    check_config.lengths.clear();
+
+    std::vector<T> out(std::min(config.chunk_size, num_element));
+    std::vector<T> ref(out.size());
+
+    CheckErrResult result;
+
+    for(std::size_t offset = 0, index = 0; offset < num_element;
+        offset += config.chunk_size, ++index)
+    {
+        const std::size_t size = std::min(config.chunk_size, num_element - offset);
+
+        out.resize(size);
+        ref.resize(size);
+        out_source(offset, size, out.data());
+        ref_source(offset, size, ref.data());
+
+        auto chunk = check_err_stats(out, ref, rtol, atol, check_config);
+
+        if(config.on_chunk)
+        {
+            config.on_chunk(CheckErrChunk{index, offset, size, chunk});
+        }
+
+        detail::merge_check_err_result(
+            result, std::move(chunk), offset, config.check_config.max_num_mismatch);
+
+        if(result.err_count > config.max_err_count)
+        {
+            break;
+        }
+    }
+
+    detail::set_mismatch_multi_index(result, config.check_config.lengths);
+
+    return result;
+}
+
+} // namespace utils
+} // namespace ck
@@ -4,29 +4,96 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <random>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "ck/utility/data_type.hpp"
+#include "ck/library/utility/host_convert.hpp"
+#include "ck/library/utility/host_philox.hpp"
 
 namespace ck {
 namespace utils {
 
+namespace detail {
+
+template <typename ForwardIter, typename T>
+constexpr bool is_contiguous_iterator_v =
+    std::is_same_v<ForwardIter, T*> ||
+    std::is_same_v<ForwardIter, typename std::vector<T>::iterator>;
+
+// philox_fill with element i set to type_convert<T>(value(random bits of element i)). When
+// convert_n has vector code from float to T and the range is contiguous, every thread draws the
+// float values into a small tile and converts the whole tile at once, which gives the same
+// elements.
+template <typename T, typename ForwardIter, typename Value>
+void philox_fill_converted(ForwardIter first,
+                           ForwardIter last,
+                           std::uint64_t seed,
+                           std::size_t index_offset,
+                           Value value)
+{
+    if constexpr(is_vectorized_convert_v<T, float> && is_contiguous_iterator_v<ForwardIter, T>)
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if(n == 0)
+            return;
+
+        T* p = &*first;
+
+        auto gen = [=](const Philox4x32::Block& r) {
+            return std::array<float, 4>{value(r[0]), value(r[1]), value(r[2]), value(r[3])};
+        };
+
+        parallel_for(n, [&](std::size_t begin, std::size_t end) {
+            constexpr std::size_t Tile = 4096;
+
+            float tile[Tile];
+            for(std::size_t i = begin; i < end; i += Tile)
+            {
+                const std::size_t m = std::min(Tile, end - i);
+                philox_fill(tile, tile + m, seed, index_offset + i, gen, 1);
+                convert_n(p + i, tile, m, 1);
+            }
+        });
+    }
+    else
+    {
+        philox_fill(first, last, seed, index_offset, [=](const Philox4x32::Block& r) {
+            return std::array<T, 4>{ck::type_convert<T>(value(r[0])),
+                                    ck::type_convert<T>(value(r[1])),
+                                    ck::type_convert<T>(value(r[2])),
+                                    ck::type_convert<T>(value(r[3]))};
+        });
+    }
+}
+
+} // namespace detail
+
+// The random fills draw element i of the range from the counter-based Philox4x32 stream of seed_,
+// so the value only depends on (seed_, i). Ranges are filled in parallel with the same result
+// for any thread count, and the three argument form regenerates the elements
+// [index_offset, index_offset + (last - first)) of a larger tensor on its own.
 template <typename T>
 struct FillUniformDistribution
 {
     float a_{-5.f};
     float b_{5.f};
+    std::uint64_t seed_{11939};
 
     template <typename ForwardIter>
-    void operator()(ForwardIter first, ForwardIter last) const
+    void operator()(ForwardIter first, ForwardIter last, std::size_t index_offset = 0) const
     {
-        std::mt19937 gen(11939);
-        std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(first, last, [&dis, &gen]() { return ck::type_convert<T>(dis(gen)); });
+        const float a = a_;
+        const float d = b_ - a_;
+        detail::philox_fill_converted<T>(first, last, seed_, index_offset, [=](std::uint32_t x) {
+            return a + d * philox_to_uniform(x);
+        });
     }
 
     template <typename ForwardRange>
@@ -64,14 +131,16 @@ struct FillUniformDistributionIntegerValue
 {
     float a_{-5.f};
     float b_{5.f};
+    std::uint64_t seed_{11939};
 
     template <typename ForwardIter>
-    void operator()(ForwardIter first, ForwardIter last) const
+    void operator()(ForwardIter first, ForwardIter last, std::size_t index_offset = 0) const
     {
-        std::mt19937 gen(11939);
-        std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(
-            first, last, [&dis, &gen]() { return ck::type_convert<T>(std::round(dis(gen))); });
+        const float a = a_;
+        const float d = b_ - a_;
+        detail::philox_fill_converted<T>(first, last, seed_, index_offset, [=](std::uint32_t x) {
+            return std::round(a + d * philox_to_uniform(x));
+        });
     }
 
     template <typename ForwardRange>
@@ -0,0 +1,477 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/library/utility/host_convert.hpp"
+#include "ck/library/utility/host_parallel.hpp"
+#include "ck/library/utility/host_simd.hpp"
+
+// Host-side calibration for the int8 and fp8 quantization paths. CalibrationStats collects
+// per-channel min/max and a histogram of |x| from float tensors in one multithreaded pass per
+// batch; its scales feed quantize_per_channel_n and the requantization scales and int32 biases
+// expected by the functors of quantization_operation.hpp:
+//
+//   X  = Sx * Qx, W = Sw * Qw, Y = Sy * Qy
+//   requant scale = Sw * Sx / Sy    (Activation_Mul_Clamp, Activation_Mul2_Clamp, ...)
+//   Qb            = round(B / (Sw * Sx))  (Add_Activation_Mul_Clamp, ...)
+
+namespace ck {
+namespace utils {
+
+// A tensor seen as [outer, num_channel, inner] with a contiguous inner dimension, statistics and
+// scales are kept per channel:
+//   per tensor                      : {1, 1, n}
+//   per channel of an NHWC input    : {N * H * W, C, 1}
+//   per output channel of KCYX wei  : {1, K, C * Y * X}
+//   per group of g along rows of k  : {rows, k / g, g}
+struct CalibrationLayout
+{
+    std::size_t outer       = 1;
+    std::size_t num_channel = 1;
+    std::size_t inner       = 1;
+
+    std::size_t GetElementSize() const { return outer * num_channel * inner; }
+};
+
+enum struct CalibrationMethod
+{
+    Max,        // threshold = max |x|
+    Percentile, // threshold = the given percentile of |x|, which clips rare outliers
+};
+
+namespace detail {
+
+// Walk the elements [begin, end) of layout in spans sharing one scale (step 0, channel c) or,
+// for inner == 1, spans of consecutive channels c, c + 1, ... (step 1)
+template <typename F>
+void for_each_channel_span(const CalibrationLayout& layout,
+                           std::size_t begin,
+                           std::size_t end,
+                           F&& f)
+{
+    for(std::size_t i = begin; i < end;)
+    {
+        std::size_t n, c, step;
+
+        if(layout.inner == 1)
+        {
+            c    = i % layout.num_channel;
+            n    = std::min(layout.num_channel - c, end - i);
+            step = 1;
+        }
+        else
+        {
+            c    = i / layout.inner % layout.num_channel;
+            n    = std::min(layout.inner - i % layout.inner, end - i);
+            step = 0;
+        }
+
+        f(i, n, c, step);
+        i += n;
+    }
+}
+
+// float copies of at most this many elements are made at a time
+inline constexpr std::size_t CalibrationTile = 1024;
+
+template <typename X, typename F>
+void for_each_float_tile(const X* p_x, std::size_t n, F&& f)
+{
+    float tile[CalibrationTile];
+
+    for(std::size_t i = 0; i < n; i += CalibrationTile)
+    {
+        const std::size_t m = std::min(CalibrationTile, n - i);
+
+        if constexpr(std::is_same_v<X, float>)
+        {
+            (void)tile;
+            f(i, p_x + i, m);
+        }
+        else
+        {
+            convert_float_like_n(tile, p_x + i, m);
+            f(i, static_cast<const float*>(tile), m);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Per-channel statistics of calibration data
+ *
+ * Keeps the element count, min, max and a histogram of |x| for every channel. The histogram bins
+ * are the exponent and the top 3 mantissa bits of |x|, which covers the whole float range in
+ * 2048 bins of at most 1/8 relative width without knowing the range in advance, so one pass is
+ * enough and statistics of several batches or threads merge exactly. NaNs are ignored.
+ */
+class CalibrationStats
+{
+    public:
+    static constexpr std::size_t HistogramBinCount = 2048;
+    static constexpr int HistogramShift            = 20;
+
+    explicit CalibrationStats(std::size_t num_channel = 1)
+        : mCount(num_channel),
+          mMin(num_channel, std::numeric_limits<float>::infinity()),
+          mMax(num_channel, -std::numeric_limits<float>::infinity()),
+          mHistogram(num_channel * HistogramBinCount)
+    {
+    }
+
+    std::size_t GetChannelCount() const { return mCount.size(); }
+
+    // Add the values of a tensor of float, half_t or bhalf_t. Channels are split over the threads
+    // when there are enough of them, element ranges with private statistics otherwise.
+    template <typename X>
+    void Observe(const X* p_x,
+                 const CalibrationLayout& layout,
+                 std::size_t num_thread = get_host_num_thread())
+    {
+        static_assert(detail::is_float_like_v<X>);
+
+        if(layout.num_channel != GetChannelCount())
+        {
+            throw std::runtime_error("wrong! layout does not match the calibration channels");
+        }
+
+        if(layout.num_channel >= std::max<std::size_t>(num_thread, 2))
+        {
+            const std::size_t per_channel = std::max<std::size_t>(layout.outer * layout.inner, 1);
+            const std::size_t min_channel = (std::size_t{1} << 14) / per_channel;
+
+            parallel_for(
+                layout.num_channel,
+                [&](std::size_t c_begin, std::size_t c_end) {
+                    for(std::size_t o = 0; o < layout.outer; ++o)
+                    {
+                        const std::size_t row = o * layout.num_channel;
+
+                        if(layout.inner == 1)
+                            ObserveSpan(p_x + row + c_begin, c_end - c_begin, c_begin, 1);
+                        else
+                            for(std::size_t c = c_begin; c < c_end; ++c)
+                                ObserveSpan(p_x + (row + c) * layout.inner, layout.inner, c, 0);
+                    }
+                },
+                num_thread,
+                std::max<std::size_t>(min_channel, 1),
+                1);
+        }
+        else
+        {
+            std::mutex mutex;
+
+            parallel_for(
+                layout.GetElementSize(),
+                [&](std::size_t begin, std::size_t end) {
+                    CalibrationStats local(layout.num_channel);
+
+                    detail::for_each_channel_span(
+                        layout,
+                        begin,
+                        end,
+                        [&](std::size_t i, std::size_t n, std::size_t c, std::size_t step) {
+                            local.ObserveSpan(p_x + i, n, c, step);
+                        });
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    Merge(local);
+                },
+                num_thread);
+        }
+    }
+
+    void Merge(const CalibrationStats& other)
+    {
+        if(other.GetChannelCount() != GetChannelCount())
+        {
+            throw std::runtime_error("wrong! merging statistics of different channel counts");
+        }
+
+        for(std::size_t c = 0; c < mCount.size(); ++c)
+        {
+            mCount[c] += other.mCount[c];
+            mMin[c] = std::min(mMin[c], other.mMin[c]);
+            mMax[c] = std::max(mMax[c], other.mMax[c]);
+        }
+
+        for(std::size_t b = 0; b < mHistogram.size(); ++b)
+            mHistogram[b] += other.mHistogram[b];
+    }
+
+    std::uint64_t GetCount(std::size_t c) const { return mCount[c]; }
+
+    // +inf / -inf for a channel without values
+    float GetMin(std::size_t c) const { return mMin[c]; }
+    float GetMax(std::size_t c) const { return mMax[c]; }
+
+    float GetAmax(std::size_t c) const
+    {
+        return mCount[c] == 0 ? 0.f : std::max(std::abs(mMin[c]), std::abs(mMax[c]));
+    }
+
+    // HistogramBinCount counts of |x|, bin b holds the floats with bit patterns
+    // [b << HistogramShift, (b + 1) << HistogramShift)
+    const std::uint64_t* GetHistogram(std::size_t c) const
+    {
+        return mHistogram.data() + c * HistogramBinCount;
+    }
+
+    // percentile in [0, 100] of |x| in channel c, interpolated linearly inside a bin
+    float GetPercentile(std::size_t c, double percentile) const
+    {
+        if(mCount[c] == 0)
+        {
+            return 0.f;
+        }
+
+        const double rank =
+            std::max(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+                               static_cast<double>(mCount[c])),
+                     1.0);
+
+        const std::uint64_t* hist = GetHistogram(c);
+        double below              = 0;
+
+        for(std::size_t b = 0; b < HistogramBinCount; ++b)
+        {
+            const double count = static_cast<double>(hist[b]);
+
+            if(below + count >= rank)
+            {
+                const float lo = GetBinEdge(b);
+                const float hi = GetBinEdge(b + 1);
+
+                if(std::isinf(lo))
+                {
+                    return GetAmax(c);
+                }
+
+                const float v = lo + (hi - lo) * static_cast<float>((rank - below) / count);
+                return std::min(v, GetAmax(c));
+            }
+
+            below += count;
+        }
+
+        return GetAmax(c);
+    }
+
+    // clipping threshold of every channel
+    std::vector<float> GetThresholds(CalibrationMethod method, double percentile = 99.99) const
+    {
+        std::vector<float> threshold(GetChannelCount());
+
+        for(std::size_t c = 0; c < threshold.size(); ++c)
+            threshold[c] =
+                method == CalibrationMethod::Max ? GetAmax(c) : GetPercentile(c, percentile);
+
+        return threshold;
+    }
+
+    // Scales S = threshold / qmax with X = S * Q, so that the threshold maps onto the largest code
+    // of Q (int8_t, f8_t or bf8_t). Channels that only saw zeros get a scale of 1.
+    template <typename Q>
+    std::vector<float> GetScales(CalibrationMethod method, double percentile = 99.99) const;
+
+    private:
+    static float GetBinEdge(std::size_t b)
+    {
+        return b >= HistogramBinCount ? std::numeric_limits<float>::infinity()
+                                      : __builtin_bit_cast(float,
+                                                           static_cast<std::uint32_t>(
+                                                               b << HistogramShift));
+    }
+
+    // n values from channel c on (step 0) or from channels c, c + 1, ... (step 1)
+    template <typename X>
+    void ObserveSpan(const X* p_x, std::size_t n, std::size_t c, std::size_t step)
+    {
+        detail::for_each_float_tile(p_x, n, [&](std::size_t offset, const float* p, std::size_t m) {
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                const float x = p[i];
+
+                if(std::isnan(x))
+                {
+                    continue;
+                }
+
+                const std::size_t ch = c + step * (offset + i);
+                const std::uint32_t bits =
+                    __builtin_bit_cast(std::uint32_t, x) & std::uint32_t{0x7fffffff};
+
+                ++mCount[ch];
+                mMin[ch] = std::min(mMin[ch], x);
+                mMax[ch] = std::max(mMax[ch], x);
+                ++mHistogram[ch * HistogramBinCount + (bits >> HistogramShift)];
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> mCount;
+    std::vector<float> mMin;
+    std::vector<float> mMax;
+    std::vector<std::uint64_t> mHistogram;
+};
+
+// largest code of a quantized type, as float
+template <typename Q>
+float get_quant_max()
+{
+    static_assert(std::is_same_v<Q, std::int8_t> || detail::is_f8_v<Q>);
+
+    if constexpr(std::is_same_v<Q, std::int8_t>)
+        return 127.f;
+    else
+        return type_convert<float>(NumericLimits<Q>::Max());
+}
+
+template <typename Q>
+std::vector<float> CalibrationStats::GetScales(CalibrationMethod method, double percentile) const
+{
+    std::vector<float> scale = GetThresholds(method, percentile);
+
+    for(auto& s : scale)
+        s = s > 0.f && std::isfinite(s) ? s / get_quant_max<Q>() : 1.f;
+
+    return scale;
+}
+
+namespace detail {
+
+// p_y = p_x / scale, the scale of lane i being p_scale[i * step]
+inline void
+divide_by_scale(float* p_y, const float* p_x, std::size_t n, const float* p_scale, std::size_t step)
+{
+    std::size_t i = 0;
+    for(; i + simd::FloatLanes <= n; i += simd::FloatLanes)
+    {
+        const simd::vfloat s = step == 0 ? simd::broadcast(*p_scale) : simd::load(p_scale + i);
+        simd::store(p_y + i, simd::load(p_x + i) / s);
+    }
+
+    for(; i < n; ++i)
+        p_y[i] = p_x[i] / p_scale[i * step];
+}
+
+typedef std::int8_t vint8_rne __attribute__((vector_size(simd::FloatLanes)));
+
+// p_q = clamp(round(p_y), -128, 127), round to nearest even; NaN gives -128
+inline void store_int8_rne(std::int8_t* p_q, const float* p_y, std::size_t n)
+{
+    const auto quantize = [](simd::vfloat v) {
+        v = simd::min(simd::max(v, simd::broadcast(-128.f)), simd::broadcast(127.f));
+        return __builtin_convertvector(__builtin_convertvector(simd::round(v), simd::vint),
+                                       vint8_rne);
+    };
+
+    std::size_t i = 0;
+    for(; i + simd::FloatLanes <= n; i += simd::FloatLanes)
+    {
+        const vint8_rne q = quantize(simd::load(p_y + i));
+        std::memcpy(p_q + i, &q, sizeof(q));
+    }
+
+    if(i < n)
+    {
+        const vint8_rne q = quantize(simd::load_partial(p_y + i, n - i));
+        std::memcpy(p_q + i, &q, n - i);
+    }
+}
+
+} // namespace detail
+
+// Quantize a tensor of float, half_t or bhalf_t with one scale per channel of layout, Q = X / S.
+// int8_t rounds to nearest even and saturates to [-128, 127], f8_t and bf8_t round to nearest
+// even with clipping, like f8_convert_rne.
+template <typename Q, typename X>
+void quantize_per_channel_n(Q* p_q,
+                            const X* p_x,
+                            const float* p_scale,
+                            const CalibrationLayout& layout,
+                            std::size_t num_thread = get_host_num_thread())
+{
+    static_assert(detail::is_float_like_v<X>);
+    static_assert(std::is_same_v<Q, std::int8_t> || detail::is_f8_v<Q>);
+
+    parallel_for(
+        layout.GetElementSize(),
+        [&](std::size_t begin, std::size_t end) {
+            float y[detail::CalibrationTile];
+
+            detail::for_each_channel_span(
+                layout,
+                begin,
+                end,
+                [&](std::size_t i, std::size_t n, std::size_t c, std::size_t step) {
+                    detail::for_each_float_tile(
+                        p_x + i, n, [&](std::size_t offset, const float* p, std::size_t m) {
+                            detail::divide_by_scale(y, p, m, p_scale + c + step * offset, step);
+
+                            if constexpr(std::is_same_v<Q, std::int8_t>)
+                                detail::store_int8_rne(p_q + i + offset, y, m);
+                            else
+                                f8_convert_rne_n(p_q + i + offset, y, m, 1);
+                        });
+                });
+        },
+        num_thread);
+}
+
+// requantization scales Sw * Sx / Sy, one per output channel for per-channel weight scales
+inline std::vector<float>
+get_requant_scales(const std::vector<float>& weight_scale, float input_scale, float output_scale)
+{
+    std::vector<float> requant_scale(weight_scale.size());
+
+    for(std::size_t k = 0; k < weight_scale.size(); ++k)
+        requant_scale[k] = weight_scale[k] * input_scale / output_scale;
+
+    return requant_scale;
+}
+
+// int32 bias Qb = round(B / (Sw * Sx)) of n output channels, with a per-channel weight scale or,
+// if weight_scale holds one value, a per-tensor one
+template <typename X>
+void quantize_bias_n(std::int32_t* p_qb,
+                     const X* p_b,
+                     std::size_t n,
+                     const std::vector<float>& weight_scale,
+                     float input_scale)
+{
+    if(weight_scale.size() != 1 && weight_scale.size() != n)
+    {
+        throw std::runtime_error("wrong! weight scales do not match the bias length");
+    }
+
+    for(std::size_t k = 0; k < n; ++k)
+    {
+        const float s = weight_scale[weight_scale.size() == 1 ? 0 : k] * input_scale;
+        const double q = std::nearbyint(static_cast<double>(type_convert<float>(p_b[k])) / s);
+
+        p_qb[k] = static_cast<std::int32_t>(
+            std::clamp(q,
+                       static_cast<double>(std::numeric_limits<std::int32_t>::min()),
+                       static_cast<double>(std::numeric_limits<std::int32_t>::max())));
+    }
+}
+
+} // namespace utils
+} // namespace ck
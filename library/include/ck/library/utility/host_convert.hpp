@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/library/utility/host_parallel.hpp"
+#include "ck/library/utility/host_philox.hpp"
+#include "ck/library/utility/host_simd.hpp"
+
+// Host-side bulk conversions. convert_n is the general entry point, with the same results as
+// type_convert. The conversions between float/half and the 8-bit floating point types f8_t and
+// bf8_t (negative zero nan mode, the layout used by the host paths of type_convert) are also
+// available directly:
+//
+//   cast_from_f8_n   : 256-entry lookup table built from the scalar conversion
+//   f8_convert_rne_n : round to nearest even with clipping, bit identical to f8_convert_rne
+//   f8_convert_sr_n  : stochastic rounding with counter-based random bits, element i of the
+//                      stream of a seed always gets the same bits whatever the thread count
+//
+// The vector code is written with the generic vector types of host_simd.hpp, which the compiler
+// lowers to AVX-512 or AVX2 (and F16C for half_t) depending on the flags of the host pass.
+
+namespace ck {
+namespace utils {
+
+namespace simd {
+
+// Lane-wise float to f8/bf8 encoding, returning the code in the low byte of each lane. This is
+// cast_to_f8<float, F8, true, true, Stoch> of f8_utils.hpp, step for step, with the shift
+// counts clamped to the lane width: inputs for which the scalar code would shift by 32 bits or
+// more all underflow to zero.
+template <typename F8, bool Stoch>
+inline vint cast_to_f8(vfloat x, vint rng)
+{
+    constexpr int out_exp  = NumericUtils<F8>::exp;
+    constexpr int out_mant = NumericUtils<F8>::mant;
+    constexpr int drop     = NumericUtils<float>::mant - out_mant;
+
+    constexpr int out_bias        = 1 << (out_exp - 1);
+    constexpr int denormal_act    = 1 - out_bias;
+    constexpr int max_exp         = (1 << out_exp) - 1;
+    constexpr std::int32_t nan_in = 0x7f800000;
+
+    const vint zero = {};
+    const vint one  = zero + 1;
+
+    const vint bits     = as_int(x);
+    const vint sign     = (bits >> 31) & 1;
+    const vint exponent = (bits >> 23) & 0xff;
+    const vint normal   = exponent != 0;
+
+    // actual exponent of the input and the right shift that brings it to the f8 denormal one
+    const vint act  = (normal & (exponent - 127)) | (~normal & (zero - 126));
+    const vint diff = (act <= denormal_act) & (denormal_act - act);
+
+    vint mantissa = (bits & 0x7fffff) | (normal & (1 << 23));
+
+    // the tie is detected before the shift, which would drop the sticky bits
+    const vint mid_shift = select(diff + drop < 31, diff + drop, zero + 31);
+    const vint midpoint  = (mantissa & ((one << mid_shift) - 1)) == (one << (mid_shift - 1));
+
+    mantissa = mantissa >> select(diff < 31, diff, zero + 31);
+
+    const vint implicit_one = (mantissa >> 23) & 1;
+    vint out_exponent       = act + diff + out_bias - 1 + implicit_one;
+
+    if constexpr(Stoch)
+    {
+        mantissa = mantissa + (rng & ((1 << drop) - 1));
+    }
+    else
+    {
+        const vint odd = ((mantissa >> drop) & 1) != 0;
+        mantissa       = mantissa + ((mantissa + (midpoint & ~odd)) & ((1 << drop) - 1));
+    }
+
+    // carry out of the mantissa: denormal to normal, or exponent increment
+    const vint denormal = out_exponent == 0;
+    const vint promote  = denormal & ((mantissa & (1 << 23)) != 0);
+    const vint carry    = ~denormal & ((mantissa & (1 << 24)) != 0);
+
+    out_exponent = out_exponent - promote - carry;
+    mantissa     = select(carry, mantissa >> 1, mantissa) >> drop;
+
+    // clip
+    const vint overflow = out_exponent > max_exp;
+    mantissa            = select(overflow, zero + ((1 << out_mant) - 1), mantissa);
+    out_exponent        = select(overflow, zero + max_exp, out_exponent);
+
+    const vint underflow = (out_exponent == 0) & (mantissa == 0);
+    const vint y         = (sign << (out_exp + out_mant)) | (out_exponent << out_mant) |
+                   (mantissa & ((1 << out_mant) - 1));
+
+    // infinities and NaN map to the NaN code
+    return select((bits & nan_in) == nan_in, zero + 0x80, ~underflow & y);
+}
+
+} // namespace simd
+
+namespace detail {
+
+template <typename F8>
+inline F8 f8_from_bits(std::uint8_t bits)
+{
+    return __builtin_bit_cast(F8, bits);
+}
+
+template <typename F8, typename Y>
+std::array<Y, 256> make_f8_decode_table()
+{
+    std::array<Y, 256> table;
+    for(std::size_t i = 0; i < table.size(); ++i)
+        table[i] = type_convert<Y>(f8_from_bits<F8>(static_cast<std::uint8_t>(i)));
+    return table;
+}
+
+// low byte of each lane to p_y[0, FloatLanes) or to the first n < FloatLanes elements
+template <typename F8>
+inline void store_f8_codes(F8* p_y, simd::vint codes)
+{
+    typedef std::uint8_t vbyte __attribute__((vector_size(simd::FloatLanes)));
+
+    const vbyte bytes = __builtin_convertvector(codes, vbyte);
+    std::memcpy(p_y, &bytes, sizeof(bytes));
+}
+
+template <typename F8>
+inline void store_f8_codes_partial(F8* p_y, simd::vint codes, std::size_t n)
+{
+    F8 y[simd::FloatLanes];
+    store_f8_codes(y, codes);
+    std::copy_n(y, n, p_y);
+}
+
+template <typename X>
+constexpr bool is_f8_source_v = std::is_same_v<X, float> || std::is_same_v<X, half_t>;
+
+template <typename F8>
+constexpr bool is_f8_v = std::is_same_v<F8, f8_t> || std::is_same_v<F8, bf8_t>;
+
+} // namespace detail
+
+// table of the 256 codes of F8 converted to Y (float or half_t)
+template <typename F8, typename Y>
+const std::array<Y, 256>& f8_decode_table()
+{
+    static_assert(detail::is_f8_v<F8> && detail::is_f8_source_v<Y>);
+
+    static const std::array<Y, 256> table = detail::make_f8_decode_table<F8, Y>();
+    return table;
+}
+
+// p_y[i] = type_convert<Y>(p_x[i]) for i in [0, n), split over num_thread host threads
+template <typename Y, typename F8>
+void cast_from_f8_n(Y* p_y,
+                    const F8* p_x,
+                    std::size_t n,
+                    std::size_t num_thread = get_host_num_thread())
+{
+    const auto& table = f8_decode_table<F8, Y>();
+
+    parallel_for(
+        n,
+        [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                p_y[i] = table[__builtin_bit_cast(std::uint8_t, p_x[i])];
+        },
+        num_thread);
+}
+
+// p_y[i] = f8_convert_rne<F8>(p_x[i]) for i in [0, n), X being float or half_t, split over
+// num_thread host threads
+template <typename F8, typename X>
+void f8_convert_rne_n(F8* p_y,
+                      const X* p_x,
+                      std::size_t n,
+                      std::size_t num_thread = get_host_num_thread())
+{
+    static_assert(detail::is_f8_v<F8> && detail::is_f8_source_v<X>);
+
+    constexpr simd::vint no_rng = {};
+
+    parallel_for(
+        n,
+        [&](std::size_t begin, std::size_t end) {
+            std::size_t i = begin;
+            for(; i + simd::FloatLanes <= end; i += simd::FloatLanes)
+                detail::store_f8_codes(p_y + i,
+                                       simd::cast_to_f8<F8, false>(simd::load(p_x + i), no_rng));
+
+            if(i < end)
+                detail::store_f8_codes_partial(
+                    p_y + i,
+                    simd::cast_to_f8<F8, false>(simd::load_partial(p_x + i, end - i), no_rng),
+                    end - i);
+        },
+        num_thread);
+}
+
+// Stochastic rounding of p_x[i] for i in [0, n), element i being rounded with the random bits of
+// element index_offset + i of the Philox stream of seed (lane j % 4 of block j / 4, as in
+// philox_fill). The result is cast_to_f8<float, F8, true, true, true>(float(p_x[i]), bits), so
+// half_t inputs are widened first. The result does not depend on num_thread.
+template <typename F8, typename X>
+void f8_convert_sr_n(F8* p_y,
+                     const X* p_x,
+                     std::size_t n,
+                     std::uint64_t seed,
+                     std::size_t index_offset = 0,
+                     std::size_t num_thread   = get_host_num_thread())
+{
+    static_assert(detail::is_f8_v<F8> && detail::is_f8_source_v<X>);
+
+    // Philox blocks produced per call, each one holding the bits of 4 elements
+    constexpr std::size_t Blocks = 8;
+    constexpr std::size_t Group  = 4 * Blocks;
+    static_assert(Group % simd::FloatLanes == 0);
+
+    // groups of Group elements aligned in the stream, the first and the last one clipped to
+    // [begin, end)
+    auto convert = [&](std::size_t begin, std::size_t end) {
+        Philox4x32::Block blocks[Blocks];
+        simd::vint rng;
+
+        for(std::size_t group = begin / Group * Group; group < end; group += Group)
+        {
+            Philox4x32::Generate(seed, group / 4, blocks);
+
+            for(std::size_t v = group; v < group + Group; v += simd::FloatLanes)
+            {
+                std::memcpy(&rng, &blocks[(v - group) / 4], sizeof(rng));
+
+                if(v >= begin && v + simd::FloatLanes <= end)
+                {
+                    const std::size_t i = v - index_offset;
+                    detail::store_f8_codes(p_y + i,
+                                           simd::cast_to_f8<F8, true>(simd::load(p_x + i), rng));
+                    continue;
+                }
+
+                const std::size_t first = std::max(v, begin);
+                const std::size_t last  = std::min(v + simd::FloatLanes, end);
+                if(first >= last)
+                    continue;
+
+                X x[simd::FloatLanes] = {};
+                F8 y[simd::FloatLanes];
+
+                std::copy_n(p_x + (first - index_offset), last - first, x + (first - v));
+                detail::store_f8_codes(y, simd::cast_to_f8<F8, true>(simd::load(x), rng));
+                std::copy_n(y + (first - v), last - first, p_y + (first - index_offset));
+            }
+        }
+    };
+
+    parallel_for(
+        n,
+        [&](std::size_t begin, std::size_t end) {
+            convert(index_offset + begin, index_offset + end);
+        },
+        num_thread);
+}
+
+namespace detail {
+
+template <typename T>
+constexpr bool is_float_like_v =
+    std::is_same_v<T, float> || std::is_same_v<T, half_t> || std::is_same_v<T, bhalf_t>;
+
+// With stochastic rounding as the default, type_convert draws its random bits from the address of
+// its argument, which the bulk encoder cannot reproduce
+#if CK_USE_SR_F8_CONVERSION
+inline constexpr bool is_f8_convert_rne = false;
+#else
+inline constexpr bool is_f8_convert_rne = true;
+#endif
+
+typedef std::uint16_t vbhalf __attribute__((vector_size(simd::FloatLanes * sizeof(bhalf_t))));
+
+// widening loads and narrowing stores between float, half_t and bhalf_t with the rounding of
+// type_convert: half_t rounds to nearest even, bhalf_t truncates
+inline simd::vfloat load_as_float(const float* p_x) { return simd::load(p_x); }
+
+inline simd::vfloat load_as_float(const half_t* p_x) { return simd::load(p_x); }
+
+inline simd::vfloat load_as_float(const bhalf_t* p_x)
+{
+    vbhalf b = {};
+    std::memcpy(&b, p_x, sizeof(b));
+    return simd::as_float(__builtin_convertvector(b, simd::vint) << 16);
+}
+
+inline void store_from_float(float* p_y, simd::vfloat y) { simd::store(p_y, y); }
+
+inline void store_from_float(half_t* p_y, simd::vfloat y)
+{
+    const simd::vhalf h = __builtin_convertvector(y, simd::vhalf);
+    std::memcpy(p_y, &h, sizeof(h));
+}
+
+inline void store_from_float(bhalf_t* p_y, simd::vfloat y)
+{
+    const vbhalf b = __builtin_convertvector(simd::as_int(y) >> 16, vbhalf);
+    std::memcpy(p_y, &b, sizeof(b));
+}
+
+template <typename Y, typename X>
+void convert_float_like_n(Y* p_y, const X* p_x, std::size_t n)
+{
+    std::size_t i = 0;
+    for(; i + simd::FloatLanes <= n; i += simd::FloatLanes)
+        store_from_float(p_y + i, load_as_float(p_x + i));
+
+    if(i < n)
+    {
+        X x[simd::FloatLanes] = {};
+        Y y[simd::FloatLanes];
+
+        std::copy_n(p_x + i, n - i, x);
+        store_from_float(y, load_as_float(x));
+        std::copy_n(y, n - i, p_y + i);
+    }
+}
+
+// pairs for which convert_n runs vector code
+template <typename Y, typename X>
+constexpr bool is_vectorized_convert_v =
+    (is_f8_v<X> && is_f8_source_v<Y>) || (is_f8_v<Y> && is_f8_source_v<X> && is_f8_convert_rne) ||
+    (!std::is_same_v<Y, X> && is_float_like_v<Y> && is_float_like_v<X>);
+
+} // namespace detail
+
+// p_y[i] = type_convert<Y>(p_x[i]) for i in [0, n), split over num_thread host threads.
+// Conversions among float, half_t and bhalf_t, from f8_t/bf8_t and, without
+// CK_USE_SR_F8_CONVERSION, to f8_t/bf8_t are vectorized; the other pairs convert element by
+// element. The result is bit identical to type_convert in every case.
+template <typename Y, typename X>
+void convert_n(Y* p_y,
+               const X* p_x,
+               std::size_t n,
+               std::size_t num_thread = get_host_num_thread())
+{
+    if constexpr(detail::is_f8_v<X> && detail::is_f8_source_v<Y>)
+    {
+        cast_from_f8_n(p_y, p_x, n, num_thread);
+    }
+    else if constexpr(detail::is_f8_v<Y> && detail::is_f8_source_v<X> &&
+                      detail::is_f8_convert_rne)
+    {
+        f8_convert_rne_n(p_y, p_x, n, num_thread);
+    }
+    else
+    {
+        parallel_for(
+            n,
+            [&](std::size_t begin, std::size_t end) {
+                if constexpr(std::is_same_v<Y, X>)
+                    std::copy(p_x + begin, p_x + end, p_y + begin);
+                else if constexpr(detail::is_float_like_v<Y> && detail::is_float_like_v<X>)
+                    detail::convert_float_like_n(p_y + begin, p_x + begin, end - begin);
+                else
+                    for(std::size_t i = begin; i < end; ++i)
+                        p_y[i] = type_convert<Y>(p_x[i]);
+            },
+            num_thread);
+    }
+}
+
+} // namespace utils
+} // namespace ck
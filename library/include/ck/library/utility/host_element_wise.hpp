@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/tensor_operation/gpu/element/unary_element_wise_operation.hpp"
+#include "ck/tensor_operation/gpu/element/binary_element_wise_operation.hpp"
+
+#include "ck/library/utility/host_parallel.hpp"
+#include "ck/library/utility/host_simd.hpp"
+
+namespace ck {
+namespace utils {
+
+// Vectorized host form of an element-wise functor. A specialization provides
+//   static simd::vfloat Apply(const ElementOp&, simd::vfloat...)
+// computing the fp32 -> fp32 form of ElementOp::operator() on FloatLanes elements at a time.
+// Functors without a specialization, or invoked on other data types, are applied element by
+// element through their own operator().
+template <typename ElementOp>
+struct HostVectorizedOp
+{
+    static constexpr bool IsSupported = false;
+};
+
+namespace detail {
+
+template <typename Op, typename Y, typename... Xs>
+inline constexpr bool is_host_vectorized_v =
+    HostVectorizedOp<Op>::IsSupported && std::is_same_v<Y, float> &&
+    (std::is_same_v<Xs, float> && ...);
+
+struct HostVectorizedOpBase
+{
+    static constexpr bool IsSupported = true;
+};
+
+// x * sigmoid(b * x)
+inline simd::vfloat swish(simd::vfloat x, float b)
+{
+    return x / (1.f + simd::exp(-b * x));
+}
+
+inline simd::vfloat fast_gelu(simd::vfloat x)
+{
+    const float c1 = -2.0 * 0.035677f;
+    const float c2 = -2.0 * 0.797885f;
+
+    const simd::vfloat u = x * (c1 * x * x + c2);
+    return x / (1.f + simd::exp(u));
+}
+
+inline simd::vfloat relu(simd::vfloat x) { return simd::max(x, simd::vfloat{}); }
+
+inline simd::vfloat clamp(simd::vfloat x, float lo, float hi)
+{
+    return simd::min(simd::broadcast(hi), simd::max(simd::broadcast(lo), x));
+}
+
+} // namespace detail
+
+#define CK_HOST_VECTORIZED_UNARY_OP(OP, EXPR)                                                \
+    template <>                                                                              \
+    struct HostVectorizedOp<tensor_operation::element_wise::OP> : detail::HostVectorizedOpBase \
+    {                                                                                        \
+        using ElementOp = tensor_operation::element_wise::OP;                                \
+                                                                                             \
+        static simd::vfloat Apply([[maybe_unused]] const ElementOp& op, simd::vfloat x)      \
+        {                                                                                    \
+            return EXPR;                                                                     \
+        }                                                                                    \
+    }
+
+#define CK_HOST_VECTORIZED_BINARY_OP(OP, EXPR)                                               \
+    template <>                                                                              \
+    struct HostVectorizedOp<tensor_operation::element_wise::OP> : detail::HostVectorizedOpBase \
+    {                                                                                        \
+        using ElementOp = tensor_operation::element_wise::OP;                                \
+                                                                                             \
+        static simd::vfloat                                                                  \
+        Apply([[maybe_unused]] const ElementOp& op, simd::vfloat x0, simd::vfloat x1)        \
+        {                                                                                    \
+            return EXPR;                                                                     \
+        }                                                                                    \
+    }
+
+// clang-format off
+CK_HOST_VECTORIZED_UNARY_OP(PassThrough, x);
+CK_HOST_VECTORIZED_UNARY_OP(Scale,       op.scale_ * x);
+CK_HOST_VECTORIZED_UNARY_OP(UnarySquare, x * x);
+CK_HOST_VECTORIZED_UNARY_OP(UnaryAbs,    simd::abs(x));
+CK_HOST_VECTORIZED_UNARY_OP(Neg,         -x);
+CK_HOST_VECTORIZED_UNARY_OP(Relu,        detail::relu(x));
+CK_HOST_VECTORIZED_UNARY_OP(LeakyRelu,   simd::select(x >= 0.f, x, x * op.alpha_));
+CK_HOST_VECTORIZED_UNARY_OP(ClippedRelu, detail::clamp(x, op.alpha_, op.beta_));
+CK_HOST_VECTORIZED_UNARY_OP(Elu,         simd::select(x > 0.f, x, op.alpha_ * simd::expm1(x)));
+CK_HOST_VECTORIZED_UNARY_OP(FastGelu,    detail::fast_gelu(x));
+CK_HOST_VECTORIZED_UNARY_OP(Gelu,        0.5f * x * simd::erfc(-0.70710678118f * x));
+CK_HOST_VECTORIZED_UNARY_OP(Sigmoid,     1.f / (1.f + simd::exp(-x)));
+CK_HOST_VECTORIZED_UNARY_OP(Silu,        detail::swish(x, 1.f));
+CK_HOST_VECTORIZED_UNARY_OP(Swish,       detail::swish(x, op.beta_));
+CK_HOST_VECTORIZED_UNARY_OP(SoftRelu,    simd::log(1.f + simd::exp(x * op.alpha_)) / op.alpha_);
+CK_HOST_VECTORIZED_UNARY_OP(TanH,        simd::tanh(x));
+CK_HOST_VECTORIZED_UNARY_OP(Exp,         simd::exp(x));
+CK_HOST_VECTORIZED_UNARY_OP(Log,         simd::log(x));
+
+CK_HOST_VECTORIZED_BINARY_OP(Add,              x0 + x1);
+CK_HOST_VECTORIZED_BINARY_OP(Subtract,         x0 - x1);
+CK_HOST_VECTORIZED_BINARY_OP(Multiply,         x0 * x1);
+CK_HOST_VECTORIZED_BINARY_OP(Max,              simd::max(x0, x1));
+CK_HOST_VECTORIZED_BINARY_OP(Min,              simd::min(x0, x1));
+CK_HOST_VECTORIZED_BINARY_OP(ScaleAdd,         op.scale_ * x0 + x1);
+CK_HOST_VECTORIZED_BINARY_OP(Bilinear,         op.alpha_ * x0 + op.beta_ * x1);
+CK_HOST_VECTORIZED_BINARY_OP(AddRelu,          detail::relu(x0 + x1));
+CK_HOST_VECTORIZED_BINARY_OP(AddFastGelu,      detail::fast_gelu(x0 + x1));
+CK_HOST_VECTORIZED_BINARY_OP(MultiplyFastGelu, detail::fast_gelu(x0 * x1));
+CK_HOST_VECTORIZED_BINARY_OP(AddSilu,          detail::swish(x0 + x1, 1.f));
+// clang-format on
+
+#undef CK_HOST_VECTORIZED_UNARY_OP
+#undef CK_HOST_VECTORIZED_BINARY_OP
+
+// p_y[i] = element_op(p_x[i]) for i in [0, n), split over num_thread host threads
+template <typename ElementOp, typename Y, typename X>
+void elementwise_n(const ElementOp& element_op,
+                   Y* p_y,
+                   const X* p_x,
+                   std::size_t n,
+                   std::size_t num_thread = get_host_num_thread())
+{
+    parallel_for(
+        n,
+        [&](std::size_t begin, std::size_t end) {
+            if constexpr(detail::is_host_vectorized_v<ElementOp, Y, X>)
+            {
+                simd::transform_n(p_x + begin, end - begin, p_y + begin, [&](simd::vfloat x) {
+                    return HostVectorizedOp<ElementOp>::Apply(element_op, x);
+                });
+            }
+            else
+            {
+                for(std::size_t i = begin; i < end; ++i)
+                    element_op(p_y[i], p_x[i]);
+            }
+        },
+        num_thread);
+}
+
+// p_y[i] = element_op(p_x0[i], p_x1[i]) for i in [0, n), split over num_thread host threads
+template <typename ElementOp, typename Y, typename X0, typename X1>
+void elementwise_n(const ElementOp& element_op,
+                   Y* p_y,
+                   const X0* p_x0,
+                   const X1* p_x1,
+                   std::size_t n,
+                   std::size_t num_thread = get_host_num_thread())
+{
+    parallel_for(
+        n,
+        [&](std::size_t begin, std::size_t end) {
+            if constexpr(detail::is_host_vectorized_v<ElementOp, Y, X0, X1>)
+            {
+                simd::transform_n(p_x0 + begin,
+                                  p_x1 + begin,
+                                  end - begin,
+                                  p_y + begin,
+                                  [&](simd::vfloat x0, simd::vfloat x1) {
+                                      return HostVectorizedOp<ElementOp>::Apply(
+                                          element_op, x0, x1);
+                                  });
+            }
+            else
+            {
+                for(std::size_t i = begin; i < end; ++i)
+                    element_op(p_y[i], p_x0[i], p_x1[i]);
+            }
+        },
+        num_thread);
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ck {
+namespace utils {
+
+/**
+ * @brief Read-only view of a whole file mapped into the host address space
+ *
+ * Pages are loaded on first touch, so host references can work on tables that are much larger
+ * than the memory they actually visit. On platforms without mmap the file is read into a heap
+ * buffer instead.
+ */
+class MappedFile
+{
+    public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    const void* GetBuffer() const { return mpBuf; }
+    std::size_t GetBufferSize() const { return mSize; }
+
+    // typed pointer to the data starting at byte_offset, which has to be aligned for T
+    template <typename T>
+    const T* GetData(std::size_t byte_offset = 0) const
+    {
+        if(byte_offset > mSize || byte_offset % alignof(T) != 0)
+        {
+            throw std::runtime_error("wrong! bad offset into mapped file");
+        }
+
+        return reinterpret_cast<const T*>(static_cast<const char*>(mpBuf) + byte_offset);
+    }
+
+    // number of T elements stored after byte_offset
+    template <typename T>
+    std::size_t GetElementCount(std::size_t byte_offset = 0) const
+    {
+        return byte_offset < mSize ? (mSize - byte_offset) / sizeof(T) : 0;
+    }
+
+    // hint that the pages are visited in random order, e.g. by gathers from embedding tables
+    void AdviseRandomAccess() const;
+
+    // hint that the pages are read once from front to back
+    void AdviseSequentialAccess() const;
+
+    // drop the whole pages of [byte_offset, byte_offset + size) from the resident set once they
+    // have been consumed, they are read from the file again if touched later
+    void ReleasePages(std::size_t byte_offset, std::size_t size) const;
+
+    private:
+    void Release() noexcept;
+
+    const void* mpBuf = nullptr;
+    std::size_t mSize = 0;
+    bool mMapped      = false;
+    std::vector<char> mFallback;
+};
+
+} // namespace utils
+} // namespace ck
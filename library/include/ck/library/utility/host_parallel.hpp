@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ck {
+namespace utils {
+
+inline std::size_t get_host_num_thread()
+{
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+// Split [0, n) into at most num_thread contiguous chunks of at least min_grain items and run
+// f(begin, end) on each of them. Chunk boundaries are rounded to multiples of align items (64
+// elements by default) so that neighbouring threads do not write to the same cache line; callers
+// whose items are whole blocks pass align = 1. The split only depends on the arguments, which
+// keeps chunked results reproducible.
+template <typename F>
+void parallel_for(std::size_t n,
+                  F&& f,
+                  std::size_t num_thread = get_host_num_thread(),
+                  std::size_t min_grain  = 1 << 14,
+                  std::size_t align      = 64)
+{
+    if(n == 0)
+        return;
+
+    const std::size_t max_chunks = std::max<std::size_t>((n + min_grain - 1) / min_grain, 1);
+    const std::size_t num_chunk  = std::clamp<std::size_t>(num_thread, 1, max_chunks);
+
+    std::size_t chunk = (n + num_chunk - 1) / num_chunk;
+    chunk             = (chunk + align - 1) / align * align;
+
+    if(num_chunk == 1 || chunk >= n)
+    {
+        f(std::size_t{0}, n);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_chunk);
+
+    for(std::size_t begin = chunk; begin < n; begin += chunk)
+    {
+        const std::size_t end = std::min(begin + chunk, n);
+        threads.emplace_back([&f, begin, end] { f(begin, end); });
+    }
+
+    // the calling thread takes the first chunk
+    f(std::size_t{0}, chunk);
+
+    for(auto& t : threads)
+        t.join();
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,400 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/utility/type_convert.hpp"
+#include "ck/tensor_operation/gpu/element/unary_element_wise_operation.hpp"
+
+#include "ck/library/utility/host_parallel.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace utils {
+namespace detail {
+
+struct PermuteDim
+{
+    std::size_t length;
+    std::size_t dst_stride;
+    std::size_t src_stride;
+};
+
+// Drop unit dimensions, order the others by decreasing dst stride and fuse neighbours which are
+// contiguous in both tensors, e.g. NCHW -> NHWC becomes a batch of [C, HW] -> [HW, C] transposes.
+inline std::vector<PermuteDim> simplify_permute_dims(std::vector<PermuteDim> dims)
+{
+    dims.erase(std::remove_if(
+                   dims.begin(), dims.end(), [](const PermuteDim& d) { return d.length == 1; }),
+               dims.end());
+
+    std::sort(dims.begin(), dims.end(), [](const PermuteDim& x, const PermuteDim& y) {
+        return std::tie(x.dst_stride, x.src_stride, x.length) >
+               std::tie(y.dst_stride, y.src_stride, y.length);
+    });
+
+    std::vector<PermuteDim> merged;
+    for(const auto& d : dims)
+    {
+        if(!merged.empty())
+        {
+            auto& outer = merged.back();
+            if(outer.dst_stride == d.dst_stride * d.length &&
+               outer.src_stride == d.src_stride * d.length)
+            {
+                outer = {outer.length * d.length, d.dst_stride, d.src_stride};
+                continue;
+            }
+        }
+        merged.push_back(d);
+    }
+
+    return merged;
+}
+
+// element conversion used when permute() is not given an element-wise operation
+struct PermuteConvert
+{
+    template <typename Y, typename X>
+    void operator()(Y& y, const X& x) const
+    {
+        y = ck::type_convert<Y>(x);
+    }
+};
+
+template <std::size_t Size>
+struct permute_bits
+{
+    using type = void;
+};
+
+template <>
+struct permute_bits<1>
+{
+    using type = std::uint8_t;
+};
+
+template <>
+struct permute_bits<2>
+{
+    using type = std::uint16_t;
+};
+
+template <>
+struct permute_bits<4>
+{
+    using type = std::uint32_t;
+};
+
+template <>
+struct permute_bits<8>
+{
+    using type = std::uint64_t;
+};
+
+// In-register transpose of a K x K block of U, K rows of K lanes:
+//   p_dst[b * dst_ld + a] = p_src[a * src_ld + b]
+// Stage H swaps the off-diagonal H x H sub-blocks of every 2H x 2H block, after the stages
+// H = K / 2, ..., 1 the block is transposed. Each stage is one two-input shuffle per row pair.
+template <typename U, std::size_t K>
+struct TransposeKernel
+{
+    typedef U vec __attribute__((vector_size(K * sizeof(U))));
+
+    static constexpr int LoLane(std::size_t j, std::size_t h)
+    {
+        return static_cast<int>((j & h) ? K + j - h : j);
+    }
+
+    static constexpr int HiLane(std::size_t j, std::size_t h)
+    {
+        return static_cast<int>((j & h) ? K + j : j + h);
+    }
+
+    template <std::size_t H, std::size_t... Js>
+    static void Stage(vec* r, std::index_sequence<Js...>)
+    {
+        for(std::size_t i = 0; i < K; ++i)
+        {
+            if(i & H)
+                continue;
+
+            const vec lo = __builtin_shufflevector(r[i], r[i + H], LoLane(Js, H)...);
+            const vec hi = __builtin_shufflevector(r[i], r[i + H], HiLane(Js, H)...);
+            r[i]         = lo;
+            r[i + H]     = hi;
+        }
+    }
+
+    template <std::size_t H>
+    static void Stages(vec* r)
+    {
+        Stage<H>(r, std::make_index_sequence<K>{});
+        if constexpr(H > 1)
+            Stages<H / 2>(r);
+    }
+
+    static void Run(U* p_dst, std::size_t dst_ld, const U* p_src, std::size_t src_ld)
+    {
+        vec r[K];
+        for(std::size_t a = 0; a < K; ++a)
+            std::memcpy(&r[a], p_src + a * src_ld, sizeof(vec));
+
+        Stages<K / 2>(r);
+
+        for(std::size_t b = 0; b < K; ++b)
+            std::memcpy(p_dst + b * dst_ld, &r[b], sizeof(vec));
+    }
+};
+
+// 8 x 8 blocks for 4 and 8 byte types, 16 x 16 for 1 and 2 byte types
+template <typename U>
+inline constexpr std::size_t transpose_block = sizeof(U) <= 2 ? 16 : 8;
+
+// Copy through the strided element mapping described by dims, in dst = op(src) form.
+//
+// The dimension with the smallest dst stride (A) and the one with the smallest src stride (B) are
+// the two innermost ones. If they differ, every (outer, a-tile) work item transposes a
+// TileA x length(B) panel in K x K register blocks, which keeps the TileA source rows being read
+// and the K destination rows being written in L1. If they are the same dimension the copy is a
+// batch of strided rows. Work items are split over host threads.
+template <bool BitCopy, typename DstT, typename SrcT, typename ElementOp>
+void permute_strided(DstT* p_dst,
+                     const SrcT* p_src,
+                     std::vector<PermuteDim> dims,
+                     const ElementOp& op,
+                     std::size_t num_thread)
+{
+    constexpr std::size_t TileA       = 64;
+    constexpr std::size_t RowChunk    = 4096;
+    constexpr std::size_t GrainPerJob = 1 << 15; // elements
+
+    for(const auto& d : dims)
+    {
+        if(d.length == 0)
+            return;
+    }
+
+    dims = simplify_permute_dims(std::move(dims));
+
+    if(dims.empty())
+    {
+        op(*p_dst, *p_src);
+        return;
+    }
+
+    const auto by_dst = [](const PermuteDim& x, const PermuteDim& y) {
+        return x.dst_stride < y.dst_stride;
+    };
+    const auto by_src = [](const PermuteDim& x, const PermuteDim& y) {
+        return x.src_stride < y.src_stride;
+    };
+    const std::size_t ia = std::min_element(dims.begin(), dims.end(), by_dst) - dims.begin();
+    const std::size_t ib = std::min_element(dims.begin(), dims.end(), by_src) - dims.begin();
+
+    const PermuteDim A = dims[ia];
+    const PermuteDim B = dims[ib];
+
+    std::vector<PermuteDim> outer;
+    for(std::size_t i = 0; i < dims.size(); ++i)
+    {
+        if(i != ia && i != ib)
+            outer.push_back(dims[i]);
+    }
+
+    std::size_t num_outer = 1;
+    for(const auto& d : outer)
+        num_outer *= d.length;
+
+    // dst/src offsets of the outer multi-index with linear index o
+    const auto outer_offsets = [&](std::size_t o) {
+        std::size_t dst = 0;
+        std::size_t src = 0;
+        for(std::size_t i = outer.size(); i-- > 0;)
+        {
+            const std::size_t idx = o % outer[i].length;
+            o /= outer[i].length;
+            dst += idx * outer[i].dst_stride;
+            src += idx * outer[i].src_stride;
+        }
+        return std::make_pair(dst, src);
+    };
+
+    if(ia == ib)
+    {
+        const std::size_t num_chunk = (A.length + RowChunk - 1) / RowChunk;
+
+        const auto f_rows = [&](std::size_t begin, std::size_t end) {
+            for(std::size_t item = begin; item < end; ++item)
+            {
+                const auto [dst, src] = outer_offsets(item / num_chunk);
+
+                const std::size_t i0 = item % num_chunk * RowChunk;
+                const std::size_t i1 = std::min(i0 + RowChunk, A.length);
+
+                DstT* p_d       = p_dst + dst + i0 * A.dst_stride;
+                const SrcT* p_s = p_src + src + i0 * A.src_stride;
+
+                if constexpr(BitCopy)
+                {
+                    if(A.dst_stride == 1 && A.src_stride == 1)
+                    {
+                        std::memcpy(p_d, p_s, (i1 - i0) * sizeof(DstT));
+                        continue;
+                    }
+                }
+
+                for(std::size_t i = 0; i < i1 - i0; ++i)
+                    op(p_d[i * A.dst_stride], p_s[i * A.src_stride]);
+            }
+        };
+
+        parallel_for(num_outer * num_chunk,
+                     f_rows,
+                     num_thread,
+                     std::max<std::size_t>(GrainPerJob / RowChunk, 1),
+                     1);
+        return;
+    }
+
+    const std::size_t num_tile = (A.length + TileA - 1) / TileA;
+
+    const auto f_panels = [&](std::size_t begin, std::size_t end) {
+        for(std::size_t item = begin; item < end; ++item)
+        {
+            const auto [dst, src] = outer_offsets(item / num_tile);
+
+            const std::size_t a0 = item % num_tile * TileA;
+            const std::size_t a1 = std::min(a0 + TileA, A.length);
+
+            DstT* p_d       = p_dst + dst;
+            const SrcT* p_s = p_src + src;
+
+            std::size_t b0 = 0;
+
+            using U = typename permute_bits<sizeof(DstT)>::type;
+
+            if constexpr(BitCopy && !std::is_void_v<U>)
+            {
+                constexpr std::size_t K = transpose_block<U>;
+
+                if(A.dst_stride == 1 && B.src_stride == 1)
+                {
+                    for(; b0 + K <= B.length; b0 += K)
+                    {
+                        std::size_t a = a0;
+                        for(; a + K <= a1; a += K)
+                        {
+                            TransposeKernel<U, K>::Run(
+                                reinterpret_cast<U*>(p_d + a + b0 * B.dst_stride),
+                                B.dst_stride,
+                                reinterpret_cast<const U*>(p_s + a * A.src_stride + b0),
+                                A.src_stride);
+                        }
+
+                        for(std::size_t b = b0; b < b0 + K; ++b)
+                            for(std::size_t aa = a; aa < a1; ++aa)
+                                op(p_d[aa + b * B.dst_stride], p_s[aa * A.src_stride + b]);
+                    }
+                }
+            }
+
+            // remaining columns, or the whole panel without the register kernels
+            constexpr std::size_t K = 16;
+            for(; b0 < B.length; b0 += K)
+            {
+                const std::size_t b1 = std::min(b0 + K, B.length);
+                for(std::size_t b = b0; b < b1; ++b)
+                    for(std::size_t a = a0; a < a1; ++a)
+                        op(p_d[a * A.dst_stride + b * B.dst_stride],
+                           p_s[a * A.src_stride + b * B.src_stride]);
+            }
+        }
+    };
+
+    parallel_for(num_outer * num_tile,
+                 f_panels,
+                 num_thread,
+                 std::max<std::size_t>(GrainPerJob / (TileA * B.length), 1),
+                 1);
+}
+
+} // namespace detail
+
+/**
+ * @brief Blocked, multi-threaded host permute
+ *
+ * dst(i_0, ..., i_n-1) = op(src(j_0, ..., j_n-1)) with j_new2old[k] = i_k, i.e. dimension k of dst
+ * is dimension new2old[k] of src, the same convention as
+ * transpose_host_tensor_descriptor_given_new2old(). Both tensors may have arbitrary strides. With
+ * identical lengths and an identity new2old it converts between two layouts of one tensor.
+ *
+ * Without an element-wise operation the elements are converted with ck::type_convert; between
+ * tensors of one type, and for PassThrough, the elements are moved as raw bits.
+ */
+template <typename DstT,
+          typename SrcT,
+          typename New2Old,
+          typename ElementOp = detail::PermuteConvert>
+void permute(Tensor<DstT>& dst,
+             const Tensor<SrcT>& src,
+             const New2Old& new2old,
+             const ElementOp& op    = ElementOp{},
+             std::size_t num_thread = get_host_num_thread())
+{
+    const auto& dst_lengths = dst.mDesc.GetLengths();
+    const auto& src_lengths = src.mDesc.GetLengths();
+    const std::size_t rank  = dst_lengths.size();
+
+    if(src_lengths.size() != rank || std::size(new2old) != rank)
+    {
+        throw std::runtime_error("wrong! permute rank mismatch");
+    }
+
+    std::vector<bool> seen(rank, false);
+    std::vector<detail::PermuteDim> dims(rank);
+
+    for(std::size_t i = 0; i < rank; ++i)
+    {
+        const std::size_t j = static_cast<std::size_t>(new2old[i]);
+
+        if(j >= rank || seen[j] || dst_lengths[i] != src_lengths[j])
+        {
+            throw std::runtime_error("wrong! new2old does not map src onto dst");
+        }
+        seen[j] = true;
+
+        dims[i] = {dst_lengths[i], dst.mDesc.GetStrides()[i], src.mDesc.GetStrides()[j]};
+    }
+
+    constexpr bool bit_copy =
+        std::is_same_v<DstT, SrcT> &&
+        (std::is_same_v<ElementOp, detail::PermuteConvert> ||
+         std::is_same_v<ElementOp, tensor_operation::element_wise::PassThrough>);
+
+    if constexpr(bit_copy)
+    {
+        const auto copy = [](DstT& y, const SrcT& x) { std::memcpy(&y, &x, sizeof(DstT)); };
+        detail::permute_strided<true>(
+            dst.mData.data(), src.mData.data(), std::move(dims), copy, num_thread);
+    }
+    else
+    {
+        detail::permute_strided<false>(
+            dst.mData.data(), src.mData.data(), std::move(dims), op, num_thread);
+    }
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "ck/library/utility/host_parallel.hpp"
+
+namespace ck {
+namespace utils {
+
+// Counter-based Philox4x32-10 generator (Salmon et al., "Parallel Random Numbers: As Easy as 1,
+// 2, 3", SC'11). Block c of the stream of a seed is a pure function of (seed, c), so any part of
+// the stream can be produced independently of the rest.
+struct Philox4x32
+{
+    using Block = std::array<std::uint32_t, 4>;
+
+    static constexpr std::uint32_t M0 = 0xD2511F53;
+    static constexpr std::uint32_t M1 = 0xCD9E8D57;
+    static constexpr std::uint32_t W0 = 0x9E3779B9;
+    static constexpr std::uint32_t W1 = 0xBB67AE85;
+
+    // Lanes blocks with consecutive counters starting at counter. Written as loops over the lanes
+    // so that the compiler can turn the rounds into vector multiplies
+    template <std::size_t Lanes>
+    static void Generate(std::uint64_t seed, std::uint64_t counter, Block (&out)[Lanes])
+    {
+        std::uint32_t c0[Lanes], c1[Lanes], c2[Lanes], c3[Lanes];
+        for(std::size_t l = 0; l < Lanes; ++l)
+        {
+            const std::uint64_t c = counter + l;
+
+            c0[l] = static_cast<std::uint32_t>(c);
+            c1[l] = static_cast<std::uint32_t>(c >> 32);
+            c2[l] = 0;
+            c3[l] = 0;
+        }
+
+        std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+        std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+
+        for(int round = 0; round < 10; ++round)
+        {
+            for(std::size_t l = 0; l < Lanes; ++l)
+            {
+                const std::uint64_t p0 = std::uint64_t{M0} * c0[l];
+                const std::uint64_t p1 = std::uint64_t{M1} * c2[l];
+
+                const std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+                const std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+
+                c0[l] = n0;
+                c1[l] = static_cast<std::uint32_t>(p1);
+                c2[l] = n2;
+                c3[l] = static_cast<std::uint32_t>(p0);
+            }
+
+            k0 += W0;
+            k1 += W1;
+        }
+
+        for(std::size_t l = 0; l < Lanes; ++l)
+            out[l] = {c0[l], c1[l], c2[l], c3[l]};
+    }
+
+    static Block Generate(std::uint64_t seed, std::uint64_t counter)
+    {
+        Block out[1];
+        Generate(seed, counter, out);
+        return out[0];
+    }
+};
+
+// uniform float in [0, 1) from the upper 24 bits
+inline float philox_to_uniform(std::uint32_t x)
+{
+    return static_cast<float>(x >> 8) * (1.f / 16777216.f);
+}
+
+// Fill [first, last) with the elements [index_offset, index_offset + n) of the stream of seed,
+// element i being lane i % 4 of gen(Philox4x32 block i / 4). gen maps a block to 4 values.
+// Random access ranges are filled by num_thread host threads; the values only depend on (seed, i),
+// so the result is the same for any thread count.
+template <typename ForwardIter, typename Gen>
+void philox_fill(ForwardIter first,
+                 ForwardIter last,
+                 std::uint64_t seed,
+                 std::size_t index_offset,
+                 Gen gen,
+                 std::size_t num_thread = get_host_num_thread())
+{
+    // blocks produced per call of the generator
+    constexpr std::size_t Lanes = 8;
+
+    using Values = decltype(gen(std::declval<const Philox4x32::Block&>()));
+
+    auto fill_n = [&](ForwardIter it, std::size_t begin, std::size_t end) {
+        Philox4x32::Block blocks[Lanes];
+        Values values[Lanes];
+
+        // groups of Lanes blocks, the first and the last one clipped to [begin, end)
+        for(std::size_t group = begin / (4 * Lanes) * (4 * Lanes); group < end;
+            group += 4 * Lanes)
+        {
+            Philox4x32::Generate(seed, group / 4, blocks);
+            for(std::size_t l = 0; l < Lanes; ++l)
+                values[l] = gen(blocks[l]);
+
+            if(group >= begin && group + 4 * Lanes <= end)
+            {
+                for(std::size_t l = 0; l < Lanes; ++l)
+                    for(std::size_t j = 0; j < 4; ++j, ++it)
+                        *it = values[l][j];
+                continue;
+            }
+
+            const std::size_t i_end = std::min(group + 4 * Lanes, end);
+            for(std::size_t i = std::max(group, begin); i < i_end; ++i, ++it)
+                *it = values[(i - group) / 4][i % 4];
+        }
+    };
+
+    if constexpr(std::is_base_of_v<std::random_access_iterator_tag,
+                                   typename std::iterator_traits<ForwardIter>::iterator_category>)
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+
+        parallel_for(
+            n,
+            [&](std::size_t begin, std::size_t end) {
+                fill_n(first + static_cast<std::ptrdiff_t>(begin),
+                       index_offset + begin,
+                       index_offset + end);
+            },
+            num_thread);
+    }
+    else
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+
+        fill_n(first, index_offset, index_offset + n);
+    }
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+
+#include "ck/library/utility/host_parallel.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace utils {
+
+// 64-bit hash of size bytes, computed in 1 MiB blocks over num_thread host threads. The value
+// only depends on the bytes and the seed, not on the thread count.
+std::uint64_t hash_bytes(const void* p,
+                         std::size_t size,
+                         std::uint64_t seed     = 0,
+                         std::size_t num_thread = get_host_num_thread());
+
+/**
+ * @brief Identity of a reference computation
+ *
+ * Collects a description of the operation (name, data types, element ops, tensor shapes and
+ * strides) together with hashes of the input contents. Two keys are equal when the
+ * descriptions are; the cache file name is derived from a 128-bit hash of the description and
+ * the full description is kept in the file to rule out collisions.
+ */
+class ReferenceCacheKey
+{
+    public:
+    explicit ReferenceCacheKey(std::string_view op_name) : mDescription(op_name) {}
+
+    ReferenceCacheKey& Add(std::string_view text)
+    {
+        mDescription += '|';
+        mDescription += text;
+        return *this;
+    }
+
+    ReferenceCacheKey& Add(std::uint64_t value) { return Add(std::to_string(value)); }
+
+    template <typename T>
+    ReferenceCacheKey& AddType()
+    {
+        return Add(typeid(T).name()).Add(sizeof(T));
+    }
+
+    ReferenceCacheKey& AddDescriptor(const HostTensorDescriptor& desc);
+
+    ReferenceCacheKey& AddContent(const void* p, std::size_t size)
+    {
+        return Add(size).Add(hash_bytes(p, size));
+    }
+
+    // element ops are identified by their type and, for those holding parameters (e.g. a scale),
+    // by the bytes of the object
+    template <typename ElementOp>
+    ReferenceCacheKey& AddElementOp(const ElementOp& op)
+    {
+        static_assert(std::is_trivially_copyable_v<ElementOp>);
+
+        AddType<ElementOp>();
+        if constexpr(!std::is_empty_v<ElementOp>)
+            AddContent(&op, sizeof(op));
+        return *this;
+    }
+
+    // data type, shape, strides and contents of an input tensor
+    template <typename T>
+    ReferenceCacheKey& AddTensor(const Tensor<T>& tensor)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        AddType<T>();
+        AddDescriptor(tensor.mDesc);
+        return AddContent(tensor.mData.data(), tensor.mData.size() * sizeof(T));
+    }
+
+    const std::string& GetDescription() const { return mDescription; }
+
+    // 32 hex digits
+    std::string GetDigest() const;
+
+    private:
+    std::string mDescription;
+};
+
+/**
+ * @brief On-disk store of reference outputs with a size cap and LRU eviction
+ *
+ * Every entry is one file named after the key digest, written through a temporary file renamed
+ * into place so that concurrent test processes can share a directory. Loads map the file and
+ * refresh its modification time, stores evict the least recently used entries once the
+ * directory exceeds the size cap. A disabled cache (empty directory) never hits and drops
+ * stores.
+ */
+class ReferenceCache
+{
+    public:
+    ReferenceCache() = default;
+    ReferenceCache(std::string dir, std::uint64_t max_size);
+
+    // cache in $CK_REFERENCE_CACHE_DIR capped at $CK_REFERENCE_CACHE_MAX_MB MiB (4096 if unset),
+    // disabled unless the directory is set
+    static ReferenceCache& GetDefault();
+
+    bool IsEnabled() const { return !mDir.empty(); }
+
+    const std::string& GetDirectory() const { return mDir; }
+    std::uint64_t GetMaxSize() const { return mMaxSize; }
+
+    // copy the cached output of key into p_out; false if missing or of another size
+    bool Load(const ReferenceCacheKey& key, void* p_out, std::size_t size) const;
+
+    void Store(const ReferenceCacheKey& key, const void* p, std::size_t size) const;
+
+    template <typename T>
+    bool Load(const ReferenceCacheKey& key, Tensor<T>& out) const
+    {
+        return Load(key, out.mData.data(), out.mData.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void Store(const ReferenceCacheKey& key, const Tensor<T>& out) const
+    {
+        Store(key, out.mData.data(), out.mData.size() * sizeof(T));
+    }
+
+    // total size of the entries in the directory
+    std::uint64_t GetSize() const;
+
+    private:
+    void Evict() const;
+
+    std::string mDir;
+    std::uint64_t mMaxSize = 0;
+};
+
+// Fill out with the reference result: loaded from the cache when present, otherwise produced
+// by compute() and stored. make_key() is only called, and the inputs only hashed, when the cache
+// is enabled. Returns whether the result came from the cache.
+template <typename T, typename MakeKey, typename Compute>
+bool run_cached_reference(const ReferenceCache& cache,
+                          Tensor<T>& out,
+                          MakeKey&& make_key,
+                          Compute&& compute)
+{
+    if(!cache.IsEnabled())
+    {
+        compute();
+        return false;
+    }
+
+    const ReferenceCacheKey key = make_key();
+
+    if(cache.Load(key, out))
+    {
+        return true;
+    }
+
+    compute();
+    cache.Store(key, out);
+    return false;
+}
+
+// run_cached_reference() on a host thread, for overlapping the reference with device setup and
+// profiling. make_key and compute are copied into the task; out, the cache and whatever the
+// callables refer to must outlive the returned future.
+template <typename T, typename MakeKey, typename Compute>
+std::future<bool> run_cached_reference_async(const ReferenceCache& cache,
+                                             Tensor<T>& out,
+                                             MakeKey make_key,
+                                             Compute compute)
+{
+    return std::async(std::launch::async, [&cache, &out, make_key, compute]() mutable {
+        return run_cached_reference(cache, out, make_key, compute);
+    });
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// Host-side fp32 vector math used by the batched reference helpers.
+//
+// The kernels are written with GCC/Clang generic vector extensions instead of x86 intrinsics so
+// that the header stays valid in the device compilation pass of hipcc. The compiler lowers them
+// to AVX-512 when the host pass is built with -mavx512f (16 lanes), to AVX2/FMA with
+// -mavx2 -mfma (8 lanes) and to pairs of SSE instructions otherwise.
+//
+// Accuracy against the libm based scalar functions, over the full float range:
+//   exp, log         : <= 2 ulp
+//   tanh, expm1      : <= 4 ulp
+//   erfc (for Gelu)  : relative error <= 5e-7 for normal results
+// NaN and infinities follow the libm conventions.
+
+namespace ck {
+namespace utils {
+namespace simd {
+
+#if defined(__AVX512F__)
+inline constexpr std::size_t FloatLanes = 16;
+#else
+inline constexpr std::size_t FloatLanes = 8;
+#endif
+
+typedef float vfloat __attribute__((vector_size(FloatLanes * sizeof(float))));
+typedef std::int32_t vint __attribute__((vector_size(FloatLanes * sizeof(std::int32_t))));
+typedef _Float16 vhalf __attribute__((vector_size(FloatLanes * sizeof(_Float16))));
+
+inline vfloat broadcast(float s)
+{
+    vfloat v = {};
+    for(std::size_t i = 0; i < FloatLanes; ++i)
+        v[i] = s;
+    return v;
+}
+
+inline vfloat load(const float* p)
+{
+    vfloat v = {};
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void store(float* p, vfloat v) { std::memcpy(p, &v, sizeof(v)); }
+
+// load/store of the first n < FloatLanes elements, the remaining lanes are zero filled
+inline vfloat load_partial(const float* p, std::size_t n)
+{
+    vfloat v = {};
+    std::memcpy(&v, p, n * sizeof(float));
+    return v;
+}
+
+inline void store_partial(float* p, vfloat v, std::size_t n)
+{
+    std::memcpy(p, &v, n * sizeof(float));
+}
+
+// widening loads from fp16, every fp16 value is exactly representable in fp32
+inline vfloat load(const _Float16* p)
+{
+    vhalf h = {};
+    std::memcpy(&h, p, sizeof(h));
+    return __builtin_convertvector(h, vfloat);
+}
+
+inline vfloat load_partial(const _Float16* p, std::size_t n)
+{
+    vhalf h = {};
+    std::memcpy(&h, p, n * sizeof(_Float16));
+    return __builtin_convertvector(h, vfloat);
+}
+
+inline float reduce_add(vfloat v)
+{
+    float s = 0.f;
+    for(std::size_t i = 0; i < FloatLanes; ++i)
+        s += v[i];
+    return s;
+}
+
+inline vint as_int(vfloat v) { return __builtin_bit_cast(vint, v); }
+
+inline vfloat as_float(vint v) { return __builtin_bit_cast(vfloat, v); }
+
+// lane-wise comparisons on the bit pattern, which keeps -Wfloat-equal quiet
+inline vint is_nan(vfloat v) { return (as_int(v) & 0x7fffffff) > 0x7f800000; }
+
+inline vint is_zero(vfloat v) { return (as_int(v) & 0x7fffffff) == 0; }
+
+inline vint bit_equal(vfloat v, float s)
+{
+    return as_int(v) == __builtin_bit_cast(std::int32_t, s);
+}
+
+// lane-wise mask ? a : b, mask lanes are all ones or all zeros
+inline vfloat select(vint mask, vfloat a, vfloat b)
+{
+    return as_float((mask & as_int(a)) | (~mask & as_int(b)));
+}
+
+inline vint select(vint mask, vint a, vint b) { return (mask & a) | (~mask & b); }
+
+inline vfloat min(vfloat a, vfloat b) { return select(a < b, a, b); }
+
+inline vfloat max(vfloat a, vfloat b) { return select(a > b, a, b); }
+
+inline vfloat abs(vfloat v) { return as_float(as_int(v) & 0x7fffffff); }
+
+inline vfloat copysign(vfloat mag, vfloat sgn)
+{
+    return as_float((as_int(mag) & std::numeric_limits<std::int32_t>::max()) |
+                    (as_int(sgn) & std::numeric_limits<std::int32_t>::min()));
+}
+
+// round to nearest even, valid for |v| < 2^22 which covers every caller below
+inline vfloat round(vfloat v)
+{
+    constexpr float magic = 12582912.f; // 1.5 * 2^23
+    return (v + magic) - magic;
+}
+
+// 2^n for integral n in [-126, 127]
+inline vfloat exp2_int(vint n) { return as_float((n + 127) << 23); }
+
+// Cephes expf
+inline vfloat exp(vfloat x)
+{
+    constexpr float log2e    = 1.44269504088896341f;
+    constexpr float ln2_hi   = 0.693359375f;
+    constexpr float ln2_lo   = -2.12194440e-4f;
+    constexpr float max_arg  = 88.72283935546875f;
+    constexpr float min_arg  = -103.972084045410f;
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    const vfloat xc = min(max(x, broadcast(-104.f)), broadcast(89.f));
+
+    const vfloat fn = round(xc * log2e);
+    vfloat r        = xc - fn * ln2_hi;
+    r               = r - fn * ln2_lo;
+
+    const vfloat r2 = r * r;
+    vfloat p        = 1.9875691500E-4f * r + 1.3981999507E-3f;
+    p               = p * r + 8.3334519073E-3f;
+    p               = p * r + 4.1665795894E-2f;
+    p               = p * r + 1.6666665459E-1f;
+    p               = p * r + 5.0000001201E-1f;
+    p               = p * r2 + r + 1.f;
+
+    // scale in two steps so that results in the subnormal range and at the overflow boundary
+    // are rounded only once
+    const vint n  = __builtin_convertvector(fn, vint);
+    const vint n1 = n >> 1;
+    vfloat y      = p * exp2_int(n1) * exp2_int(n - n1);
+
+    y = select(x > max_arg, broadcast(infinity), y);
+    y = select(x < min_arg, vfloat{}, y);
+    return select(is_nan(x), x, y);
+}
+
+// Cephes logf
+inline vfloat log(vfloat x)
+{
+    constexpr float sqrt_half = 0.707106781186547524f;
+    constexpr float ln2_hi    = 0.693359375f;
+    constexpr float ln2_lo    = -2.12194440e-4f;
+    constexpr float min_norm  = std::numeric_limits<float>::min();
+    constexpr float infinity  = std::numeric_limits<float>::infinity();
+
+    // bring subnormals into the normal range first
+    const vint subnormal = x < min_norm;
+    const vfloat xs      = select(subnormal, x * 8388608.f, x); // 2^23
+
+    const vint ix = as_int(xs);
+    vint e        = ((ix >> 23) & 0xff) - 126 + (subnormal & -23);
+    vfloat m      = as_float((ix & 0x007fffff) | 0x3f000000); // mantissa in [0.5, 1)
+
+    const vint small = m < sqrt_half;
+    e                = e + small; // mask lanes are -1
+    m                = select(small, m + m, m) - 1.f;
+
+    const vfloat z = m * m;
+
+    vfloat p = 7.0376836292E-2f * m - 1.1514610310E-1f;
+    p        = p * m + 1.1676998740E-1f;
+    p        = p * m - 1.2420140846E-1f;
+    p        = p * m + 1.4249322787E-1f;
+    p        = p * m - 1.6668057665E-1f;
+    p        = p * m + 2.0000714765E-1f;
+    p        = p * m - 2.4999993993E-1f;
+    p        = p * m + 3.3333331174E-1f;
+    p        = p * m * z;
+
+    const vfloat fe = __builtin_convertvector(e, vfloat);
+
+    vfloat y = p + fe * ln2_lo;
+    y        = y - 0.5f * z;
+    y        = m + y;
+    y        = y + fe * ln2_hi;
+
+    y = select(bit_equal(x, infinity), x, y);
+    y = select(is_zero(x), broadcast(-infinity), y);
+    y = select(x < 0.f, broadcast(std::numeric_limits<float>::quiet_NaN()), y);
+    return select(is_nan(x), x, y);
+}
+
+// Cephes tanhf: odd polynomial below 0.625, 1 - 2 / (exp(2|x|) + 1) above
+inline vfloat tanh(vfloat x)
+{
+    const vfloat ax = abs(x);
+
+    const vfloat z = x * x;
+    vfloat p       = -5.70498872745E-3f * z + 2.06390887954E-2f;
+    p              = p * z - 5.37397155531E-2f;
+    p              = p * z + 1.33314422036E-1f;
+    p              = p * z - 3.33332819422E-1f;
+    p              = p * z * x + x;
+
+    const vfloat q = 1.f - 2.f / (exp(ax + ax) + 1.f);
+
+    return select(ax < 0.625f, p, copysign(q, x));
+}
+
+// exp(x) - 1 without cancellation for small |x| (Kahan)
+inline vfloat expm1(vfloat x)
+{
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    const vfloat u  = exp(x);
+    const vfloat um = u - 1.f;
+
+    vfloat y = um * (x / log(u));
+    y        = select(bit_equal(um, -1.f), um, y);
+    y        = select(bit_equal(u, 1.f), x, y);
+    y        = select(bit_equal(u, infinity), u, y);
+    return select(is_nan(x), x, y);
+}
+
+// Complementary error function, Numerical Recipes erfcc
+inline vfloat erfc(vfloat x)
+{
+    // erfc(10) is below the smallest subnormal, clamping keeps z * z finite
+    const vfloat z = min(abs(x), broadcast(10.f));
+    const vfloat t = 1.f / (1.f + 0.5f * z);
+
+    vfloat p = 0.17087277f * t - 0.82215223f;
+    p        = p * t + 1.48851587f;
+    p        = p * t - 1.13520398f;
+    p        = p * t + 0.27886807f;
+    p        = p * t - 0.18628806f;
+    p        = p * t + 0.09678418f;
+    p        = p * t + 0.37409196f;
+    p        = p * t + 1.00002368f;
+    p        = p * t - 1.26551223f;
+
+    // exp(-z * z) is evaluated as exp(-zh * zh) * exp((zh - z) * (zh + z)) with zh holding the
+    // upper 12 mantissa bits of z, so that the large exponent is exact
+    const vfloat zh = as_float(as_int(z) & static_cast<std::int32_t>(0xfffff000));
+    const vfloat r  = t * exp(-zh * zh) * exp((zh - z) * (zh + z) + p);
+
+    return select(is_nan(x), x, select(x < 0.f, 2.f - r, r));
+}
+
+// Apply f to every FloatLanes wide block of [p_x, p_x + n), finishing with one partial block
+template <typename F>
+void transform_n(const float* p_x, std::size_t n, float* p_y, F&& f)
+{
+    std::size_t i = 0;
+    for(; i + FloatLanes <= n; i += FloatLanes)
+        store(p_y + i, f(load(p_x + i)));
+
+    if(i < n)
+        store_partial(p_y + i, f(load_partial(p_x + i, n - i)), n - i);
+}
+
+template <typename F>
+void transform_n(const float* p_x0, const float* p_x1, std::size_t n, float* p_y, F&& f)
+{
+    std::size_t i = 0;
+    for(; i + FloatLanes <= n; i += FloatLanes)
+        store(p_y + i, f(load(p_x0 + i), load(p_x1 + i)));
+
+    if(i < n)
+        store_partial(
+            p_y + i, f(load_partial(p_x0 + i, n - i), load_partial(p_x1 + i, n - i)), n - i);
+}
+
+} // namespace simd
+} // namespace utils
+} // namespace ck
@@ -16,6 +16,7 @@
 #include "ck/utility/type_convert.hpp"
 
 #include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/host_convert.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 template <typename Range>
@@ -271,8 +272,7 @@ struct Tensor
     {
         Tensor<OutT> ret(mDesc);
 
-        ck::ranges::transform(
-            mData, ret.mData.begin(), [](auto value) { return ck::type_convert<OutT>(value); });
+        ck::utils::convert_n(ret.mData.data(), mData.data(), mData.size());
 
         return ret;
     }
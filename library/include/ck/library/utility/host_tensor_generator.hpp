@@ -4,10 +4,49 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <numeric>
 #include <random>
 
 #include "ck/ck.hpp"
+#include "ck/library/utility/host_philox.hpp"
+
+namespace ck {
+namespace utils {
+namespace detail {
+
+// 32 random bits of the element at multi-index is. The bits are a hash of (seed, is) instead of
+// the next value of a shared generator, so GenerateTensorValue() produces the same tensor for any
+// num_thread and its threads do not serialize on the lock of std::rand()
+template <typename... Is>
+std::uint32_t hash_tensor_index(std::uint32_t seed, Is... is)
+{
+    std::uint64_t key = 0;
+    ((key = key * 0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(is)), ...);
+
+    return Philox4x32::Generate(seed, key)[0];
+}
+
+// integer in [min_value, max_value)
+template <typename... Is>
+int hash_tensor_index_int(std::uint32_t seed, int min_value, int max_value, Is... is)
+{
+    const auto range = static_cast<std::uint32_t>(max_value - min_value);
+
+    return static_cast<int>(hash_tensor_index(seed, is...) % range) + min_value;
+}
+
+// float in [0, 1)
+template <typename... Is>
+float hash_tensor_index_float(std::uint32_t seed, Is... is)
+{
+    return philox_to_uniform(hash_tensor_index(seed, is...));
+}
+
+} // namespace detail
+} // namespace utils
+} // namespace ck
 
 template <typename T>
 struct GeneratorTensor_0
@@ -84,26 +123,30 @@ struct GeneratorTensor_1<int8_t>
 template <typename T>
 struct GeneratorTensor_2
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    // drawn from std::rand() once, so std::srand() still selects the data
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    T operator()(Is...)
+    T operator()(Is... is)
     {
-        return static_cast<T>((std::rand() % (max_value - min_value)) + min_value);
+        return static_cast<T>(
+            ck::utils::detail::hash_tensor_index_int(seed, min_value, max_value, is...));
     }
 };
 
 template <>
 struct GeneratorTensor_2<ck::bhalf_t>
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    ck::bhalf_t operator()(Is...)
+    ck::bhalf_t operator()(Is... is)
     {
-        float tmp = (std::rand() % (max_value - min_value)) + min_value;
+        float tmp = ck::utils::detail::hash_tensor_index_int(seed, min_value, max_value, is...);
         return ck::type_convert<ck::bhalf_t>(tmp);
     }
 };
@@ -111,13 +154,14 @@ struct GeneratorTensor_2<ck::bhalf_t>
 template <>
 struct GeneratorTensor_2<int8_t>
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    int8_t operator()(Is...)
+    int8_t operator()(Is... is)
     {
-        return (std::rand() % (max_value - min_value)) + min_value;
+        return ck::utils::detail::hash_tensor_index_int(seed, min_value, max_value, is...);
     }
 };
 
@@ -125,13 +169,14 @@ struct GeneratorTensor_2<int8_t>
 template <>
 struct GeneratorTensor_2<ck::f8_t>
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    ck::f8_t operator()(Is...)
+    ck::f8_t operator()(Is... is)
     {
-        float tmp = (std::rand() % (max_value - min_value)) + min_value;
+        float tmp = ck::utils::detail::hash_tensor_index_int(seed, min_value, max_value, is...);
         return ck::type_convert<ck::f8_t>(tmp);
     }
 };
@@ -141,13 +186,14 @@ struct GeneratorTensor_2<ck::f8_t>
 template <>
 struct GeneratorTensor_2<ck::bf8_t>
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    ck::bf8_t operator()(Is...)
+    ck::bf8_t operator()(Is... is)
     {
-        float tmp = (std::rand() % (max_value - min_value)) + min_value;
+        float tmp = ck::utils::detail::hash_tensor_index_int(seed, min_value, max_value, is...);
         return ck::type_convert<ck::bf8_t>(tmp);
     }
 };
@@ -156,13 +202,15 @@ struct GeneratorTensor_2<ck::bf8_t>
 template <typename T>
 struct GeneratorTensor_3
 {
-    float min_value = 0;
-    float max_value = 1;
+    float min_value    = 0;
+    float max_value    = 1;
+    // drawn from std::rand() once, so std::srand() still selects the data
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    T operator()(Is...)
+    T operator()(Is... is)
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = ck::utils::detail::hash_tensor_index_float(seed, is...);
 
         return static_cast<T>(min_value + tmp * (max_value - min_value));
     }
@@ -171,13 +219,14 @@ struct GeneratorTensor_3
 template <>
 struct GeneratorTensor_3<ck::bhalf_t>
 {
-    float min_value = 0;
-    float max_value = 1;
+    float min_value    = 0;
+    float max_value    = 1;
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    ck::bhalf_t operator()(Is...)
+    ck::bhalf_t operator()(Is... is)
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = ck::utils::detail::hash_tensor_index_float(seed, is...);
 
         float fp32_tmp = min_value + tmp * (max_value - min_value);
 
@@ -189,13 +238,14 @@ struct GeneratorTensor_3<ck::bhalf_t>
 template <>
 struct GeneratorTensor_3<ck::f8_t>
 {
-    float min_value = 0;
-    float max_value = 1;
+    float min_value    = 0;
+    float max_value    = 1;
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    ck::f8_t operator()(Is...)
+    ck::f8_t operator()(Is... is)
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = ck::utils::detail::hash_tensor_index_float(seed, is...);
 
         float fp32_tmp = min_value + tmp * (max_value - min_value);
 
@@ -208,13 +258,14 @@ struct GeneratorTensor_3<ck::f8_t>
 template <>
 struct GeneratorTensor_3<ck::bf8_t>
 {
-    float min_value = 0;
-    float max_value = 1;
+    float min_value    = 0;
+    float max_value    = 1;
+    std::uint32_t seed = static_cast<std::uint32_t>(std::rand());
 
     template <typename... Is>
-    ck::bf8_t operator()(Is...)
+    ck::bf8_t operator()(Is... is)
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        float tmp = ck::utils::detail::hash_tensor_index_float(seed, is...);
 
         float fp32_tmp = min_value + tmp * (max_value - min_value);
 
@@ -0,0 +1,693 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/library/utility/host_convert.hpp"
+#include "ck/library/utility/host_mapped_file.hpp"
+#include "ck/library/utility/host_parallel.hpp"
+#include "ck/library/utility/host_simd.hpp"
+
+// Host-side preparation of quantized weights for the weight-only (fpAintB) GEMM path:
+//
+//   pack_int4_n / unpack_int4_n : int8 values in [-8, 7] <-> two int4 per byte, element 2i in
+//                                 the low nibble of byte i
+//   to_unsigned_weight_n        : int8 -> uint8 biased by 128, the B operand of
+//                                 DeviceFpAintBGemm_Wmma_CShuffle
+//   compute_group_quant_params,
+//   quantize_group_n,
+//   dequantize_group_n          : per-group scales and zero points along the rows of a matrix
+//   pack_int4_weight            : the steps above fused row by row, with an optional reordering
+//                                 of the 8 elements held by every 32-bit word
+//   PackedInt4WeightFile        : on-disk cache of a packed weight, mapped when loaded
+//
+// The bulk loops use the generic vector types of host_simd.hpp and run on all host threads.
+
+namespace ck {
+namespace utils {
+
+enum struct QuantScheme
+{
+    Symmetric,  // zero point 0 and scale = max |x| / qmax
+    Asymmetric, // the range [min(x, 0), max(x, 0)] is mapped onto [qmin, qmax]
+};
+
+// A num_row x row_length matrix with contiguous rows, quantized to num_bit signed integers in
+// groups of group_size consecutive elements of a row; the last group of a row may be shorter.
+// For the B operand of a GEMM the rows are the N columns of a column-major B, so that the groups
+// run along K. Scales and zero points are stored as [num_row, GetRowGroupCount()] matrices.
+struct GroupQuantDesc
+{
+    std::size_t num_row    = 0;
+    std::size_t row_length = 0;
+    std::size_t group_size = 0;
+    int num_bit            = 4;
+    QuantScheme scheme     = QuantScheme::Symmetric;
+
+    std::size_t GetRowGroupCount() const
+    {
+        return group_size == 0 ? 0 : (row_length + group_size - 1) / group_size;
+    }
+
+    std::size_t GetGroupCount() const { return num_row * GetRowGroupCount(); }
+
+    std::int32_t GetQMin() const { return -(std::int32_t{1} << (num_bit - 1)); }
+
+    std::int32_t GetQMax() const { return (std::int32_t{1} << (num_bit - 1)) - 1; }
+
+    void Validate() const
+    {
+        if(group_size == 0 || num_bit < 2 || num_bit > 8)
+        {
+            throw std::runtime_error("wrong! bad group quantization descriptor");
+        }
+    }
+};
+
+// Order of the elements inside each 32-bit word (8 int4) of a packed row: nibble j holds element
+// interleave[j] of the word. The even/odd order puts elements 2i and 2i + 1 into the two 16-bit
+// halves, as expected by int4 -> fp16 converters that build two halves per mask-and-or.
+using Int4Interleave = std::array<std::uint8_t, 8>;
+
+inline constexpr Int4Interleave int4_interleave_identity = {0, 1, 2, 3, 4, 5, 6, 7};
+inline constexpr Int4Interleave int4_interleave_even_odd = {0, 2, 4, 6, 1, 3, 5, 7};
+
+namespace detail {
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "packing assumes a little endian host");
+
+// bytes of packed int4 produced per vector step
+inline constexpr std::size_t Int4PackBytes = 2 * simd::FloatLanes;
+
+typedef std::uint16_t vint4_pair
+    __attribute__((vector_size(Int4PackBytes * sizeof(std::uint16_t))));
+typedef std::uint8_t vint4_byte __attribute__((vector_size(Int4PackBytes)));
+typedef std::int8_t vint8 __attribute__((vector_size(simd::FloatLanes)));
+
+inline std::uint8_t pack_int4_pair(std::int8_t lo, std::int8_t hi)
+{
+    return static_cast<std::uint8_t>((static_cast<std::uint8_t>(lo) & 0x0fu) |
+                                     ((static_cast<std::uint8_t>(hi) & 0x0fu) << 4));
+}
+
+inline std::int8_t unpack_int4(std::uint32_t nibble)
+{
+    return static_cast<std::int8_t>(static_cast<std::int32_t>((nibble & 0x0fu) ^ 0x08u) - 8);
+}
+
+// the bytes of 2 * Int4PackBytes int8 read as Int4PackBytes little endian pairs
+inline vint4_byte pack_int4_vector(const std::int8_t* p_x)
+{
+    vint4_pair w = {};
+    std::memcpy(&w, p_x, sizeof(w));
+    return __builtin_convertvector((w & 0x0f) | ((w >> 4) & 0xf0), vint4_byte);
+}
+
+inline void unpack_int4_vector(std::int8_t* p_y, vint4_byte b)
+{
+    const vint4_pair w  = __builtin_convertvector(b, vint4_pair);
+    const vint4_pair lo = ((w & 0x0f) ^ 0x08) - 0x08;
+    const vint4_pair hi = ((w >> 4) ^ 0x08) - 0x08;
+    const vint4_pair y  = (lo & 0xff) | (hi << 8);
+    std::memcpy(p_y, &y, sizeof(y));
+}
+
+inline bool is_identity(const Int4Interleave& interleave)
+{
+    return interleave == int4_interleave_identity;
+}
+
+// quantization parameters of a group with the value range [lo, hi], lo <= 0 <= hi. The scale is
+// rounded to Scale so that quantization and dequantization use the same stored value.
+template <typename Scale>
+void get_group_quant_param(
+    float lo, float hi, const GroupQuantDesc& desc, float& scale, std::int32_t& zero)
+{
+    const float qmin = static_cast<float>(desc.GetQMin());
+    const float qmax = static_cast<float>(desc.GetQMax());
+
+    float s = desc.scheme == QuantScheme::Symmetric ? std::max(-lo, hi) / qmax
+                                                    : (hi - lo) / (qmax - qmin);
+
+    s = type_convert<float>(type_convert<Scale>(s));
+
+    // an all zero group, or a scale that underflows in Scale
+    scale = s > 0.f ? s : 1.f;
+    zero  = 0;
+
+    if(desc.scheme == QuantScheme::Asymmetric)
+    {
+        zero =
+            static_cast<std::int32_t>(std::clamp(std::nearbyint(qmin - lo / scale), qmin, qmax));
+    }
+}
+
+// [min(x, 0), max(x, 0)] of n floats
+inline void get_group_range(const float* p_x, std::size_t n, float& lo, float& hi)
+{
+    simd::vfloat vlo = {};
+    simd::vfloat vhi = {};
+
+    std::size_t i = 0;
+    for(; i + simd::FloatLanes <= n; i += simd::FloatLanes)
+    {
+        const simd::vfloat x = simd::load(p_x + i);
+
+        vlo = simd::min(vlo, x);
+        vhi = simd::max(vhi, x);
+    }
+
+    if(i < n)
+    {
+        // the zero filled lanes do not change a range that contains 0
+        const simd::vfloat x = simd::load_partial(p_x + i, n - i);
+
+        vlo = simd::min(vlo, x);
+        vhi = simd::max(vhi, x);
+    }
+
+    lo = 0.f;
+    hi = 0.f;
+    for(std::size_t l = 0; l < simd::FloatLanes; ++l)
+    {
+        lo = std::min(lo, vlo[l]);
+        hi = std::max(hi, vhi[l]);
+    }
+}
+
+// q = clamp(round(x / scale) + zero, qmin, qmax), round to nearest even; the quotient is clamped
+// before rounding, which gives the same result for integral bounds
+inline simd::vint
+quantize_vector(simd::vfloat x, float scale, float lo, float hi, std::int32_t zero)
+{
+    const simd::vfloat v =
+        simd::min(simd::max(x / scale, simd::broadcast(lo)), simd::broadcast(hi));
+    return __builtin_convertvector(simd::round(v), simd::vint) + zero;
+}
+
+inline void quantize_group(std::int8_t* p_q,
+                           const float* p_x,
+                           std::size_t n,
+                           float scale,
+                           std::int32_t zero,
+                           const GroupQuantDesc& desc)
+{
+    const float lo = static_cast<float>(desc.GetQMin() - zero);
+    const float hi = static_cast<float>(desc.GetQMax() - zero);
+
+    std::size_t i = 0;
+    for(; i + simd::FloatLanes <= n; i += simd::FloatLanes)
+    {
+        const vint8 q = __builtin_convertvector(
+            quantize_vector(simd::load(p_x + i), scale, lo, hi, zero), vint8);
+        std::memcpy(p_q + i, &q, sizeof(q));
+    }
+
+    if(i < n)
+    {
+        const vint8 q = __builtin_convertvector(
+            quantize_vector(simd::load_partial(p_x + i, n - i), scale, lo, hi, zero), vint8);
+        std::memcpy(p_q + i, &q, n - i);
+    }
+}
+
+inline void
+dequantize_group(float* p_y, const std::int8_t* p_q, std::size_t n, float scale, std::int32_t zero)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        p_y[i] = static_cast<float>(p_q[i] - zero) * scale;
+}
+
+// row of X as float in buf
+template <typename X>
+const float* load_row_as_float(std::vector<float>& buf, const X* p_x, std::size_t n)
+{
+    if constexpr(std::is_same_v<X, float>)
+    {
+        (void)buf;
+        return p_x;
+    }
+    else
+    {
+        buf.resize(n);
+        convert_float_like_n(buf.data(), p_x, n);
+        return buf.data();
+    }
+}
+
+template <typename Y>
+void store_row_from_float(Y* p_y, const float* p_x, std::size_t n)
+{
+    if constexpr(std::is_same_v<Y, float>)
+        std::copy_n(p_x, n, p_y);
+    else
+        convert_float_like_n(p_y, p_x, n);
+}
+
+// quantize one row, returning its scales and zero points
+template <typename Scale>
+void quantize_row(std::int8_t* p_q,
+                  float* p_scale,
+                  std::int8_t* p_zero,
+                  const float* p_x,
+                  const GroupQuantDesc& desc)
+{
+    for(std::size_t g = 0, k = 0; k < desc.row_length; ++g, k += desc.group_size)
+    {
+        const std::size_t n = std::min(desc.group_size, desc.row_length - k);
+
+        float lo, hi, scale;
+        std::int32_t zero;
+        get_group_range(p_x + k, n, lo, hi);
+        get_group_quant_param<Scale>(lo, hi, desc, scale, zero);
+        quantize_group(p_q + k, p_x + k, n, scale, zero, desc);
+
+        p_scale[g] = scale;
+        p_zero[g]  = static_cast<std::int8_t>(zero);
+    }
+}
+
+// f(begin, end) on chunks of rows with about 2^14 elements at least
+template <typename F>
+void parallel_for_row(const GroupQuantDesc& desc, F&& f, std::size_t num_thread)
+{
+    const std::size_t min_row = (std::size_t{1} << 14) / std::max<std::size_t>(desc.row_length, 1);
+
+    parallel_for(desc.num_row, f, num_thread, std::max<std::size_t>(min_row, 1), 1);
+}
+
+} // namespace detail
+
+// pack n int8 values in [-8, 7] into (n + 1) / 2 bytes, element 2i in the low nibble of byte i;
+// the high nibble of the last byte is 0 for odd n
+inline void pack_int4_n(std::uint8_t* p_y,
+                        const std::int8_t* p_x,
+                        std::size_t n,
+                        std::size_t num_thread = get_host_num_thread())
+{
+    parallel_for(
+        (n + 1) / 2,
+        [&](std::size_t begin, std::size_t end) {
+            std::size_t i = begin;
+            for(; i + detail::Int4PackBytes <= end && 2 * (i + detail::Int4PackBytes) <= n;
+                i += detail::Int4PackBytes)
+            {
+                const detail::vint4_byte y = detail::pack_int4_vector(p_x + 2 * i);
+                std::memcpy(p_y + i, &y, sizeof(y));
+            }
+
+            for(; i < end; ++i)
+                p_y[i] = detail::pack_int4_pair(p_x[2 * i],
+                                                2 * i + 1 < n ? p_x[2 * i + 1] : std::int8_t{0});
+        },
+        num_thread);
+}
+
+// inverse of pack_int4_n, sign extending the n int4 values read from (n + 1) / 2 bytes
+inline void unpack_int4_n(std::int8_t* p_y,
+                          const std::uint8_t* p_x,
+                          std::size_t n,
+                          std::size_t num_thread = get_host_num_thread())
+{
+    parallel_for(
+        (n + 1) / 2,
+        [&](std::size_t begin, std::size_t end) {
+            std::size_t i = begin;
+            for(; i + detail::Int4PackBytes <= end && 2 * (i + detail::Int4PackBytes) <= n;
+                i += detail::Int4PackBytes)
+            {
+                detail::vint4_byte x;
+                std::memcpy(&x, p_x + i, sizeof(x));
+                detail::unpack_int4_vector(p_y + 2 * i, x);
+            }
+
+            for(; i < end; ++i)
+            {
+                p_y[2 * i] = detail::unpack_int4(p_x[i]);
+                if(2 * i + 1 < n)
+                    p_y[2 * i + 1] = detail::unpack_int4(static_cast<std::uint32_t>(p_x[i]) >> 4);
+            }
+        },
+        num_thread);
+}
+
+// p_y[i] = p_x[i] + 128, the unsigned weight layout consumed by the fpAintB GEMM
+inline void to_unsigned_weight_n(std::uint8_t* p_y,
+                                 const std::int8_t* p_x,
+                                 std::size_t n,
+                                 std::size_t num_thread = get_host_num_thread())
+{
+    parallel_for(
+        n,
+        [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                p_y[i] = static_cast<std::uint8_t>(static_cast<std::uint8_t>(p_x[i]) ^ 0x80u);
+        },
+        num_thread);
+}
+
+// Scales and zero points of every group of p_x, scales rounded to Scale. X is float, half_t or
+// bhalf_t and has to be finite.
+template <typename Scale = float, typename X>
+void compute_group_quant_params(float* p_scale,
+                                std::int8_t* p_zero,
+                                const X* p_x,
+                                const GroupQuantDesc& desc,
+                                std::size_t num_thread = get_host_num_thread())
+{
+    static_assert(detail::is_float_like_v<X>);
+
+    desc.Validate();
+
+    const std::size_t num_group = desc.GetRowGroupCount();
+
+    detail::parallel_for_row(
+        desc,
+        [&](std::size_t begin, std::size_t end) {
+            std::vector<float> buf;
+
+            for(std::size_t r = begin; r < end; ++r)
+            {
+                const float* p_row =
+                    detail::load_row_as_float(buf, p_x + r * desc.row_length, desc.row_length);
+
+                for(std::size_t g = 0, k = 0; k < desc.row_length; ++g, k += desc.group_size)
+                {
+                    float lo, hi, scale;
+                    std::int32_t zero;
+                    detail::get_group_range(
+                        p_row + k, std::min(desc.group_size, desc.row_length - k), lo, hi);
+                    detail::get_group_quant_param<Scale>(lo, hi, desc, scale, zero);
+
+                    p_scale[r * num_group + g] = scale;
+                    p_zero[r * num_group + g]  = static_cast<std::int8_t>(zero);
+                }
+            }
+        },
+        num_thread);
+}
+
+// p_q = clamp(round(p_x / scale) + zero, qmin, qmax) group by group
+template <typename X>
+void quantize_group_n(std::int8_t* p_q,
+                      const X* p_x,
+                      const float* p_scale,
+                      const std::int8_t* p_zero,
+                      const GroupQuantDesc& desc,
+                      std::size_t num_thread = get_host_num_thread())
+{
+    static_assert(detail::is_float_like_v<X>);
+
+    desc.Validate();
+
+    const std::size_t num_group = desc.GetRowGroupCount();
+
+    detail::parallel_for_row(
+        desc,
+        [&](std::size_t begin, std::size_t end) {
+            std::vector<float> buf;
+
+            for(std::size_t r = begin; r < end; ++r)
+            {
+                const float* p_row =
+                    detail::load_row_as_float(buf, p_x + r * desc.row_length, desc.row_length);
+
+                for(std::size_t g = 0, k = 0; k < desc.row_length; ++g, k += desc.group_size)
+                    detail::quantize_group(p_q + r * desc.row_length + k,
+                                           p_row + k,
+                                           std::min(desc.group_size, desc.row_length - k),
+                                           p_scale[r * num_group + g],
+                                           p_zero[r * num_group + g],
+                                           desc);
+            }
+        },
+        num_thread);
+}
+
+// p_y = (p_q - zero) * scale group by group
+template <typename Y>
+void dequantize_group_n(Y* p_y,
+                        const std::int8_t* p_q,
+                        const float* p_scale,
+                        const std::int8_t* p_zero,
+                        const GroupQuantDesc& desc,
+                        std::size_t num_thread = get_host_num_thread())
+{
+    static_assert(detail::is_float_like_v<Y>);
+
+    desc.Validate();
+
+    const std::size_t num_group = desc.GetRowGroupCount();
+
+    detail::parallel_for_row(
+        desc,
+        [&](std::size_t begin, std::size_t end) {
+            std::vector<float> buf(desc.row_length);
+
+            for(std::size_t r = begin; r < end; ++r)
+            {
+                for(std::size_t g = 0, k = 0; k < desc.row_length; ++g, k += desc.group_size)
+                    detail::dequantize_group(buf.data() + k,
+                                             p_q + r * desc.row_length + k,
+                                             std::min(desc.group_size, desc.row_length - k),
+                                             p_scale[r * num_group + g],
+                                             p_zero[r * num_group + g]);
+
+                detail::store_row_from_float(
+                    p_y + r * desc.row_length, buf.data(), desc.row_length);
+            }
+        },
+        num_thread);
+}
+
+// packed int4 weight whose storage is owned elsewhere, rows of row_length / 2 bytes
+struct PackedInt4WeightView
+{
+    GroupQuantDesc desc;
+    Int4Interleave interleave = int4_interleave_identity;
+    const std::uint8_t* p_data = nullptr;
+    const float* p_scale       = nullptr;
+    const std::int8_t* p_zero  = nullptr;
+};
+
+struct PackedInt4Weight
+{
+    GroupQuantDesc desc;
+    Int4Interleave interleave = int4_interleave_identity;
+    std::vector<std::uint8_t> data;
+    std::vector<float> scale;
+    std::vector<std::int8_t> zero;
+
+    PackedInt4WeightView GetView() const
+    {
+        return {desc, interleave, data.data(), scale.data(), zero.data()};
+    }
+};
+
+namespace detail {
+
+inline void check_int4_weight_desc(const GroupQuantDesc& desc, const Int4Interleave& interleave)
+{
+    desc.Validate();
+
+    if(desc.num_bit != 4)
+    {
+        throw std::runtime_error("wrong! packed weights hold 4-bit values");
+    }
+
+    if(desc.row_length % (is_identity(interleave) ? 2 : 8) != 0)
+    {
+        throw std::runtime_error("wrong! row length does not fill whole packed words");
+    }
+}
+
+} // namespace detail
+
+// Quantize the rows of p_x to int4 with per-group scales and zero points and pack them, each row
+// in one pass through a per-thread buffer. X is float, half_t or bhalf_t and has to be finite.
+template <typename Scale = float, typename X>
+PackedInt4Weight pack_int4_weight(const X* p_x,
+                                  const GroupQuantDesc& desc,
+                                  const Int4Interleave& interleave = int4_interleave_identity,
+                                  std::size_t num_thread           = get_host_num_thread())
+{
+    static_assert(detail::is_float_like_v<X>);
+
+    detail::check_int4_weight_desc(desc, interleave);
+
+    const std::size_t num_group = desc.GetRowGroupCount();
+    const std::size_t row_bytes = desc.row_length / 2;
+
+    PackedInt4Weight weight{desc,
+                            interleave,
+                            std::vector<std::uint8_t>(desc.num_row * row_bytes),
+                            std::vector<float>(desc.GetGroupCount()),
+                            std::vector<std::int8_t>(desc.GetGroupCount())};
+
+    const bool shuffle = !detail::is_identity(interleave);
+
+    detail::parallel_for_row(
+        desc,
+        [&](std::size_t begin, std::size_t end) {
+            std::vector<float> buf;
+            std::vector<std::int8_t> q(desc.row_length);
+            std::vector<std::int8_t> t(shuffle ? desc.row_length : 0);
+
+            for(std::size_t r = begin; r < end; ++r)
+            {
+                const float* p_row =
+                    detail::load_row_as_float(buf, p_x + r * desc.row_length, desc.row_length);
+
+                detail::quantize_row<Scale>(q.data(),
+                                            weight.scale.data() + r * num_group,
+                                            weight.zero.data() + r * num_group,
+                                            p_row,
+                                            desc);
+
+                if(shuffle)
+                {
+                    for(std::size_t k = 0; k < desc.row_length; k += 8)
+                        for(std::size_t j = 0; j < 8; ++j)
+                            t[k + j] = q[k + interleave[j]];
+                }
+
+                pack_int4_n(weight.data.data() + r * row_bytes,
+                            shuffle ? t.data() : q.data(),
+                            desc.row_length,
+                            1);
+            }
+        },
+        num_thread);
+
+    return weight;
+}
+
+// int8 values of a packed weight in the natural element order, e.g. for the host reference
+inline void unpack_int4_weight(std::int8_t* p_q,
+                               const PackedInt4WeightView& weight,
+                               std::size_t num_thread = get_host_num_thread())
+{
+    const GroupQuantDesc& desc = weight.desc;
+
+    detail::check_int4_weight_desc(desc, weight.interleave);
+
+    const bool shuffle = !detail::is_identity(weight.interleave);
+
+    detail::parallel_for_row(
+        desc,
+        [&](std::size_t begin, std::size_t end) {
+            std::vector<std::int8_t> t(shuffle ? desc.row_length : 0);
+
+            for(std::size_t r = begin; r < end; ++r)
+            {
+                std::int8_t* p_row = p_q + r * desc.row_length;
+
+                unpack_int4_n(shuffle ? t.data() : p_row,
+                              weight.p_data + r * desc.row_length / 2,
+                              desc.row_length,
+                              1);
+
+                if(shuffle)
+                {
+                    for(std::size_t k = 0; k < desc.row_length; k += 8)
+                        for(std::size_t j = 0; j < 8; ++j)
+                            p_row[k + weight.interleave[j]] = t[k + j];
+                }
+            }
+        },
+        num_thread);
+}
+
+// dequantized values of a packed weight in the natural element order
+template <typename Y>
+void dequantize_int4_weight(Y* p_y,
+                            const PackedInt4WeightView& weight,
+                            std::size_t num_thread = get_host_num_thread())
+{
+    std::vector<std::int8_t> q(weight.desc.num_row * weight.desc.row_length);
+
+    unpack_int4_weight(q.data(), weight, num_thread);
+    dequantize_group_n(p_y, q.data(), weight.p_scale, weight.p_zero, weight.desc, num_thread);
+}
+
+/**
+ * @brief Packed int4 weight stored in a file and mapped into the host address space
+ *
+ * The file holds a small header (descriptor, interleave and a caller chosen key, e.g. a hash of
+ * the checkpoint and the quantization settings) followed by the packed rows, the float scales
+ * and the int8 zero points, each 64-byte aligned. Loading validates the header and sizes and
+ * throws on a malformed file.
+ */
+class PackedInt4WeightFile
+{
+    public:
+    explicit PackedInt4WeightFile(const std::string& path);
+
+    PackedInt4WeightFile(PackedInt4WeightFile&&) noexcept = default;
+    PackedInt4WeightFile& operator=(PackedInt4WeightFile&&) noexcept = default;
+
+    // write the weight to path, through a temporary file renamed into place so that concurrent
+    // readers never see a partial file
+    static void
+    Save(const std::string& path, const PackedInt4WeightView& weight, std::uint64_t key);
+
+    const PackedInt4WeightView& GetView() const { return mView; }
+    std::uint64_t GetKey() const { return mKey; }
+
+    // whether the file was written for the given descriptor, interleave and key
+    bool Matches(const GroupQuantDesc& desc,
+                 const Int4Interleave& interleave,
+                 std::uint64_t key) const;
+
+    private:
+    MappedFile mFile;
+    PackedInt4WeightView mView;
+    std::uint64_t mKey = 0;
+};
+
+// The packed weight cached in path when the file matches desc, interleave and key; otherwise the
+// weight is packed from p_x, saved to path and mapped. A missing or malformed file is rebuilt.
+template <typename Scale = float, typename X>
+PackedInt4WeightFile
+load_or_pack_int4_weight(const std::string& path,
+                         std::uint64_t key,
+                         const X* p_x,
+                         const GroupQuantDesc& desc,
+                         const Int4Interleave& interleave = int4_interleave_identity,
+                         std::size_t num_thread           = get_host_num_thread())
+{
+    try
+    {
+        PackedInt4WeightFile file(path);
+
+        if(file.Matches(desc, interleave, key))
+        {
+            return file;
+        }
+    }
+    catch(const std::exception&)
+    {
+    }
+
+    PackedInt4WeightFile::Save(
+        path, pack_int4_weight<Scale>(p_x, desc, interleave, num_thread).GetView(), key);
+
+    return PackedInt4WeightFile(path);
+}
+
+} // namespace utils
+} // namespace ck
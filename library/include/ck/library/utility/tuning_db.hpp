@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ck {
+namespace utils {
+
+// What a tuning record applies to, data type and layout use the numbering of the ckProfiler
+// arguments of the operation
+struct TuningKey
+{
+    std::string arch;
+    std::string op;
+    std::string data_type;
+    std::string layout;
+
+    bool operator<(const TuningKey& other) const
+    {
+        return std::tie(arch, op, data_type, layout) <
+               std::tie(other.arch, other.op, other.data_type, other.layout);
+    }
+};
+
+struct TuningRecord
+{
+    TuningKey key;
+    // problem sizes, a non-positive extent (a default stride) matches any value
+    std::vector<std::int64_t> shape;
+    float ave_time = 0;
+    // GetTypeString() of the fastest instance, and its runtime parameters (e.g. "KBatch 4")
+    std::string instance;
+    std::string params;
+};
+
+/**
+ * @brief Fastest instance per (arch, op, data type, layout, shape)
+ *
+ * Filled from profiler results, see the tuning_db operation of ckProfiler, and kept as a text
+ * file with one tab separated record per line. A lookup returns the records of the key ordered
+ * by their shape distance to the problem, an exact match first, so that a caller can fall back
+ * to the instance of the nearest tuned shape.
+ */
+class TuningDb
+{
+    public:
+    TuningDb() = default;
+    explicit TuningDb(const std::string& path) { Load(path); }
+
+    // The database named by the CK_TUNING_DB environment variable, empty if it is not set or the
+    // file does not exist
+    static const TuningDb& GetDefault();
+
+    // Keep the faster record of the same key and shape, returns true if the record was taken
+    bool Add(const TuningRecord& record);
+
+    std::vector<const TuningRecord*> Lookup(const TuningKey& key,
+                                            const std::vector<std::int64_t>& shape) const;
+
+    const TuningRecord* Find(const TuningKey& key, const std::vector<std::int64_t>& shape) const
+    {
+        const auto records = Lookup(key, shape);
+        return records.empty() ? nullptr : records.front();
+    }
+
+    std::size_t GetRecordCount() const;
+
+    // Records are added to the current ones, a missing file is an error
+    void Load(const std::string& path);
+    void Load(std::istream& is, const std::string& name = "tuning db");
+    void Save(const std::string& path) const;
+    void Save(std::ostream& os) const;
+
+    // Euclidean distance of the log2 extents, negative for shapes of different rank
+    static double GetShapeDistance(const std::vector<std::int64_t>& a,
+                                   const std::vector<std::int64_t>& b);
+
+    private:
+    std::map<TuningKey, std::vector<TuningRecord>> mRecords;
+};
+
+} // namespace utils
+} // namespace ck
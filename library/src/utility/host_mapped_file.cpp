@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ck/library/utility/host_mapped_file.hpp"
+
+namespace ck {
+namespace utils {
+
+#ifndef _WIN32
+MappedFile::MappedFile(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if(::fstat(fd, &st) != 0)
+    {
+        const int err = errno;
+        ::close(fd);
+        throw std::runtime_error("cannot stat " + path + ": " + std::strerror(err));
+    }
+
+    mSize = static_cast<std::size_t>(st.st_size);
+
+    // mmap refuses empty mappings, an empty file is just an empty view
+    if(mSize > 0)
+    {
+        void* p = ::mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+        if(p == MAP_FAILED)
+        {
+            const int err = errno;
+            ::close(fd);
+            throw std::runtime_error("cannot map " + path + ": " + std::strerror(err));
+        }
+        mpBuf   = p;
+        mMapped = true;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+void MappedFile::AdviseRandomAccess() const
+{
+    if(mMapped)
+    {
+        ::madvise(const_cast<void*>(mpBuf), mSize, MADV_RANDOM);
+    }
+}
+
+void MappedFile::AdviseSequentialAccess() const
+{
+    if(mMapped)
+    {
+        ::madvise(const_cast<void*>(mpBuf), mSize, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedFile::ReleasePages(std::size_t byte_offset, std::size_t size) const
+{
+    if(!mMapped || byte_offset >= mSize)
+    {
+        return;
+    }
+
+    // the mapping starts on a page boundary, only pages fully inside the range are dropped
+    const std::size_t page  = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t begin = (byte_offset + page - 1) / page * page;
+    const std::size_t end   = std::min(byte_offset + size, mSize) / page * page;
+
+    if(begin < end)
+    {
+        ::madvise(static_cast<char*>(const_cast<void*>(mpBuf)) + begin, end - begin, MADV_DONTNEED);
+    }
+}
+
+void MappedFile::Release() noexcept
+{
+    if(mMapped)
+    {
+        ::munmap(const_cast<void*>(mpBuf), mSize);
+    }
+    mpBuf   = nullptr;
+    mSize   = 0;
+    mMapped = false;
+    mFallback.clear();
+}
+#else
+MappedFile::MappedFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file)
+    {
+        throw std::runtime_error("cannot open " + path);
+    }
+
+    mFallback.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    if(!file.read(mFallback.data(), static_cast<std::streamsize>(mFallback.size())))
+    {
+        throw std::runtime_error("cannot read " + path);
+    }
+
+    mpBuf = mFallback.data();
+    mSize = mFallback.size();
+}
+
+void MappedFile::AdviseRandomAccess() const {}
+
+void MappedFile::AdviseSequentialAccess() const {}
+
+void MappedFile::ReleasePages(std::size_t, std::size_t) const {}
+
+void MappedFile::Release() noexcept
+{
+    mpBuf = nullptr;
+    mSize = 0;
+    mFallback.clear();
+}
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mpBuf(std::exchange(other.mpBuf, nullptr)),
+      mSize(std::exchange(other.mSize, 0)),
+      mMapped(std::exchange(other.mMapped, false)),
+      mFallback(std::move(other.mFallback))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if(this != &other)
+    {
+        Release();
+        mpBuf     = std::exchange(other.mpBuf, nullptr);
+        mSize     = std::exchange(other.mSize, 0);
+        mMapped   = std::exchange(other.mMapped, false);
+        mFallback = std::move(other.mFallback);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { Release(); }
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include "ck/utility/env.hpp"
+#include "ck/library/utility/host_mapped_file.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
+
+CK_DECLARE_ENV_VAR_STR(CK_REFERENCE_CACHE_DIR)
+CK_DECLARE_ENV_VAR_UINT64(CK_REFERENCE_CACHE_MAX_MB)
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr std::uint64_t prime1 = 11400714785074694791ULL;
+constexpr std::uint64_t prime2 = 14029467366897019727ULL;
+constexpr std::uint64_t prime3 = 1609587929392839161ULL;
+constexpr std::uint64_t prime4 = 9650029242287828579ULL;
+constexpr std::uint64_t prime5 = 2870177450012600261ULL;
+
+constexpr std::size_t hash_block_size = std::size_t{1} << 20;
+
+std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+std::uint64_t read_u64(const unsigned char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint64_t hash_round(std::uint64_t acc, std::uint64_t v)
+{
+    return rotl(acc + v * prime2, 31) * prime1;
+}
+
+std::uint64_t avalanche(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+// xxHash64 style hash of one block: four lanes over 32-byte stripes, then the tail
+std::uint64_t hash_block(const unsigned char* p, std::size_t size, std::uint64_t seed)
+{
+    std::uint64_t v1 = seed + prime1 + prime2;
+    std::uint64_t v2 = seed + prime2;
+    std::uint64_t v3 = seed;
+    std::uint64_t v4 = seed - prime1;
+
+    std::size_t i = 0;
+    for(; i + 32 <= size; i += 32)
+    {
+        v1 = hash_round(v1, read_u64(p + i));
+        v2 = hash_round(v2, read_u64(p + i + 8));
+        v3 = hash_round(v3, read_u64(p + i + 16));
+        v4 = hash_round(v4, read_u64(p + i + 24));
+    }
+
+    std::uint64_t h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18) + size;
+
+    for(; i + 8 <= size; i += 8)
+        h = rotl(h ^ hash_round(0, read_u64(p + i)), 27) * prime1 + prime4;
+
+    for(; i < size; ++i)
+        h = rotl(h ^ (p[i] * prime5), 11) * prime1;
+
+    return avalanche(h);
+}
+
+constexpr char entry_magic[8]       = "CKREF01";
+constexpr char entry_extension[]    = ".ckref";
+constexpr std::uint64_t entry_align = 64;
+
+struct EntryHeader
+{
+    char magic[8];
+    std::uint64_t description_size;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+};
+
+std::uint64_t get_data_offset(std::uint64_t description_size)
+{
+    return (sizeof(EntryHeader) + description_size + entry_align - 1) / entry_align * entry_align;
+}
+
+std::string get_entry_path(const std::string& dir, const ReferenceCacheKey& key)
+{
+    return (fs::path(dir) / (key.GetDigest() + entry_extension)).string();
+}
+
+} // namespace
+
+std::uint64_t
+hash_bytes(const void* p, std::size_t size, std::uint64_t seed, std::size_t num_thread)
+{
+    const auto* bytes           = static_cast<const unsigned char*>(p);
+    const std::size_t num_block = (size + hash_block_size - 1) / hash_block_size;
+
+    std::vector<std::uint64_t> block_hash(num_block);
+
+    parallel_for(
+        num_block,
+        [&](std::size_t begin, std::size_t end) {
+            for(std::size_t b = begin; b < end; ++b)
+            {
+                const std::size_t offset = b * hash_block_size;
+                block_hash[b] =
+                    hash_block(bytes + offset, std::min(hash_block_size, size - offset), seed);
+            }
+        },
+        num_thread,
+        1,
+        1);
+
+    // chain the block hashes in order
+    std::uint64_t h = avalanche(seed ^ (size * prime5));
+    for(std::uint64_t bh : block_hash)
+        h = avalanche(hash_round(h, bh));
+
+    return h;
+}
+
+ReferenceCacheKey& ReferenceCacheKey::AddDescriptor(const HostTensorDescriptor& desc)
+{
+    std::string text = "[";
+    for(std::size_t len : desc.GetLengths())
+        text += std::to_string(len) + ",";
+    text += "][";
+    for(std::size_t stride : desc.GetStrides())
+        text += std::to_string(stride) + ",";
+    text += "]";
+
+    return Add(text);
+}
+
+std::string ReferenceCacheKey::GetDigest() const
+{
+    const std::uint64_t h[2] = {hash_bytes(mDescription.data(), mDescription.size(), 0),
+                                hash_bytes(mDescription.data(), mDescription.size(), prime4)};
+
+    char digest[33];
+    std::snprintf(digest,
+                  sizeof(digest),
+                  "%016llx%016llx",
+                  static_cast<unsigned long long>(h[0]),
+                  static_cast<unsigned long long>(h[1]));
+
+    return digest;
+}
+
+ReferenceCache::ReferenceCache(std::string dir, std::uint64_t max_size)
+    : mDir(std::move(dir)), mMaxSize(max_size)
+{
+    if(!mDir.empty())
+    {
+        std::error_code ec;
+        fs::create_directories(mDir, ec);
+
+        if(ec)
+        {
+            throw std::runtime_error("cannot create reference cache directory " + mDir + ": " +
+                                     ec.message());
+        }
+    }
+}
+
+ReferenceCache& ReferenceCache::GetDefault()
+{
+    static ReferenceCache cache = [] {
+        const std::uint64_t max_mb = EnvIsUnset(CK_ENV(CK_REFERENCE_CACHE_MAX_MB))
+                                         ? 4096
+                                         : EnvValue(CK_ENV(CK_REFERENCE_CACHE_MAX_MB));
+
+        return ReferenceCache(EnvGetString(CK_ENV(CK_REFERENCE_CACHE_DIR)), max_mb << 20);
+    }();
+
+    return cache;
+}
+
+bool ReferenceCache::Load(const ReferenceCacheKey& key, void* p_out, std::size_t size) const
+{
+    if(!IsEnabled())
+    {
+        return false;
+    }
+
+    const std::string path         = get_entry_path(mDir, key);
+    const std::string& description = key.GetDescription();
+
+    std::error_code ec;
+    if(!fs::exists(path, ec))
+    {
+        return false;
+    }
+
+    try
+    {
+        const MappedFile file(path);
+
+        EntryHeader header;
+        if(file.GetBufferSize() < sizeof(header))
+        {
+            return false;
+        }
+
+        std::memcpy(&header, file.GetBuffer(), sizeof(header));
+
+        const auto* p_file = static_cast<const char*>(file.GetBuffer());
+
+        if(std::memcmp(header.magic, entry_magic, sizeof(header.magic)) != 0 ||
+           header.description_size != description.size() ||
+           header.data_offset != get_data_offset(header.description_size) ||
+           header.data_size != size || header.data_offset + size != file.GetBufferSize() ||
+           description.compare(0,
+                               description.size(),
+                               p_file + sizeof(header),
+                               static_cast<std::size_t>(header.description_size)) != 0)
+        {
+            return false;
+        }
+
+        file.AdviseSequentialAccess();
+        std::memcpy(p_out, p_file + header.data_offset, size);
+    }
+    catch(const std::runtime_error&)
+    {
+        // evicted by another process in between, or unreadable
+        return false;
+    }
+
+    // most recently used
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    return true;
+}
+
+void ReferenceCache::Store(const ReferenceCacheKey& key, const void* p, std::size_t size) const
+{
+    if(!IsEnabled())
+    {
+        return;
+    }
+
+    const std::string& description = key.GetDescription();
+    const std::string path          = get_entry_path(mDir, key);
+    const std::string tmp_path      = path + ".tmp" + std::to_string(std::random_device{}());
+
+    EntryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, entry_magic, sizeof(header.magic));
+    header.description_size = description.size();
+    header.data_offset      = get_data_offset(description.size());
+    header.data_size        = size;
+
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+
+        const std::vector<char> padding(header.data_offset - sizeof(header) - description.size());
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(description.data(), static_cast<std::streamsize>(description.size()));
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(static_cast<const char*>(p), static_cast<std::streamsize>(size));
+
+        if(!out.flush())
+        {
+            // a full disk or a read-only directory only costs the recomputation next time
+            out.close();
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmp_path, path, ec);
+    if(ec)
+    {
+        fs::remove(tmp_path, ec);
+        return;
+    }
+
+    Evict();
+}
+
+std::uint64_t ReferenceCache::GetSize() const
+{
+    std::uint64_t total = 0;
+
+    std::error_code ec;
+    for(const auto& entry : fs::directory_iterator(mDir, ec))
+    {
+        if(entry.path().extension() == entry_extension)
+        {
+            total += entry.file_size(ec);
+        }
+    }
+
+    return total;
+}
+
+void ReferenceCache::Evict() const
+{
+    struct Entry
+    {
+        fs::path path;
+        fs::file_time_type time;
+        std::uint64_t size;
+    };
+
+    std::vector<Entry> entries;
+    std::uint64_t total = 0;
+
+    std::error_code ec;
+    for(const auto& entry : fs::directory_iterator(mDir, ec))
+    {
+        if(entry.path().extension() != entry_extension)
+        {
+            continue;
+        }
+
+        const std::uint64_t size = entry.file_size(ec);
+        const auto time          = entry.last_write_time(ec);
+        if(!ec)
+        {
+            entries.push_back({entry.path(), time, size});
+            total += size;
+        }
+    }
+
+    if(total <= mMaxSize)
+    {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.time < b.time;
+    });
+
+    for(const auto& entry : entries)
+    {
+        if(total <= mMaxSize)
+        {
+            break;
+        }
+
+        // removing an entry another process is reading is fine, its mapping stays valid
+        fs::remove(entry.path, ec);
+        total -= entry.size;
+    }
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "ck/library/utility/host_weight_quantization.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+constexpr char packed_int4_magic[8]       = "CKINT4W";
+constexpr std::uint32_t packed_int4_version = 1;
+constexpr std::uint64_t packed_int4_align   = 64;
+
+struct PackedInt4WeightFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t scheme;
+    std::uint64_t num_row;
+    std::uint64_t row_length;
+    std::uint64_t group_size;
+    std::uint64_t key;
+    std::uint8_t interleave[8];
+    std::uint64_t data_offset;
+    std::uint64_t scale_offset;
+    std::uint64_t zero_offset;
+    std::uint64_t file_size;
+};
+
+std::uint64_t align_up(std::uint64_t x)
+{
+    return (x + packed_int4_align - 1) / packed_int4_align * packed_int4_align;
+}
+
+// byte offsets of the sections for desc, in the header fields
+void set_layout(PackedInt4WeightFileHeader& header, const GroupQuantDesc& desc)
+{
+    const std::uint64_t data_size = desc.num_row * desc.row_length / 2;
+    const std::uint64_t num_group = desc.GetGroupCount();
+
+    header.data_offset  = align_up(sizeof(PackedInt4WeightFileHeader));
+    header.scale_offset = align_up(header.data_offset + data_size);
+    header.zero_offset  = align_up(header.scale_offset + num_group * sizeof(float));
+    header.file_size    = header.zero_offset + num_group * sizeof(std::int8_t);
+}
+
+void write_at(std::ofstream& out, std::uint64_t offset, const void* p, std::size_t size)
+{
+    out.seekp(static_cast<std::streamoff>(offset));
+    out.write(static_cast<const char*>(p), static_cast<std::streamsize>(size));
+}
+
+} // namespace
+
+PackedInt4WeightFile::PackedInt4WeightFile(const std::string& path) : mFile(path)
+{
+    PackedInt4WeightFileHeader header;
+
+    if(mFile.GetBufferSize() < sizeof(header))
+    {
+        throw std::runtime_error("wrong! " + path + " is not a packed int4 weight");
+    }
+
+    std::memcpy(&header, mFile.GetBuffer(), sizeof(header));
+
+    if(std::memcmp(header.magic, packed_int4_magic, sizeof(header.magic)) != 0 ||
+       header.version != packed_int4_version ||
+       header.scheme > static_cast<std::uint32_t>(QuantScheme::Asymmetric))
+    {
+        throw std::runtime_error("wrong! " + path + " is not a packed int4 weight");
+    }
+
+    GroupQuantDesc desc;
+    desc.num_row    = header.num_row;
+    desc.row_length = header.row_length;
+    desc.group_size = header.group_size;
+    desc.num_bit    = 4;
+    desc.scheme     = static_cast<QuantScheme>(header.scheme);
+
+    Int4Interleave interleave;
+    std::memcpy(interleave.data(), header.interleave, interleave.size());
+
+    for(std::uint8_t j : interleave)
+    {
+        if(j >= interleave.size())
+        {
+            throw std::runtime_error("wrong! bad interleave in " + path);
+        }
+    }
+
+    detail::check_int4_weight_desc(desc, interleave);
+
+    PackedInt4WeightFileHeader expected = header;
+    set_layout(expected, desc);
+
+    if(std::memcmp(&expected, &header, sizeof(header)) != 0 ||
+       header.file_size != mFile.GetBufferSize())
+    {
+        throw std::runtime_error("wrong! " + path + " is truncated or has a bad layout");
+    }
+
+    mView = {desc,
+             interleave,
+             mFile.GetData<std::uint8_t>(header.data_offset),
+             mFile.GetData<float>(header.scale_offset),
+             mFile.GetData<std::int8_t>(header.zero_offset)};
+    mKey  = header.key;
+}
+
+void PackedInt4WeightFile::Save(const std::string& path,
+                                const PackedInt4WeightView& weight,
+                                std::uint64_t key)
+{
+    const GroupQuantDesc& desc = weight.desc;
+
+    detail::check_int4_weight_desc(desc, weight.interleave);
+
+    // zero the whole header, padding included, so that files compare equal byte for byte
+    PackedInt4WeightFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, packed_int4_magic, sizeof(header.magic));
+    header.version    = packed_int4_version;
+    header.scheme     = static_cast<std::uint32_t>(desc.scheme);
+    header.num_row    = desc.num_row;
+    header.row_length = desc.row_length;
+    header.group_size = desc.group_size;
+    header.key        = key;
+    std::memcpy(header.interleave, weight.interleave.data(), sizeof(header.interleave));
+    set_layout(header, desc);
+
+    const std::string tmp_path = path + ".tmp";
+
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+
+        write_at(out, 0, &header, sizeof(header));
+        write_at(out, header.data_offset, weight.p_data, desc.num_row * desc.row_length / 2);
+        write_at(out, header.scale_offset, weight.p_scale, desc.GetGroupCount() * sizeof(float));
+        write_at(out, header.zero_offset, weight.p_zero, desc.GetGroupCount());
+
+        // empty sections do not extend the file, the end of an empty weight is padding
+        out.seekp(0, std::ios::end);
+        if(static_cast<std::uint64_t>(out.tellp()) < header.file_size)
+        {
+            write_at(out, header.file_size - 1, "", 1);
+        }
+
+        if(!out.flush())
+        {
+            throw std::runtime_error("cannot write " + tmp_path);
+        }
+    }
+
+    if(std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("cannot rename " + tmp_path + " to " + path);
+    }
+}
+
+bool PackedInt4WeightFile::Matches(const GroupQuantDesc& desc,
+                                   const Int4Interleave& interleave,
+                                   std::uint64_t key) const
+{
+    return mKey == key && mView.interleave == interleave && mView.desc.num_bit == desc.num_bit &&
+           mView.desc.scheme == desc.scheme && mView.desc.num_row == desc.num_row &&
+           mView.desc.row_length == desc.row_length && mView.desc.group_size == desc.group_size;
+}
+
+} // namespace utils
+} // namespace ck
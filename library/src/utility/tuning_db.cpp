@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+#include "ck/utility/env.hpp"
+#include "ck/library/utility/tuning_db.hpp"
+
+CK_DECLARE_ENV_VAR_STR(CK_TUNING_DB)
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+constexpr std::size_t num_field = 8;
+
+std::vector<std::string> split_fields(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::size_t begin = 0;
+    for(std::size_t end; (end = line.find('\t', begin)) != std::string::npos; begin = end + 1)
+    {
+        fields.push_back(line.substr(begin, end - begin));
+    }
+    fields.push_back(line.substr(begin));
+
+    return fields;
+}
+
+std::string shape_to_string(const std::vector<std::int64_t>& shape)
+{
+    std::string s;
+    for(auto x : shape)
+    {
+        s += (s.empty() ? "" : " ") + std::to_string(x);
+    }
+
+    return s;
+}
+
+} // namespace
+
+const TuningDb& TuningDb::GetDefault()
+{
+    static const TuningDb db = [] {
+        const std::string& path = EnvGetString(CK_ENV(CK_TUNING_DB));
+
+        std::error_code ec;
+        return path.empty() || !std::filesystem::exists(path, ec) ? TuningDb() : TuningDb(path);
+    }();
+
+    return db;
+}
+
+bool TuningDb::Add(const TuningRecord& record)
+{
+    auto& records = mRecords[record.key];
+
+    const auto same = std::find_if(records.begin(), records.end(), [&](const TuningRecord& r) {
+        return r.shape == record.shape;
+    });
+
+    if(same == records.end())
+    {
+        records.push_back(record);
+        return true;
+    }
+    if(record.ave_time < same->ave_time)
+    {
+        *same = record;
+        return true;
+    }
+
+    return false;
+}
+
+std::vector<const TuningRecord*> TuningDb::Lookup(const TuningKey& key,
+                                                  const std::vector<std::int64_t>& shape) const
+{
+    std::vector<std::pair<double, const TuningRecord*>> found;
+
+    const auto records = mRecords.find(key);
+    if(records != mRecords.end())
+    {
+        for(const auto& r : records->second)
+        {
+            const double distance = GetShapeDistance(r.shape, shape);
+            if(distance >= 0)
+            {
+                found.emplace_back(distance, &r);
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.first, a.second->ave_time) < std::tie(b.first, b.second->ave_time);
+    });
+
+    std::vector<const TuningRecord*> result;
+    for(const auto& f : found)
+    {
+        result.push_back(f.second);
+    }
+
+    return result;
+}
+
+std::size_t TuningDb::GetRecordCount() const
+{
+    std::size_t count = 0;
+    for(const auto& records : mRecords)
+    {
+        count += records.second.size();
+    }
+
+    return count;
+}
+
+double TuningDb::GetShapeDistance(const std::vector<std::int64_t>& a,
+                                  const std::vector<std::int64_t>& b)
+{
+    if(a.size() != b.size())
+    {
+        return -1;
+    }
+
+    double sum = 0;
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+        if(a[i] > 0 && b[i] > 0)
+        {
+            const double d =
+                std::log2(static_cast<double>(a[i])) - std::log2(static_cast<double>(b[i]));
+            sum += d * d;
+        }
+    }
+
+    return std::sqrt(sum);
+}
+
+void TuningDb::Load(const std::string& path)
+{
+    std::ifstream is(path);
+    if(!is)
+    {
+        throw std::runtime_error("cannot open tuning db " + path);
+    }
+
+    Load(is, path);
+}
+
+void TuningDb::Load(std::istream& is, const std::string& name)
+{
+    std::string line;
+    for(int line_no = 1; std::getline(is, line); ++line_no)
+    {
+        if(!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        const auto fields = split_fields(line);
+
+        TuningRecord record;
+        bool ok = fields.size() == num_field;
+        if(ok)
+        {
+            record.key      = {fields[0], fields[1], fields[2], fields[3]};
+            record.instance = fields[6];
+            record.params   = fields[7];
+
+            std::istringstream shape(fields[4]);
+            for(std::int64_t x; shape >> x;)
+            {
+                record.shape.push_back(x);
+            }
+
+            std::istringstream time(fields[5]);
+            ok = shape.eof() && (time >> record.ave_time) && !record.instance.empty();
+        }
+
+        if(!ok)
+        {
+            throw std::runtime_error("wrong! " + name + ":" + std::to_string(line_no) +
+                                     ": not a tuning db record");
+        }
+
+        Add(record);
+    }
+}
+
+void TuningDb::Save(const std::string& path) const
+{
+    std::ofstream os(path);
+    if(!os)
+    {
+        throw std::runtime_error("cannot open tuning db " + path);
+    }
+
+    Save(os);
+
+    if(!os.flush())
+    {
+        throw std::runtime_error("cannot write tuning db " + path);
+    }
+}
+
+void TuningDb::Save(std::ostream& os) const
+{
+    os << "# arch\top\tdata type\tlayout\tshape\tave_time_ms\tinstance\tparams\n";
+    os.precision(std::numeric_limits<float>::max_digits10);
+
+    for(const auto& [key, records] : mRecords)
+    {
+        std::vector<const TuningRecord*> sorted;
+        for(const auto& r : records)
+        {
+            sorted.push_back(&r);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) { return a->shape < b->shape; });
+
+        for(const auto* r : sorted)
+        {
+            os << key.arch << '\t' << key.op << '\t' << key.data_type << '\t' << key.layout << '\t'
+               << shape_to_string(r->shape) << '\t' << r->ave_time << '\t' << r->instance << '\t'
+               << r->params << '\n';
+        }
+    }
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,541 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ck {
+namespace profiler {
+
+// Tile parameters of a GEMM instance, as printed by its GetTypeString()
+struct GemmTileParams
+{
+    std::string kernel;
+    // the kernels that do not print their specialization pad or check by themselves
+    std::string specialization = "MNKPadding";
+    int block_size             = 0;
+    int m_per_block            = 0;
+    int n_per_block            = 0;
+    int k_per_block            = 0;
+    int k1                     = 0;
+    // XDL, WMMA or DPP instruction tile and the repeats of it per wave, 0 for DL
+    int m_per_inst = 0;
+    int n_per_inst = 0;
+    int m_repeat   = 0;
+    int n_repeat   = 0;
+    // LDS buffers of the A and B tiles, 2 for the double buffered pipelines
+    int lds_buffers = 1;
+};
+
+namespace detail {
+
+inline std::vector<std::string> split_type_string(const std::string& s, const std::string& sep)
+{
+    std::vector<std::string> tokens;
+    std::size_t begin = 0;
+    for(std::size_t end; (end = s.find(sep, begin)) != std::string::npos; begin = end + sep.size())
+        tokens.push_back(s.substr(begin, end - begin));
+    tokens.push_back(s.substr(begin));
+    return tokens;
+}
+
+// "Name: value" of the text after the template arguments
+inline std::string get_type_string_field(const std::string& s, const std::string& name)
+{
+    const std::size_t pos = s.find(name + ": ");
+    if(pos == std::string::npos)
+    {
+        return "";
+    }
+
+    const std::size_t begin = pos + name.size() + 2;
+    return s.substr(begin, s.find(',', begin) - begin);
+}
+
+} // namespace detail
+
+inline std::optional<GemmTileParams> parse_gemm_tile_params(const std::string& type_string)
+{
+    const std::size_t open  = type_string.find('<');
+    const std::size_t close = type_string.find('>', open);
+    if(open == std::string::npos || close == std::string::npos)
+    {
+        return std::nullopt;
+    }
+
+    GemmTileParams p;
+    p.kernel = type_string.substr(0, open);
+
+    std::vector<std::string> args =
+        detail::split_type_string(type_string.substr(open + 1, close - open - 1), ", ");
+    const std::string rest = type_string.substr(close + 1);
+
+    std::vector<int> v;
+    try
+    {
+        if(p.kernel == "DeviceGemmXdlUniversal")
+        {
+            // <Spec, layouts> BlkSize: 256, BlkTile: 256x128x64, WaveTile: 32x32, WaveMap: 4x2
+            p.specialization = args[0];
+            for(const char* name : {"BlkSize", "BlkTile", "WaveTile", "WaveMap"})
+            {
+                for(const auto& x : detail::split_type_string(
+                        detail::get_type_string_field(rest, name), "x"))
+                    v.push_back(std::stoi(x));
+            }
+            if(v.size() != 8)
+            {
+                return std::nullopt;
+            }
+
+            // K1 is not printed
+            v.insert(v.begin() + 4, 0);
+            p.lds_buffers =
+                detail::get_type_string_field(rest, "BlkGemmPipelineVersion") == "v4" ? 2 : 1;
+        }
+        else
+        {
+            // the specialization is printed first, or last by the LDS direct load kernel
+            auto is_name = [](const std::string& x) {
+                return !x.empty() && !std::isdigit(static_cast<unsigned char>(x[0]));
+            };
+            if(!args.empty() && is_name(args.front()))
+            {
+                p.specialization = args.front();
+                args.erase(args.begin());
+            }
+            else if(!args.empty() && is_name(args.back()))
+            {
+                p.specialization = args.back();
+                args.pop_back();
+            }
+            for(const auto& x : args)
+                v.push_back(std::stoi(x));
+        }
+    }
+    catch(const std::logic_error&)
+    {
+        return std::nullopt;
+    }
+
+    // <BlockSize, MPerBlock, NPerBlock, KPerBlock (or K0PerBlock), K1, instruction and repeat>
+    if(v.size() < 5)
+    {
+        return std::nullopt;
+    }
+
+    p.block_size  = v[0];
+    p.m_per_block = v[1];
+    p.n_per_block = v[2];
+    p.k_per_block = v[3];
+    p.k1          = v[4];
+
+    if(p.kernel == "DeviceGemmXdl" || p.kernel == "DeviceGemmDl")
+    {
+        p.k_per_block *= p.k1;
+    }
+
+    // the CShuffle and DPP kernels print AK1 and BK1
+    const bool ak1_bk1 = p.kernel == "DeviceGemm_Xdl_CShuffle" ||
+                         p.kernel == "DeviceGemm_Xdl_CShuffleV2" ||
+                         p.kernel == "DeviceGemm_Xdl_CShuffle_LdsDirectLoad" ||
+                         p.kernel == "DeviceGemmDpp";
+    const std::size_t inst = ak1_bk1 ? 6 : 5;
+    if(p.kernel != "DeviceGemmDl" && v.size() >= inst + 4)
+    {
+        p.m_per_inst = v[inst];
+        p.n_per_inst = v[inst + 1];
+        p.m_repeat   = v[inst + 2];
+        p.n_repeat   = v[inst + 3];
+    }
+
+    if(p.block_size <= 0 || p.m_per_block <= 0 || p.n_per_block <= 0 || p.k_per_block <= 0)
+    {
+        return std::nullopt;
+    }
+
+    return p;
+}
+
+/**
+ * @brief Cost terms of running an instance on a problem
+ *
+ * compute: GFLOP executed by the busiest CU, the padded tiles of every wave of workgroups, so it
+ *          includes the wave quantization and the padding waste
+ * memory:  GB read from and written to global memory, the A and B tiles are read once per
+ *          workgroup, so it falls with the arithmetic intensity of the tile
+ * loop:    thousands of main loop iterations on the critical path, the fixed cost per iteration
+ *          of the pipeline and its LDS synchronization
+ */
+struct GemmCostFeatures
+{
+    std::array<double, 4> terms{}; // launch (1), compute, memory, loop
+
+    bool supported = true; // false if the specialization cannot pad the problem
+
+    // not part of the model, for reports
+    double wave_efficiency      = 0; // busy workgroup slots over all slots of the waves
+    double padding_waste        = 0; // padded over actual flops, minus 1
+    double arithmetic_intensity = 0; // flop per byte of A and B tile loaded
+    double lds_bytes            = 0; // A and B tiles in LDS per workgroup
+};
+
+inline GemmCostFeatures get_gemm_cost_features(const GemmTileParams& p,
+                                               std::int64_t M,
+                                               std::int64_t N,
+                                               std::int64_t K,
+                                               int elem_bytes,
+                                               int num_cu,
+                                               int k_batch = 1)
+{
+    GemmCostFeatures f;
+
+    // "MNKPadding" pads M, N and K, "Default" none of them
+    const std::string padding = p.specialization.substr(0, p.specialization.find("Padding"));
+
+    auto pads = [&](char dim) { return padding.find(dim) != std::string::npos; };
+
+    k_batch                = std::max(k_batch, 1);
+    const std::int64_t k_b = (K + k_batch - 1) / k_batch;
+
+    f.supported = (pads('M') || M % p.m_per_block == 0) &&
+                  (pads('N') || N % p.n_per_block == 0) && (pads('K') || k_b % p.k_per_block == 0);
+
+    auto ceil_div = [](std::int64_t a, std::int64_t b) { return (a + b - 1) / b; };
+
+    const double lds_bytes =
+        double(p.m_per_block + p.n_per_block) * p.k_per_block * elem_bytes * p.lds_buffers;
+    // 64 KiB of LDS per CU, and at most two workgroups of a CK kernel resident per CU
+    const std::int64_t occupancy =
+        std::clamp<std::int64_t>(static_cast<std::int64_t>(65536 / lds_bytes), 1, 2);
+
+    const std::int64_t tiles = ceil_div(M, p.m_per_block) * ceil_div(N, p.n_per_block) * k_batch;
+    const std::int64_t slots = std::max<std::int64_t>(num_cu, 1) * occupancy;
+    const std::int64_t waves = ceil_div(tiles, slots);
+    const std::int64_t loops = ceil_div(k_b, p.k_per_block);
+    const double k_pad       = double(loops) * p.k_per_block;
+
+    const double tile_flop = 2. * p.m_per_block * p.n_per_block * k_pad;
+
+    f.terms[0] = 1;
+    f.terms[1] = double(waves) * occupancy * tile_flop / 1e9;
+    f.terms[2] =
+        (double(tiles) * k_pad * (p.m_per_block + p.n_per_block) + double(M) * N) * elem_bytes /
+        1e9;
+    f.terms[3] = double(waves) * loops / 1e3;
+
+    f.wave_efficiency      = double(tiles) / double(waves * slots);
+    f.padding_waste        = double(tiles) * tile_flop / (2. * M * N * K) - 1;
+    f.arithmetic_intensity = tile_flop / (k_pad * (p.m_per_block + p.n_per_block) * elem_bytes);
+    f.lds_bytes            = lds_bytes;
+
+    return f;
+}
+
+// A measured time, in ms, of an instance on a problem
+struct GemmCostSample
+{
+    GemmCostFeatures features;
+    double time = 0;
+};
+
+/**
+ * @brief Predicted time, in ms, of an instance on a problem, a weighted sum of the cost terms
+ *
+ * The default weights are of the order of an MI200/MI300 class GPU running fp16: 5 us launch,
+ * ~4 TFlops per CU, ~5 TB/s and 0.5 us per main loop iteration. Fit() calibrates them to
+ * measured times, by non-negative least squares of the relative error.
+ */
+struct GemmCostModel
+{
+    std::array<double, 4> weights{0.005, 0.25, 0.2, 0.5};
+
+    double Predict(const GemmCostFeatures& f) const
+    {
+        if(!f.supported)
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        return std::inner_product(weights.begin(), weights.end(), f.terms.begin(), 0.);
+    }
+
+    static GemmCostModel Fit(const std::vector<GemmCostSample>& samples)
+    {
+        constexpr std::size_t n = 4;
+
+        // normal equations of sum_i (w . f_i / t_i - 1)^2
+        std::array<std::array<double, n>, n> a{};
+        std::array<double, n> b{};
+        for(const auto& sample : samples)
+        {
+            if(!sample.features.supported || !(sample.time > 0))
+                continue;
+            for(std::size_t r = 0; r < n; ++r)
+            {
+                const double fr = sample.features.terms[r] / sample.time;
+                b[r] += fr;
+                for(std::size_t c = 0; c < n; ++c)
+                    a[r][c] += fr * sample.features.terms[c] / sample.time;
+            }
+        }
+
+        // active set: solve for the free weights, pin the most negative one to 0 and repeat
+        std::array<bool, n> active;
+        active.fill(true);
+
+        GemmCostModel model;
+        for(std::size_t iter = 0; iter < n; ++iter)
+        {
+            std::array<std::array<double, n + 1>, n> m{};
+            for(std::size_t r = 0; r < n; ++r)
+            {
+                for(std::size_t c = 0; c < n; ++c)
+                    m[r][c] = active[r] && active[c] ? a[r][c] : double(r == c);
+                m[r][n] = active[r] ? b[r] : 0;
+            }
+
+            // Gauss-Jordan with partial pivoting, a singular column gets weight 0
+            for(std::size_t c = 0; c < n; ++c)
+            {
+                std::size_t pivot = c;
+                for(std::size_t r = c + 1; r < n; ++r)
+                    if(std::abs(m[r][c]) > std::abs(m[pivot][c]))
+                        pivot = r;
+                std::swap(m[c], m[pivot]);
+
+                if(std::abs(m[c][c]) < 1e-12)
+                {
+                    m[c].fill(0);
+                    m[c][c] = 1;
+                    continue;
+                }
+                for(std::size_t r = 0; r < n; ++r)
+                {
+                    if(r == c)
+                        continue;
+                    const double s = m[r][c] / m[c][c];
+                    for(std::size_t k = c; k <= n; ++k)
+                        m[r][k] -= s * m[c][k];
+                }
+            }
+
+            std::size_t most_negative = n;
+            for(std::size_t r = 0; r < n; ++r)
+            {
+                model.weights[r] = active[r] ? m[r][n] / m[r][r] : 0;
+                if(model.weights[r] < 0 &&
+                   (most_negative == n || model.weights[r] < model.weights[most_negative]))
+                    most_negative = r;
+            }
+
+            if(most_negative == n)
+                break;
+
+            active[most_negative]        = false;
+            model.weights[most_negative] = 0;
+        }
+
+        for(auto& w : model.weights)
+            w = std::max(w, 0.);
+
+        return model;
+    }
+
+    void Load(const std::string& path)
+    {
+        std::ifstream is(path);
+        if(!is)
+        {
+            throw std::runtime_error("cannot open cost model " + path);
+        }
+
+        std::string line;
+        while(std::getline(is, line) && (line.empty() || line[0] == '#'))
+        {
+        }
+
+        std::istringstream ss(line);
+        for(auto& w : weights)
+        {
+            if(!(ss >> w))
+            {
+                throw std::runtime_error("wrong! " + path + ": not a cost model");
+            }
+        }
+    }
+
+    void Save(const std::string& path) const
+    {
+        std::ofstream os(path);
+        os.precision(std::numeric_limits<double>::max_digits10);
+        os << "# ms per launch, GFLOP per CU, GB and 1000 main loop iterations" << std::endl
+           << weights[0] << " " << weights[1] << " " << weights[2] << " " << weights[3]
+           << std::endl;
+        if(!os)
+        {
+            throw std::runtime_error("cannot write cost model " + path);
+        }
+    }
+};
+
+struct GemmRankingQuality
+{
+    std::size_t problems = 0;
+    // problems whose fastest instance is among the top k predicted ones
+    double hit_rate = 0;
+    // fastest time of the top k predicted instances over the fastest time, mean over problems
+    double mean_regret = 0;
+};
+
+// How well the model picks the top k instances, for the samples of every problem
+inline GemmRankingQuality
+evaluate_gemm_ranking(const std::vector<std::vector<GemmCostSample>>& problems,
+                      const GemmCostModel& model,
+                      std::size_t k)
+{
+    GemmRankingQuality quality;
+
+    for(const auto& samples : problems)
+    {
+        if(samples.empty())
+            continue;
+
+        // (predicted, position, measured)
+        std::vector<std::tuple<double, std::size_t, double>> predicted;
+        double best = std::numeric_limits<double>::max();
+        for(std::size_t i = 0; i < samples.size(); ++i)
+        {
+            predicted.emplace_back(model.Predict(samples[i].features), i, samples[i].time);
+            best = std::min(best, samples[i].time);
+        }
+        std::sort(predicted.begin(), predicted.end());
+
+        double best_top_k = std::numeric_limits<double>::max();
+        for(std::size_t i = 0; i < std::min(k, predicted.size()); ++i)
+            best_top_k = std::min(best_top_k, std::get<2>(predicted[i]));
+
+        ++quality.problems;
+        quality.hit_rate += best_top_k <= best ? 1 : 0;
+        quality.mean_regret += best_top_k / best;
+    }
+
+    if(quality.problems > 0)
+    {
+        quality.hit_rate /= quality.problems;
+        quality.mean_regret /= quality.problems;
+    }
+
+    return quality;
+}
+
+// Order of the instances by predicted time, the unsupported ones last and those whose type
+// string is not understood after them, in their original order
+inline std::vector<std::size_t> rank_gemm_instances(const std::vector<std::string>& type_strings,
+                                                    const GemmCostModel& model,
+                                                    std::int64_t M,
+                                                    std::int64_t N,
+                                                    std::int64_t K,
+                                                    int elem_bytes,
+                                                    int num_cu,
+                                                    int k_batch = 1)
+{
+    // (unsupported or not understood, predicted time, position)
+    std::vector<std::tuple<int, double, std::size_t>> order;
+    for(std::size_t i = 0; i < type_strings.size(); ++i)
+    {
+        const auto p = parse_gemm_tile_params(type_strings[i]);
+        if(!p)
+        {
+            order.emplace_back(2, 0., i);
+            continue;
+        }
+
+        const auto f = get_gemm_cost_features(*p, M, N, K, elem_bytes, num_cu, k_batch);
+        order.emplace_back(f.supported ? 0 : 1, model.Predict(f), i);
+    }
+
+    std::sort(order.begin(), order.end());
+
+    std::vector<std::size_t> ranks;
+    for(const auto& o : order)
+        ranks.push_back(std::get<2>(o));
+    return ranks;
+}
+
+// --top-k and --cost-model of ckProfiler
+struct GemmCostModelConfig
+{
+    static GemmCostModelConfig& GetInstance()
+    {
+        static GemmCostModelConfig config;
+        return config;
+    }
+
+    std::size_t top_k = 0; // 0 profiles every instance
+    GemmCostModel model;
+};
+
+/**
+ * @brief Keep the top_k instances of the cost model, in the order of their predicted time
+ *
+ * Instances whose type string is not understood are always kept, after the ranked ones. Does
+ * nothing without --top-k. get_num_cu() returns the number of CUs of the device, it is only
+ * called when the instances are ranked.
+ */
+template <typename OpPtrs, typename GetNumCu>
+void select_gemm_instances(OpPtrs& op_ptrs,
+                           std::int64_t M,
+                           std::int64_t N,
+                           std::int64_t K,
+                           int elem_bytes,
+                           GetNumCu&& get_num_cu,
+                           int k_batch = 1)
+{
+    const auto& config = GemmCostModelConfig::GetInstance();
+    if(config.top_k == 0 || op_ptrs.size() <= config.top_k)
+    {
+        return;
+    }
+
+    std::vector<std::string> type_strings;
+    for(const auto& op_ptr : op_ptrs)
+        type_strings.push_back(op_ptr->GetTypeString());
+
+    const auto ranks = rank_gemm_instances(
+        type_strings, config.model, M, N, K, elem_bytes, get_num_cu(), k_batch);
+
+    OpPtrs selected;
+    for(std::size_t r = 0; r < ranks.size(); ++r)
+    {
+        if(r < config.top_k || !parse_gemm_tile_params(type_strings[ranks[r]]))
+        {
+            selected.push_back(std::move(op_ptrs[ranks[r]]));
+        }
+    }
+
+    std::cout << "cost model: profiling " << selected.size() << " of " << op_ptrs.size()
+              << " instances" << std::endl;
+
+    op_ptrs = std::move(selected);
+}
+
+} // namespace profiler
+} // namespace ck
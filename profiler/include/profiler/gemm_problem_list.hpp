@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "profiler/profile_result_sink.hpp"
+
+namespace ck {
+namespace profiler {
+
+// One GEMM shape of a problem list, a negative stride selects the packed default
+struct GemmProblem
+{
+    int M       = 0;
+    int N       = 0;
+    int K       = 0;
+    int StrideA = -1;
+    int StrideB = -1;
+    int StrideC = -1;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const GemmProblem& p)
+{
+    return os << p.M << "," << p.N << "," << p.K << "," << p.StrideA << "," << p.StrideB << ","
+              << p.StrideC;
+}
+
+// Parse "M,N,K[,StrideA,StrideB,StrideC]" rows. Blank lines, '#' comments and a header row
+// (any row starting with a letter) are skipped, fields may also be separated by blanks.
+inline std::vector<GemmProblem> read_gemm_problems(std::istream& is,
+                                                   const std::string& name = "problem list")
+{
+    std::vector<GemmProblem> problems;
+
+    std::string line;
+    for(int line_no = 1; std::getline(is, line); ++line_no)
+    {
+        line = line.substr(0, line.find('#'));
+        std::replace(line.begin(), line.end(), ',', ' ');
+
+        std::istringstream fields(line);
+        std::string first;
+        if(!(fields >> first) || std::isalpha(static_cast<unsigned char>(first[0])))
+        {
+            continue;
+        }
+
+        std::vector<int> values;
+        fields.clear();
+        fields.str(line);
+        for(std::string field; fields >> field;)
+        {
+            std::size_t end = 0;
+            int value       = 0;
+            try
+            {
+                value = std::stoi(field, &end);
+            }
+            catch(const std::logic_error&)
+            {
+                end = 0;
+            }
+
+            if(end != field.size())
+            {
+                throw std::runtime_error("wrong! " + name + ":" + std::to_string(line_no) +
+                                         ": bad field \"" + field + "\"");
+            }
+            values.push_back(value);
+        }
+
+        if(values.size() != 3 && values.size() != 6)
+        {
+            throw std::runtime_error("wrong! " + name + ":" + std::to_string(line_no) +
+                                     ": expect M,N,K[,StrideA,StrideB,StrideC]");
+        }
+
+        if(values[0] <= 0 || values[1] <= 0 || values[2] <= 0)
+        {
+            throw std::runtime_error("wrong! " + name + ":" + std::to_string(line_no) +
+                                     ": M, N and K must be positive");
+        }
+
+        GemmProblem problem{values[0], values[1], values[2]};
+        if(values.size() == 6)
+        {
+            problem.StrideA = values[3];
+            problem.StrideB = values[4];
+            problem.StrideC = values[5];
+        }
+
+        problems.push_back(problem);
+    }
+
+    return problems;
+}
+
+inline std::vector<GemmProblem> read_gemm_problems(const std::string& path)
+{
+    std::ifstream is(path);
+    if(!is)
+    {
+        throw std::runtime_error("cannot open problem list " + path);
+    }
+
+    return read_gemm_problems(is, path);
+}
+
+/**
+ * @brief Per-slot buffers reused across the problems of a batch
+ *
+ * A slot is only reallocated when a problem needs more than it holds, and then grows by at
+ * least half its size so that a list of increasing shapes reallocates a logarithmic number of
+ * times. Buffer is DeviceMem or anything with a default constructor, Realloc(size) and
+ * GetBufferSize().
+ */
+template <typename Buffer>
+class GrowingBufferPool
+{
+    public:
+    explicit GrowingBufferPool(std::size_t num_slot) : mBuffers(num_slot) {}
+
+    Buffer& Get(std::size_t slot, std::size_t size)
+    {
+        Buffer& buffer = mBuffers.at(slot);
+
+        if(buffer.GetBufferSize() < size)
+        {
+            buffer.Realloc(std::max(size, buffer.GetBufferSize() / 2 * 3));
+            ++mAllocationCount;
+        }
+
+        return buffer;
+    }
+
+    std::size_t GetAllocationCount() const { return mAllocationCount; }
+
+    private:
+    std::vector<Buffer> mBuffers;
+    std::size_t mAllocationCount = 0;
+};
+
+// One result row of a batch, per (problem, instance)
+struct GemmProfileResult
+{
+    std::size_t problem_id = 0;
+    GemmProblem problem;
+    std::string instance;
+    bool supported   = false;
+    float ave_time   = 0;
+    float tflops     = 0;
+    float gb_per_sec = 0;
+    bool pass        = true;
+};
+
+inline void write_gemm_result_csv_header(std::ostream& os)
+{
+    os << "problem_id,M,N,K,StrideA,StrideB,StrideC,instance,supported,ave_time_ms,tflops,"
+          "gb_per_sec,pass"
+       << std::endl;
+}
+
+inline void write_gemm_result_csv(std::ostream& os, const GemmProfileResult& r)
+{
+    // instance names contain commas and angle brackets
+    os << r.problem_id << "," << r.problem << ",\"" << r.instance << "\"," << r.supported << ","
+       << r.ave_time << "," << r.tflops << "," << r.gb_per_sec << "," << r.pass << std::endl;
+}
+
+// The row of a supported instance for the ProfileResultReporter. Its problem is args, the
+// ckProfiler arguments before the problem list, followed by the shape of the row, the same as if
+// the shape was profiled on its own
+inline ProfileResult make_profile_result(const GemmProfileResult& r,
+                                         const std::string& args,
+                                         bool do_verification,
+                                         bool time_kernel)
+{
+    const GemmProblem& p = r.problem;
+
+    std::ostringstream problem;
+    problem << args << " " << p.M << " " << p.N << " " << p.K << " " << p.StrideA << " "
+            << p.StrideB << " " << p.StrideC;
+
+    ProfileResult result;
+    result.problem    = problem.str();
+    result.instance   = r.instance;
+    result.ave_time   = r.ave_time;
+    result.tflops     = r.tflops;
+    result.gb_per_sec = r.gb_per_sec;
+    result.timed      = time_kernel;
+    if(do_verification)
+    {
+        result.verification = r.pass ? VerificationStatus::Pass : VerificationStatus::Fail;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Profile every instance of a backend on every problem of a list
+ *
+ * The backend keeps its instance list and buffers across problems and provides
+ *
+ *   std::size_t GetInstanceCount() const;
+ *   std::string GetInstanceName(std::size_t i) const;
+ *   GemmProblem SetProblem(const GemmProblem&);  // resolve default strides, fill the inputs,
+ *                                                // start the reference
+ *   std::size_t GetNumBytes() const;             // bytes moved by the current problem
+ *   bool IsSupported(std::size_t i);
+ *   float Run(std::size_t i);                    // average time in ms, 0 if not timed
+ *   bool Verify(std::size_t i);                  // compare the output of the last Run
+ *
+ * sink(const GemmProfileResult&) is called once per (problem, instance) as soon as the row is
+ * known. Returns whether all supported instances passed verification.
+ */
+template <typename Backend, typename Sink>
+bool profile_gemm_problems(Backend& backend,
+                           const std::vector<GemmProblem>& problems,
+                           bool do_verification,
+                           Sink&& sink)
+{
+    bool pass = true;
+
+    for(std::size_t p = 0; p < problems.size(); ++p)
+    {
+        const GemmProblem problem = backend.SetProblem(problems[p]);
+
+        const double flop      = 2.0 * problem.M * problem.N * problem.K;
+        const double num_bytes = static_cast<double>(backend.GetNumBytes());
+
+        for(std::size_t i = 0; i < backend.GetInstanceCount(); ++i)
+        {
+            GemmProfileResult result;
+            result.problem_id = p;
+            result.problem    = problem;
+            result.instance   = backend.GetInstanceName(i);
+            result.supported  = backend.IsSupported(i);
+
+            if(result.supported)
+            {
+                result.ave_time = backend.Run(i);
+
+                if(result.ave_time > 0)
+                {
+                    result.tflops     = static_cast<float>(flop / 1.E9 / result.ave_time);
+                    result.gb_per_sec = static_cast<float>(num_bytes / 1.E6 / result.ave_time);
+                }
+
+                if(do_verification)
+                {
+                    result.pass = backend.Verify(i);
+                    pass        = pass && result.pass;
+                }
+            }
+
+            sink(result);
+        }
+    }
+
+    return pass;
+}
+
+} // namespace profiler
+} // namespace ck
@@ -14,6 +14,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_avgpool_bwd.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -188,9 +189,7 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -202,11 +201,11 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
         if(do_verification)
         {
             din_device_buf.FromDevice(din_n_c_di_hi_wi_device.mData.data());
-            bool pass = ck::utils::check_err(din_n_c_di_hi_wi_device.mData,
-                                             din_n_c_di_hi_wi_host.mData,
-                                             "Error: Incorrect results",
-                                             1e-3,
-                                             1e-3);
+            bool pass = report_verification(ck::utils::check_err(din_n_c_di_hi_wi_device.mData,
+                                                                 din_n_c_di_hi_wi_host.mData,
+                                                                 "Error: Incorrect results",
+                                                                 1e-3,
+                                                                 1e-3));
 
             if(do_log)
             {
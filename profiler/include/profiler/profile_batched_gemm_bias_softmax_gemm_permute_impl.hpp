@@ -19,6 +19,7 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -325,8 +326,7 @@ bool profile_batched_gemm_bias_softmax_gemm_permute_impl(bool do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -355,11 +355,11 @@ bool profile_batched_gemm_bias_softmax_gemm_permute_impl(bool do_verification,
                     atol = 1e-2;
                 }
 
-                pass = pass & ck::utils::check_err(c_gs_ms_os_device_result,
-                                                   c_gs_ms_os_host_result,
-                                                   "Error: Incorrect results!",
-                                                   rtol,
-                                                   atol);
+                pass = pass & report_verification(ck::utils::check_err(c_gs_ms_os_device_result,
+                                                                       c_gs_ms_os_host_result,
+                                                                       "Error: Incorrect results!",
+                                                                       rtol,
+                                                                       atol));
 
                 if(do_log)
                 {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 
 #include "ck/ck.hpp"
@@ -20,6 +21,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -98,6 +100,8 @@ bool profile_batched_gemm_impl(int do_verification,
     const auto b_element_op = BElementOp{};
     const auto c_element_op = CElementOp{};
 
+    // run reference op on host threads while the instances are set up, joined at the first check
+    std::future<float> ref_result;
     if(do_verification)
     {
         using ReferenceBatchedGemmInstance =
@@ -115,7 +119,7 @@ bool profile_batched_gemm_impl(int do_verification,
         auto ref_argument = ref_batched_gemm.MakeArgument(
             a_g_m_k, b_g_k_n, c_g_m_n_host_result, a_element_op, b_element_op, c_element_op);
 
-        ref_invoker.Run(ref_argument);
+        ref_result = ref_invoker.RunAsync(ref_argument);
     }
 
     DeviceMem a_device_buf(sizeof(ADataType) * a_g_m_k.mDesc.GetElementSpaceSize());
@@ -219,8 +223,7 @@ bool profile_batched_gemm_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -234,7 +237,13 @@ bool profile_batched_gemm_impl(int do_verification,
             {
                 c_device_buf.FromDevice(c_g_m_n_device_result.mData.data());
 
-                pass = pass & ck::utils::check_err(c_g_m_n_device_result, c_g_m_n_host_result);
+                if(ref_result.valid())
+                {
+                    ref_result.get();
+                }
+
+                pass = pass & report_verification(ck::utils::check_err(
+                                  c_g_m_n_device_result, c_g_m_n_host_result));
 
                 if(do_log)
                 {
@@ -16,6 +16,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -299,8 +300,7 @@ bool profile_batched_gemm_reduce_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << gemm_name << std::endl;
+            report_profile_result(gemm_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -316,9 +316,12 @@ bool profile_batched_gemm_reduce_impl(int do_verification,
                 reduce0_device_buf.FromDevice(d0_g_m_device_result.mData.data());
                 reduce1_device_buf.FromDevice(d1_g_m_device_result.mData.data());
 
-                bool c_error  = ck::utils::check_err(c_g_m_n_device_result, c_g_m_n_host_result);
-                bool d0_error = ck::utils::check_err(d0_g_m_device_result, d0_g_m_host_result);
-                bool d1_error = ck::utils::check_err(d1_g_m_device_result, d1_g_m_host_result);
+                bool c_error  = report_verification(ck::utils::check_err(
+                    c_g_m_n_device_result, c_g_m_n_host_result));
+                bool d0_error = report_verification(ck::utils::check_err(
+                    d0_g_m_device_result, d0_g_m_host_result));
+                bool d1_error = report_verification(ck::utils::check_err(
+                    d1_g_m_device_result, d1_g_m_host_result));
 
                 pass = pass && (c_error == true);
                 pass = pass && (d0_error == true);
@@ -19,6 +19,7 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -297,8 +298,7 @@ bool profile_batched_gemm_softmax_gemm_impl(bool do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -312,7 +312,8 @@ bool profile_batched_gemm_softmax_gemm_impl(bool do_verification,
             {
                 c_g_m_o_device_buf.FromDevice(c_g_m_o_device_result.mData.data());
 
-                pass = pass & ck::utils::check_err(c_g_m_o_device_result, c_g_m_o_host_result);
+                pass = pass & report_verification(ck::utils::check_err(
+                                  c_g_m_o_device_result, c_g_m_o_host_result));
 
                 if(do_log)
                 {
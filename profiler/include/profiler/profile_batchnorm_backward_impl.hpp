@@ -14,6 +14,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/tensor_operation_instance/gpu/batchnorm_backward.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_backward.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -327,9 +328,7 @@ bool profile_batchnorm_backward_impl(bool do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -348,9 +347,9 @@ bool profile_batchnorm_backward_impl(bool do_verification,
             dbias_dev.FromDevice(dbias.data());
 
             // clang-format off
-            single_pass = single_pass && ck::utils::check_err(dx.mData, dx_ref.mData, "dx result:", 5e-4, 5e-4);
-            single_pass = single_pass && ck::utils::check_err(dscale.mData, dscale_ref.mData, "dScale result:", 3e-3, 3e-3);
-            single_pass = single_pass && ck::utils::check_err(dbias.mData, dbias_ref.mData, "dBias result:", 3e-3, 3e-3);
+            single_pass = single_pass && report_verification(ck::utils::check_err(dx.mData, dx_ref.mData, "dx result:", 5e-4, 5e-4));
+            single_pass = single_pass && report_verification(ck::utils::check_err(dscale.mData, dscale_ref.mData, "dScale result:", 3e-3, 3e-3));
+            single_pass = single_pass && report_verification(ck::utils::check_err(dbias.mData, dbias_ref.mData, "dBias result:", 3e-3, 3e-3));
             // clang-format on
 
             pass = pass && single_pass;
@@ -14,6 +14,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/tensor_operation_instance/gpu/batchnorm_forward.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_forward.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -323,9 +324,7 @@ bool profile_batchnorm_forward_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -342,9 +341,11 @@ bool profile_batchnorm_forward_impl(int do_verification,
             y_dev.FromDevice(y.mData.data());
 
             if constexpr(ck::is_same_v<YDataType, ck::bhalf_t>)
-                single_pass = check_err(y.mData, y_ref.mData, "y results", 1e-2, 1e-2);
+                single_pass = report_verification(check_err(
+                    y.mData, y_ref.mData, "y results", 1e-2, 1e-2));
             else
-                single_pass = check_err(y.mData, y_ref.mData, "y results", 4e-3, 4e-3);
+                single_pass = report_verification(check_err(
+                    y.mData, y_ref.mData, "y results", 4e-3, 4e-3));
 
             if(updateMovingAverage)
             {
@@ -352,8 +353,8 @@ bool profile_batchnorm_forward_impl(int do_verification,
                 resultRunningVariance_dev.FromDevice(resultRunningVariance.mData.data());
 
                 // clang-format off
-                single_pass = single_pass && check_err(resultRunningMean.mData, resultRunningMean_ref.mData, "average mean results", 1.5e-5, 1.5e-5);
-                single_pass = single_pass && check_err(resultRunningVariance.mData, resultRunningVariance_ref.mData, "average variance results", 1e-5, 1e-5);
+                single_pass = single_pass && report_verification(check_err(resultRunningMean.mData, resultRunningMean_ref.mData, "average mean results", 1.5e-5, 1.5e-5));
+                single_pass = single_pass && report_verification(check_err(resultRunningVariance.mData, resultRunningVariance_ref.mData, "average variance results", 1e-5, 1e-5));
                 // clang-format on
             };
 
@@ -363,8 +364,8 @@ bool profile_batchnorm_forward_impl(int do_verification,
                 resultSaveInvVariance_dev.FromDevice(resultSaveInvVariance.mData.data());
 
                 // clang-format off
-                single_pass = single_pass && check_err(resultSaveMean.mData, resultSaveMean_ref.mData, "mean results", 3e-5, 3e-5);
-                single_pass = single_pass && check_err(resultSaveInvVariance.mData, resultSaveInvVariance_ref.mData, "inv-variance results", 7e-5, 7e-5);
+                single_pass = single_pass && report_verification(check_err(resultSaveMean.mData, resultSaveMean_ref.mData, "mean results", 3e-5, 3e-5));
+                single_pass = single_pass && report_verification(check_err(resultSaveInvVariance.mData, resultSaveInvVariance_ref.mData, "inv-variance results", 7e-5, 7e-5));
                 // clang-format on
             };
 
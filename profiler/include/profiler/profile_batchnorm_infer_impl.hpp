@@ -14,6 +14,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/tensor_operation_instance/gpu/batchnorm_infer.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_infer.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -278,9 +279,7 @@ bool profile_batchnorm_infer_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -297,9 +296,11 @@ bool profile_batchnorm_infer_impl(int do_verification,
             y_dev.FromDevice(y.mData.data());
 
             if constexpr(ck::is_same_v<YDataType, ck::bhalf_t>)
-                single_pass = check_err(y.mData, y_ref.mData, "y results", 1e-2, 1e-2);
+                single_pass = report_verification(check_err(
+                    y.mData, y_ref.mData, "y results", 1e-2, 1e-2));
             else
-                single_pass = check_err(y.mData, y_ref.mData, "y results", 4e-3, 4e-3);
+                single_pass = report_verification(check_err(
+                    y.mData, y_ref.mData, "y results", 4e-3, 4e-3));
 
             pass = pass && single_pass;
         };
@@ -25,6 +25,7 @@
 #include "ck/library/utility/numeric.hpp"
 
 #include "ck/host_utility/io.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -264,8 +265,7 @@ int profile_contraction_impl(ck::index_t do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / avg_time;
 
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, avg_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -302,11 +302,11 @@ int profile_contraction_impl(ck::index_t do_verification,
                     threshold += epsilon * 2;
                 }
 
-                pass = pass & ck::utils::check_err(e_m_n_device_result,
-                                                   e_m_n_host_result,
-                                                   "Error: incorrect results!",
-                                                   threshold,
-                                                   threshold);
+                pass = pass & report_verification(ck::utils::check_err(e_m_n_device_result,
+                                                                       e_m_n_host_result,
+                                                                       "Error: incorrect results!",
+                                                                       threshold,
+                                                                       threshold));
 
                 if(do_log)
                 {
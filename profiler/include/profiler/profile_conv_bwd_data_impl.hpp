@@ -17,6 +17,7 @@
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -194,8 +195,7 @@ bool profile_conv_bwd_data_impl(int do_verification,
             float tflops     = static_cast<float>(flop) / 1.E9 / avg_time;
             float gb_per_sec = num_btype / 1.E6 / avg_time;
 
-            std::cout << "Perf: " << avg_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s" << std::endl;
+            report_profile_result(op_name, avg_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -209,7 +209,8 @@ bool profile_conv_bwd_data_impl(int do_verification,
             {
                 in_device_buf.FromDevice(input_device_result.mData.data());
 
-                pass = pass & ck::utils::check_err(input_device_result, input_host_result);
+                pass = pass & report_verification(ck::utils::check_err(
+                                  input_device_result, input_host_result));
 
                 if(do_log)
                 {
@@ -14,6 +14,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd_bias_activation_add.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -236,8 +237,7 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << conv_name << std::endl;
+            report_profile_result(conv_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -251,7 +251,8 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
             {
                 out_device_buf.FromDevice(out_n_k_ho_wo_device_result.mData.data());
 
-                ck::utils::check_err(out_n_k_ho_wo_device_result, out_n_k_ho_wo_host_result);
+                report_verification(ck::utils::check_err(
+                    out_n_k_ho_wo_device_result, out_n_k_ho_wo_host_result));
 
                 if(do_log)
                 {
@@ -22,6 +22,7 @@
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_image_to_column.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_column_to_image.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -257,8 +258,7 @@ bool profile_conv_tensor_rearrange_impl(int do_verification,
             std::size_t num_btype =
                 conv_param.G_ * NDoHoWo * CZYX * (sizeof(OutputDataType) + sizeof(InputDataType));
             float gb_per_sec = num_btype / 1.E6 / avg_time;
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << op_name << std::endl;
+            report_profile_result(op_name, avg_time, gb_per_sec);
 
             if(avg_time < best_avg_time)
             {
@@ -270,7 +270,7 @@ bool profile_conv_tensor_rearrange_impl(int do_verification,
             if(do_verification)
             {
                 out_device_buf.FromDevice(device_output.mData.data());
-                pass = pass & ck::utils::check_err(device_output, host_output);
+                pass = pass & report_verification(ck::utils::check_err(device_output, host_output));
 
                 if(do_log)
                 {
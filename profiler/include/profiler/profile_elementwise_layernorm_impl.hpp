@@ -15,6 +15,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -217,9 +218,7 @@ bool profile_elementwise_layernorm_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -232,8 +231,8 @@ bool profile_elementwise_layernorm_impl(int do_verification,
         {
             y_dev.FromDevice(y.mData.data());
 
-            bool pass =
-                ck::utils::check_err(y.mData, host_y.mData, "Error: Incorrect results", 5e-3, 5e-3);
+            bool pass = report_verification(ck::utils::check_err(
+                y.mData, host_y.mData, "Error: Incorrect results", 5e-3, 5e-3));
 
             if(do_log)
             {
@@ -19,6 +19,7 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -304,9 +305,7 @@ bool profile_gemm_add_relu_add_layernorm_impl(int do_verification,
 
             float gb_per_sec = num_byte / 1.E6 / ave_time;
 
-            if(time_kernel)
-                std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << gb_per_sec
-                          << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, ave_time, gb_per_sec, time_kernel);
 
             if(ave_time < best_ave_time)
             {
@@ -319,8 +318,9 @@ bool profile_gemm_add_relu_add_layernorm_impl(int do_verification,
             {
                 h_device_buf.FromDevice(h_m_n.mData.data());
 
-                pass = pass && ck::utils::check_err(
-                                   h_m_n, h_m_n_host, "Error: Incorrect results h_m_n", 1e-2, 1e-2);
+                pass =
+                    pass && report_verification(ck::utils::check_err(
+                                h_m_n, h_m_n_host, "Error: Incorrect results h_m_n", 1e-2, 1e-2));
             }
         }
         else
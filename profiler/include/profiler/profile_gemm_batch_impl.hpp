@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/device/device_gemm.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/tensor_operation_instance/gpu/gemm.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/literals.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+#include "profiler/gemm_problem_list.hpp"
+
+namespace ck {
+namespace profiler {
+
+/**
+ * @brief Device backend of profile_gemm_problems()
+ *
+ * Builds the DeviceGemm instance list once and keeps the device buffers in a growing pool, so
+ * a problem list pays for neither per shape. The host reference of each problem runs on host
+ * threads while the instances are profiled and is joined by the first Verify().
+ */
+template <typename ALayout,
+          typename BLayout,
+          typename CLayout,
+          typename ADataType,
+          typename BDataType,
+          typename AccDataType,
+          typename CDataType>
+class DeviceGemmBatchBackend
+{
+    public:
+    using AElementOp = ck::tensor_operation::element_wise::PassThrough;
+    using BElementOp = ck::tensor_operation::element_wise::PassThrough;
+    using CElementOp = ck::tensor_operation::element_wise::PassThrough;
+
+    using DeviceOp = ck::tensor_operation::device::DeviceGemm<ALayout,
+                                                              BLayout,
+                                                              CLayout,
+                                                              ADataType,
+                                                              BDataType,
+                                                              CDataType,
+                                                              AElementOp,
+                                                              BElementOp,
+                                                              CElementOp>;
+
+    using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                                            BDataType,
+                                                                            CDataType,
+                                                                            AccDataType,
+                                                                            AElementOp,
+                                                                            BElementOp,
+                                                                            CElementOp>;
+
+    DeviceGemmBatchBackend(
+        bool do_verification, int init_method, bool time_kernel, int n_warmup, int n_iter)
+        : mOpPtrs(ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+                  DeviceOp>::GetInstances()),
+          mBuffers(3),
+          mDoVerification(do_verification),
+          mInitMethod(init_method),
+          mTimeKernel(time_kernel),
+          mWarmup(n_warmup),
+          mIter(n_iter),
+          mA({1, 1}),
+          mB({1, 1}),
+          mCHost({1, 1}),
+          mCDevice({1, 1})
+    {
+    }
+
+    ~DeviceGemmBatchBackend() { JoinReference(); }
+
+    std::size_t GetInstanceCount() const { return mOpPtrs.size(); }
+
+    std::string GetInstanceName(std::size_t i) const { return mOpPtrs[i]->GetTypeString(); }
+
+    std::size_t GetAllocationCount() const { return mBuffers.GetAllocationCount(); }
+
+    GemmProblem SetProblem(const GemmProblem& problem)
+    {
+        // the reference of the previous problem still writes into mCHost
+        JoinReference();
+
+        mProblem = problem;
+        if(mProblem.StrideA < 0)
+            mProblem.StrideA = is_same_v<ALayout, Row> ? problem.K : problem.M;
+        if(mProblem.StrideB < 0)
+            mProblem.StrideB = is_same_v<BLayout, Row> ? problem.N : problem.K;
+        if(mProblem.StrideC < 0)
+            mProblem.StrideC = is_same_v<CLayout, Row> ? problem.N : problem.M;
+
+        const auto& p = mProblem;
+        mA            = Tensor<ADataType>(MakeDescriptor(p.M, p.K, p.StrideA, ALayout{}));
+        mB            = Tensor<BDataType>(MakeDescriptor(p.K, p.N, p.StrideB, BLayout{}));
+        mCHost        = Tensor<CDataType>(MakeDescriptor(p.M, p.N, p.StrideC, CLayout{}));
+        mCDevice      = Tensor<CDataType>(MakeDescriptor(p.M, p.N, p.StrideC, CLayout{}));
+
+        switch(mInitMethod)
+        {
+        case 0:
+            ck::utils::FillConstant<ADataType>{static_cast<ADataType>(1.f)}(mA);
+            ck::utils::FillConstant<BDataType>{static_cast<BDataType>(1.f)}(mB);
+            break;
+        case 1:
+            ck::utils::FillUniformDistributionIntegerValue<ADataType>{-5.f, 5.f}(mA);
+            ck::utils::FillUniformDistributionIntegerValue<BDataType>{-5.f, 5.f}(mB);
+            break;
+        default:
+            ck::utils::FillUniformDistribution<ADataType>{-1.f, 1.f}(mA);
+            ck::utils::FillUniformDistribution<BDataType>{-1.f, 1.f}(mB);
+        }
+
+        // pooled buffers may be larger than the tensors, copy the tensor sizes only
+        const std::size_t a_size = mA.GetElementSpaceSizeInBytes();
+        const std::size_t b_size = mB.GetElementSpaceSizeInBytes();
+        mBuffers.Get(0, a_size).ToDevice(mA.mData.data(), a_size);
+        mBuffers.Get(1, b_size).ToDevice(mB.mData.data(), b_size);
+        mBuffers.Get(2, mCDevice.GetElementSpaceSizeInBytes());
+
+        if(mDoVerification)
+        {
+            auto make_key = [this] {
+                ck::utils::ReferenceCacheKey key("ReferenceGemm");
+                key.AddType<AccDataType>();
+                key.AddType<CDataType>();
+
+                return key.AddDescriptor(mCHost.mDesc)
+                    .AddTensor(mA)
+                    .AddTensor(mB)
+                    .AddElementOp(AElementOp{})
+                    .AddElementOp(BElementOp{})
+                    .AddElementOp(CElementOp{});
+            };
+
+            mRefResult = ck::utils::run_cached_reference_async(
+                ck::utils::ReferenceCache::GetDefault(), mCHost, make_key, [this] {
+                    auto ref_op      = ReferenceGemmInstance{};
+                    auto ref_invoker = ref_op.MakeInvoker();
+
+                    ref_invoker.Run(ref_op.MakeArgument(
+                        mA, mB, mCHost, AElementOp{}, BElementOp{}, CElementOp{}));
+                });
+        }
+
+        return mProblem;
+    }
+
+    std::size_t GetNumBytes() const
+    {
+        return sizeof(ADataType) * mProblem.M * mProblem.K +
+               sizeof(BDataType) * mProblem.K * mProblem.N +
+               sizeof(CDataType) * mProblem.M * mProblem.N;
+    }
+
+    bool IsSupported(std::size_t i)
+    {
+        mArgument = mOpPtrs[i]->MakeArgumentPointer(
+            static_cast<ADataType*>(mBuffers.Get(0, 0).GetDeviceBuffer()),
+            static_cast<BDataType*>(mBuffers.Get(1, 0).GetDeviceBuffer()),
+            static_cast<CDataType*>(mBuffers.Get(2, 0).GetDeviceBuffer()),
+            mProblem.M,
+            mProblem.N,
+            mProblem.K,
+            mProblem.StrideA,
+            mProblem.StrideB,
+            mProblem.StrideC,
+            AElementOp{},
+            BElementOp{},
+            CElementOp{});
+
+        return mOpPtrs[i]->IsSupportedArgument(mArgument.get());
+    }
+
+    float Run(std::size_t i)
+    {
+        // re-init C to zero before profiling next kernel
+        mBuffers.Get(2, 0).SetZero();
+
+        return mOpPtrs[i]->MakeInvokerPointer()->Run(
+            mArgument.get(), StreamConfig{nullptr, mTimeKernel, 0, mWarmup, mIter});
+    }
+
+    bool Verify(std::size_t)
+    {
+        JoinReference();
+
+        mBuffers.Get(2, 0).FromDevice(mCDevice.mData.data(), mCDevice.GetElementSpaceSizeInBytes());
+
+        return ck::utils::check_err(mCDevice, mCHost);
+    }
+
+    private:
+    using Row = ck::tensor_layout::gemm::RowMajor;
+
+    template <typename Layout>
+    static HostTensorDescriptor
+    MakeDescriptor(std::size_t row, std::size_t col, std::size_t stride, Layout)
+    {
+        using namespace ck::literals;
+
+        if constexpr(is_same_v<Layout, Row>)
+        {
+            return HostTensorDescriptor({row, col}, {stride, 1_uz});
+        }
+        else
+        {
+            return HostTensorDescriptor({row, col}, {1_uz, stride});
+        }
+    }
+
+    void JoinReference()
+    {
+        if(mRefResult.valid())
+        {
+            mRefResult.get();
+        }
+    }
+
+    std::vector<std::unique_ptr<DeviceOp>> mOpPtrs;
+    GrowingBufferPool<DeviceMem> mBuffers;
+
+    bool mDoVerification;
+    int mInitMethod;
+    bool mTimeKernel;
+    int mWarmup;
+    int mIter;
+
+    GemmProblem mProblem;
+    Tensor<ADataType> mA;
+    Tensor<BDataType> mB;
+    Tensor<CDataType> mCHost;
+    Tensor<CDataType> mCDevice;
+
+    std::future<bool> mRefResult;
+    std::unique_ptr<ck::tensor_operation::device::BaseArgument> mArgument;
+};
+
+// Profile all DeviceGemm instances on every problem of a list, one CSV row per (problem,
+// instance) to os. The supported ones are also recorded by the ProfileResultReporter, with args,
+// the ckProfiler arguments before the problem list, and the shape as their problem
+template <typename ALayout,
+          typename BLayout,
+          typename CLayout,
+          typename ADataType,
+          typename BDataType,
+          typename AccDataType,
+          typename CDataType>
+bool profile_gemm_batch_impl(int do_verification,
+                             int init_method,
+                             bool time_kernel,
+                             const std::vector<GemmProblem>& problems,
+                             int n_warmup,
+                             int n_iter,
+                             const std::string& args,
+                             std::ostream& os = std::cout)
+{
+    DeviceGemmBatchBackend<ALayout,
+                           BLayout,
+                           CLayout,
+                           ADataType,
+                           BDataType,
+                           AccDataType,
+                           CDataType>
+        backend(do_verification, init_method, time_kernel, n_warmup, n_iter);
+
+    std::cerr << "found " << backend.GetInstanceCount() << " instances, " << problems.size()
+              << " problems" << std::endl;
+
+    write_gemm_result_csv_header(os);
+
+    const bool pass = profile_gemm_problems(
+        backend, problems, do_verification, [&](const GemmProfileResult& result) {
+            write_gemm_result_csv(os, result);
+
+            if(result.supported)
+            {
+                ProfileResultReporter::GetInstance().Record(
+                    make_profile_result(result, args, do_verification, time_kernel));
+            }
+        });
+
+    std::cerr << "device buffer allocations: " << backend.GetAllocationCount() << std::endl;
+
+    return pass;
+}
+
+} // namespace profiler
+} // namespace ck
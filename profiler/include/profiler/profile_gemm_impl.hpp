@@ -3,12 +3,14 @@
 
 #pragma once
 
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <typeinfo>
 #include <unistd.h>
 
 #include "ck/ck.hpp"
+#include "ck/host_utility/hip_check_error.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/device_gemm.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
@@ -18,10 +20,13 @@
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 #include "ck/library/utility/fill.hpp"
+#include "profiler/gemm_cost_model.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -112,12 +117,21 @@ int profile_gemm_impl(int do_verification,
                                                               CElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+    auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
         DeviceOp>::GetInstances();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // Run reference op
+    // with --top-k, only the instances that the cost model ranks best
+    const auto get_num_cu = [] {
+        hipDeviceProp_t props;
+        hip_check_error(hipGetDeviceProperties(&props, 0));
+        return props.multiProcessorCount;
+    };
+    select_gemm_instances(op_ptrs, M, N, K, sizeof(ADataType), get_num_cu);
+
+    // Run reference op on host threads while the instances are set up, joined at the first check
+    std::future<bool> ref_result;
     if(do_verification)
     {
         using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
@@ -128,13 +142,29 @@ int profile_gemm_impl(int do_verification,
                                                                                 BElementOp,
                                                                                 CElementOp>;
 
-        auto ref_op      = ReferenceGemmInstance{};
-        auto ref_invoker = ref_op.MakeInvoker();
+        auto make_key = [&] {
+            ck::utils::ReferenceCacheKey key("ReferenceGemm");
+            key.AddType<AccDataType>();
+            key.AddType<CDataType>();
+
+            return key.AddDescriptor(c_m_n_host_result.mDesc)
+                .AddTensor(a_m_k)
+                .AddTensor(b_k_n)
+                .AddElementOp(a_element_op)
+                .AddElementOp(b_element_op)
+                .AddElementOp(c_element_op);
+        };
+
+        ref_result = ck::utils::run_cached_reference_async(
+            ck::utils::ReferenceCache::GetDefault(), c_m_n_host_result, make_key, [&] {
+                auto ref_op      = ReferenceGemmInstance{};
+                auto ref_invoker = ref_op.MakeInvoker();
 
-        auto ref_argument = ref_op.MakeArgument(
-            a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, c_element_op);
+                auto ref_argument = ref_op.MakeArgument(
+                    a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, c_element_op);
 
-        ref_invoker.Run(ref_argument);
+                ref_invoker.Run(ref_argument);
+            });
     }
 
     float best_tflops    = 0;
@@ -179,8 +209,7 @@ int profile_gemm_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / avg_time;
 
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, avg_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -192,7 +221,13 @@ int profile_gemm_impl(int do_verification,
             {
                 c_device_buf.FromDevice(c_m_n_device_result.mData.data());
 
-                pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                if(ref_result.valid())
+                {
+                    ref_result.get();
+                }
+
+                pass = pass & report_verification(ck::utils::check_err(
+                                  c_m_n_device_result, c_m_n_host_result));
 
                 if(do_log)
                 {
@@ -16,6 +16,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -293,8 +294,7 @@ bool profile_gemm_reduce_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << gemm_name << std::endl;
+            report_profile_result(gemm_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -310,9 +310,11 @@ bool profile_gemm_reduce_impl(int do_verification,
                 reduce0_device_buf.FromDevice(reduce0_m_device_result.mData.data());
                 reduce1_device_buf.FromDevice(reduce1_m_device_result.mData.data());
 
-                ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
-                ck::utils::check_err(reduce0_m_device_result, reduce0_m_host_result);
-                ck::utils::check_err(reduce1_m_device_result, reduce1_m_host_result);
+                report_verification(ck::utils::check_err(c_m_n_device_result, c_m_n_host_result));
+                report_verification(ck::utils::check_err(
+                    reduce0_m_device_result, reduce0_m_host_result));
+                report_verification(ck::utils::check_err(
+                    reduce1_m_device_result, reduce1_m_host_result));
 
                 if(do_log)
                 {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <typeinfo>
@@ -20,6 +21,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -115,7 +117,8 @@ bool profile_gemm_splitk_impl(int do_verification,
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // Run reference GEMM
+    // Run reference GEMM on host threads while the instances are set up, joined at the first check
+    std::future<float> ref_result;
     if(do_verification)
     {
         using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
@@ -133,7 +136,7 @@ bool profile_gemm_splitk_impl(int do_verification,
         auto ref_argument = ref_gemm.MakeArgument(
             a_m_k, b_k_n, c_m_n_host_result, a_element_op, b_element_op, c_element_op);
 
-        ref_invoker.Run(ref_argument);
+        ref_result = ref_invoker.RunAsync(ref_argument);
     }
 
     std::string best_op_name;
@@ -175,6 +178,8 @@ bool profile_gemm_splitk_impl(int do_verification,
 
             if(op_ptr->IsSupportedArgument(argument_ptr.get()))
             {
+                // the verification below belongs to this instance
+                begin_profile_instance();
 
                 // re-init C to zero before profiling next kernel
                 c_device_buf.SetZero();
@@ -186,7 +191,13 @@ bool profile_gemm_splitk_impl(int do_verification,
                 {
                     c_device_buf.FromDevice(c_m_n_device_result.mData.data());
 
-                    pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                    if(ref_result.valid())
+                    {
+                        ref_result.get();
+                    }
+
+                    pass = pass & report_verification(ck::utils::check_err(
+                                      c_m_n_device_result, c_m_n_host_result));
 
                     if(do_log)
                     {
@@ -215,9 +226,11 @@ bool profile_gemm_splitk_impl(int do_verification,
 
                 float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-                std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops
-                          << " TFlops, " << gb_per_sec << " GB/s, " << op_name << ", KBatch "
-                          << kbatch_curr << std::endl;
+                report_profile_result(op_name,
+                                      ave_time,
+                                      tflops,
+                                      gb_per_sec,
+                                      "KBatch " + std::to_string(kbatch_curr));
 
 #if defined CK_ENABLE_FP8
                 // set softer tolerances for fp8
@@ -20,6 +20,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -167,6 +168,9 @@ bool profile_gemm_streamk_impl(int do_verification,
 
         if(op_ptr->IsSupportedArgument(argument_ptr.get()))
         {
+            // the verification below belongs to this instance
+            begin_profile_instance();
+
             // re-init C to zero before profiling next kernel
             c_device_buf.SetZero();
 
@@ -176,7 +180,8 @@ bool profile_gemm_streamk_impl(int do_verification,
             {
                 c_device_buf.FromDevice(c_m_n_device_result.mData.data());
 
-                pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                pass = pass & report_verification(ck::utils::check_err(
+                                  c_m_n_device_result, c_m_n_host_result));
 
                 if(do_log)
                 {
@@ -203,8 +208,7 @@ bool profile_gemm_streamk_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
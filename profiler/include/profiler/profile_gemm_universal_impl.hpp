@@ -8,6 +8,7 @@
 #include <typeinfo>
 
 #include "ck/ck.hpp"
+#include "ck/host_utility/hip_check_error.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle_v3.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
@@ -20,6 +21,8 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "profiler/gemm_cost_model.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -116,11 +119,19 @@ bool profile_gemm_universal_impl(int do_verification,
                                                                 CElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+    auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
         DeviceOp>::GetInstances();
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
+    // with --top-k, only the instances that the cost model ranks best
+    const auto get_num_cu = [] {
+        hipDeviceProp_t props;
+        hip_check_error(hipGetDeviceProperties(&props, 0));
+        return props.multiProcessorCount;
+    };
+    select_gemm_instances(op_ptrs, M, N, K, sizeof(ADataType), get_num_cu, std::max(KBatch, 1));
+
     // Run reference GEMM
     if(do_verification)
     {
@@ -180,6 +191,8 @@ bool profile_gemm_universal_impl(int do_verification,
 
             if(op_ptr->IsSupportedArgument(argument_ptr.get()))
             {
+                // the verification below belongs to this instance
+                begin_profile_instance();
 
                 // re-init C to zero before profiling next kernel
                 c_device_buf.SetZero();
@@ -191,7 +204,8 @@ bool profile_gemm_universal_impl(int do_verification,
                 {
                     c_device_buf.FromDevice(c_m_n_device_result.mData.data());
 
-                    pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                    pass = pass & report_verification(ck::utils::check_err(
+                                      c_m_n_device_result, c_m_n_host_result));
 
                     if(do_log)
                     {
@@ -226,9 +240,11 @@ bool profile_gemm_universal_impl(int do_verification,
 
                 float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-                std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops
-                          << " TFlops, " << gb_per_sec << " GB/s, " << op_name << ", KBatch "
-                          << kbatch_curr << std::endl;
+                report_profile_result(op_name,
+                                      ave_time,
+                                      tflops,
+                                      gb_per_sec,
+                                      "KBatch " + std::to_string(kbatch_curr));
 
 #if defined CK_ENABLE_FP8
                 // set softer tolerances for fp8
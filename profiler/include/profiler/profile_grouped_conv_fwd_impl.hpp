@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <typeinfo>
 
 #include "ck/ck.hpp"
@@ -17,10 +19,12 @@
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_reference_cache.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -109,33 +113,52 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
     in_device_buf.ToDevice(input.mData.data());
     wei_device_buf.ToDevice(weight.mData.data());
 
-    // run reference op
+    // run reference op on host threads while the instances are set up, joined at the first check
+    std::future<bool> ref_result;
     if(do_verification)
     {
-        auto ref_conv = ck::tensor_operation::host::ReferenceConvFwd<NDimSpatial,
-                                                                     InDataType,
-                                                                     WeiDataType,
-                                                                     OutDataType,
-                                                                     InElementOp,
-                                                                     WeiElementOp,
-                                                                     OutElementOp>{};
-
-        auto ref_invoker  = ref_conv.MakeInvoker();
-        auto ref_argument = ref_conv.MakeArgument(input,
-                                                  weight,
-                                                  host_output,
-                                                  conv_param.conv_filter_strides_,
-                                                  conv_param.conv_filter_dilations_,
-                                                  conv_param.input_left_pads_,
-                                                  conv_param.input_right_pads_,
-                                                  in_element_op,
-                                                  wei_element_op,
-                                                  out_element_op);
-
-        // init host output to zero
-        host_output.SetZero();
-
-        ref_invoker.Run(ref_argument);
+        auto make_key = [&] {
+            std::ostringstream conv_desc;
+            conv_desc << conv_param;
+
+            return ck::utils::ReferenceCacheKey("ReferenceConvFwd")
+                .Add(conv_desc.str())
+                .AddType<OutDataType>()
+                .AddDescriptor(host_output.mDesc)
+                .AddTensor(input)
+                .AddTensor(weight)
+                .AddElementOp(in_element_op)
+                .AddElementOp(wei_element_op)
+                .AddElementOp(out_element_op);
+        };
+
+        ref_result = ck::utils::run_cached_reference_async(
+            ck::utils::ReferenceCache::GetDefault(), host_output, make_key, [&] {
+                auto ref_conv = ck::tensor_operation::host::ReferenceConvFwd<NDimSpatial,
+                                                                             InDataType,
+                                                                             WeiDataType,
+                                                                             OutDataType,
+                                                                             InElementOp,
+                                                                             WeiElementOp,
+                                                                             OutElementOp>{};
+
+                auto ref_invoker  = ref_conv.MakeInvoker();
+                auto ref_argument = ref_conv.MakeArgument(input,
+                                                          weight,
+                                                          host_output,
+                                                          conv_param.conv_filter_strides_,
+                                                          conv_param.conv_filter_dilations_,
+                                                          conv_param.input_left_pads_,
+                                                          conv_param.input_right_pads_,
+                                                          in_element_op,
+                                                          wei_element_op,
+                                                          out_element_op);
+
+                // init host output to zero
+                host_output.SetZero();
+
+                ref_invoker.Run(ref_argument);
+            });
     }
 
     std::string best_op_name;
@@ -166,8 +189,7 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / avg_time;
 
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, avg_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -181,7 +203,12 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
             {
                 out_device_buf.FromDevice(device_output.mData.data());
 
-                pass = pass & ck::utils::check_err(device_output, host_output);
+                if(ref_result.valid())
+                {
+                    ref_result.get();
+                }
+
+                pass = pass & report_verification(ck::utils::check_err(device_output, host_output));
 
                 if(do_log)
                 {
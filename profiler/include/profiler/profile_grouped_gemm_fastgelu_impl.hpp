@@ -16,6 +16,7 @@
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/device_grouped_gemm.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -197,8 +198,7 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
             float tflops = static_cast<float>(flop) / 1.E9 / ave_time;
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
-            std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << gemm_name << std::endl;
+            report_profile_result(gemm_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -237,8 +237,8 @@ bool profile_grouped_gemm_fastgelu_impl(int do_verification,
 
                     ref_invoker.Run(ref_argument);
 
-                    bool group_pass =
-                        ck::utils::check_err(c_m_n_device_results[i], c_m_n_host_result);
+                    bool group_pass = report_verification(ck::utils::check_err(
+                        c_m_n_device_results[i], c_m_n_host_result));
                     pass = pass && group_pass;
 
                     std::cout << "group: " << i << " verification result: " << std::boolalpha
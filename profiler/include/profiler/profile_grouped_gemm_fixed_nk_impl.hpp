@@ -20,6 +20,7 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/utility/fill.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -270,6 +271,9 @@ bool profile_grouped_gemm_fixed_nk_impl(int do_verification,
 
             if(gemm_ptr->IsSupportedArgument(argument_ptr.get()))
             {
+                // the verification below belongs to this instance
+                begin_profile_instance();
+
                 for(std::size_t i = 0; i < gemm_descs.size(); i++)
                     c_device_buf[i]->SetZero();
 
@@ -287,16 +291,18 @@ bool profile_grouped_gemm_fixed_nk_impl(int do_verification,
                         if(std::is_same_v<CDataType, ck::half_t> && kbatch_curr > 1)
                         {
                             instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i],
-                                                                      "Error: Incorrect results!",
-                                                                      0.06);
+                                instance_pass && report_verification(ck::utils::check_err(
+                                                     c_m_n_device_results[i],
+                                                     c_m_n_host_results[i],
+                                                     "Error: Incorrect results!",
+                                                     0.06));
                         }
                         else
                         {
                             instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i]);
+                                instance_pass && report_verification(ck::utils::check_err(
+                                                     c_m_n_device_results[i],
+                                                     c_m_n_host_results[i]));
                         }
 
                         if(do_log)
@@ -338,9 +344,11 @@ bool profile_grouped_gemm_fixed_nk_impl(int do_verification,
                     float tflops = static_cast<float>(flop) / 1.E9 / ave_time;
 
                     float gb_per_sec = num_btype / 1.E6 / ave_time;
-                    std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops
-                              << " TFlops, " << gb_per_sec << " GB/s, " << gemm_name << ", KBatch "
-                              << kbatch_curr << std::endl;
+                    report_profile_result(gemm_name,
+                                          ave_time,
+                                          tflops,
+                                          gb_per_sec,
+                                          "KBatch " + std::to_string(kbatch_curr));
 
                     if(tflops > best_tflops)
                     {
@@ -19,6 +19,7 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/utility/fill.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -241,6 +242,9 @@ bool profile_grouped_gemm_tile_loop_impl(int do_verification,
 
         if(gemm_ptr->IsSupportedArgument(argument_ptr.get()))
         {
+            // the verification below belongs to this instance
+            begin_profile_instance();
+
             invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, false, 0, n_warmup, n_iter});
             if(do_verification)
             {
@@ -248,8 +252,9 @@ bool profile_grouped_gemm_tile_loop_impl(int do_verification,
                 for(std::size_t i = 0; i < gemm_descs.size(); i++)
                 {
                     c_device_buf[i]->FromDevice(c_m_n_device_results[i].mData.data());
-                    instance_pass = instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                          c_m_n_host_results[i]);
+                    instance_pass = instance_pass && report_verification(ck::utils::check_err(
+                                                         c_m_n_device_results[i],
+                                                         c_m_n_host_results[i]));
 
                     if(do_log)
                     {
@@ -288,8 +293,7 @@ bool profile_grouped_gemm_tile_loop_impl(int do_verification,
 
                 float tflops     = static_cast<float>(flop) / 1.E9 / ave_time;
                 float gb_per_sec = num_btype / 1.E6 / ave_time;
-                std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops
-                          << " TFlops, " << gb_per_sec << " GB/s, " << gemm_name << std::endl;
+                report_profile_result(gemm_name, ave_time, tflops, gb_per_sec);
 
                 if(tflops > best_tflops)
                 {
@@ -12,6 +12,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_groupnorm_bwd.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -191,9 +192,7 @@ bool profile_groupnorm_bwd_data_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -205,8 +204,8 @@ bool profile_groupnorm_bwd_data_impl(int do_verification,
         if(do_verification)
         {
             dx_dev.FromDevice(dx.mData.data());
-            bool pass = ck::utils::check_err(
-                dx.mData, host_dx.mData, "Error: Incorrect results", 1e-3, 1e-3);
+            bool pass = report_verification(ck::utils::check_err(
+                dx.mData, host_dx.mData, "Error: Incorrect results", 1e-3, 1e-3));
 
             if(do_log)
             {
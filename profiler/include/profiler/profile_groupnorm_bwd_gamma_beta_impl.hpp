@@ -12,6 +12,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_groupnorm_bwd.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -198,9 +199,7 @@ bool profile_groupnorm_bwd_gamma_beta_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -213,10 +212,11 @@ bool profile_groupnorm_bwd_gamma_beta_impl(int do_verification,
         {
             dgamma_dev.FromDevice(dgamma.mData.data());
             dbeta_dev.FromDevice(dbeta.mData.data());
-            bool pass =
-                ck::utils::check_err(dgamma, host_dgamma, "Error: Incorrect dgamma", 1e-3, 1e-3);
+            bool pass = report_verification(ck::utils::check_err(
+                dgamma, host_dgamma, "Error: Incorrect dgamma", 1e-3, 1e-3));
 
-            pass &= ck::utils::check_err(dbeta, host_dbeta, "Error: Incorrect dbeta", 1e-3, 1e-3);
+            pass &= report_verification(ck::utils::check_err(
+                dbeta, host_dbeta, "Error: Incorrect dbeta", 1e-3, 1e-3));
 
             if(do_log)
             {
@@ -14,6 +14,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_groupnorm.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -203,9 +204,7 @@ bool profile_groupnorm_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -217,20 +216,21 @@ bool profile_groupnorm_impl(int do_verification,
         if(do_verification)
         {
             y_dev.FromDevice(y.mData.data());
-            bool pass = ck::utils::check_err(y, host_y, "Error: Incorrect results", 1e-3, 1e-3);
+            bool pass = report_verification(ck::utils::check_err(
+                y, host_y, "Error: Incorrect results", 1e-3, 1e-3));
 
             if constexpr(SaveMeanInvStd)
             {
                 save_mean_dev.FromDevice(save_mean.mData.data());
-                pass &= ck::utils::check_err(
-                    save_mean.mData, host_save_mean.mData, "Error: Incorrect results", 1e-3, 1e-3);
+                pass &= report_verification(ck::utils::check_err(
+                    save_mean.mData, host_save_mean.mData, "Error: Incorrect results", 1e-3, 1e-3));
 
                 save_inv_std_dev.FromDevice(save_inv_std.mData.data());
-                pass &= ck::utils::check_err(save_inv_std.mData,
-                                             host_save_inv_std.mData,
-                                             "Error: Incorrect results",
-                                             1e-3,
-                                             1e-3);
+                pass &= report_verification(ck::utils::check_err(save_inv_std.mData,
+                                                                 host_save_inv_std.mData,
+                                                                 "Error: Incorrect results",
+                                                                 1e-3,
+                                                                 1e-3));
             }
 
             if(do_log)
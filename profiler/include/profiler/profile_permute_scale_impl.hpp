@@ -21,6 +21,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -105,6 +106,9 @@ bool profile_permute_scale_impl(int do_verification,
 
         if(op_ptr->IsSupportedArgument(argument_ptr.get()))
         {
+            // the verification below belongs to this instance
+            begin_profile_instance();
+
             instance_found = true;
 
             b_device_buf.SetZero();
@@ -114,8 +118,8 @@ bool profile_permute_scale_impl(int do_verification,
             {
                 b_device_buf.FromDevice(b.mData.data());
 
-                pass &= ck::utils::check_err(
-                    b.mData, host_b.mData, "Error: Incorrect results b", 1e-3, 1e-3);
+                pass &= report_verification(ck::utils::check_err(
+                    b.mData, host_b.mData, "Error: Incorrect results b", 1e-3, 1e-3));
 
                 if(do_log)
                 {
@@ -139,8 +143,7 @@ bool profile_permute_scale_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
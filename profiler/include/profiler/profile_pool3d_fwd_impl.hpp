@@ -13,6 +13,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -198,9 +199,7 @@ bool profile_pool3d_fwd_impl(int do_verification,
 
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-        if(time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
         if(avg_time < best_avg_time)
         {
@@ -213,18 +212,18 @@ bool profile_pool3d_fwd_impl(int do_verification,
         {
             out_device_buf.FromDevice(out_n_c_do_ho_wo_device.mData.data());
 
-            bool pass = ck::utils::check_err(out_n_c_do_ho_wo_device.mData,
-                                             out_n_c_do_ho_wo_host.mData,
-                                             "Error: Incorrect results",
-                                             1e-3,
-                                             1e-3);
+            bool pass = report_verification(ck::utils::check_err(out_n_c_do_ho_wo_device.mData,
+                                                                 out_n_c_do_ho_wo_host.mData,
+                                                                 "Error: Incorrect results",
+                                                                 1e-3,
+                                                                 1e-3));
 
             if constexpr(OutputIndex)
             {
                 out_indices_device_buf.FromDevice(out_indices_n_c_do_ho_wo_device.mData.data());
 
-                pass = pass && ck::utils::check_err(out_indices_n_c_do_ho_wo_device,
-                                                    out_indices_n_c_do_ho_wo_host);
+                pass = pass && report_verification(ck::utils::check_err(
+                                   out_indices_n_c_do_ho_wo_device, out_indices_n_c_do_ho_wo_host));
             }
 
             if(do_log)
@@ -13,6 +13,7 @@
 #include "ck/library/reference_tensor_operation/cpu/reference_reduce.hpp"
 #include "ck/library/utility/host_common_util.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -388,9 +389,7 @@ bool profile_reduce_impl_impl(bool do_verification,
 
             float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-            if(time_kernel)
-                std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                          << reduce_name << std::endl;
+            report_profile_result(reduce_name, avg_time, gb_per_sec, time_kernel);
 
             if(gb_per_sec > best_gb_per_sec)
             {
@@ -403,12 +402,13 @@ bool profile_reduce_impl_impl(bool do_verification,
                 bool single_pass;
 
                 out_dev.FromDevice(out.mData.data());
-                single_pass = ck::utils::check_err(out, out_ref);
+                single_pass = report_verification(ck::utils::check_err(out, out_ref));
 
                 if(OutputIndex)
                 {
                     out_indices_dev.FromDevice(out_indices.mData.data());
-                    single_pass = single_pass && ck::utils::check_err(out_indices, out_indices_ref);
+                    single_pass = single_pass && report_verification(ck::utils::check_err(
+                                                     out_indices, out_indices_ref));
                 };
 
                 if(!single_pass)
@@ -0,0 +1,510 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "profiler/profile_result_sink.hpp"
+
+namespace ck {
+namespace profiler {
+
+namespace detail {
+
+inline std::runtime_error result_parse_error(const std::string& name,
+                                             int line_no,
+                                             const std::string& reason = "not a ckProfiler result")
+{
+    return std::runtime_error("wrong! " + name + ":" + std::to_string(line_no) + ": " + reason);
+}
+
+// One object of a JSON lines result file: string, number and null members only
+inline std::map<std::string, std::string> parse_json_object(const std::string& line, bool& ok)
+{
+    std::map<std::string, std::string> members;
+    std::size_t i = 0;
+
+    auto skip_blank = [&] {
+        while(i < line.size() && std::isspace(static_cast<unsigned char>(line[i])))
+            ++i;
+    };
+    auto expect = [&](char c) {
+        skip_blank();
+        ok = ok && i < line.size() && line[i] == c;
+        i += ok ? 1 : 0;
+    };
+    auto read_string = [&] {
+        std::string s;
+        expect('"');
+        while(ok && i < line.size() && line[i] != '"')
+        {
+            if(line[i] == '\\' && i + 1 < line.size())
+            {
+                const char c = line[++i];
+                if(c == 'u' && i + 4 < line.size())
+                {
+                    s += static_cast<char>(std::strtol(line.substr(i + 1, 4).c_str(), nullptr, 16));
+                    i += 4;
+                }
+                else
+                {
+                    s += c == 'n' ? '\n' : c == 't' ? '\t' : c;
+                }
+            }
+            else
+            {
+                s += line[i];
+            }
+            ++i;
+        }
+        expect('"');
+        return s;
+    };
+
+    ok = true;
+    expect('{');
+    while(ok)
+    {
+        const std::string key = read_string();
+        expect(':');
+        skip_blank();
+
+        if(i < line.size() && line[i] == '"')
+        {
+            members[key] = read_string();
+        }
+        else
+        {
+            const std::size_t end = line.find_first_of(",}", i);
+            ok                    = ok && end != std::string::npos;
+            if(ok)
+            {
+                const std::string value = line.substr(i, end - i);
+                members[key]            = value == "null" ? "" : value;
+                i                       = end;
+            }
+        }
+
+        skip_blank();
+        if(i < line.size() && line[i] == ',')
+        {
+            ++i;
+            continue;
+        }
+        expect('}');
+        break;
+    }
+
+    return members;
+}
+
+// One row of a CSV result file, fields may be quoted with "" escapes
+inline std::vector<std::string> parse_csv_row(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+
+    for(std::size_t i = 0; i < line.size(); ++i)
+    {
+        const char c = line[i];
+        if(quoted && c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+        {
+            fields.back() += '"';
+            ++i;
+        }
+        else if(c == '"')
+        {
+            quoted = !quoted;
+        }
+        else if(c == ',' && !quoted)
+        {
+            fields.emplace_back();
+        }
+        else if(c != '\r')
+        {
+            fields.back() += c;
+        }
+    }
+
+    return fields;
+}
+
+inline ProfileResult make_profile_result(const std::map<std::string, std::string>& members,
+                                         const std::string& name,
+                                         int line_no)
+{
+    auto get = [&](const char* key) {
+        const auto found = members.find(key);
+        if(found == members.end())
+        {
+            throw result_parse_error(name, line_no, std::string("no ") + key);
+        }
+        return found->second;
+    };
+    auto get_float = [&](const char* key) {
+        const std::string value = get(key);
+        try
+        {
+            return value.empty() ? 0.f : std::stof(value);
+        }
+        catch(const std::logic_error&)
+        {
+            throw result_parse_error(
+                name, line_no, std::string("bad ") + key + " \"" + value + "\"");
+        }
+    };
+
+    ProfileResult r;
+    r.op         = get("op");
+    r.problem    = get("problem");
+    r.instance   = get("instance");
+    r.params     = get("params");
+    r.ave_time   = get_float("ave_time_ms");
+    r.gb_per_sec = get_float("gb_per_sec");
+    if(!get("tflops").empty())
+    {
+        r.tflops = get_float("tflops");
+    }
+
+    const std::string verification = get("verification");
+    r.verification                 = verification == "pass"   ? VerificationStatus::Pass
+                                     : verification == "fail" ? VerificationStatus::Fail
+                                                              : VerificationStatus::NotRun;
+    return r;
+}
+
+} // namespace detail
+
+// Read a file written by ckProfiler --result, CSV or JSON lines
+inline std::vector<ProfileResult>
+read_profile_results(std::istream& is, bool csv, const std::string& name = "result file")
+{
+    std::vector<ProfileResult> results;
+    std::vector<std::string> header;
+
+    std::string line;
+    for(int line_no = 1; std::getline(is, line); ++line_no)
+    {
+        if(line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+
+        std::map<std::string, std::string> members;
+        if(csv)
+        {
+            const auto fields = detail::parse_csv_row(line);
+            if(header.empty())
+            {
+                header = fields;
+                continue;
+            }
+            if(fields.size() != header.size())
+            {
+                throw detail::result_parse_error(
+                    name, line_no, "expect " + std::to_string(header.size()) + " fields");
+            }
+            for(std::size_t i = 0; i < fields.size(); ++i)
+            {
+                members[header[i]] = fields[i];
+            }
+        }
+        else
+        {
+            bool ok = true;
+            members = detail::parse_json_object(line, ok);
+            if(!ok)
+            {
+                throw detail::result_parse_error(name, line_no);
+            }
+        }
+
+        results.push_back(detail::make_profile_result(members, name, line_no));
+    }
+
+    return results;
+}
+
+inline std::vector<ProfileResult> read_profile_results(const std::string& path)
+{
+    std::ifstream is(path);
+    if(!is)
+    {
+        throw std::runtime_error("cannot open result file " + path);
+    }
+
+    const bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+
+    return read_profile_results(is, csv, path);
+}
+
+// The problem without the verify, init, log and time arguments of the GEMM family, so that runs
+// with and without verification match
+inline std::string get_problem_key(const ProfileResult& r)
+{
+    std::istringstream is(r.problem);
+    std::vector<std::string> args;
+    for(std::string arg; is >> arg;)
+        args.push_back(arg);
+
+    const bool gemm = r.op.rfind("gemm", 0) == 0 || r.op.rfind("batched_gemm", 0) == 0 ||
+                      r.op.rfind("grouped_gemm", 0) == 0;
+    if(gemm && args.size() > 6)
+    {
+        args.erase(args.begin() + 2, args.begin() + 6);
+    }
+
+    std::string key = r.op;
+    for(const auto& arg : args)
+        key += " " + arg;
+    return key;
+}
+
+struct SampleStats
+{
+    std::size_t count = 0;
+    float median      = 0;
+    float mad         = 0; // median absolute deviation
+};
+
+inline float get_median(std::vector<float> x)
+{
+    if(x.empty())
+    {
+        return 0;
+    }
+
+    const std::size_t mid = x.size() / 2;
+    std::nth_element(x.begin(), x.begin() + mid, x.end());
+    if(x.size() % 2 == 1)
+    {
+        return x[mid];
+    }
+
+    return (x[mid] + *std::max_element(x.begin(), x.begin() + mid)) / 2;
+}
+
+inline SampleStats get_sample_stats(const std::vector<float>& samples)
+{
+    SampleStats stats;
+    stats.count  = samples.size();
+    stats.median = get_median(samples);
+
+    std::vector<float> deviations;
+    for(float x : samples)
+        deviations.push_back(std::abs(x - stats.median));
+    stats.mad = get_median(deviations);
+
+    return stats;
+}
+
+struct CompareOptions
+{
+    // relative change of the median time below which two results count as the same
+    float threshold = 0.05f;
+    // a change must also exceed this many (MAD based) standard deviations of the noisier side
+    float noise_factor = 3.f;
+};
+
+enum struct CompareVerdict
+{
+    Same,
+    Faster,
+    Slower,
+    BaseOnly,
+    TestOnly,
+};
+
+inline const char* to_string(CompareVerdict verdict)
+{
+    switch(verdict)
+    {
+    case CompareVerdict::Same: return "same";
+    case CompareVerdict::Faster: return "faster";
+    case CompareVerdict::Slower: return "REGRESSION";
+    case CompareVerdict::BaseOnly: return "base only";
+    case CompareVerdict::TestOnly: return "test only";
+    }
+
+    return "";
+}
+
+struct ResultComparison
+{
+    std::string problem; // get_problem_key()
+    std::string base_instance;
+    std::string test_instance;
+    SampleStats base;
+    SampleStats test;
+    float speedup          = 0; // base / test median time
+    CompareVerdict verdict = CompareVerdict::Same;
+};
+
+struct CompareReport
+{
+    // matched by (problem, instance, params)
+    std::vector<ResultComparison> instances;
+    // fastest instance of each problem on either side
+    std::vector<ResultComparison> problems;
+
+    std::size_t GetRegressionCount() const
+    {
+        return std::count_if(problems.begin(), problems.end(), [](const auto& c) {
+            return c.verdict == CompareVerdict::Slower;
+        });
+    }
+
+    // geometric mean of the per-problem speedups
+    float GetGeomeanSpeedup() const
+    {
+        double log_sum    = 0;
+        std::size_t count = 0;
+        for(const auto& c : problems)
+        {
+            if(c.speedup > 0)
+            {
+                log_sum += std::log(c.speedup);
+                ++count;
+            }
+        }
+
+        return count == 0 ? 1.f : static_cast<float>(std::exp(log_sum / count));
+    }
+};
+
+inline CompareVerdict
+get_compare_verdict(const SampleStats& base, const SampleStats& test, const CompareOptions& options)
+{
+    if(test.count == 0)
+    {
+        return CompareVerdict::BaseOnly;
+    }
+    if(base.count == 0)
+    {
+        return CompareVerdict::TestOnly;
+    }
+
+    // 1.4826 * MAD estimates the standard deviation of normally distributed samples
+    const float noise = options.noise_factor * 1.4826f * std::max(base.mad, test.mad);
+    const float limit = std::max(options.threshold * base.median, noise);
+    const float delta = test.median - base.median;
+
+    return delta > limit ? CompareVerdict::Slower
+                         : -delta > limit ? CompareVerdict::Faster : CompareVerdict::Same;
+}
+
+/**
+ * @brief Compare the times of two result sets
+ *
+ * Repeated results of the same (problem, instance, params), e.g. from several runs appended to
+ * one file, are samples of one timing; their median is compared and their spread widens the
+ * threshold. Results that failed verification or were not timed are ignored.
+ */
+inline CompareReport compare_profile_results(const std::vector<ProfileResult>& base,
+                                             const std::vector<ProfileResult>& test,
+                                             const CompareOptions& options = {})
+{
+    // problem -> instance + params -> samples of the base (0) and test (1) side
+    std::map<std::string, std::map<std::string, std::array<std::vector<float>, 2>>> samples;
+
+    auto add = [&](const std::vector<ProfileResult>& results, int side) {
+        for(const auto& r : results)
+        {
+            if(r.verification != VerificationStatus::Fail && r.ave_time > 0)
+            {
+                const std::string instance = r.params.empty() ? r.instance
+                                                              : r.instance + ", " + r.params;
+                samples[get_problem_key(r)][instance][side].push_back(r.ave_time);
+            }
+        }
+    };
+    add(base, 0);
+    add(test, 1);
+
+    CompareReport report;
+
+    for(const auto& [problem, instances] : samples)
+    {
+        ResultComparison best;
+        best.problem = problem;
+
+        for(const auto& [instance, times] : instances)
+        {
+            ResultComparison c;
+            c.problem       = problem;
+            c.base_instance = instance;
+            c.test_instance = instance;
+            c.base          = get_sample_stats(times[0]);
+            c.test          = get_sample_stats(times[1]);
+            c.speedup       = c.base.count && c.test.count ? c.base.median / c.test.median : 0;
+            c.verdict       = get_compare_verdict(c.base, c.test, options);
+            report.instances.push_back(c);
+
+            if(c.base.count && (best.base.count == 0 || c.base.median < best.base.median))
+            {
+                best.base_instance = instance;
+                best.base          = c.base;
+            }
+            if(c.test.count && (best.test.count == 0 || c.test.median < best.test.median))
+            {
+                best.test_instance = instance;
+                best.test          = c.test;
+            }
+        }
+
+        best.speedup = best.base.count && best.test.count ? best.base.median / best.test.median : 0;
+        best.verdict = get_compare_verdict(best.base, best.test, options);
+        report.problems.push_back(best);
+    }
+
+    return report;
+}
+
+inline void print_compare_report(std::ostream& os, const CompareReport& report, bool all_instances)
+{
+    auto print = [&](const ResultComparison& c, bool instance) {
+        os << std::setw(10) << to_string(c.verdict) << "  " << std::setw(10) << c.base.median
+           << " ms -> " << std::setw(10) << c.test.median << " ms, " << std::setw(6)
+           << c.speedup << "x, " << c.problem;
+        if(instance || c.base_instance != c.test_instance)
+        {
+            os << ", " << (c.base.count ? c.base_instance : "-");
+        }
+        if(!instance && c.base_instance != c.test_instance)
+        {
+            os << " -> " << (c.test.count ? c.test_instance : "-");
+        }
+        os << std::endl;
+    };
+
+    os << "best instance per problem:" << std::endl;
+    for(const auto& c : report.problems)
+        print(c, false);
+
+    if(all_instances)
+    {
+        os << "per instance:" << std::endl;
+        for(const auto& c : report.instances)
+            print(c, true);
+    }
+
+    os << report.problems.size() << " problems, " << report.GetRegressionCount()
+       << " regressions, geomean speedup " << report.GetGeomeanSpeedup() << "x" << std::endl;
+}
+
+} // namespace profiler
+} // namespace ck
@@ -0,0 +1,382 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ck {
+namespace profiler {
+
+enum struct VerificationStatus
+{
+    NotRun,
+    Pass,
+    Fail,
+};
+
+inline const char* to_string(VerificationStatus status)
+{
+    switch(status)
+    {
+    case VerificationStatus::NotRun: return "not_run";
+    case VerificationStatus::Pass: return "pass";
+    case VerificationStatus::Fail: return "fail";
+    }
+
+    return "";
+}
+
+// One profiled (problem, instance) pair
+struct ProfileResult
+{
+    std::string op;       // ckProfiler operation, e.g. "gemm"
+    std::string problem;  // operation arguments as given on the command line
+    std::string instance; // device op type string
+    std::string params;   // run parameters outside the type string, e.g. "KBatch 4"
+    float ave_time = 0;   // ms
+    std::optional<float> tflops;
+    float gb_per_sec                = 0;
+    VerificationStatus verification = VerificationStatus::NotRun;
+    bool timed                      = true; // false if the kernel ran without timing
+};
+
+struct ResultSink
+{
+    virtual ~ResultSink() = default;
+
+    virtual void Write(const ProfileResult& result) = 0;
+
+    // sinks that record the verification status get a result once it is known
+    virtual bool IsDeferred() const { return true; }
+};
+
+// The human readable "Perf: ..." lines, written as soon as the timing is known. Untimed results
+// have no line
+struct TextResultSink : public ResultSink
+{
+    explicit TextResultSink(std::ostream& os) : os_(os) {}
+
+    void Write(const ProfileResult& r) override
+    {
+        if(!r.timed)
+        {
+            return;
+        }
+
+        os_ << "Perf: " << std::setw(10) << r.ave_time << " ms, ";
+        if(r.tflops)
+        {
+            os_ << *r.tflops << " TFlops, ";
+        }
+        os_ << r.gb_per_sec << " GB/s, " << r.instance;
+        if(!r.params.empty())
+        {
+            os_ << ", " << r.params;
+        }
+        os_ << std::endl;
+    }
+
+    bool IsDeferred() const override { return false; }
+
+    private:
+    std::ostream& os_;
+};
+
+namespace detail {
+
+inline std::string json_string(const std::string& s)
+{
+    std::string out = "\"";
+    for(char c : s)
+    {
+        if(c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            out += buf;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+inline std::string csv_string(const std::string& s)
+{
+    std::string out = "\"";
+    for(char c : s)
+    {
+        out += c;
+        if(c == '"')
+        {
+            out += '"';
+        }
+    }
+    return out + "\"";
+}
+
+// results are written to a stream owned by the sink, or to one the caller keeps alive
+struct SinkStream
+{
+    explicit SinkStream(std::ostream& os) : os_(&os) {}
+
+    explicit SinkStream(const std::string& path)
+        : file_(std::make_unique<std::ofstream>(path)), os_(file_.get())
+    {
+        if(!*file_)
+        {
+            throw std::runtime_error("cannot open result file " + path);
+        }
+    }
+
+    std::ostream& Get() { return *os_; }
+
+    private:
+    std::unique_ptr<std::ofstream> file_;
+    std::ostream* os_;
+};
+
+} // namespace detail
+
+// One JSON object per line
+struct JsonLinesResultSink : public ResultSink
+{
+    template <typename Output>
+    explicit JsonLinesResultSink(Output&& output) : stream_(std::forward<Output>(output))
+    {
+    }
+
+    void Write(const ProfileResult& r) override
+    {
+        auto& os = stream_.Get();
+
+        os << "{\"op\":" << detail::json_string(r.op)
+           << ",\"problem\":" << detail::json_string(r.problem)
+           << ",\"instance\":" << detail::json_string(r.instance)
+           << ",\"params\":" << detail::json_string(r.params) << ",\"ave_time_ms\":" << r.ave_time
+           << ",\"tflops\":";
+        if(r.tflops)
+        {
+            os << *r.tflops;
+        }
+        else
+        {
+            os << "null";
+        }
+        os << ",\"gb_per_sec\":" << r.gb_per_sec << ",\"verification\":\""
+           << to_string(r.verification) << "\"}" << std::endl;
+    }
+
+    private:
+    detail::SinkStream stream_;
+};
+
+// A header row, then one row per result
+struct CsvResultSink : public ResultSink
+{
+    template <typename Output>
+    explicit CsvResultSink(Output&& output) : stream_(std::forward<Output>(output))
+    {
+        stream_.Get() << "op,problem,instance,params,ave_time_ms,tflops,gb_per_sec,verification"
+                      << std::endl;
+    }
+
+    void Write(const ProfileResult& r) override
+    {
+        auto& os = stream_.Get();
+
+        os << detail::csv_string(r.op) << "," << detail::csv_string(r.problem) << ","
+           << detail::csv_string(r.instance) << "," << detail::csv_string(r.params) << ","
+           << r.ave_time << ",";
+        if(r.tflops)
+        {
+            os << *r.tflops;
+        }
+        os << "," << r.gb_per_sec << "," << to_string(r.verification) << std::endl;
+    }
+
+    private:
+    detail::SinkStream stream_;
+};
+
+/**
+ * @brief Process wide destination of the profile_*_impl results
+ *
+ * Report() writes the text sink at once and keeps the result open; verification outcomes
+ * reported afterwards are attached to it and the deferred sinks get it on the next Report() or
+ * Flush(). Routines that verify an instance before timing it call BeginInstance() first, their
+ * outcomes are then held for the upcoming Report(). Results that are complete and printed by
+ * their routine, e.g. the rows of a gemm problem list, go to the deferred sinks with Record().
+ */
+class ProfileResultReporter final
+{
+    ProfileResultReporter() { sinks_.push_back(std::make_unique<TextResultSink>(std::cout)); }
+
+    public:
+    ~ProfileResultReporter() { Flush(); }
+
+    static ProfileResultReporter& GetInstance()
+    {
+        static ProfileResultReporter reporter;
+        return reporter;
+    }
+
+    void AddSink(std::unique_ptr<ResultSink> sink) { sinks_.push_back(std::move(sink)); }
+
+    void SetProblem(std::string op, std::string problem)
+    {
+        op_      = std::move(op);
+        problem_ = std::move(problem);
+    }
+
+    void BeginInstance() { Flush(); }
+
+    void Report(ProfileResult result)
+    {
+        Flush();
+
+        result.op           = result.op.empty() ? op_ : result.op;
+        result.problem      = result.problem.empty() ? problem_ : result.problem;
+        result.verification = Combine(result.verification, staged_);
+        staged_             = VerificationStatus::NotRun;
+
+        for(auto& sink : sinks_)
+        {
+            if(!sink->IsDeferred())
+            {
+                sink->Write(result);
+            }
+        }
+
+        open_ = std::move(result);
+    }
+
+    void Record(ProfileResult result)
+    {
+        Flush();
+
+        result.op      = result.op.empty() ? op_ : result.op;
+        result.problem = result.problem.empty() ? problem_ : result.problem;
+
+        for(auto& sink : sinks_)
+        {
+            if(sink->IsDeferred())
+            {
+                sink->Write(result);
+            }
+        }
+    }
+
+    bool ReportVerification(bool pass)
+    {
+        const auto status = pass ? VerificationStatus::Pass : VerificationStatus::Fail;
+
+        if(open_)
+        {
+            open_->verification = Combine(open_->verification, status);
+        }
+        else
+        {
+            staged_ = Combine(staged_, status);
+        }
+
+        return pass;
+    }
+
+    void Flush()
+    {
+        if(!open_)
+        {
+            return;
+        }
+
+        for(auto& sink : sinks_)
+        {
+            if(sink->IsDeferred())
+            {
+                sink->Write(*open_);
+            }
+        }
+
+        open_.reset();
+    }
+
+    private:
+    static VerificationStatus Combine(VerificationStatus a, VerificationStatus b)
+    {
+        if(a == VerificationStatus::Fail || b == VerificationStatus::Fail)
+        {
+            return VerificationStatus::Fail;
+        }
+
+        return a == VerificationStatus::Pass || b == VerificationStatus::Pass
+                   ? VerificationStatus::Pass
+                   : VerificationStatus::NotRun;
+    }
+
+    std::vector<std::unique_ptr<ResultSink>> sinks_;
+    std::string op_;
+    std::string problem_;
+    std::optional<ProfileResult> open_;
+    VerificationStatus staged_ = VerificationStatus::NotRun;
+};
+
+inline void report_profile_result(const std::string& instance,
+                                  float ave_time,
+                                  float tflops,
+                                  float gb_per_sec,
+                                  std::string params = "")
+{
+    ProfileResult result;
+    result.instance   = instance;
+    result.params     = std::move(params);
+    result.ave_time   = ave_time;
+    result.tflops     = tflops;
+    result.gb_per_sec = gb_per_sec;
+
+    ProfileResultReporter::GetInstance().Report(std::move(result));
+}
+
+// operations without a flop count. Routines that only print timed results pass timed = false for
+// the others, which then still get a row with their verification status
+inline void report_profile_result(const std::string& instance,
+                                  float ave_time,
+                                  float gb_per_sec,
+                                  bool timed = true)
+{
+    ProfileResult result;
+    result.instance   = instance;
+    result.ave_time   = ave_time;
+    result.gb_per_sec = gb_per_sec;
+    result.timed      = timed;
+
+    ProfileResultReporter::GetInstance().Report(std::move(result));
+}
+
+// attach a check_err outcome to the current result, returns pass
+inline bool report_verification(bool pass)
+{
+    return ProfileResultReporter::GetInstance().ReportVerification(pass);
+}
+
+inline void begin_profile_instance() { ProfileResultReporter::GetInstance().BeginInstance(); }
+
+} // namespace profiler
+} // namespace ck
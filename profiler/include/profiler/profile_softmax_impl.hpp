@@ -19,6 +19,7 @@
 #include "ck/tensor_operation/gpu/device/device_softmax.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 #include "ck/utility/data_type.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
@@ -152,16 +153,14 @@ bool profile_softmax_impl(int do_verification,
         auto invoker_ptr = inst_ptr->MakeInvokerPointer();
         float avg_time   = invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, time_kernel});
 
-        if(time_kernel)
-        {
-            std::size_t num_bytes =
-                in.GetElementSize() * sizeof(InDataType) +
-                (beta == 0.0f ? 1 : 2) * out.GetElementSize() * sizeof(OutDataType);
-            float gb_per_sec = num_bytes / 1.E6 / avg_time;
+        std::size_t num_bytes = in.GetElementSize() * sizeof(InDataType) +
+                                (beta == 0.0f ? 1 : 2) * out.GetElementSize() * sizeof(OutDataType);
+        float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
-                      << inst_ptr->GetTypeString() << std::endl;
+        report_profile_result(inst_ptr->GetTypeString(), avg_time, gb_per_sec, time_kernel);
 
+        if(time_kernel)
+        {
             if(avg_time < best_avg_time)
             {
                 best_instance_name = inst_ptr->GetTypeString();
@@ -176,8 +175,8 @@ bool profile_softmax_impl(int do_verification,
             bool pass = true;
             if(std::is_same<InDataType, int8_t>::value)
             {
-                pass = pass && ck::utils::check_err(
-                                   out.mData, out_ref.mData, "Error: Incorrect results!", 0, 1);
+                pass = pass && report_verification(ck::utils::check_err(
+                                   out.mData, out_ref.mData, "Error: Incorrect results!", 0, 1));
                 if(do_log)
                 {
                     LogRangeAsType<int>(std::cout << "in  : ", in.mData, ",") << std::endl;
@@ -188,7 +187,7 @@ bool profile_softmax_impl(int do_verification,
             }
             else
             {
-                pass = pass && ck::utils::check_err(out.mData, out_ref.mData);
+                pass = pass && report_verification(ck::utils::check_err(out.mData, out_ref.mData));
                 if(do_log)
                 {
                     LogRangeAsType<float>(std::cout << "in  : ", in.mData, ",") << std::endl;
@@ -17,27 +17,15 @@
 
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/host_permute.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "profiler/profile_result_sink.hpp"
 
 namespace ck {
 namespace profiler {
 
-template <typename HostTensorA, typename HostTensorB, typename Functor>
-void host_elementwise4D(HostTensorB& B_ndhwc, const HostTensorA& A_ncdhw, Functor functor)
-{
-    for(std::size_t n = 0; n < A_ncdhw.mDesc.GetLengths()[0]; ++n)
-        for(std::size_t c = 0; c < A_ncdhw.mDesc.GetLengths()[1]; ++c)
-            for(std::size_t d = 0; d < A_ncdhw.mDesc.GetLengths()[2]; ++d)
-                for(std::size_t h = 0; h < A_ncdhw.mDesc.GetLengths()[3]; ++h)
-                    for(std::size_t w = 0; w < A_ncdhw.mDesc.GetLengths()[4]; ++w)
-                    {
-                        auto a_val = A_ncdhw(n, c, d, h, w);
-                        functor(B_ndhwc(n, d, h, w, c), a_val);
-                    }
-}
-
 template <typename ADataType, typename BDataType, index_t NumDim>
 bool profile_transpose_impl(int do_verification,
                             int init_method,
@@ -95,7 +83,8 @@ bool profile_transpose_impl(int do_verification,
 
     if(do_verification)
     {
-        host_elementwise4D(host_b, a, ElementOp{});
+        // NCDHW -> NDHWC
+        ck::utils::permute(host_b, a, std::vector<std::size_t>{0, 2, 3, 4, 1}, ElementOp{});
     }
 
     std::string best_op_name;
@@ -112,6 +101,8 @@ bool profile_transpose_impl(int do_verification,
 
         if(op_ptr->IsSupportedArgument(argument_ptr.get()))
         {
+            // the verification below belongs to this instance
+            begin_profile_instance();
 
             // re-init C to zero before profiling next kernel
             b_device_buf.SetZero();
@@ -123,8 +114,8 @@ bool profile_transpose_impl(int do_verification,
             {
                 b_device_buf.FromDevice(b.mData.data());
 
-                pass &= ck::utils::check_err(
-                    b.mData, host_b.mData, "Error: Incorrect results b", 1e-3, 1e-3);
+                pass &= report_verification(ck::utils::check_err(
+                    b.mData, host_b.mData, "Error: Incorrect results b", 1e-3, 1e-3));
 
                 if(do_log)
                 {
@@ -150,8 +141,7 @@ bool profile_transpose_impl(int do_verification,
 
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
-            std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+            report_profile_result(op_name, ave_time, tflops, gb_per_sec);
 
             if(tflops > best_tflops)
             {
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "profiler/profile_result_compare.hpp"
+#include "profiler_operation_registry.hpp"
+
+#define OP_NAME "compare_results"
+#define OP_DESC "Compare two --result files"
+
+static void print_helper_msg()
+{
+    printf("arg1: tensor operation (" OP_NAME ": " OP_DESC ")\n");
+    printf("arg2: base result file (.csv or JSON lines)\n");
+    printf("arg3: test result file (.csv or JSON lines)\n");
+    printf("arg4: regression threshold, relative change of the median time (default 0.05)\n");
+    printf("arg5: regression budget, number of regressed problems allowed (default 0)\n");
+    printf("arg6: print every instance (0: no; 1: yes, default 0)\n");
+}
+
+int profile_compare_results(int argc, char* argv[])
+{
+    if(argc < 4 || argc > 7)
+    {
+        print_helper_msg();
+        return 1;
+    }
+
+    ck::profiler::CompareOptions options;
+    std::size_t budget = 0;
+    bool all_instances = false;
+    try
+    {
+        if(argc > 4)
+        {
+            options.threshold = std::stof(argv[4]);
+        }
+        budget        = argc > 5 ? std::stoul(argv[5]) : 0;
+        all_instances = argc > 6 ? std::stoi(argv[6]) : false;
+    }
+    catch(const std::logic_error&)
+    {
+        std::cerr << "wrong! bad threshold, budget or print argument" << std::endl;
+        print_helper_msg();
+        return 1;
+    }
+
+    try
+    {
+        const auto report = ck::profiler::compare_profile_results(
+            ck::profiler::read_profile_results(argv[2]),
+            ck::profiler::read_profile_results(argv[3]),
+            options);
+
+        ck::profiler::print_compare_report(std::cout, report, all_instances);
+
+        if(report.GetRegressionCount() > budget)
+        {
+            std::cout << "regression budget of " << budget << " exceeded" << std::endl;
+            return 1;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+REGISTER_PROFILER_OPERATION(OP_NAME, OP_DESC, profile_compare_results);
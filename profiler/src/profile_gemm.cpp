@@ -5,8 +5,11 @@
 #include <numeric>
 #include <initializer_list>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
 #include "profiler/profile_gemm_impl.hpp"
+#include "profiler/profile_gemm_batch_impl.hpp"
 #include "profiler_operation_registry.hpp"
 
 enum struct GemmMatrixLayout
@@ -45,12 +48,17 @@ static void print_helper_msg()
               << "optional:\n"
               << "arg14: number of warm-up cycles (default 1)\n"
               << "arg15: number of iterations (default 10)\n"
+              << "batch mode, replacing arg8 to 13:\n"
+              << "--problems shapes.csv: one M,N,K[,StrideA,StrideB,StrideC] problem per line,\n"
+              << "                       prints one CSV row per problem and instance\n"
               << std::endl;
 }
 
 int profile_gemm(int argc, char* argv[])
 {
-    if(argc != 14 && argc != 16)
+    const bool batch_mode = argc >= 10 && std::string(argv[8]) == "--problems";
+
+    if(batch_mode ? argc != 10 && argc != 12 : argc != 14 && argc != 16)
     {
         print_helper_msg();
         exit(1);
@@ -63,20 +71,32 @@ int profile_gemm(int argc, char* argv[])
     const bool do_log          = std::stoi(argv[6]);
     const bool time_kernel     = std::stoi(argv[7]);
 
-    const int M = std::stoi(argv[8]);
-    const int N = std::stoi(argv[9]);
-    const int K = std::stoi(argv[10]);
+    std::vector<ck::profiler::GemmProblem> problems;
+    std::string batch_args;
+    if(batch_mode)
+    {
+        problems = ck::profiler::read_gemm_problems(argv[9]);
+
+        for(int i = 2; i < 8; ++i)
+        {
+            batch_args += (i > 2 ? " " : "") + std::string(argv[i]);
+        }
+    }
 
-    const int StrideA = std::stoi(argv[11]);
-    const int StrideB = std::stoi(argv[12]);
-    const int StrideC = std::stoi(argv[13]);
+    const int M = batch_mode ? 0 : std::stoi(argv[8]);
+    const int N = batch_mode ? 0 : std::stoi(argv[9]);
+    const int K = batch_mode ? 0 : std::stoi(argv[10]);
+
+    const int StrideA = batch_mode ? 0 : std::stoi(argv[11]);
+    const int StrideB = batch_mode ? 0 : std::stoi(argv[12]);
+    const int StrideC = batch_mode ? 0 : std::stoi(argv[13]);
 
     int n_warmup = 1;
     int n_iter   = 10;
-    if(argc == 16)
+    if(argc == (batch_mode ? 12 : 16))
     {
-        n_warmup = std::stoi(argv[14]);
-        n_iter   = std::stoi(argv[15]);
+        n_warmup = std::stoi(argv[argc - 2]);
+        n_iter   = std::stoi(argv[argc - 1]);
     }
     using F32 = float;
     using F16 = ck::half_t;
@@ -110,6 +130,20 @@ int profile_gemm(int argc, char* argv[])
         using AccDataType = decltype(acc_type);
         using CDataType   = decltype(c_type);
 
+        if(batch_mode)
+        {
+            const bool pass = ck::profiler::profile_gemm_batch_impl<ALayout,
+                                                                    BLayout,
+                                                                    CLayout,
+                                                                    ADataType,
+                                                                    BDataType,
+                                                                    AccDataType,
+                                                                    CDataType>(
+                do_verification, init_method, time_kernel, problems, n_warmup, n_iter, batch_args);
+
+            return pass ? 0 : 1;
+        }
+
         const int DefaultStrideA = ck::is_same_v<ALayout, Row> ? K : M;
         const int DefaultStrideB = ck::is_same_v<BLayout, Row> ? N : K;
         const int DefaultStrideC = ck::is_same_v<CLayout, Row> ? N : M;
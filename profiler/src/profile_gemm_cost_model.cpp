@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "profiler/gemm_cost_model.hpp"
+#include "profiler/profile_result_compare.hpp"
+#include "profiler_operation_registry.hpp"
+
+#define OP_NAME "gemm_cost_model"
+#define OP_DESC "Calibrate the GEMM cost model of --top-k from --result files"
+
+static void print_helper_msg()
+{
+    printf("arg1: tensor operation (" OP_NAME ": " OP_DESC ")\n");
+    printf("arg2: number of CUs of the gpu the results were measured on\n");
+    printf("arg3: cost model file to write\n");
+    printf("arg4 and on: result files (.csv or JSON lines) of gemm, gemm_splitk or "
+           "gemm_universal\n");
+}
+
+// Bytes of the A and B elements for the data type argument of the operation
+static int get_elem_bytes(const std::string& op, int data_type)
+{
+    // gemm: fp32, fp16, bf16, int8, fp8; the others: fp32, fp16, bf16, int8, then fp8 and fp16
+    // mixed
+    const std::vector<int> bytes =
+        op == "gemm" ? std::vector<int>{4, 2, 2, 1, 1} : std::vector<int>{4, 2, 2, 1, 2, 2, 2};
+
+    return data_type >= 0 && data_type < static_cast<int>(bytes.size()) ? bytes[data_type] : 0;
+}
+
+static void print_quality(const std::string& name,
+                          const std::vector<std::vector<ck::profiler::GemmCostSample>>& problems,
+                          const ck::profiler::GemmCostModel& model)
+{
+    std::cout << name;
+    for(std::size_t k : {1, 5, 10})
+    {
+        const auto quality = ck::profiler::evaluate_gemm_ranking(problems, model, k);
+        std::cout << ", top " << k << ": best found " << std::setprecision(3)
+                  << quality.hit_rate * 100 << "%, " << quality.mean_regret << "x of best";
+    }
+    std::cout << std::endl;
+}
+
+int profile_gemm_cost_model(int argc, char* argv[])
+{
+    if(argc < 5)
+    {
+        print_helper_msg();
+        return 1;
+    }
+
+    const int num_cu             = std::stoi(argv[2]);
+    const std::string model_path = argv[3];
+
+    // samples per problem
+    std::map<std::string, std::vector<ck::profiler::GemmCostSample>> samples;
+    std::size_t num_skipped = 0;
+
+    try
+    {
+        for(int i = 4; i < argc; ++i)
+        {
+            for(const auto& r : ck::profiler::read_profile_results(argv[i]))
+            {
+                std::istringstream is(r.problem);
+                std::vector<std::string> args;
+                for(std::string arg; is >> arg;)
+                    args.push_back(arg);
+
+                const bool gemm =
+                    r.op == "gemm" || r.op == "gemm_splitk" || r.op == "gemm_universal";
+                const auto tile = ck::profiler::parse_gemm_tile_params(r.instance);
+
+                if(!gemm || !tile || args.size() < 9 ||
+                   r.verification == ck::profiler::VerificationStatus::Fail || r.ave_time <= 0)
+                {
+                    ++num_skipped;
+                    continue;
+                }
+
+                const int elem_bytes = get_elem_bytes(r.op, std::stoi(args[0]));
+                const int k_batch =
+                    r.params.rfind("KBatch ", 0) == 0 ? std::stoi(r.params.substr(7)) : 1;
+
+                ck::profiler::GemmCostSample sample;
+                sample.features = ck::profiler::get_gemm_cost_features(*tile,
+                                                                       std::stoll(args[6]),
+                                                                       std::stoll(args[7]),
+                                                                       std::stoll(args[8]),
+                                                                       elem_bytes,
+                                                                       num_cu,
+                                                                       k_batch);
+                sample.time     = r.ave_time;
+
+                samples[ck::profiler::get_problem_key(r)].push_back(sample);
+            }
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    // fit on all problems, and validate by fitting on one half of the problems and ranking the
+    // other half
+    using Samples = std::vector<ck::profiler::GemmCostSample>;
+    std::vector<Samples> problems;
+    std::array<std::vector<Samples>, 2> half_problems;
+    Samples all;
+    std::array<Samples, 2> half;
+    for(const auto& [problem, s] : samples)
+    {
+        const std::size_t h = problems.size() % 2;
+        problems.push_back(s);
+        half_problems[h].push_back(s);
+        all.insert(all.end(), s.begin(), s.end());
+        half[h].insert(half[h].end(), s.begin(), s.end());
+    }
+
+    std::cout << problems.size() << " problems, " << all.size() << " samples, " << num_skipped
+              << " results skipped" << std::endl;
+    if(all.empty())
+    {
+        return 1;
+    }
+
+    using ck::profiler::GemmCostModel;
+    const auto model = GemmCostModel::Fit(all);
+
+    print_quality("default model", problems, GemmCostModel{});
+    print_quality("fitted model", problems, model);
+    print_quality("half 1 fitted on half 2", half_problems[0], GemmCostModel::Fit(half[1]));
+    print_quality("half 2 fitted on half 1", half_problems[1], GemmCostModel::Fit(half[0]));
+
+    std::cout << "weights: launch " << model.weights[0] << ", compute " << model.weights[1]
+              << ", memory " << model.weights[2] << ", loop " << model.weights[3] << std::endl;
+
+    try
+    {
+        model.Save(model_path);
+    }
+    catch(const std::runtime_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+REGISTER_PROFILER_OPERATION(OP_NAME, OP_DESC, profile_gemm_cost_model);
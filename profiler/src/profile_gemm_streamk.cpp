@@ -43,7 +43,7 @@ int profile_gemm_streamk(int argc, char* argv[])
         printf("arg6: print tensor value (0: no; 1: yes)\n");
         printf("arg7: time kernel (0=no, 1=yes)\n");
         printf("arg8 to 13: M, N, K, StrideA, StrideB, StrideC\n");
-        printf("arg14: num_sk_blocks (optional)\n");
+        printf("arg14: num_sk_blocks (optional, auto: best in a simulation of the launch)\n");
         exit(1);
     }
 
@@ -61,8 +61,17 @@ int profile_gemm_streamk(int argc, char* argv[])
     const int StrideA = std::stoi(argv[11]);
     const int StrideB = std::stoi(argv[12]);
     const int StrideC = std::stoi(argv[13]);
-    const uint32_t NumSKBlocks =
-        argc >= 15 ? static_cast<uint32_t>(std::stoul(std::string(argv[14]))) : 0xffffffff;
+    const std::string sk_blocks = argc >= 15 ? argv[14] : "";
+    // 0xfffffffe: AutoNumSKBlocks of DeviceGemmXdlStreamK
+    uint32_t NumSKBlocks = 0xffffffff;
+    if(sk_blocks == "auto")
+    {
+        NumSKBlocks = 0xfffffffe;
+    }
+    else if(!sk_blocks.empty())
+    {
+        NumSKBlocks = static_cast<uint32_t>(std::stoul(sk_blocks));
+    }
 
     using F32 = float;
     using F16 = ck::half_t;
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ck/library/utility/tuning_db.hpp"
+#include "profiler/profile_result_compare.hpp"
+#include "profiler_operation_registry.hpp"
+
+#define OP_NAME "tuning_db"
+#define OP_DESC "Add the fastest instances of --result files to a tuning database"
+
+static void print_helper_msg()
+{
+    printf("arg1: tensor operation (" OP_NAME ": " OP_DESC ")\n");
+    printf("arg2: tuning database file, created if it does not exist\n");
+    printf("arg3: gpu architecture the results were measured on, e.g. gfx942\n");
+    printf("arg4 and on: result files (.csv or JSON lines) of the GEMM family operations\n");
+}
+
+// A record of a GEMM family result, whose arguments are "datatype layout verify init log time"
+// followed by the shape. Returns false for other results.
+static bool make_tuning_record(const ck::profiler::ProfileResult& r,
+                               const std::string& arch,
+                               ck::utils::TuningRecord& record)
+{
+    const bool gemm = r.op.rfind("gemm", 0) == 0 || r.op.rfind("batched_gemm", 0) == 0 ||
+                      r.op.rfind("grouped_gemm", 0) == 0;
+    if(!gemm || r.verification == ck::profiler::VerificationStatus::Fail || r.ave_time <= 0)
+    {
+        return false;
+    }
+
+    std::istringstream is(r.problem);
+    std::vector<std::string> args;
+    for(std::string arg; is >> arg;)
+        args.push_back(arg);
+
+    if(args.size() <= 6)
+    {
+        return false;
+    }
+
+    record     = ck::utils::TuningRecord{};
+    record.key = {arch, r.op, args[0], args[1]};
+    for(std::size_t i = 6; i < args.size(); ++i)
+    {
+        std::size_t pos = 0;
+        try
+        {
+            record.shape.push_back(std::stoll(args[i], &pos));
+        }
+        catch(const std::logic_error&)
+        {
+            return false;
+        }
+        if(pos != args[i].size())
+        {
+            return false;
+        }
+    }
+
+    record.ave_time = r.ave_time;
+    record.instance = r.instance;
+    record.params   = r.params;
+
+    return true;
+}
+
+int profile_tuning_db(int argc, char* argv[])
+{
+    if(argc < 5)
+    {
+        print_helper_msg();
+        return 1;
+    }
+
+    const std::string db_path = argv[2];
+    const std::string arch    = argv[3];
+
+    try
+    {
+        ck::utils::TuningDb db;
+        if(std::filesystem::exists(db_path))
+        {
+            db.Load(db_path);
+        }
+
+        std::size_t num_result = 0, num_taken = 0;
+        for(int i = 4; i < argc; ++i)
+        {
+            for(const auto& r : ck::profiler::read_profile_results(argv[i]))
+            {
+                ck::utils::TuningRecord record;
+                if(make_tuning_record(r, arch, record))
+                {
+                    ++num_result;
+                    num_taken += db.Add(record) ? 1 : 0;
+                }
+            }
+        }
+
+        db.Save(db_path);
+
+        std::cout << num_result << " results, " << num_taken << " records updated, "
+                  << db.GetRecordCount() << " records in " << db_path << std::endl;
+    }
+    catch(const std::runtime_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+REGISTER_PROFILER_OPERATION(OP_NAME, OP_DESC, profile_tuning_db);
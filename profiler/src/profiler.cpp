@@ -2,17 +2,67 @@
 // Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "profiler/gemm_cost_model.hpp"
+#include "profiler/profile_result_sink.hpp"
 #include "profiler_operation_registry.hpp"
 
 static void print_helper_message()
 {
-    std::cout << "arg1: tensor operation " << ProfilerOperationRegistry::GetInstance() << std::endl;
+    std::cout << "arg1: tensor operation " << ProfilerOperationRegistry::GetInstance() << std::endl
+              << "--result <file>: also write every result with its verification status to "
+                 "<file>, as CSV if it ends in .csv and as JSON lines otherwise"
+              << std::endl
+              << "--top-k <k>: only profile the k GEMM instances that the cost model ranks best"
+              << std::endl
+              << "--cost-model <file>: cost model calibrated by gemm_cost_model, for --top-k"
+              << std::endl;
+}
+
+static bool ends_with(const std::string& s, const std::string& suffix)
+{
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
 }
 
 int main(int argc, char* argv[])
 {
+    // "--result <file>", "--top-k <k>" and "--cost-model <file>" may appear anywhere after the
+    // operation, the operations never see them
+    std::vector<char*> args(argv, argv + argc);
+    std::string result_path, top_k, cost_model_path;
+
+    for(std::size_t i = 2; i < args.size();)
+    {
+        std::string* value = nullptr;
+        if(std::strcmp(args[i], "--result") == 0)
+            value = &result_path;
+        else if(std::strcmp(args[i], "--top-k") == 0)
+            value = &top_k;
+        else if(std::strcmp(args[i], "--cost-model") == 0)
+            value = &cost_model_path;
+
+        if(value != nullptr && i + 1 < args.size())
+        {
+            *value = args[i + 1];
+            args.erase(args.begin() + i, args.begin() + i + 2);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    argc = static_cast<int>(args.size());
+    args.push_back(nullptr);
+    argv = args.data();
+
     if(argc == 1)
     {
         print_helper_message();
@@ -20,7 +70,47 @@ int main(int argc, char* argv[])
     else if(const auto operation = ProfilerOperationRegistry::GetInstance().Get(argv[1]);
             operation.has_value())
     {
-        return (*operation)(argc, argv);
+        auto& reporter = ck::profiler::ProfileResultReporter::GetInstance();
+
+        std::string problem;
+        for(int i = 2; i < argc; ++i)
+        {
+            problem += (i > 2 ? " " : "") + std::string(argv[i]);
+        }
+        reporter.SetProblem(argv[1], problem);
+
+        try
+        {
+            auto& cost_model = ck::profiler::GemmCostModelConfig::GetInstance();
+            if(!top_k.empty())
+            {
+                cost_model.top_k = std::stoul(top_k);
+            }
+            if(!cost_model_path.empty())
+            {
+                cost_model.model.Load(cost_model_path);
+            }
+
+            if(ends_with(result_path, ".csv"))
+            {
+                reporter.AddSink(std::make_unique<ck::profiler::CsvResultSink>(result_path));
+            }
+            else if(!result_path.empty())
+            {
+                reporter.AddSink(std::make_unique<ck::profiler::JsonLinesResultSink>(result_path));
+            }
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const int ret = (*operation)(argc, argv);
+
+        reporter.Flush();
+
+        return ret;
     }
     else
     {
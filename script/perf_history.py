@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+'''
+Local performance history in a SQLite file, needs nothing beyond the python standard library.
+
+  # store the results of one ckProfiler run (written with --result <file>)
+  perf_history.py ingest ck_perf.db gemm.jsonl conv.csv --gpu-arch gfx942 --commit $(git rev-parse HEAD)
+
+  # fastest verified instance of every shape, for the latest commit of a gpu
+  perf_history.py best ck_perf.db --op gemm --gpu-arch gfx942
+
+  # best time of every shape over the commits
+  perf_history.py trend ck_perf.db --op gemm --shape "3840 4096 4096 -1 -1 -1"
+'''
+import os, sys, csv, json, argparse, datetime, sqlite3
+
+SCHEMA = '''
+CREATE TABLE IF NOT EXISTS runs(
+    id INTEGER PRIMARY KEY,
+    datetime TEXT NOT NULL,
+    commit_sha TEXT NOT NULL,
+    branch TEXT NOT NULL,
+    gpu_arch TEXT NOT NULL,
+    node TEXT NOT NULL,
+    compute_units INTEGER,
+    rocm_version TEXT,
+    hip_version TEXT,
+    environment TEXT);
+CREATE TABLE IF NOT EXISTS results(
+    run_id INTEGER NOT NULL REFERENCES runs(id),
+    op TEXT NOT NULL,
+    dtype TEXT NOT NULL,
+    layout TEXT NOT NULL,
+    shape TEXT NOT NULL,
+    instance TEXT NOT NULL,
+    params TEXT NOT NULL,
+    ave_time_ms REAL,
+    tflops REAL,
+    gb_per_sec REAL,
+    verification TEXT NOT NULL);
+CREATE INDEX IF NOT EXISTS runs_by_arch_commit ON runs(gpu_arch, commit_sha, datetime);
+CREATE INDEX IF NOT EXISTS results_by_problem ON results(op, dtype, layout, shape, instance, run_id);
+CREATE INDEX IF NOT EXISTS results_by_run ON results(run_id);
+'''
+
+RUN_FIELDS = ['commit_sha', 'branch', 'gpu_arch', 'node', 'compute_units', 'rocm_version',
+              'hip_version', 'environment']
+
+def connect(path):
+    conn = sqlite3.connect(path)
+    conn.executescript(SCHEMA)
+    return conn
+
+def split_problem(op, problem):
+    '''
+    Split the ckProfiler arguments of a result into (dtype, layout, shape). The GEMM family takes
+    "datatype layout verify init log time <shape...>", the other operations are kept whole.
+    '''
+    args = problem.split()
+    if op.startswith(('gemm', 'batched_gemm', 'grouped_gemm')) and len(args) > 6:
+        return args[0], args[1], ' '.join(args[6:])
+    return '', '', problem
+
+def read_results(filename):
+    '''Rows of a ckProfiler --result file, JSON lines or CSV'''
+    with open(filename, newline='') as f:
+        if filename.endswith('.csv'):
+            rows = list(csv.DictReader(f))
+        else:
+            rows = [json.loads(line) for line in f if line.strip()]
+    for row in rows:
+        for key in ['ave_time_ms', 'tflops', 'gb_per_sec']:
+            value = row.get(key)
+            row[key] = float(value) if value not in (None, '') else None
+    return rows
+
+def add_run(conn, **run):
+    values = [run.get(key) for key in RUN_FIELDS]
+    values = [v if v is not None else '' for v in values[:4]] + values[4:]
+    cur = conn.execute('INSERT INTO runs(datetime, ' + ', '.join(RUN_FIELDS) + ') '
+                       'VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?)',
+                       [run.get('datetime') or str(datetime.datetime.now())] + values)
+    return cur.lastrowid
+
+def add_results(conn, run_id, rows):
+    records = []
+    for row in rows:
+        op = row.get('op', '')
+        dtype, layout, shape = split_problem(op, row.get('problem', ''))
+        records.append((run_id, op, dtype, layout, shape, row.get('instance', ''),
+                        row.get('params', ''), row['ave_time_ms'], row['tflops'],
+                        row['gb_per_sec'], row.get('verification', 'not_run')))
+    conn.executemany('INSERT INTO results VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)', records)
+    return len(records)
+
+def latest_run(conn, gpu_arch=None, branch=None, op=None):
+    query = '''
+        SELECT id FROM runs
+        WHERE (?1 IS NULL OR gpu_arch = ?1) AND (?2 IS NULL OR branch = ?2)
+              AND (?3 IS NULL OR EXISTS (SELECT 1 FROM results WHERE run_id = runs.id AND op = ?3))
+        ORDER BY datetime DESC, id DESC LIMIT 1'''
+    row = conn.execute(query, (gpu_arch, branch, op)).fetchone()
+    return row[0] if row else None
+
+def best_instances(conn, run_id, op=None):
+    '''
+    Fastest instance that did not fail verification, per (op, dtype, layout, shape) of a run. Rows
+    without a time (the legacy logs only keep TFlops) are ranked by TFlops.
+    '''
+    query = '''
+        SELECT op, dtype, layout, shape, instance, params, ave_time_ms, tflops, gb_per_sec
+        FROM (SELECT *, ROW_NUMBER() OVER (PARTITION BY op, dtype, layout, shape
+                                           ORDER BY ave_time_ms IS NULL, ave_time_ms,
+                                                    tflops DESC) AS rank
+              FROM results
+              WHERE run_id = ?1 AND (?2 IS NULL OR op = ?2) AND verification != 'fail'
+                    AND (ave_time_ms > 0 OR tflops > 0))
+        WHERE rank = 1
+        ORDER BY op, dtype, layout, shape'''
+    return conn.execute(query, (run_id, op)).fetchall()
+
+def trend(conn, op, shape=None, instance=None, gpu_arch=None, branch=None):
+    '''Best time per (shape, run) in run order, optionally for a single instance'''
+    query = '''
+        SELECT r.datetime, r.commit_sha, r.gpu_arch, s.dtype, s.layout, s.shape,
+               MIN(s.ave_time_ms), MAX(s.tflops)
+        FROM results s JOIN runs r ON r.id = s.run_id
+        WHERE s.op = ?1 AND (?2 IS NULL OR s.shape = ?2) AND (?3 IS NULL OR s.instance = ?3)
+              AND (?4 IS NULL OR r.gpu_arch = ?4) AND (?5 IS NULL OR r.branch = ?5)
+              AND s.verification != 'fail' AND (s.ave_time_ms > 0 OR s.tflops > 0)
+        GROUP BY r.id, s.dtype, s.layout, s.shape
+        ORDER BY s.dtype, s.layout, s.shape, r.datetime, r.id'''
+    return conn.execute(query, (op, shape, instance, gpu_arch, branch)).fetchall()
+
+def print_rows(header, rows):
+    writer = csv.writer(sys.stdout)
+    writer.writerow(header)
+    writer.writerows(rows)
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='Local SQLite history of ckProfiler results')
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    ingest = sub.add_parser('ingest', help='store ckProfiler --result files as one run')
+    ingest.add_argument('db', type=str)
+    ingest.add_argument('files', type=str, nargs='+')
+    ingest.add_argument('--commit', dest='commit_sha', type=str, default='')
+    ingest.add_argument('--branch', type=str, default='')
+    ingest.add_argument('--gpu-arch', type=str, default='')
+    ingest.add_argument('--node', type=str, default=os.uname().nodename)
+
+    best = sub.add_parser('best', help='fastest instance per shape of a run')
+    best.add_argument('db', type=str)
+    best.add_argument('--op', type=str)
+    best.add_argument('--run', type=int, help='run id, default the latest matching run')
+    best.add_argument('--gpu-arch', type=str)
+    best.add_argument('--branch', type=str)
+
+    history = sub.add_parser('trend', help='best time per shape over the runs')
+    history.add_argument('db', type=str)
+    history.add_argument('--op', type=str, required=True)
+    history.add_argument('--shape', type=str)
+    history.add_argument('--instance', type=str)
+    history.add_argument('--gpu-arch', type=str)
+    history.add_argument('--branch', type=str)
+
+    return parser.parse_args()
+
+def main():
+    args = parse_args()
+    conn = connect(args.db)
+
+    if args.command == 'ingest':
+        with conn:
+            run_id = add_run(conn, commit_sha=args.commit_sha, branch=args.branch,
+                             gpu_arch=args.gpu_arch, node=args.node)
+            count = sum(add_results(conn, run_id, read_results(f)) for f in args.files)
+        print("run", run_id, ":", count, "results")
+    elif args.command == 'best':
+        run_id = args.run
+        if run_id is None:
+            run_id = latest_run(conn, args.gpu_arch, args.branch, args.op)
+        if run_id is None:
+            print("no matching run")
+            return 1
+        print_rows(['op', 'dtype', 'layout', 'shape', 'instance', 'params', 'ave_time_ms',
+                    'tflops', 'gb_per_sec'], best_instances(conn, run_id, args.op))
+    elif args.command == 'trend':
+        print_rows(['datetime', 'commit', 'gpu_arch', 'dtype', 'layout', 'shape', 'ave_time_ms',
+                    'tflops'],
+                   trend(conn, args.op, args.shape, args.instance, args.gpu_arch, args.branch))
+
+    conn.close()
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
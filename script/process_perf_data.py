@@ -1,12 +1,7 @@
 #!/usr/bin/env python3
 import os, io, argparse, datetime
 #import numpy as np
-import sqlalchemy
-from sqlalchemy.types import NVARCHAR, Float, Integer
-from sqlalchemy import text
-import pymysql
-import pandas as pd
-from sshtunnel import SSHTunnelForwarder
+import perf_history
 
 def print_to_string(*args, **kwargs):
     output = io.StringIO()
@@ -18,6 +13,8 @@ def print_to_string(*args, **kwargs):
 def parse_args():
     parser = argparse.ArgumentParser(description='Parse results from tf benchmark runs')
     parser.add_argument('filename', type=str, help='Log file to prase or directory containing log files')
+    parser.add_argument('--sqlite', type=str, help='Local SQLite history to use instead of the MySQL server')
+    parser.add_argument('--commit', type=str, default='', help='Commit of the results, for --sqlite')
     args = parser.parse_args()
     files = []
     if os.path.isdir(args.filename):
@@ -147,10 +144,13 @@ def parse_logfile(logfile):
 
 
 def get_baseline(table, connection):
+    import pandas as pd
+    from sqlalchemy import text
     query = text('''SELECT * from '''+table+''' WHERE Datetime = (SELECT MAX(Datetime) FROM '''+table+''' where Branch_ID='develop' );''')
     return pd.read_sql(query, connection)
 
 def store_new_test_result(table_name, test_results, testlist, branch_name, node_id, gpu_arch, compute_units, rocm_vers, hip_vers, environment, connection):
+    import pandas as pd
     params=[str(branch_name),str(node_id),str(gpu_arch),compute_units,str(rocm_vers),str(hip_vers),str(environment),str(datetime.datetime.now())]
     df=pd.DataFrame(data=[params],columns=['Branch_ID','Node_ID','GPU_arch','Compute Units','ROCM_version','HIP_version','Environment','Datetime'])
     df_add=pd.DataFrame(data=[test_results],columns=testlist)
@@ -159,11 +159,29 @@ def store_new_test_result(table_name, test_results, testlist, branch_name, node_
     df.to_sql(table_name,connection,if_exists='append',index=False)
     return 0
 
-def compare_test_to_baseline(baseline,test,testlist):
+def get_sqlite_baseline(table, testlist, conn):
+    run_id = perf_history.latest_run(conn, branch='develop', op=table)
+    if run_id is None:
+        return []
+    rows = dict(conn.execute('SELECT shape, tflops FROM results WHERE run_id = ? AND op = ?', (run_id, table)).fetchall())
+    if not all(test in rows for test in testlist):
+        return []
+    return [rows[test] for test in testlist]
+
+def store_sqlite_test_result(table_name, test_results, testlist, branch_name, node_id, gpu_arch, compute_units, rocm_vers, hip_vers, environment, commit, conn):
+    with conn:
+        run_id = perf_history.add_run(conn, commit_sha=commit, branch=branch_name, gpu_arch=gpu_arch, node=node_id,
+                                      compute_units=compute_units, rocm_version=rocm_vers, hip_version=hip_vers,
+                                      environment=environment)
+        # one row per test, the logs only keep the tflops of the best instance
+        perf_history.add_results(conn, run_id, [{'op': table_name, 'problem': test, 'ave_time_ms': None,
+                                                 'tflops': float(result), 'gb_per_sec': None}
+                                                for test, result in zip(testlist, test_results)])
+    return 0
+
+def compare_test_to_baseline(base_list,test):
     regression=0
-    if not baseline.empty:
-        base=baseline[testlist].to_numpy(dtype='float')
-        base_list=base[0]
+    if len(base_list)>0:
         ave_perf=0
         for i in range(len(base_list)):
             # success criterion:
@@ -213,6 +231,64 @@ def post_test_params(tlist,connection):
     df.to_sql("ck_gemm_test_params",connection,if_exists='replace',index=False, dtype=dtypes)
 '''
 
+def get_table_name(filename, results):
+    testlist=[]
+    table_name=None
+    #save gemm performance tests:
+    if 'perf_gemm.log' in filename:
+        #write the ck_gemm_test_params table only needed once the test set changes
+        #post_test_params(test_list,conn)
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_gemm_tflops"
+    if 'batched_gemm' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_batched_gemm_tflops"
+    if 'grouped_gemm' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_grouped_gemm_tflops"
+    if 'conv_fwd' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_conv_fwd_tflops"
+    if 'conv_bwd_data' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_conv_bwd_data_tflops"
+    if 'gemm_bilinear' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_gemm_bilinear_tflops"
+    if 'reduction' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_reduction_GBps"
+    if 'resnet50_N4' in filename:
+        for i in range(1,50):
+            testlist.append("Layer%i"%i)
+        table_name="ck_resnet50_N4_tflops"
+    if 'resnet50_N256' in filename:
+        for i in range(1,50):
+            testlist.append("Layer%i"%i)
+        table_name="ck_resnet50_N256_tflops"
+    if 'onnx_gemm' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_onnx_gemm_tflops"
+    if 'splitK_gemm' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_splitK_gemm_tflops"
+    if 'mixed_gemm' in filename:
+        for i in range(1,len(results)+1):
+            testlist.append("Test%i"%i)
+        table_name="ck_mixed_gemm_tflops"
+    if table_name is None:
+        raise ValueError("no results table for log file %s" % filename)
+    return table_name, testlist
+
 def main():
     args = parse_args()
     results=[]
@@ -233,6 +309,25 @@ def main():
     results=parse_logfile(filename)
 
     print("Number of tests:",len(results))
+    table_name, testlist = get_table_name(filename, results)
+
+    if args.sqlite:
+        conn = perf_history.connect(args.sqlite)
+        tflops_base = get_sqlite_baseline(table_name, testlist, conn)
+        store_sqlite_test_result(table_name, results, testlist, branch_name, node_id, gpu_arch, compute_units, rocm_vers, hip_vers, environment, args.commit, conn)
+        conn.close()
+    else:
+        tflops_base = store_mysql_test_result(table_name, results, testlist, branch_name, node_id, gpu_arch, compute_units, rocm_vers, hip_vers, environment)
+
+    #compare the results to the baseline if baseline exists
+    regression=0
+    regression=compare_test_to_baseline(tflops_base,results)
+    return regression
+
+def store_mysql_test_result(table_name, results, testlist, branch_name, node_id, gpu_arch, compute_units, rocm_vers, hip_vers, environment):
+    import sqlalchemy
+    from sshtunnel import SSHTunnelForwarder
+
     sql_hostname = '127.0.0.1'
     sql_username = os.environ["dbuser"]
     sql_password = os.environ["dbpassword"]
@@ -253,66 +348,12 @@ def main():
             format(sql_username, sql_password, sql_hostname, tunnel.local_bind_port, sql_main_database))
         conn = sqlEngine.connect()
 
-        #save gemm performance tests:
-        if 'perf_gemm.log' in filename:
-            #write the ck_gemm_test_params table only needed once the test set changes
-            #post_test_params(test_list,conn)
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_gemm_tflops"
-        if 'batched_gemm' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_batched_gemm_tflops"
-        if 'grouped_gemm' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_grouped_gemm_tflops"
-        if 'conv_fwd' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_conv_fwd_tflops"
-        if 'conv_bwd_data' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_conv_bwd_data_tflops"
-        if 'gemm_bilinear' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_gemm_bilinear_tflops"
-        if 'reduction' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_reduction_GBps"
-        if 'resnet50_N4' in filename:
-            for i in range(1,50):
-                testlist.append("Layer%i"%i)
-            table_name="ck_resnet50_N4_tflops"
-        if 'resnet50_N256' in filename:
-            for i in range(1,50):
-                testlist.append("Layer%i"%i)
-            table_name="ck_resnet50_N256_tflops"
-        if 'onnx_gemm' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_onnx_gemm_tflops"
-        if 'splitK_gemm' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_splitK_gemm_tflops"
-        if 'mixed_gemm' in filename:
-            for i in range(1,len(results)+1):
-                testlist.append("Test%i"%i)
-            table_name="ck_mixed_gemm_tflops"
-
-        tflops_base = get_baseline(table_name,conn)
+        baseline = get_baseline(table_name,conn)
+        tflops_base = [] if baseline.empty else list(baseline[testlist].to_numpy(dtype='float')[0])
         store_new_test_result(table_name, results, testlist, branch_name, node_id, gpu_arch, compute_units, rocm_vers, hip_vers, environment, conn)
         conn.close()
 
-    #compare the results to the baseline if baseline exists
-    regression=0
-    regression=compare_test_to_baseline(tflops_base,results,testlist)
-    return regression
+    return tflops_base
 
 if __name__ == '__main__':
     main()
@@ -8,6 +8,9 @@
 # you would also need to set up some environment variables in order to 
 # post your new test results to the database and compare them to the baseline
 # please contact Illia.Silin@amd.com for more details
+#
+# alternatively, add "--sqlite <file>" to keep the history in a local SQLite file,
+# which needs none of the packages above, see perf_history.py for the queries
 
 #process results
 python3 process_perf_data.py perf_gemm.log
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+'''
+Tests of perf_history.py and of the SQLite path of process_perf_data.py, standard library only:
+
+  python3 -m unittest discover -s script -p 'test_*.py'
+'''
+import os, sys, json, tempfile, unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import perf_history
+import process_perf_data
+
+# two instances of two gemm shapes and one of a reduction, as written by ckProfiler --result
+FIXTURE_CSV = '''op,problem,instance,params,ave_time_ms,tflops,gb_per_sec,verification
+"gemm","1 1 1 1 0 5 256 256 256 -1 -1 -1","DeviceGemm<a, ""x"">","",0.5,2,3,pass
+"gemm","1 1 1 1 0 5 256 256 256 -1 -1 -1","DeviceGemm<b>","",0.25,4,6,fail
+"gemm","1 1 1 1 0 5 256 256 256 -1 -1 -1","DeviceGemm<c>","KBatch 2",0.4,2.5,3.5,not_run
+"gemm","1 1 1 1 0 5 512 512 512 -1 -1 -1","DeviceGemm<a, ""x"">","",1.5,8,9,pass
+"reduce","-D 64,32 -R 1 -O 0","DeviceReduce<a>","",0.1,,100,pass
+'''
+
+SHAPE_256 = '256 256 256 -1 -1 -1'
+SHAPE_512 = '512 512 512 -1 -1 -1'
+
+class PerfHistoryTest(unittest.TestCase):
+    def setUp(self):
+        self.dir = tempfile.TemporaryDirectory()
+        self.db = os.path.join(self.dir.name, 'ck_perf.db')
+        self.csv = os.path.join(self.dir.name, 'gemm.csv')
+        with open(self.csv, 'w') as f:
+            f.write(FIXTURE_CSV)
+
+    def tearDown(self):
+        self.dir.cleanup()
+
+    def ingest(self, conn, rows, **run):
+        with conn:
+            run_id = perf_history.add_run(conn, **run)
+            perf_history.add_results(conn, run_id, rows)
+        return run_id
+
+    def test_split_problem(self):
+        self.assertEqual(perf_history.split_problem('gemm', '1 2 1 1 0 5 ' + SHAPE_256),
+                         ('1', '2', SHAPE_256))
+        self.assertEqual(perf_history.split_problem('reduce', '-D 64,32 -R 1'),
+                         ('', '', '-D 64,32 -R 1'))
+
+    def test_read_results(self):
+        rows = perf_history.read_results(self.csv)
+        self.assertEqual(len(rows), 5)
+        self.assertEqual(rows[0]['instance'], 'DeviceGemm<a, "x">')
+        self.assertEqual(rows[2]['params'], 'KBatch 2')
+        self.assertEqual(rows[1]['ave_time_ms'], 0.25)
+        self.assertIsNone(rows[4]['tflops'])
+
+        # the same rows as JSON lines
+        jsonl = os.path.join(self.dir.name, 'gemm.jsonl')
+        with open(jsonl, 'w') as f:
+            for row in rows:
+                f.write(json.dumps(row) + '\n')
+        self.assertEqual(perf_history.read_results(jsonl), rows)
+
+    def test_ingest(self):
+        sys.argv = ['perf_history.py', 'ingest', self.db, self.csv, '--gpu-arch', 'gfx942',
+                    '--commit', 'abc']
+        self.assertEqual(perf_history.main(), 0)
+
+        conn = perf_history.connect(self.db)
+        runs = conn.execute('SELECT id, commit_sha, gpu_arch FROM runs').fetchall()
+        self.assertEqual(runs, [(1, 'abc', 'gfx942')])
+        shapes = conn.execute('SELECT op, dtype, layout, shape FROM results').fetchall()
+        self.assertEqual(shapes[0], ('gemm', '1', '1', SHAPE_256))
+        self.assertEqual(shapes[4], ('reduce', '', '', '-D 64,32 -R 1 -O 0'))
+        conn.close()
+
+    def test_best(self):
+        conn = perf_history.connect(self.db)
+        run_id = self.ingest(conn, perf_history.read_results(self.csv), gpu_arch='gfx942')
+
+        # b is faster but failed verification, c was not verified
+        best = perf_history.best_instances(conn, run_id, 'gemm')
+        self.assertEqual([(row[3], row[4], row[6]) for row in best],
+                         [(SHAPE_256, 'DeviceGemm<c>', 0.4),
+                          (SHAPE_512, 'DeviceGemm<a, "x">', 1.5)])
+
+        # the latest run of an arch and op
+        self.ingest(conn, perf_history.read_results(self.csv)[4:], gpu_arch='gfx942')
+        self.assertEqual(perf_history.latest_run(conn, gpu_arch='gfx942', op='gemm'), run_id)
+        self.assertEqual(perf_history.latest_run(conn, gpu_arch='gfx942'), run_id + 1)
+        self.assertIsNone(perf_history.latest_run(conn, gpu_arch='gfx90a'))
+        conn.close()
+
+    def test_trend(self):
+        conn = perf_history.connect(self.db)
+        rows = perf_history.read_results(self.csv)
+        self.ingest(conn, rows, datetime='2024-01-01', commit_sha='c1', gpu_arch='gfx942')
+        for row in rows:
+            row['ave_time_ms'] *= 0.5
+        self.ingest(conn, rows, datetime='2024-01-02', commit_sha='c2', gpu_arch='gfx942')
+        self.ingest(conn, rows, datetime='2024-01-03', commit_sha='c3', gpu_arch='gfx90a')
+
+        trend = perf_history.trend(conn, 'gemm', shape=SHAPE_256, gpu_arch='gfx942')
+        self.assertEqual([(row[1], row[6]) for row in trend], [('c1', 0.4), ('c2', 0.2)])
+
+        trend = perf_history.trend(conn, 'gemm', instance='DeviceGemm<a, "x">', gpu_arch='gfx942')
+        self.assertEqual([(row[1], row[5], row[6]) for row in trend],
+                         [('c1', SHAPE_256, 0.5), ('c2', SHAPE_256, 0.25),
+                          ('c1', SHAPE_512, 1.5), ('c2', SHAPE_512, 0.75)])
+        conn.close()
+
+class ProcessPerfDataTest(unittest.TestCase):
+    def test_get_table_name(self):
+        self.assertEqual(process_perf_data.get_table_name('logs/perf_gemm.log', [1, 2]),
+                         ('ck_gemm_tflops', ['Test1', 'Test2']))
+        with self.assertRaisesRegex(ValueError, 'perf_unknown.log'):
+            process_perf_data.get_table_name('logs/perf_unknown.log', [1])
+
+    def test_sqlite_baseline(self):
+        conn = perf_history.connect(':memory:')
+        testlist = ['Test1', 'Test2']
+        self.assertEqual(
+            process_perf_data.get_sqlite_baseline('ck_gemm_tflops', testlist, conn), [])
+
+        process_perf_data.store_sqlite_test_result('ck_gemm_tflops', ['10.5', '20'], testlist,
+                                                   'develop', 'node', 'gfx942', 304, '6.1', '6.1',
+                                                   '', 'abc', conn)
+        self.assertEqual(process_perf_data.get_sqlite_baseline('ck_gemm_tflops', testlist, conn),
+                         [10.5, 20.0])
+        # a test missing from the baseline run
+        self.assertEqual(process_perf_data.get_sqlite_baseline('ck_gemm_tflops',
+                                                               testlist + ['Test3'], conn), [])
+        conn.close()
+
+if __name__ == '__main__':
+    unittest.main()
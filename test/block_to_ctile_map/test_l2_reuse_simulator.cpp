@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/grid/block_to_ctile_map.hpp"
+#include "ck/host_utility/l2_reuse_simulator.hpp"
+
+using namespace ck;
+using ck::utility::choose_block_to_ctile_swizzle;
+using ck::utility::L2ReuseOptions;
+using ck::utility::L2ReuseProblem;
+using ck::utility::LruCacheModel;
+using ck::utility::simulate_l2_reuse;
+
+using MapM01 = BlockToCTileMap_M00_N0_M01Adapt<128, 128>;
+using MapN01 = BlockToCTileMap_N00_M0_N01Adapt<128, 128>;
+
+namespace {
+
+// fp32 tiles of 128 x 32 with K contiguous: every row of a tile is one line of 128 bytes, so
+// every tile of A or B is 128 lines
+L2ReuseProblem make_problem(index_t M, index_t N, index_t K, index_t num_slots)
+{
+    return {M, N, K, 128, 128, 32, 4, 4, true, true, num_slots};
+}
+
+// large enough to never evict
+const L2ReuseOptions no_eviction{1 << 30, 16, 128, 1, 0};
+
+} // namespace
+
+TEST(L2ReuseSimulator, LruCache)
+{
+    // 2 sets of 2 ways, the even lines go to set 0
+    LruCacheModel cache(L2ReuseOptions{512, 2, 128, 1, 0});
+
+    EXPECT_FALSE(cache.Access(0));
+    EXPECT_FALSE(cache.Access(2));
+    EXPECT_TRUE(cache.Access(0));
+    EXPECT_FALSE(cache.Access(4)); // evicts 2
+    EXPECT_FALSE(cache.Access(2)); // evicts 0
+    EXPECT_FALSE(cache.Access(0));
+    EXPECT_TRUE(cache.Access(2));
+
+    EXPECT_FALSE(cache.Access(1));
+    EXPECT_TRUE(cache.Access(1));
+    EXPECT_TRUE(cache.Access(2));
+}
+
+TEST(L2ReuseSimulator, CompulsoryMisses)
+{
+    // 2 x 2 tiles of 2 k steps in one wave, A and B are 256 rows of 2 lines
+    const auto sim =
+        simulate_l2_reuse(MapM01(256, 256), make_problem(256, 256, 64, 4), no_eviction);
+
+    EXPECT_EQ(sim.accesses, 4 * 2 * (128 + 128));
+    EXPECT_EQ(sim.misses, 2 * 256 * 2);
+    EXPECT_EQ(sim.dram_bytes, sim.misses * 128);
+    EXPECT_DOUBLE_EQ(sim.hit_rate, 0.5);
+
+    // A with M contiguous: 64 rows of 256 floats, 8 lines each
+    auto problem           = make_problem(256, 256, 64, 4);
+    problem.a_k_contiguous = false;
+    EXPECT_EQ(simulate_l2_reuse(MapM01(256, 256), problem, no_eviction).misses, 64 * 8 + 256 * 2);
+}
+
+TEST(L2ReuseSimulator, LeadingDimensions)
+{
+    const auto packed = simulate_l2_reuse(MapM01(256, 256), make_problem(256, 256, 64, 4));
+
+    auto problem = make_problem(256, 256, 64, 4);
+    problem.lda  = 64;
+    problem.ldb  = 64;
+    EXPECT_EQ(simulate_l2_reuse(MapM01(256, 256), problem).misses, packed.misses);
+
+    // rows of A 80 floats apart: the odd ones start in the middle of a line and take 3 lines
+    problem.lda = 80;
+    EXPECT_EQ(simulate_l2_reuse(MapM01(256, 256), problem, no_eviction).misses,
+              128 * 2 + 128 * 3 + 256 * 2);
+}
+
+TEST(L2ReuseSimulator, LruOrder)
+{
+    // one workgroup at a time on a cache of two tiles, a single k step
+    const L2ReuseOptions two_tiles{256 * 128, 256, 128, 1, 0};
+    const auto problem = make_problem(256, 256, 32, 1);
+
+    // tiles (0, 0), (0, 1), (1, 0), (1, 1): A0 B0 | A0 hit, B1 evicts B0 | A1 evicts A0, B0
+    // evicts B1 | A1 hit, B1 evicts B0
+    const auto rows = simulate_l2_reuse(MapM01(256, 256, 1), problem, two_tiles);
+    EXPECT_EQ(rows.accesses, 4 * 256);
+    EXPECT_EQ(rows.misses, 256 + 128 + 256 + 128);
+
+    // tiles (0, 0), (1, 0), (0, 1), (1, 1): A0 B0 | A1 evicts A0, B0 hit | A0 evicts A1, B1
+    // evicts B0 | A1 evicts A0, B1 hit
+    const auto columns = simulate_l2_reuse(MapM01(256, 256, 2), problem, two_tiles);
+    EXPECT_EQ(columns.misses, 256 + 128 + 256 + 128);
+}
+
+TEST(L2ReuseSimulator, RoundRobinCaches)
+{
+    // 2 x 4 tiles in one wave, the even workgroups on one cache and the odd ones on the other
+    L2ReuseOptions options = no_eviction;
+    options.num_caches     = 2;
+    const auto problem     = make_problem(256, 512, 32, 8);
+
+    // M01 1: tiles (0, 0), (0, 1), (0, 2), ... each cache reads A0, A1 and two B tiles
+    EXPECT_EQ(simulate_l2_reuse(MapM01(256, 512, 1), problem, options).misses, 2 * 4 * 128);
+    // M01 2: tiles (0, 0), (1, 0), (0, 1), ... each cache reads one A tile and all four B tiles
+    EXPECT_EQ(simulate_l2_reuse(MapM01(256, 512, 2), problem, options).misses, 2 * 5 * 128);
+    EXPECT_EQ(simulate_l2_reuse(MapM01(256, 512, 4), problem, options).misses, 2 * 5 * 128);
+    EXPECT_EQ(choose_block_to_ctile_swizzle<MapM01>(problem, options), 1);
+
+    // the same with M and N swapped
+    const auto transposed = make_problem(512, 256, 32, 8);
+    EXPECT_EQ(simulate_l2_reuse(MapN01(512, 256, 1), transposed, options).misses, 2 * 4 * 128);
+    EXPECT_EQ(simulate_l2_reuse(MapN01(512, 256, 2), transposed, options).misses, 2 * 5 * 128);
+    EXPECT_EQ(choose_block_to_ctile_swizzle<MapN01>(transposed, options), 1);
+
+    // on a single cache there is nothing to choose, ties go to the smaller swizzle
+    EXPECT_EQ(choose_block_to_ctile_swizzle<MapM01>(problem, no_eviction), 1);
+}
+
+TEST(L2ReuseSimulator, MaxKSteps)
+{
+    // every k step of a single tile is new lines, so one k step predicts all of them
+    const auto problem = make_problem(128, 128, 128, 1);
+    const auto all     = simulate_l2_reuse(MapM01(128, 128), problem, no_eviction);
+
+    L2ReuseOptions options = no_eviction;
+    options.max_ksteps     = 1;
+    const auto one         = simulate_l2_reuse(MapM01(128, 128), problem, options);
+
+    EXPECT_EQ(all.accesses, 4 * 256);
+    EXPECT_EQ(all.misses, 4 * 256);
+    EXPECT_EQ(one.accesses, all.accesses);
+    EXPECT_EQ(one.misses, all.misses);
+}
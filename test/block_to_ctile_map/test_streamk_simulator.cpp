@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/grid/block_to_ctile_map.hpp"
+#include "ck/host_utility/streamk_simulator.hpp"
+
+using namespace ck;
+using ck::utility::choose_streamk_sk_blocks;
+using ck::utility::simulate_streamk;
+
+using AtomicMap    = BlockToCTileMap_GemmStreamK<128, 128, 32, StreamKReductionStrategy::Atomic>;
+using ReductionMap = BlockToCTileMap_GemmStreamK<128, 128, 32, StreamKReductionStrategy::Reduction>;
+
+namespace {
+
+// m, n, k, num_cu, occupancy, sk_blocks
+const std::vector<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>> problems{
+    {1024, 1024, 1024, 8, 1, 0xffffffff},
+    {1152, 1024, 4096, 8, 2, 0xffffffff},
+    {1280, 1280, 1000, 16, 1, 5},
+    {3840, 4096, 4096, 120, 2, 0xffffffff},
+    {200, 300, 777, 4, 2, 3},
+    {128, 128, 8192, 64, 1, 0xffffffff},
+    {128, 128, 8192, 64, 1, 0},
+};
+
+template <typename Map>
+void check_coverage(uint32_t m, uint32_t n, uint32_t k, const Map& map)
+{
+    const uint32_t num_tiles =
+        math::integer_divide_ceil(m, 128u) * math::integer_divide_ceil(n, 128u);
+    const uint32_t k_iters   = math::integer_divide_ceil(k, 32u);
+
+    const auto sim = simulate_streamk(map, m, n, 8, 2, 4);
+
+    // every k iteration of every tile is done exactly once
+    std::vector<uint32_t> count(num_tiles * k_iters, 0);
+    std::vector<uint32_t> parts(num_tiles, 0);
+    uint32_t partials = 0;
+    for(const auto& item : sim.work_items)
+    {
+        ASSERT_LT(item.tile_idx, num_tiles);
+        ASSERT_LT(item.k_iter_begin, item.k_iter_end);
+        ASSERT_LE(item.k_iter_end, k_iters);
+        for(uint32_t i = item.k_iter_begin; i < item.k_iter_end; ++i)
+        {
+            ++count[item.tile_idx * k_iters + i];
+        }
+
+        EXPECT_EQ(item.partial, item.block_idx < map.sk_num_blocks);
+        if(item.partial)
+        {
+            ++parts[item.tile_idx];
+            ++partials;
+        }
+        else
+        {
+            EXPECT_EQ(item.k_iter_end - item.k_iter_begin, k_iters);
+        }
+    }
+    for(auto c : count)
+    {
+        ASSERT_EQ(c, 1);
+    }
+
+    const auto partial_tiles = std::count_if(parts.begin(), parts.end(), [](auto p) { return p; });
+    EXPECT_EQ(sim.partials, partials);
+    EXPECT_EQ(sim.partial_tiles, partial_tiles);
+    EXPECT_EQ(sim.partial_tiles, map.get_sk_tiles());
+}
+
+} // namespace
+
+TEST(StreamKSimulator, CoversEveryIterationOnce)
+{
+    for(const auto& [m, n, k, num_cu, occupancy, sk_blocks] : problems)
+    {
+        check_coverage(m, n, k, AtomicMap(m, n, k, num_cu, occupancy, sk_blocks));
+        check_coverage(m, n, k, ReductionMap(m, n, k, num_cu, occupancy, sk_blocks));
+    }
+}
+
+TEST(StreamKSimulator, Load)
+{
+    // 64 tiles of 32 iterations on 8 CUs, data parallel only: 8 tiles per CU
+    const AtomicMap dp(1024, 1024, 1024, 8, 1, 0);
+    const auto sim = simulate_streamk(dp, 1024, 1024, 8, 2, 4);
+
+    EXPECT_EQ(sim.sk_blocks, 0);
+    EXPECT_EQ(sim.dp_blocks, 64);
+    EXPECT_EQ(sim.partials, 0);
+    ASSERT_EQ(sim.cu_load.size(), 8);
+    for(double load : sim.cu_load)
+    {
+        EXPECT_NEAR(load, 8 * (32 + 1), 1e-9);
+    }
+    EXPECT_NEAR(sim.tail_imbalance, 0, 1e-9);
+    EXPECT_EQ(sim.atomic_bytes, 1024 * 1024 * 2);
+    EXPECT_EQ(sim.reduction_bytes, 0);
+
+    // 65 tiles leave a tail of one tile on one CU
+    const AtomicMap tail(640, 1664, 1024, 8, 1, 0);
+    const auto tail_sim = simulate_streamk(tail, 640, 1664, 8, 2, 4);
+    EXPECT_NEAR(tail_sim.makespan, 9 * 33, 1e-9);
+    EXPECT_NEAR(tail_sim.tail_imbalance, 9. * 8 / 65 - 1, 1e-9);
+}
+
+TEST(StreamKSimulator, ReductionTraffic)
+{
+    // one tile of 256 iterations split over 4 stream-K blocks
+    const ReductionMap map(128, 128, 8192, 64, 1, 4);
+    const auto sim = simulate_streamk(map, 128, 128, 64, 2, 4);
+
+    EXPECT_EQ(sim.sk_blocks, 4);
+    EXPECT_EQ(sim.partials, 4);
+    EXPECT_EQ(sim.partial_tiles, 1);
+    EXPECT_EQ(sim.reduction_blocks, 1);
+    EXPECT_EQ(sim.grid_size, map.get_grid_dims().x);
+    EXPECT_EQ(sim.reduction_bytes, 2 * 4 * 128 * 128 * 4);
+    EXPECT_EQ(sim.atomic_bytes, 128 * 128 * 2 + 2 * 4 * 128 * 128 * 2);
+    // 64 iterations and a partial store per stream-K block
+    EXPECT_NEAR(sim.makespan, 64 + 2, 1e-9);
+
+    const auto total = std::accumulate(sim.cu_load.begin(), sim.cu_load.end(), 0.);
+    EXPECT_NEAR(total, 4 * (64 + 2) + 4 * 1 + 1, 1e-9);
+}
+
+TEST(StreamKSimulator, ChooseSkBlocks)
+{
+    for(const auto& [m, n, k, num_cu, occupancy, sk_blocks] : problems)
+    {
+        const uint32_t chosen =
+            choose_streamk_sk_blocks<ReductionMap>(m, n, k, num_cu, occupancy, 2, 4);
+        const double best =
+            simulate_streamk(ReductionMap(m, n, k, num_cu, occupancy, chosen), m, n, num_cu, 2, 4)
+                .makespan;
+
+        // no better than data parallel or the map's own choice
+        EXPECT_LE(best,
+                  simulate_streamk(ReductionMap(m, n, k, num_cu, occupancy, 0), m, n, num_cu, 2, 4)
+                      .makespan);
+        EXPECT_LE(best,
+                  simulate_streamk(ReductionMap(m, n, k, num_cu, occupancy), m, n, num_cu, 2, 4)
+                      .makespan);
+        check_coverage(m, n, k, ReductionMap(m, n, k, num_cu, occupancy, chosen));
+        (void)sk_blocks;
+    }
+
+    // a single long tile is split over the CUs
+    EXPECT_GT(choose_streamk_sk_blocks<AtomicMap>(128, 128, 8192, 64, 1, 2, 4), 1);
+}
+
+TEST(StreamKSimulator, ChooseSkBlocksCapped)
+{
+    for(const auto& [m, n, k, num_cu, occupancy, sk_blocks] : problems)
+    {
+        // a few candidates, which still include data parallel and the map's own choice
+        const uint32_t capped =
+            choose_streamk_sk_blocks<ReductionMap>(m, n, k, num_cu, occupancy, 2, 4, {}, 4);
+        const double capped_makespan =
+            simulate_streamk(ReductionMap(m, n, k, num_cu, occupancy, capped), m, n, num_cu, 2, 4)
+                .makespan;
+        EXPECT_LE(capped_makespan,
+                  simulate_streamk(ReductionMap(m, n, k, num_cu, occupancy, 0), m, n, num_cu, 2, 4)
+                      .makespan);
+        EXPECT_LE(capped_makespan,
+                  simulate_streamk(ReductionMap(m, n, k, num_cu, occupancy), m, n, num_cu, 2, 4)
+                      .makespan);
+
+        // no better than all the candidates
+        const uint32_t chosen =
+            choose_streamk_sk_blocks<ReductionMap>(m, n, k, num_cu, occupancy, 2, 4, {}, 1 << 20);
+        EXPECT_LE(
+            simulate_streamk(ReductionMap(m, n, k, num_cu, occupancy, chosen), m, n, num_cu, 2, 4)
+                .makespan,
+            capped_makespan);
+
+        // the cached result
+        EXPECT_EQ(choose_streamk_sk_blocks<ReductionMap>(m, n, k, num_cu, occupancy, 2, 4, {}, 4),
+                  capped);
+        (void)sk_blocks;
+    }
+}
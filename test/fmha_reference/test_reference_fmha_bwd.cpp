@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host.hpp"
+#include "ck_tile/ops/fmha.hpp"
+
+using ck_tile::HostTensor;
+using ck_tile::index_t;
+
+using NoMask      = ck_tile::GenericAttentionMask<false>;
+using CausalMask  = ck_tile::GenericAttentionMask<true, false>;
+using GenericMask = ck_tile::GenericAttentionMask<true, true>;
+
+namespace {
+
+const float scale_s = 0.5f;
+const float p_drop  = 0.3f;
+
+// drops about 30% of P, the same for every call
+auto make_dropout = [](index_t wb, index_t i_h, index_t, index_t) {
+    return [=](index_t i_q, index_t i_k) { return (wb + 3 * i_h + 7 * i_q + 13 * i_k) % 10 >= 3; };
+};
+
+// O and LSE of the forward pass in double, without the tiling and the online softmax of the
+// references
+template <typename MaskFactory, typename DropoutFactory>
+void naive_fmha_fwd(const HostTensor<double>& q,
+                    const HostTensor<double>& k,
+                    const HostTensor<double>& v,
+                    HostTensor<double>& o,
+                    HostTensor<double>& lse,
+                    const std::vector<int32_t>& seqstart_q,
+                    const std::vector<int32_t>& seqstart_k,
+                    const MaskFactory& make_mask,
+                    const DropoutFactory& make_keep,
+                    double rp_undrop)
+{
+    const index_t nhead  = q.mDesc.get_lengths()[1];
+    const index_t nr     = nhead / k.mDesc.get_lengths()[1];
+    const index_t hdim_q = q.mDesc.get_lengths()[3];
+    const index_t hdim_v = v.mDesc.get_lengths()[3];
+    const auto sequences = ck_tile::detail::make_fmha_sequences(
+        q.mDesc.get_lengths(), k.mDesc.get_lengths(), seqstart_q, seqstart_k);
+
+    for(index_t wb = 0; wb < static_cast<index_t>(sequences.size()); ++wb)
+    {
+        const auto& seq = sequences[wb];
+        const auto mask = make_mask(seq.seqlen_q, seq.seqlen_k);
+
+        for(index_t i_h = 0; i_h < nhead; ++i_h)
+        {
+            const auto keep = make_keep(wb, i_h, seq.seqlen_q, seq.seqlen_k);
+
+            for(index_t i = 0; i < seq.seqlen_q; ++i)
+            {
+                const index_t i_q = seq.q_offset + i;
+
+                std::vector<double> s(seq.seqlen_k, -std::numeric_limits<double>::infinity());
+                double m = -std::numeric_limits<double>::infinity();
+                for(index_t j = 0; j < seq.seqlen_k; ++j)
+                {
+                    if(mask.IsOutOfBound(i, j))
+                        continue;
+
+                    double acc = 0;
+                    for(index_t d = 0; d < hdim_q; ++d)
+                        acc += q(seq.i_b, i_h, i_q, d) * k(seq.i_b, i_h / nr, seq.k_offset + j, d);
+                    s[j] = scale_s * acc;
+                    m    = std::max(m, s[j]);
+                }
+
+                double l = 0;
+                for(index_t j = 0; j < seq.seqlen_k; ++j)
+                    l += std::isinf(s[j]) ? 0 : std::exp(s[j] - m);
+
+                for(index_t d = 0; d < hdim_v; ++d)
+                {
+                    double acc = 0;
+                    for(index_t j = 0; j < seq.seqlen_k; ++j)
+                    {
+                        if(std::isinf(s[j]) || !keep(i, j))
+                            continue;
+                        acc += std::exp(s[j] - m) / l * rp_undrop *
+                               v(seq.i_b, i_h / nr, seq.k_offset + j, d);
+                    }
+                    o(seq.i_b, i_h, i_q, d) = acc;
+                }
+                lse(seq.i_b, i_h, i_q) = l > 0 ? m + std::log(l) : m;
+            }
+        }
+    }
+}
+
+// checks dQ, dK and dV against central differences of sum(dO * O) of the naive forward pass.
+// Batch mode if seqstart_q is empty, else group mode with a single batch of seqlen_q/seqlen_k
+template <typename MaskFactory, typename DropoutFactory = ck_tile::reference_fmha_no_dropout>
+void check_bwd(index_t batch,
+               index_t seqlen_q,
+               index_t seqlen_k,
+               const std::vector<int32_t>& seqstart_q,
+               const std::vector<int32_t>& seqstart_k,
+               const MaskFactory& make_mask,
+               const DropoutFactory& dropout = {})
+{
+    // 2 q heads per k head, so that dK and dV sum over heads
+    const index_t nhead   = 2;
+    const index_t nhead_k = 1;
+    const index_t hdim_q  = 4;
+    const index_t hdim_v  = 3;
+
+    constexpr bool kHasDropout =
+        !std::is_same_v<DropoutFactory, ck_tile::reference_fmha_no_dropout>;
+    const auto make_keep = [&](index_t wb, index_t i_h, index_t sq, index_t sk) {
+        if constexpr(kHasDropout)
+            return dropout(wb, i_h, sq, sk);
+        else
+            return [](index_t, index_t) { return true; };
+    };
+    const double rp_undrop = kHasDropout ? 1. / (1. - p_drop) : 1.;
+
+    HostTensor<float> q({batch, nhead, seqlen_q, hdim_q});
+    HostTensor<float> k({batch, nhead_k, seqlen_k, hdim_q});
+    HostTensor<float> v({batch, nhead_k, seqlen_k, hdim_v});
+    HostTensor<float> dout({batch, nhead, seqlen_q, hdim_v});
+    ck_tile::FillUniformDistribution<float>{-1.f, 1.f, 1}(q);
+    ck_tile::FillUniformDistribution<float>{-1.f, 1.f, 2}(k);
+    ck_tile::FillUniformDistribution<float>{-1.f, 1.f, 3}(v);
+    ck_tile::FillUniformDistribution<float>{-1.f, 1.f, 4}(dout);
+
+    HostTensor<double> q_ref(q.mDesc.get_lengths());
+    HostTensor<double> k_ref(k.mDesc.get_lengths());
+    HostTensor<double> v_ref(v.mDesc.get_lengths());
+    std::copy(q.begin(), q.end(), q_ref.begin());
+    std::copy(k.begin(), k.end(), k_ref.begin());
+    std::copy(v.begin(), v.end(), v_ref.begin());
+
+    HostTensor<double> o_ref({batch, nhead, seqlen_q, hdim_v});
+    HostTensor<double> lse_ref({batch, nhead, seqlen_q});
+    naive_fmha_fwd(q_ref,
+                   k_ref,
+                   v_ref,
+                   o_ref,
+                   lse_ref,
+                   seqstart_q,
+                   seqstart_k,
+                   make_mask,
+                   make_keep,
+                   rp_undrop);
+
+    HostTensor<float> o({batch, nhead, seqlen_q, hdim_v});
+    HostTensor<float> lse({batch, nhead, seqlen_q});
+    std::copy(o_ref.begin(), o_ref.end(), o.begin());
+    std::copy(lse_ref.begin(), lse_ref.end(), lse.begin());
+
+    HostTensor<float> dq(q.mDesc.get_lengths());
+    HostTensor<float> dk(k.mDesc.get_lengths());
+    HostTensor<float> dv(v.mDesc.get_lengths());
+    ck_tile::reference_fmha_bwd<float,
+                                float,
+                                float,
+                                float,
+                                float,
+                                float,
+                                float,
+                                float,
+                                float,
+                                float>(q,
+                                       k,
+                                       v,
+                                       o,
+                                       lse,
+                                       dout,
+                                       dq,
+                                       dk,
+                                       dv,
+                                       scale_s,
+                                       seqstart_q,
+                                       seqstart_k,
+                                       make_mask,
+                                       ck_tile::reference_fmha_no_bias{},
+                                       dropout,
+                                       p_drop);
+
+    // d sum(dO * O) / dx of every element x of t_ref
+    auto finite_differences = [&](HostTensor<double>& t_ref) {
+        HostTensor<float> grad(t_ref.mDesc.get_lengths());
+        HostTensor<double> o_h(o_ref.mDesc.get_lengths());
+        HostTensor<double> lse_h(lse_ref.mDesc.get_lengths());
+
+        auto loss = [&]() {
+            naive_fmha_fwd(q_ref,
+                           k_ref,
+                           v_ref,
+                           o_h,
+                           lse_h,
+                           seqstart_q,
+                           seqstart_k,
+                           make_mask,
+                           make_keep,
+                           rp_undrop);
+            double l = 0;
+            for(std::size_t i = 0; i < o_h.mData.size(); ++i)
+                l += dout.mData[i] * o_h.mData[i];
+            return l;
+        };
+
+        const double h = 1e-4;
+        for(std::size_t i = 0; i < t_ref.mData.size(); ++i)
+        {
+            const double x = t_ref.mData[i];
+            t_ref.mData[i] = x + h;
+            const double l_plus = loss();
+            t_ref.mData[i] = x - h;
+            const double l_minus = loss();
+            t_ref.mData[i] = x;
+
+            grad.mData[i] = static_cast<float>((l_plus - l_minus) / (2 * h));
+        }
+        return grad;
+    };
+
+    EXPECT_TRUE(
+        ck_tile::check_err(dq, finite_differences(q_ref), "Error: Incorrect dQ!", 1e-3, 1e-4));
+    EXPECT_TRUE(
+        ck_tile::check_err(dk, finite_differences(k_ref), "Error: Incorrect dK!", 1e-3, 1e-4));
+    EXPECT_TRUE(
+        ck_tile::check_err(dv, finite_differences(v_ref), "Error: Incorrect dV!", 1e-3, 1e-4));
+}
+
+auto make_no_mask = [](index_t sq, index_t sk) { return NoMask{sq, sk}; };
+
+auto make_causal_mask = [](index_t sq, index_t sk) {
+    return ck_tile::make_generic_attention_mask_from_lr_window<CausalMask>(-1, 0, sq, sk, false);
+};
+
+auto make_window_mask = [](index_t sq, index_t sk) {
+    return ck_tile::make_generic_attention_mask_from_lr_window<GenericMask>(20, 7, sq, sk);
+};
+
+} // namespace
+
+// the seqlens are not multiples of the 32 x 64 tiles of the reference
+
+TEST(ReferenceFmhaBwd, NoMask)
+{
+    check_bwd(2, 37, 70, {}, {}, make_no_mask);
+}
+
+TEST(ReferenceFmhaBwd, Masked)
+{
+    // bottom-right causal with seqlen_q > seqlen_k leaves rows without any key
+    check_bwd(1, 37, 70, {}, {}, make_causal_mask);
+    check_bwd(1, 70, 37, {}, {}, make_causal_mask);
+    check_bwd(1, 37, 70, {}, {}, make_window_mask);
+    check_bwd(1, 70, 37, {}, {}, make_window_mask);
+}
+
+TEST(ReferenceFmhaBwd, Dropout)
+{
+    check_bwd(1, 37, 70, {}, {}, make_no_mask, make_dropout);
+    check_bwd(1, 70, 37, {}, {}, make_causal_mask, make_dropout);
+    check_bwd(1, 37, 70, {}, {}, make_window_mask, make_dropout);
+}
+
+TEST(ReferenceFmhaBwd, GroupMode)
+{
+    const std::vector<int32_t> seqstart_q{0, 37, 38, 71};
+    const std::vector<int32_t> seqstart_k{0, 70, 75, 90};
+
+    check_bwd(1, 71, 90, seqstart_q, seqstart_k, make_causal_mask);
+    check_bwd(1, 71, 90, seqstart_q, seqstart_k, make_window_mask, make_dropout);
+}
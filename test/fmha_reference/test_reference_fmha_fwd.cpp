@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host.hpp"
+#include "ck_tile/ops/fmha.hpp"
+
+using ck_tile::HostTensor;
+using ck_tile::index_t;
+
+using NoMask      = ck_tile::GenericAttentionMask<false>;
+using CausalMask  = ck_tile::GenericAttentionMask<true, false>;
+using GenericMask = ck_tile::GenericAttentionMask<true, true>;
+
+namespace {
+
+// O and LSE computed sequence by sequence like the fmha_fwd example did before the tiled
+// reference: the whole [nhead, seqlen_q, seqlen_k] score matrix, masked element by element
+template <typename MaskFactory>
+void reference_fmha_fwd_per_element(const HostTensor<float>& q,
+                                    const HostTensor<float>& k,
+                                    const HostTensor<float>& v,
+                                    HostTensor<float>& o,
+                                    HostTensor<float>& lse,
+                                    float scale_s,
+                                    const std::vector<int32_t>& seqstart_q,
+                                    const std::vector<int32_t>& seqstart_k,
+                                    const MaskFactory& make_mask)
+{
+    const index_t nhead  = q.mDesc.get_lengths()[1];
+    const index_t nr     = nhead / k.mDesc.get_lengths()[1];
+    const index_t hdim_q = q.mDesc.get_lengths()[3];
+    const index_t hdim_v = v.mDesc.get_lengths()[3];
+
+    for(const auto& seq : ck_tile::detail::make_fmha_sequences(
+            q.mDesc.get_lengths(), k.mDesc.get_lengths(), seqstart_q, seqstart_k))
+    {
+        HostTensor<float> q_ref({nhead, seq.seqlen_q, hdim_q});
+        HostTensor<float> k_ref({nhead, seq.seqlen_k, hdim_q});
+        HostTensor<float> v_ref({nhead, hdim_v, seq.seqlen_k});
+        HostTensor<float> s_ref({nhead, seq.seqlen_q, seq.seqlen_k});
+        HostTensor<float> p_ref({nhead, seq.seqlen_q, seq.seqlen_k});
+        HostTensor<float> o_ref({nhead, seq.seqlen_q, hdim_v});
+        HostTensor<float> lse_ref({nhead, seq.seqlen_q});
+
+        // clang-format off
+        q_ref.ForEach([&](auto& self, auto i) { self(i) = q(seq.i_b, i[0], seq.q_offset + i[1], i[2]); });
+        k_ref.ForEach([&](auto& self, auto i) { self(i) = k(seq.i_b, i[0] / nr, seq.k_offset + i[1], i[2]); });
+        v_ref.ForEach([&](auto& self, auto i) { self(i) = v(seq.i_b, i[0] / nr, seq.k_offset + i[2], i[1]); });
+        // clang-format on
+
+        ck_tile::reference_batched_gemm<float, float, float, float>(
+            q_ref, k_ref, s_ref, ck_tile::identity{}, ck_tile::identity{}, ck_tile::scales(scale_s));
+        ck_tile::reference_batched_masking<float>(s_ref, make_mask(seq.seqlen_q, seq.seqlen_k));
+        ck_tile::reference_batched_softmax<float, float, float>(
+            s_ref, p_ref, ck_tile::identity{}, lse_ref);
+        ck_tile::reference_batched_gemm<float, float, float, float>(p_ref, v_ref, o_ref);
+
+        // clang-format off
+        o_ref.ForEach([&](auto& self, auto i) { o(seq.i_b, i[0], seq.q_offset + i[1], i[2]) = self(i); });
+        lse_ref.ForEach([&](auto& self, auto i) { lse(seq.i_b, i[0], seq.q_offset + i[1]) = self(i); });
+        // clang-format on
+    }
+}
+
+// batch mode if seqstart_q is empty, else group mode with a single batch of seqlen_q/seqlen_k
+template <typename MaskFactory>
+void check_fwd(index_t batch,
+               index_t seqlen_q,
+               index_t seqlen_k,
+               const std::vector<int32_t>& seqstart_q,
+               const std::vector<int32_t>& seqstart_k,
+               const MaskFactory& make_mask)
+{
+    // 2 q heads per k head
+    const index_t nhead   = 4;
+    const index_t nhead_k = 2;
+    const index_t hdim_q  = 40;
+    const index_t hdim_v  = 24;
+    const float scale_s   = 0.3f;
+
+    HostTensor<float> q({batch, nhead, seqlen_q, hdim_q});
+    HostTensor<float> k({batch, nhead_k, seqlen_k, hdim_q});
+    HostTensor<float> v({batch, nhead_k, seqlen_k, hdim_v});
+    ck_tile::FillUniformDistribution<float>{-2.f, 2.f, 1}(q);
+    ck_tile::FillUniformDistribution<float>{-2.f, 2.f, 2}(k);
+    ck_tile::FillUniformDistribution<float>{-2.f, 2.f, 3}(v);
+
+    HostTensor<float> o({batch, nhead, seqlen_q, hdim_v});
+    HostTensor<float> lse({batch, nhead, seqlen_q});
+    ck_tile::reference_fmha_fwd<float, float, float, float, float, float, float, float>(
+        q,
+        k,
+        v,
+        o,
+        scale_s,
+        seqstart_q,
+        seqstart_k,
+        make_mask,
+        ck_tile::reference_fmha_no_bias{},
+        ck_tile::identity{},
+        ck_tile::identity{},
+        lse);
+
+    HostTensor<float> o_ref({batch, nhead, seqlen_q, hdim_v});
+    HostTensor<float> lse_ref({batch, nhead, seqlen_q});
+    reference_fmha_fwd_per_element(
+        q, k, v, o_ref, lse_ref, scale_s, seqstart_q, seqstart_k, make_mask);
+
+    EXPECT_TRUE(ck_tile::check_err(o, o_ref, "Error: Incorrect O!", 1e-5, 1e-5));
+    // rows with every key masked have an LSE of -inf
+    EXPECT_TRUE(ck_tile::check_err(lse, lse_ref, "Error: Incorrect LSE!", 1e-5, 1e-5, true));
+}
+
+// seqlens that are not multiples of the 32 x 64 tiles of the reference
+const std::vector<std::pair<index_t, index_t>> seqlens{{77, 133}, {133, 77}, {1, 65}, {96, 192}};
+
+} // namespace
+
+TEST(ReferenceFmhaFwd, NoMask)
+{
+    for(const auto& [seqlen_q, seqlen_k] : seqlens)
+    {
+        check_fwd(2, seqlen_q, seqlen_k, {}, {}, [](index_t sq, index_t sk) {
+            return NoMask{sq, sk};
+        });
+    }
+}
+
+TEST(ReferenceFmhaFwd, Causal)
+{
+    for(const auto& [seqlen_q, seqlen_k] : seqlens)
+    {
+        for(bool is_top_left : {true, false})
+        {
+            check_fwd(2, seqlen_q, seqlen_k, {}, {}, [=](index_t sq, index_t sk) {
+                return ck_tile::make_generic_attention_mask_from_lr_window<CausalMask>(
+                    -1, 0, sq, sk, is_top_left);
+            });
+        }
+    }
+}
+
+TEST(ReferenceFmhaFwd, Window)
+{
+    for(const auto& [seqlen_q, seqlen_k] : seqlens)
+    {
+        for(const auto& [left, right] : std::vector<std::pair<index_t, index_t>>{
+                {0, 0}, {5, 0}, {20, 7}, {70, -1}, {-1, 40}})
+        {
+            for(bool is_top_left : {true, false})
+            {
+                check_fwd(2, seqlen_q, seqlen_k, {}, {}, [=](index_t sq, index_t sk) {
+                    return ck_tile::make_generic_attention_mask_from_lr_window<GenericMask>(
+                        left, right, sq, sk, is_top_left);
+                });
+            }
+        }
+    }
+}
+
+TEST(ReferenceFmhaFwd, GroupMode)
+{
+    const std::vector<int32_t> seqstart_q{0, 77, 78, 211};
+    const std::vector<int32_t> seqstart_k{0, 133, 198, 275};
+
+    check_fwd(1, 211, 275, seqstart_q, seqstart_k, [](index_t sq, index_t sk) {
+        return NoMask{sq, sk};
+    });
+    check_fwd(1, 211, 275, seqstart_q, seqstart_k, [](index_t sq, index_t sk) {
+        return ck_tile::make_generic_attention_mask_from_lr_window<CausalMask>(
+            -1, 0, sq, sk, false);
+    });
+    check_fwd(1, 211, 275, seqstart_q, seqstart_k, [](index_t sq, index_t sk) {
+        return ck_tile::make_generic_attention_mask_from_lr_window<GenericMask>(
+            20, 7, sq, sk, false);
+    });
+}
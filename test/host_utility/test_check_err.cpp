@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/check_err_streaming.hpp"
+
+using ck::utils::check_err_stats;
+using ck::utils::CheckErrConfig;
+
+namespace {
+
+// A path in the temporary directory, unique to this process, removed on destruction
+struct TempFile
+{
+    explicit TempFile(const std::string& name)
+        : path(std::filesystem::temp_directory_path() /
+               (std::to_string(::getpid()) + "_" + name))
+    {
+    }
+    ~TempFile() { std::filesystem::remove(path); }
+
+    std::filesystem::path path;
+};
+
+std::vector<float> make_ref(std::size_t n)
+{
+    std::vector<float> ref(n);
+    for(std::size_t i = 0; i < n; ++i)
+        ref[i] = 1.f + static_cast<float>(i % 1000) / 1000.f;
+    return ref;
+}
+
+} // namespace
+
+TEST(CheckErr, Statistics)
+{
+    // spans several chunks of the parallel pass
+    const auto ref = make_ref(300000);
+    auto out       = ref;
+
+    out[7]      = std::nextafter(ref[7], 2.f * ref[7]);
+    out[100]    = ref[100] + 0.5f;
+    out[200001] = std::numeric_limits<float>::quiet_NaN();
+    out[250000] = std::numeric_limits<float>::infinity();
+
+    CheckErrConfig config;
+    config.lengths = {3, 100000};
+
+    const auto result = check_err_stats(out, ref, 1e-5, 3e-6, config);
+
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.num_element, ref.size());
+    EXPECT_EQ(result.err_count, 3);
+    EXPECT_EQ(result.out_nan_count, 1);
+    EXPECT_EQ(result.out_inf_count, 1);
+    EXPECT_EQ(result.ref_nan_count, 0);
+    EXPECT_DOUBLE_EQ(result.max_abs_err, 0.5);
+    EXPECT_DOUBLE_EQ(result.max_rel_err, 0.5 / ref[100]);
+    EXPECT_NEAR(result.mean_abs_err, 0.5 / (ref.size() - 2), 1e-9);
+
+    // the one ulp error is within the tolerance, 0.5 at 1.1 is 2^22 ulp of float
+    EXPECT_EQ(result.ulp_histogram[0], ref.size() - 4);
+    EXPECT_EQ(result.ulp_histogram[1], 1);
+    EXPECT_EQ(result.ulp_histogram[23], 1);
+
+    ASSERT_EQ(result.mismatches.size(), 3);
+    EXPECT_EQ(result.mismatches[0].index, 100);
+    EXPECT_EQ(result.mismatches[1].index, 200001);
+    EXPECT_EQ(result.mismatches[2].index, 250000);
+    EXPECT_EQ(result.mismatches[1].multi_index, (std::vector<std::size_t>{2, 1}));
+    EXPECT_EQ(result.mismatches[2].multi_index, (std::vector<std::size_t>{2, 50000}));
+    EXPECT_FLOAT_EQ(result.mismatches[0].out, ref[100] + 0.5f);
+
+    EXPECT_FALSE(ck::utils::check_err(out, ref));
+}
+
+TEST(CheckErr, UnalignedSizes)
+{
+    // sizes that are not a multiple of the accumulator lanes, nor of the block
+    for(std::size_t n : {1, 5, 17, 259})
+    {
+        const std::vector<float> ref(n, 1.f);
+        auto out = ref;
+        out[0]   = 2.f;
+
+        const auto result = check_err_stats(out, ref, 0, 0.5);
+
+        EXPECT_EQ(result.num_element, n);
+        EXPECT_EQ(result.num_finite, n);
+        EXPECT_EQ(result.err_count, 1);
+        EXPECT_EQ(result.ulp_histogram[0], n - 1);
+        EXPECT_DOUBLE_EQ(result.mean_abs_err, 1. / n);
+    }
+
+    // a non-finite element in the padded last step
+    std::vector<float> ref(5, 1.f);
+    auto out = ref;
+    out[4]   = std::numeric_limits<float>::infinity();
+
+    const auto result = check_err_stats(out, ref, 0, 0.5);
+
+    EXPECT_EQ(result.num_finite, 4);
+    EXPECT_EQ(result.out_inf_count, 1);
+    EXPECT_EQ(result.ulp_histogram[0], 4);
+    EXPECT_DOUBLE_EQ(result.mean_abs_err, 0);
+}
+
+TEST(CheckErr, ThreadCount)
+{
+    const auto ref = make_ref(500000);
+    auto out       = ref;
+    for(std::size_t i = 0; i < out.size(); i += 997)
+        out[i] += 1e-3f * static_cast<float>(i % 7);
+
+    CheckErrConfig config;
+    config.num_thread = 1;
+    const auto expected = check_err_stats(out, ref, 1e-5, 3e-6, config);
+
+    for(std::size_t num_thread : {3, 8})
+    {
+        config.num_thread = num_thread;
+        const auto result = check_err_stats(out, ref, 1e-5, 3e-6, config);
+
+        EXPECT_EQ(result.err_count, expected.err_count);
+        EXPECT_EQ(result.mean_abs_err, expected.mean_abs_err);
+        EXPECT_EQ(result.ulp_histogram, expected.ulp_histogram);
+        ASSERT_EQ(result.mismatches.size(), config.max_num_mismatch);
+        for(std::size_t k = 0; k < result.mismatches.size(); ++k)
+            EXPECT_EQ(result.mismatches[k].index, expected.mismatches[k].index);
+    }
+
+    // the ranges without random access are compared serially
+    const std::list<float> out_list(out.begin(), out.end());
+    const std::list<float> ref_list(ref.begin(), ref.end());
+    EXPECT_EQ(check_err_stats(out_list, ref_list, 1e-5, 3e-6).err_count, expected.err_count);
+}
+
+TEST(CheckErr, EarlyExit)
+{
+    const auto ref = make_ref(1 << 22);
+    auto out       = ref;
+    out[1000]      = 0;
+
+    CheckErrConfig config;
+    config.stop_at_first_error = true;
+    config.num_thread          = 1;
+
+    const auto result = check_err_stats(out, ref, 1e-5, 3e-6, config);
+
+    EXPECT_FALSE(result);
+    EXPECT_LT(result.num_element, ref.size());
+    ASSERT_EQ(result.mismatches.size(), 1);
+    EXPECT_EQ(result.mismatches[0].index, 1000);
+
+    EXPECT_TRUE(check_err_stats(ref, ref, 1e-5, 3e-6, config));
+}
+
+TEST(CheckErr, Integer)
+{
+    std::vector<int> ref(1000, 5);
+    auto out = ref;
+    out[3]   = 7;
+    out[4]   = 6;
+
+    EXPECT_EQ(check_err_stats(out, ref, 0, 0).err_count, 2);
+    EXPECT_EQ(check_err_stats(out, ref, 0, 1).err_count, 1);
+    EXPECT_EQ(check_err_stats(out, ref, 0, 0).ulp_histogram[2], 1);
+    EXPECT_TRUE(ck::utils::check_err(ref, ref));
+}
+
+TEST(CheckErr, BHalf)
+{
+    std::vector<ck::bhalf_t> ref(100, ck::type_convert<ck::bhalf_t>(1.f));
+    auto out = ref;
+    // 3 ulp of bf16 at 1.0
+    out[10] = ck::type_convert<ck::bhalf_t>(1.f + 3.f / 128.f);
+
+    const auto result = check_err_stats(out, ref, 1e-3, 1e-3);
+
+    EXPECT_EQ(result.err_count, 1);
+    EXPECT_EQ(result.ulp_histogram[2], 1);
+    EXPECT_FALSE(ck::utils::check_err(out, ref));
+}
+
+TEST(CheckErr, Streaming)
+{
+    // neither the size nor the chunks are multiples of the lane count
+    const auto ref = make_ref(100005);
+    auto out       = ref;
+    out[5]         = 0;
+    out[70001]     = 0;
+    out[100004]    = 0;
+
+    // out stored behind a 64 byte header, in a file of this process that is removed on exit
+    const TempFile temp("test_check_err_streaming.bin");
+    {
+        std::ofstream file(temp.path, std::ios::binary);
+        const std::vector<char> header(64);
+        file.write(header.data(), header.size());
+        file.write(reinterpret_cast<const char*>(out.data()), out.size() * sizeof(float));
+    }
+
+    ck::utils::MappedFile file(temp.path.string());
+
+    ck::utils::StreamingCheckErrConfig config;
+    config.chunk_size           = 30001;
+    config.check_config.lengths = {5, 20001};
+
+    std::vector<std::size_t> chunk_errors;
+    config.on_chunk = [&](const ck::utils::CheckErrChunk& chunk) {
+        EXPECT_EQ(chunk.offset, chunk.index * config.chunk_size);
+        chunk_errors.push_back(chunk.result.err_count);
+    };
+
+    const auto result =
+        ck::utils::check_err_streaming<float>(ref.size(),
+                                              ck::utils::make_mapped_file_source<float>(file, 64),
+                                              ck::utils::make_range_source(ref),
+                                              1e-5,
+                                              3e-6,
+                                              config);
+    const auto expected = check_err_stats(out, ref, 1e-5, 3e-6);
+
+    EXPECT_EQ(chunk_errors, (std::vector<std::size_t>{1, 0, 1, 1}));
+    EXPECT_EQ(result.num_element, ref.size());
+    EXPECT_EQ(result.num_finite, ref.size());
+    EXPECT_EQ(result.err_count, 3);
+    EXPECT_EQ(result.ulp_histogram, expected.ulp_histogram);
+    EXPECT_EQ(result.ulp_histogram[0], ref.size() - 3);
+    EXPECT_DOUBLE_EQ(result.max_abs_err, expected.max_abs_err);
+    EXPECT_NEAR(result.mean_abs_err, expected.mean_abs_err, 1e-12);
+    ASSERT_EQ(result.mismatches.size(), 3);
+    EXPECT_EQ(result.mismatches[1].index, 70001);
+    EXPECT_EQ(result.mismatches[1].multi_index, (std::vector<std::size_t>{3, 9998}));
+
+    // the budget of one error runs out in the third chunk
+    config.max_err_count = 1;
+    chunk_errors.clear();
+
+    const auto partial =
+        ck::utils::check_err_streaming<float>(ref.size(),
+                                              ck::utils::make_mapped_file_source<float>(file, 64),
+                                              ck::utils::make_range_source(ref),
+                                              1e-5,
+                                              3e-6,
+                                              config);
+
+    EXPECT_FALSE(partial);
+    EXPECT_EQ(partial.num_element, 90003);
+    EXPECT_EQ(partial.num_finite, 90003);
+    EXPECT_EQ(partial.err_count, 2);
+    EXPECT_EQ(chunk_errors.size(), 3);
+}
+
+TEST(CheckErr, StreamingUnalignedSizes)
+{
+    // chunks of sizes that are not multiples of the lane count, each with a padded last step
+    for(std::size_t n : {1, 5, 17, 259})
+    {
+        for(std::size_t chunk_size : {1, 3, 7, 64})
+        {
+            const std::vector<float> ref(n, 1.f);
+            auto out = ref;
+            out[0]   = 2.f;
+
+            ck::utils::StreamingCheckErrConfig config;
+            config.chunk_size = chunk_size;
+
+            const auto result =
+                ck::utils::check_err_streaming<float>(n,
+                                                      ck::utils::make_range_source(out),
+                                                      ck::utils::make_range_source(ref),
+                                                      0,
+                                                      0.5,
+                                                      config);
+
+            EXPECT_EQ(result.num_element, n) << n << " " << chunk_size;
+            EXPECT_EQ(result.num_finite, n) << n << " " << chunk_size;
+            EXPECT_EQ(result.err_count, 1) << n << " " << chunk_size;
+            EXPECT_EQ(result.ulp_histogram[0], n - 1) << n << " " << chunk_size;
+            EXPECT_DOUBLE_EQ(result.mean_abs_err, 1. / n) << n << " " << chunk_size;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/check_err.hpp"
+
+TEST(CkTileCheckErr, UnalignedSizes)
+{
+    // sizes that are not a multiple of the accumulator lanes, nor of the block
+    for(std::size_t n : {1, 5, 17, 259})
+    {
+        const std::vector<float> ref(n, 1.f);
+        auto out = ref;
+        out[0]   = 2.f;
+
+        const auto result = ck_tile::check_err_stats(out, ref, 0, 0.5);
+
+        EXPECT_EQ(result.num_element, n);
+        EXPECT_EQ(result.err_count, 1);
+        EXPECT_EQ(result.ulp_histogram[0], n - 1);
+        EXPECT_DOUBLE_EQ(result.mean_abs_err, 1. / n);
+    }
+
+    // a non-finite element in the padded last step
+    std::vector<float> ref(5, 1.f);
+    auto out = ref;
+    out[4]   = std::numeric_limits<float>::infinity();
+    out[0]   = 1.5f;
+
+    const auto result = ck_tile::check_err_stats(out, ref, 0, 0.5);
+
+    EXPECT_EQ(result.out_inf_count, 1);
+    EXPECT_EQ(result.ulp_histogram[0], 3);
+    EXPECT_DOUBLE_EQ(result.mean_abs_err, 0.5 / 4);
+}
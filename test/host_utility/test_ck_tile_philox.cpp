@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/fill.hpp"
+#include "ck_tile/host/fill.hpp"
+
+// ck_tile has a Philox4x32 generator of its own so that it does not depend on the ck library.
+// Both must produce the same streams, so that a tensor filled with a seed by either one is the
+// same tensor.
+
+TEST(CkTilePhilox, SameBlocksAsCk)
+{
+    const std::vector<std::uint64_t> seeds{0, 42, 0x123456789abcdef};
+    // including counters across the 32 bit boundary of the low counter word
+    const std::vector<std::uint64_t> counters{
+        0, 5, (std::uint64_t{1} << 32) - 3, std::uint64_t{1} << 40};
+
+    for(std::uint64_t seed : seeds)
+    {
+        for(std::uint64_t counter : counters)
+        {
+            std::array<std::uint32_t, 4> blocks[8];
+            ck_tile::detail::philox4x32(seed, counter, blocks);
+
+            for(std::uint64_t l = 0; l < 8; ++l)
+                EXPECT_EQ(blocks[l], ck::utils::Philox4x32::Generate(seed, counter + l))
+                    << seed << " " << counter + l;
+        }
+    }
+}
+
+TEST(CkTilePhilox, SameFillsAsCk)
+{
+    // a size and an offset that are not multiples of the 4 x 8 elements of a group of blocks
+    const std::size_t n = 100003;
+
+    std::vector<float> ck_values(n), ck_tile_values(n);
+    ck::utils::FillUniformDistribution<float>{-3.f, 7.f, 1234}(ck_values);
+    ck_tile::FillUniformDistribution<float>{-3.f, 7.f, 1234}(ck_tile_values);
+    EXPECT_EQ(ck_values, ck_tile_values);
+
+    ck::utils::FillUniformDistribution<float>{-3.f, 7.f, 1234}(
+        ck_values.begin(), ck_values.end(), 77);
+    ck_tile::FillUniformDistribution<float>{-3.f, 7.f, 1234}(
+        ck_tile_values.begin(), ck_tile_values.end(), 77);
+    EXPECT_EQ(ck_values, ck_tile_values);
+
+    ck::utils::FillUniformDistributionIntegerValue<float>{-5.f, 5.f, 99}(ck_values);
+    ck_tile::FillUniformDistributionIntegerValue<float>{-5.f, 5.f, 99}(ck_tile_values);
+    EXPECT_EQ(ck_values, ck_tile_values);
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/host_utility/timing_stats.hpp"
+#include "ck_tile/host/timing_stats.hpp"
+
+// ck_tile keeps a timing_recorder of its own so that it does not depend on the ck library. Both
+// must report the same statistics of the same samples, so that the timings of ck and ck_tile
+// kernels can be compared.
+
+namespace {
+
+void expect_same_stats(const std::vector<float>& times, float outlier_threshold)
+{
+    ck::utility::TimingRecorder ck_recorder;
+    ck_tile::timing_recorder ck_tile_recorder;
+
+    const auto get_time = [&](int i) { return times[i]; };
+    const int nrepeat   = static_cast<int>(times.size());
+
+    const auto& a = ck_recorder.Record(nrepeat, get_time, outlier_threshold);
+    const auto& b = ck_tile_recorder.record(nrepeat, get_time, outlier_threshold);
+
+    EXPECT_EQ(a.count, b.count);
+    EXPECT_EQ(a.outliers, b.outliers);
+    EXPECT_EQ(a.mean, b.mean);
+    EXPECT_EQ(a.min, b.min);
+    EXPECT_EQ(a.median, b.median);
+    EXPECT_EQ(a.p90, b.p90);
+    EXPECT_EQ(a.p99, b.p99);
+    EXPECT_EQ(a.max, b.max);
+    EXPECT_EQ(a.stddev, b.stddev);
+    EXPECT_EQ(ck_recorder.GetSamples(), ck_tile_recorder.samples());
+}
+
+} // namespace
+
+TEST(CkTileTimingStats, SameStatsAsCk)
+{
+    std::vector<std::vector<float>> sample_sets{
+        {},
+        {2.f},
+        {1.f, 1.f, 1.f, 5.f},
+        {1.f, 1.02f, 0.98f, 1.01f, 0.99f, 9.f, 1.f, 1.03f, 0.97f, 20.f},
+        // 1.149 is just outside of 1 scaled MAD from the median
+        {0.9f, 1.f, 1.1f, 1.f, 0.9f, 1.1f, 1.149f},
+        // every sample is an outlier with a threshold of 0.5
+        {1.f, 2.f}};
+
+    // a long, noisy timer with a few preempted iterations
+    std::vector<float> noisy;
+    for(int i = 0; i < 1000; ++i)
+    {
+        noisy.push_back(0.5f + 0.01f * std::sin(i * 0.7f) + (i % 97 == 0 ? 3.f : 0.f));
+    }
+    sample_sets.push_back(noisy);
+
+    for(const auto& times : sample_sets)
+    {
+        for(float outlier_threshold : {0.f, 0.5f, 1.f, 3.f})
+        {
+            expect_same_stats(times, outlier_threshold);
+        }
+    }
+
+    std::sort(noisy.begin(), noisy.end());
+    for(float percentile : {0.f, 37.5f, 50.f, 90.f, 99.f, 100.f})
+    {
+        EXPECT_EQ(ck::utility::TimingRecorder::GetPercentile(noisy, percentile),
+                  ck_tile::get_percentile(noisy, percentile));
+    }
+}
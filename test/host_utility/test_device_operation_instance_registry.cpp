@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+#include "ck/library/tensor_operation_instance/add_device_operation_instance.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_registry.hpp"
+
+using ck::tensor_operation::device::BaseOperator;
+using ck::tensor_operation::device::GemmSpecialization;
+using ck::tensor_operation::device::getGemmSpecializationString;
+using namespace ck::tensor_operation::device::instance;
+
+namespace {
+
+struct MockDeviceOp : public BaseOperator
+{
+    virtual int GetTile() const = 0;
+};
+
+// every instance constructed on the heap, as the factories do
+int num_heap_instances = 0;
+
+template <GemmSpecialization Spec, int Tile, int Pipeline>
+struct MockInstance : public MockDeviceOp
+{
+    static void* operator new(std::size_t size)
+    {
+        ++num_heap_instances;
+        return ::operator new(size);
+    }
+
+    int GetTile() const override { return Tile; }
+
+    std::string GetTypeString() const override
+    {
+        const std::string tile = std::to_string(Tile);
+        return "MockInstance<" + getGemmSpecializationString(Spec) + ", 256> BlkTile: " + tile +
+               "x" + tile + "x32, PipelineVersion: v" + std::to_string(Pipeline);
+    }
+};
+
+using mock_instances = std::tuple<MockInstance<GemmSpecialization::Default, 128, 1>,
+                                  MockInstance<GemmSpecialization::MNKPadding, 128, 3>,
+                                  MockInstance<GemmSpecialization::MNPadding, 256, 1>,
+                                  MockInstance<GemmSpecialization::MNKPadding, 256, 3>>;
+
+// an instance that is not added with add_device_operation_instances()
+struct OtherInstance : public MockDeviceOp
+{
+    int GetTile() const override { return 64; }
+    std::string GetTypeString() const override { return "OtherInstance<Default>"; }
+};
+
+int num_factory_calls = 0;
+
+std::vector<std::unique_ptr<MockDeviceOp>> get_mock_instances()
+{
+    ++num_factory_calls;
+
+    std::vector<std::unique_ptr<MockDeviceOp>> op_ptrs;
+    add_device_operation_instances(op_ptrs, mock_instances{});
+    op_ptrs.push_back(std::make_unique<OtherInstance>());
+    return op_ptrs;
+}
+
+using Registry = DeviceOperationInstanceRegistry<MockDeviceOp>;
+
+} // namespace
+
+TEST(DeviceOperationInstanceRegistry, CollectsWithoutConstructing)
+{
+    num_heap_instances = 0;
+    num_factory_calls  = 0;
+
+    const Registry registry(get_mock_instances);
+    EXPECT_EQ(num_heap_instances, 0);
+    EXPECT_EQ(num_factory_calls, 1);
+
+    const auto& descriptors = registry.GetDescriptors();
+    ASSERT_EQ(descriptors.size(), 5);
+    EXPECT_EQ(descriptors[0].type_string,
+              "MockInstance<Default, 256> BlkTile: 128x128x32, PipelineVersion: v1");
+    EXPECT_EQ(descriptors[4].type_string, "OtherInstance<Default>");
+
+    // the factory is unaffected outside of the registry
+    EXPECT_EQ(get_mock_instances().size(), 5);
+    EXPECT_EQ(num_heap_instances, 4);
+}
+
+TEST(DeviceOperationInstanceRegistry, Filter)
+{
+    const Registry registry(get_mock_instances);
+
+    EXPECT_EQ(registry.Filter(AnyDescriptor{}).size(), 5);
+    EXPECT_EQ(registry.Filter(MatchGemmSpecialization{GemmSpecialization::Default}).size(), 2);
+    EXPECT_EQ(registry.Filter(MatchGemmSpecialization{GemmSpecialization::MNKPadding}).size(), 2);
+    EXPECT_EQ(registry.Filter(MatchGemmSpecialization{GemmSpecialization::KPadding}).size(), 0);
+
+    EXPECT_EQ(registry.Filter(MatchTypeStringField{"BlkTile", "256x256x32"}).size(), 2);
+    EXPECT_EQ(registry.Filter(MatchTypeStringField{"BlkTile", "256x256"}).size(), 0);
+    EXPECT_EQ(registry.Filter(MatchTypeStringField{"PipelineVersion", "v3"}).size(), 2);
+    EXPECT_EQ(registry.Filter(MatchTypeStringField{"Version", "v3"}).size(), 0);
+
+    const auto found = registry.Filter([](const auto& d) {
+        return MatchGemmSpecialization{GemmSpecialization::MNKPadding}(d) &&
+               MatchTypeStringField{"BlkTile", "256x256x32"}(d);
+    });
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0], &registry.GetDescriptors()[3]);
+}
+
+TEST(DeviceOperationInstanceRegistry, ConstructsOnDemand)
+{
+    const Registry registry(get_mock_instances);
+
+    num_heap_instances = 0;
+    num_factory_calls  = 0;
+
+    const auto op_ptrs = registry.GetInstances(MatchTypeStringField{"PipelineVersion", "v3"});
+    ASSERT_EQ(op_ptrs.size(), 2);
+    EXPECT_EQ(op_ptrs[0]->GetTile(), 128);
+    EXPECT_EQ(op_ptrs[1]->GetTile(), 256);
+    EXPECT_EQ(op_ptrs[1]->GetTypeString(), registry.GetDescriptors()[3].type_string);
+    EXPECT_EQ(num_heap_instances, 2);
+    EXPECT_EQ(num_factory_calls, 0);
+
+    // an instance the factory constructs by other means runs the factory again
+    const auto other = registry.MakeInstance(registry.GetDescriptors()[4]);
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(other->GetTile(), 64);
+    EXPECT_EQ(num_heap_instances, 2);
+    EXPECT_EQ(num_factory_calls, 1);
+
+    EXPECT_EQ(registry.GetInstances().size(), 5);
+}
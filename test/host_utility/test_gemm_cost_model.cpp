@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "profiler/gemm_cost_model.hpp"
+
+using ck::profiler::GemmCostModel;
+using ck::profiler::GemmCostSample;
+using ck::profiler::GemmTileParams;
+
+namespace {
+
+const std::string xdl =
+    "DeviceGemmXdl<256, 256, 128, 4, 8, 32, 32, 4, 2, 8, 8, 8, 8> NumPrefetch: 1, LoopScheduler: "
+    "Default";
+const std::string cshuffle =
+    "DeviceGemm_Xdl_CShuffle<Default, 256, 128, 128, 32, 8, 8, 32, 32, 2, 2, 8, 8> LoopScheduler: "
+    "Default";
+const std::string universal =
+    "DeviceGemmXdlUniversal<MNKPadding, RRR> BlkSize: 256, BlkTile: 224x256x64, WaveTile: 16x16, "
+    "WaveMap: 7x8, VmemReadVec: 8x8, BlkGemmPipelineScheduler: Intrawave, "
+    "BlkGemmPipelineVersion: v4, BlkGemmPipelinePrefetchStages: 2";
+
+GemmTileParams make_tile(int m_per_block, int n_per_block, int k_per_block)
+{
+    GemmTileParams p;
+    p.kernel      = "DeviceGemm_Xdl_CShuffle";
+    p.block_size  = 256;
+    p.m_per_block = m_per_block;
+    p.n_per_block = n_per_block;
+    p.k_per_block = k_per_block;
+    return p;
+}
+
+} // namespace
+
+TEST(GemmCostModel, ParseTypeStrings)
+{
+    const auto p0 = ck::profiler::parse_gemm_tile_params(xdl);
+    ASSERT_TRUE(p0.has_value());
+    EXPECT_EQ(p0->kernel, "DeviceGemmXdl");
+    EXPECT_EQ(p0->specialization, "MNKPadding");
+    EXPECT_EQ(p0->block_size, 256);
+    EXPECT_EQ(p0->m_per_block, 256);
+    EXPECT_EQ(p0->n_per_block, 128);
+    EXPECT_EQ(p0->k_per_block, 32); // K0PerBlock x K1
+    EXPECT_EQ(p0->m_per_inst, 32);
+    EXPECT_EQ(p0->n_repeat, 2);
+
+    const auto p1 = ck::profiler::parse_gemm_tile_params(cshuffle);
+    ASSERT_TRUE(p1.has_value());
+    EXPECT_EQ(p1->specialization, "Default");
+    EXPECT_EQ(p1->k_per_block, 32);
+    EXPECT_EQ(p1->m_per_inst, 32);
+    EXPECT_EQ(p1->n_per_inst, 32);
+    EXPECT_EQ(p1->m_repeat, 2);
+    EXPECT_EQ(p1->lds_buffers, 1);
+
+    const auto p2 = ck::profiler::parse_gemm_tile_params(universal);
+    ASSERT_TRUE(p2.has_value());
+    EXPECT_EQ(p2->specialization, "MNKPadding");
+    EXPECT_EQ(p2->m_per_block, 224);
+    EXPECT_EQ(p2->n_per_block, 256);
+    EXPECT_EQ(p2->k_per_block, 64);
+    EXPECT_EQ(p2->m_per_inst, 16);
+    EXPECT_EQ(p2->m_repeat, 7);
+    EXPECT_EQ(p2->n_repeat, 8);
+    EXPECT_EQ(p2->lds_buffers, 2);
+
+    EXPECT_FALSE(ck::profiler::parse_gemm_tile_params("DeviceGemmFoo"));
+    EXPECT_FALSE(ck::profiler::parse_gemm_tile_params("DeviceGemmFoo<Default, a, b>"));
+    EXPECT_FALSE(ck::profiler::parse_gemm_tile_params("DeviceGemmFoo<256, 0, 128, 32, 8>"));
+}
+
+TEST(GemmCostModel, WaveQuantization)
+{
+    const auto p = make_tile(256, 256, 64);
+
+    // 16 tiles on 8 CUs (one workgroup each) are two full waves, 20 tiles need a third wave
+    const auto full = ck::profiler::get_gemm_cost_features(p, 1024, 1024, 1024, 2, 8);
+    const auto tail = ck::profiler::get_gemm_cost_features(p, 1024 + 256, 1024, 1024, 2, 8);
+
+    EXPECT_TRUE(full.supported);
+    EXPECT_NEAR(full.wave_efficiency, 1., 1e-12);
+    EXPECT_NEAR(full.padding_waste, 0., 1e-12);
+    EXPECT_NEAR(tail.wave_efficiency, 20. / 24., 1e-12);
+    EXPECT_NEAR(tail.terms[1] / full.terms[1], 1.5, 1e-12);
+    EXPECT_NEAR(tail.terms[3] / full.terms[3], 1.5, 1e-12);
+}
+
+TEST(GemmCostModel, Padding)
+{
+    auto p           = make_tile(128, 128, 32);
+    p.specialization = "Default";
+
+    EXPECT_TRUE(ck::profiler::get_gemm_cost_features(p, 256, 256, 64, 2, 1).supported);
+    EXPECT_FALSE(ck::profiler::get_gemm_cost_features(p, 255, 256, 64, 2, 1).supported);
+    EXPECT_FALSE(ck::profiler::get_gemm_cost_features(p, 256, 256, 65, 2, 1).supported);
+
+    p.specialization = "MNPadding";
+    EXPECT_TRUE(ck::profiler::get_gemm_cost_features(p, 255, 200, 64, 2, 1).supported);
+    EXPECT_FALSE(ck::profiler::get_gemm_cost_features(p, 255, 200, 65, 2, 1).supported);
+
+    p.specialization = "MNKPadding";
+    const auto f     = ck::profiler::get_gemm_cost_features(p, 129, 128, 32, 2, 4);
+    EXPECT_TRUE(f.supported);
+    EXPECT_NEAR(f.padding_waste, 256. / 129. - 1, 1e-12);
+
+    // K is split into k_batch parts, each of them padded to KPerBlock
+    EXPECT_TRUE(ck::profiler::get_gemm_cost_features(p, 128, 128, 96, 2, 4, 2).supported);
+    p.specialization = "Default";
+    EXPECT_FALSE(ck::profiler::get_gemm_cost_features(p, 128, 128, 96, 2, 4, 2).supported);
+    EXPECT_TRUE(ck::profiler::get_gemm_cost_features(p, 128, 128, 96, 2, 4, 3).supported);
+
+    GemmCostModel model;
+    EXPECT_TRUE(
+        std::isinf(model.Predict(ck::profiler::get_gemm_cost_features(p, 129, 128, 32, 2, 4))));
+}
+
+TEST(GemmCostModel, SplitK)
+{
+    const auto p = make_tile(128, 128, 64);
+
+    // one tile on 64 CUs: splitting K in 4 has 4 workgroups in one wave, with a quarter of the
+    // main loop each
+    const auto f1 = ck::profiler::get_gemm_cost_features(p, 128, 128, 4096, 2, 64, 1);
+    const auto f4 = ck::profiler::get_gemm_cost_features(p, 128, 128, 4096, 2, 64, 4);
+
+    EXPECT_NEAR(f4.terms[3] * 4, f1.terms[3], 1e-12);
+    EXPECT_NEAR(f4.terms[1] * 4, f1.terms[1], 1e-12);
+    EXPECT_NEAR(f4.wave_efficiency, 4 * f1.wave_efficiency, 1e-12);
+}
+
+TEST(GemmCostModel, FitRecoversWeights)
+{
+    GemmCostModel truth;
+    truth.weights = {0.01, 0.3, 0.1, 0.2};
+
+    std::vector<GemmCostSample> samples;
+    for(int m : {64, 128, 256})
+    {
+        for(int n : {64, 128, 256})
+        {
+            for(std::int64_t size : {256, 1000, 4096, 8192})
+            {
+                GemmCostSample s;
+                s.features = ck::profiler::get_gemm_cost_features(
+                    make_tile(m, n, 32), size, size / 2, size * 2, 2, 104);
+                s.time = truth.Predict(s.features);
+                samples.push_back(s);
+            }
+        }
+    }
+
+    const auto fitted = GemmCostModel::Fit(samples);
+    for(std::size_t i = 0; i < truth.weights.size(); ++i)
+    {
+        EXPECT_NEAR(fitted.weights[i], truth.weights[i], 1e-6 * (1 + truth.weights[i]));
+    }
+
+    // a term that only slows things down when it is small gets weight 0 instead of negative
+    for(auto& s : samples)
+    {
+        s.time = 0.01 + 0.3 * s.features.terms[1] + 0.01 / (1 + s.features.terms[3]);
+    }
+    for(auto w : GemmCostModel::Fit(samples).weights)
+    {
+        EXPECT_GE(w, 0.);
+    }
+}
+
+TEST(GemmCostModel, EvaluateRanking)
+{
+    GemmCostModel model;
+    model.weights = {0, 1, 0, 0};
+
+    auto sample = [](double compute, double time) {
+        GemmCostSample s;
+        s.features.terms = {1, compute, 0, 0};
+        s.time           = time;
+        return s;
+    };
+
+    // the model ranks the fastest instance first in the first problem, second in the other one
+    const std::vector<std::vector<GemmCostSample>> problems{
+        {sample(1, 1), sample(2, 2), sample(3, 3)}, {sample(1, 2), sample(2, 1), sample(3, 4)}};
+
+    const auto top1 = ck::profiler::evaluate_gemm_ranking(problems, model, 1);
+    EXPECT_EQ(top1.problems, 2);
+    EXPECT_NEAR(top1.hit_rate, 0.5, 1e-12);
+    EXPECT_NEAR(top1.mean_regret, 1.5, 1e-12);
+
+    const auto top2 = ck::profiler::evaluate_gemm_ranking(problems, model, 2);
+    EXPECT_NEAR(top2.hit_rate, 1., 1e-12);
+    EXPECT_NEAR(top2.mean_regret, 1., 1e-12);
+}
+
+TEST(GemmCostModel, RankInstances)
+{
+    const std::vector<std::string> type_strings{
+        cshuffle, "DeviceGemmFoo<x>", xdl, universal, "DeviceGemmXdl<256, 64, 64, 4, 8>"};
+
+    // M is not a multiple of the 128 x 128 tile of the Default cshuffle instance
+    const auto ranks =
+        ck::profiler::rank_gemm_instances(type_strings, GemmCostModel{}, 3900, 4096, 4096, 2, 104);
+    ASSERT_EQ(ranks.size(), type_strings.size());
+    EXPECT_EQ(ranks[3], 0); // unsupported
+    EXPECT_EQ(ranks[4], 1); // not understood
+}
+
+TEST(GemmCostModel, SelectInstances)
+{
+    struct Instance
+    {
+        std::string name;
+        std::string GetTypeString() const { return name; }
+    };
+
+    auto& config = ck::profiler::GemmCostModelConfig::GetInstance();
+
+    std::vector<std::unique_ptr<Instance>> op_ptrs;
+    for(const auto& name : {xdl, std::string("DeviceGemmFoo<x>"), universal, cshuffle})
+    {
+        op_ptrs.push_back(std::make_unique<Instance>(Instance{name}));
+    }
+
+    // the device is only queried when the instances are ranked
+    int num_cu_queries = 0;
+    const auto get_num_cu = [&] {
+        ++num_cu_queries;
+        return 104;
+    };
+
+    config.top_k = 0;
+    ck::profiler::select_gemm_instances(op_ptrs, 4096, 4096, 4096, 2, get_num_cu);
+    EXPECT_EQ(op_ptrs.size(), 4);
+    EXPECT_EQ(num_cu_queries, 0);
+
+    config.top_k = 2;
+    ck::profiler::select_gemm_instances(op_ptrs, 4096, 4096, 4096, 2, get_num_cu);
+    ASSERT_EQ(op_ptrs.size(), 3);
+    EXPECT_EQ(num_cu_queries, 1);
+    EXPECT_EQ(op_ptrs[2]->name, "DeviceGemmFoo<x>");
+
+    config.top_k = 0;
+}
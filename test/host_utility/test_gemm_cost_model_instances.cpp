@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_dl.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_dpp.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_wmma.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle_lds_direct_load.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle_v2.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle_v3.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "profiler/gemm_cost_model.hpp"
+
+// parse_gemm_tile_params() on the GetTypeString() of one instance of every kernel family of the
+// gemm and gemm_universal instance lists, copied from the library
+
+using namespace ck::tensor_operation::device;
+
+using F16  = ck::half_t;
+using BF16 = ck::bhalf_t;
+using F32  = float;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+template <ck::index_t... Is>
+using S = ck::Sequence<Is...>;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+static constexpr auto GemmDefault    = GemmSpecialization::Default;
+static constexpr auto GemmMNKPadding = GemmSpecialization::MNKPadding;
+
+using ck::BlockGemmPipelineScheduler;
+using ck::BlockGemmPipelineVersion;
+using ck::LoopScheduler;
+using ck::PipelineVersion;
+
+namespace {
+
+// block size, M, N and K per block, M and N per instruction, M and N repeats
+struct ExpectedTile
+{
+    std::string specialization;
+    int block_size;
+    int m_per_block;
+    int n_per_block;
+    int k_per_block;
+    int m_per_inst;
+    int n_per_inst;
+    int m_repeat;
+    int n_repeat;
+    int lds_buffers = 1;
+};
+
+template <typename DeviceOp>
+void expect_tile(const ExpectedTile& e)
+{
+    const std::string type_string = DeviceOp{}.GetTypeString();
+    const auto p                  = ck::profiler::parse_gemm_tile_params(type_string);
+
+    ASSERT_TRUE(p.has_value()) << type_string;
+    EXPECT_EQ(p->specialization, e.specialization) << type_string;
+    EXPECT_EQ(p->block_size, e.block_size) << type_string;
+    EXPECT_EQ(p->m_per_block, e.m_per_block) << type_string;
+    EXPECT_EQ(p->n_per_block, e.n_per_block) << type_string;
+    EXPECT_EQ(p->k_per_block, e.k_per_block) << type_string;
+    EXPECT_EQ(p->m_per_inst, e.m_per_inst) << type_string;
+    EXPECT_EQ(p->n_per_inst, e.n_per_inst) << type_string;
+    EXPECT_EQ(p->m_repeat, e.m_repeat) << type_string;
+    EXPECT_EQ(p->n_repeat, e.n_repeat) << type_string;
+    EXPECT_EQ(p->lds_buffers, e.lds_buffers) << type_string;
+}
+
+} // namespace
+
+// clang-format off
+TEST(GemmCostModel, ParseXdl)
+{
+    // K0PerBlock x K1, the specialization is not printed
+    expect_tile<DeviceGemmXdl<  F32,   F32,   F32,     F32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough,   GemmDefault,   256,   256,   128,     4,  4,   32,   32,    4,    2,     S<4, 64, 1>,     S<0, 2, 1>,     S<0, 2, 1>,              1,              4,              4,      true,     S<4, 64, 1>,     S<0, 2, 1>,     S<0, 2, 1>,             1,              2,              4,      true,               7,               1>>(
+        {"MNKPadding", 256, 256, 128, 16, 32, 32, 4, 2});
+}
+
+TEST(GemmCostModel, ParseXdlCShuffle)
+{
+    expect_tile<DeviceGemm_Xdl_CShuffle<     Row,     Col,     Row,   F16,   F16,   F16,     F32,      F16, PassThrough, PassThrough, PassThrough,    GemmDefault,        2,   256,   256,   128,    32,   8,   8,   32,   32,    4,    2,     S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1,     S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,             2,              8,              8,         1,           1,           1,               S<1, 32, 1, 8>,               8, LoopScheduler::Default,        PipelineVersion::v1>>(
+        {"Default", 256, 256, 128, 32, 32, 32, 4, 2});
+}
+
+TEST(GemmCostModel, ParseXdlCShuffleV2)
+{
+    expect_tile<DeviceGemm_Xdl_CShuffleV2<   Row,     Col,     Row,  BF16,  BF16,  BF16,     F32,     BF16, PassThrough, PassThrough, PassThrough,    GemmDefault,        2,   256,   256,   256,    32,   8,   8,   32,   32,    4,    4,     S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         0,     S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,             2,              8,              8,         0,           1,           1,               S<1, 32, 1, 8>,              8,  LoopScheduler::Default,        PipelineVersion::v1>>(
+        {"Default", 256, 256, 256, 32, 32, 32, 4, 4});
+}
+
+TEST(GemmCostModel, ParseXdlCShuffleLdsDirectLoad)
+{
+    // the specialization is printed last
+    expect_tile<DeviceGemm_Xdl_CShuffle_LdsDirectLoad<     Row,     Col,     Row,   F16,   F16,   F16,     F32,      F32, PassThrough, PassThrough, PassThrough,    GemmDefault,        2,   256,    64,    64,    64,  16,  16,   32,   32,    1,    1,      S<4, 8, 8>,     S<1, 0, 2>,              2,              2,         0,      S<4, 8, 8>,     S<1, 0, 2>,             2,              2,         0,           1,           1,                S<1, 8, 1, 8>,               4>>(
+        {"Default", 256, 64, 64, 64, 32, 32, 1, 1});
+}
+
+TEST(GemmCostModel, ParseXdlUniversal)
+{
+    expect_tile<DeviceGemm_Xdl_CShuffleV3<  Row,     Col,     Row,     F16,   F16,  F16,   F32,     F16,      PassThrough, PassThrough, PassThrough,    GemmMNKPadding,   256,   256,   256,    32,   8,   8,  32,   32,    4,    4,     S<4, 64, 1>,     S<1, 0, 2>,    S<1, 0, 2>,               2,              8,              8,          0,    S<4, 64, 1>,     S<1, 0, 2>,    S<1, 0, 2>,               2,              8,              8,          0,          1,           1,                   S<1, 32, 1, 8>,               8,  BlockGemmPipelineScheduler::Intrawave, BlockGemmPipelineVersion::v4>>(
+        {"MNKPadding", 256, 256, 256, 32, 32, 32, 4, 4, 2});
+}
+
+TEST(GemmCostModel, ParseDl)
+{
+    // K0PerBlock x K1, no instruction tile
+    expect_tile<DeviceGemmDl<   F16,   F16,   F16,     F32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough,    GemmDefault,   256,   128,   128,    16,  2,          4,          4,      1,       S<8, 2>,       S<8, 2>,      S<2, 1, 4, 2>,       S<8, 1, 32, 1>,  S<0, 3, 1, 2>,  S<0, 3, 1, 2>,       S<1, 1, 4, 1>,      S<0, 3, 1, 2>,        S<1, 1, 4, 2>,      S<2, 1, 4, 2>,       S<8, 1, 32, 1>,  S<0, 3, 1, 2>,  S<0, 3, 1, 2>,       S<1, 1, 4, 1>,      S<0, 3, 1, 2>,        S<1, 1, 4, 2>, S<0, 1, 2, 3, 4, 5>,                5,                  4>>(
+        {"MNKPadding", 256, 128, 128, 32, 0, 0, 0, 0});
+}
+
+TEST(GemmCostModel, ParseDpp)
+{
+    expect_tile<DeviceGemmDpp< F16,   F16,   F16,     F32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough,    GemmDefault,   256,   128,   128,    64,   4,   4,   16,   16,       2,       4,     S<4, 64, 1>,     S<0, 2, 1>,     S<0, 2, 1>,              1,              2,              4,      true,     S<4, 64, 1>,     S<0, 2, 1>,     S<0, 2, 1>,             1,              2,              4,      true,               5,               1>>(
+        {"MNKPadding", 256, 128, 128, 64, 16, 16, 2, 4});
+}
+
+TEST(GemmCostModel, ParseWmma)
+{
+    expect_tile<DeviceGemmWmma_CShuffle<      Col,     Row,     Row,   F16,   F16,   F16,     F32,      F16, PassThrough, PassThrough, PassThrough, GemmMNKPadding,           2,   256,   128,   128,    32,  8,   16,   16,      4,       2,     S<4, 64, 1>,     S<0, 2, 1>,     S<0, 2, 1>,              1,              1,              8,      true,     S<4, 64, 1>,     S<0, 2, 1>,     S<0, 2, 1>,              1,              1,              8,      true,        1,        1,       S<1, 32, 1,  8>,                      8>>(
+        {"MNKPadding", 256, 128, 128, 32, 16, 16, 4, 2});
+}
+// clang-format on
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "profiler/gemm_problem_list.hpp"
+
+using ck::profiler::GemmProblem;
+using ck::profiler::GemmProfileResult;
+
+namespace {
+
+struct HostBuffer
+{
+    void Realloc(std::size_t size) { data.assign(size, 0); }
+    std::size_t GetBufferSize() const { return data.size(); }
+    float* Get() { return reinterpret_cast<float*>(data.data()); }
+
+    std::vector<char> data;
+};
+
+// Row-major float GEMM on the host. The "instances" are a plain loop, the same loop limited to
+// K % 4 == 0, and a wrong one that skips the last k.
+class HostGemmBackend
+{
+    public:
+    std::size_t GetInstanceCount() const { return 3; }
+
+    std::string GetInstanceName(std::size_t i) const
+    {
+        const char* names[] = {"host_gemm", "host_gemm<K4>", "host_gemm_wrong"};
+        return names[i];
+    }
+
+    GemmProblem SetProblem(const GemmProblem& problem)
+    {
+        mProblem         = problem;
+        mProblem.StrideA = problem.StrideA < 0 ? problem.K : problem.StrideA;
+        mProblem.StrideB = problem.StrideB < 0 ? problem.N : problem.StrideB;
+        mProblem.StrideC = problem.StrideC < 0 ? problem.N : problem.StrideC;
+
+        const auto& p = mProblem;
+        float* a      = mBuffers.Get(0, sizeof(float) * p.M * p.StrideA).Get();
+        float* b      = mBuffers.Get(1, sizeof(float) * p.K * p.StrideB).Get();
+        mBuffers.Get(2, sizeof(float) * p.M * p.StrideC);
+
+        for(int i = 0; i < p.M * p.StrideA; ++i)
+            a[i] = static_cast<float>(i % 7 - 3);
+        for(int i = 0; i < p.K * p.StrideB; ++i)
+            b[i] = static_cast<float>(i % 5 - 2);
+
+        mReference.assign(static_cast<std::size_t>(p.M) * p.N, 0.f);
+        Gemm(mReference.data(), p.N, p.K);
+
+        return mProblem;
+    }
+
+    std::size_t GetNumBytes() const
+    {
+        return sizeof(float) * (mProblem.M * mProblem.K + mProblem.K * mProblem.N +
+                                mProblem.M * mProblem.N);
+    }
+
+    bool IsSupported(std::size_t i) const { return i != 1 || mProblem.K % 4 == 0; }
+
+    float Run(std::size_t i)
+    {
+        Gemm(mBuffers.Get(2, 0).Get(), mProblem.StrideC, i == 2 ? mProblem.K - 1 : mProblem.K);
+        return 1.f;
+    }
+
+    bool Verify(std::size_t)
+    {
+        const float* c = mBuffers.Get(2, 0).Get();
+
+        for(int m = 0; m < mProblem.M; ++m)
+            for(int n = 0; n < mProblem.N; ++n)
+                if(std::abs(c[m * mProblem.StrideC + n] - mReference[m * mProblem.N + n]) > 0.f)
+                    return false;
+        return true;
+    }
+
+    std::size_t GetAllocationCount() const { return mBuffers.GetAllocationCount(); }
+
+    private:
+    void Gemm(float* c, int stride_c, int k_end)
+    {
+        const float* a = mBuffers.Get(0, 0).Get();
+        const float* b = mBuffers.Get(1, 0).Get();
+
+        for(int m = 0; m < mProblem.M; ++m)
+            for(int n = 0; n < mProblem.N; ++n)
+            {
+                float acc = 0.f;
+                for(int k = 0; k < k_end; ++k)
+                    acc += a[m * mProblem.StrideA + k] * b[k * mProblem.StrideB + n];
+                c[m * stride_c + n] = acc;
+            }
+    }
+
+    GemmProblem mProblem;
+    ck::profiler::GrowingBufferPool<HostBuffer> mBuffers{3};
+    std::vector<float> mReference;
+};
+
+} // namespace
+
+TEST(GemmProblemList, Read)
+{
+    std::istringstream is("M,N,K,StrideA,StrideB,StrideC\n"
+                          "# bert\n"
+                          "384,768,768\n"
+                          "\n"
+                          "  384 768 2304   # blanks work too\n"
+                          "64,32,16,20,40,40\n");
+
+    const auto problems = ck::profiler::read_gemm_problems(is);
+
+    ASSERT_EQ(problems.size(), std::size_t{3});
+    EXPECT_EQ(problems[0].M, 384);
+    EXPECT_EQ(problems[0].StrideA, -1);
+    EXPECT_EQ(problems[1].K, 2304);
+    EXPECT_EQ(problems[2].StrideA, 20);
+    EXPECT_EQ(problems[2].StrideC, 40);
+
+    for(const char* bad : {"1,2\n", "1,2,3,4\n", "1,2,x3\n", "0,2,3\n", "1,2,99999999999\n"})
+    {
+        std::istringstream bad_is(bad);
+        EXPECT_THROW(ck::profiler::read_gemm_problems(bad_is), std::runtime_error);
+    }
+
+    EXPECT_THROW(ck::profiler::read_gemm_problems("no_such_problem_list.csv"),
+                 std::runtime_error);
+}
+
+TEST(GemmProblemList, BufferPool)
+{
+    ck::profiler::GrowingBufferPool<HostBuffer> pool(2);
+
+    // 100 increasing sizes grow the buffer a logarithmic number of times
+    for(std::size_t size = 1000; size <= 100000; size += 1000)
+        EXPECT_GE(pool.Get(0, size).GetBufferSize(), size);
+    EXPECT_LE(pool.GetAllocationCount(), std::size_t{13});
+
+    // a smaller request reuses the buffer, slots are independent
+    const std::size_t count = pool.GetAllocationCount();
+    pool.Get(0, 10);
+    EXPECT_EQ(pool.GetAllocationCount(), count);
+    pool.Get(1, 10);
+    EXPECT_EQ(pool.GetAllocationCount(), count + 1);
+}
+
+TEST(GemmProblemList, Profile)
+{
+    const std::vector<GemmProblem> problems = {
+        {16, 8, 12}, {7, 5, 3}, {4, 4, 8, 10, 6, 5}, {32, 16, 12}};
+
+    HostGemmBackend backend;
+    std::vector<GemmProfileResult> results;
+
+    const bool pass = ck::profiler::profile_gemm_problems(
+        backend, problems, true, [&](const GemmProfileResult& r) { results.push_back(r); });
+
+    EXPECT_FALSE(pass);
+    ASSERT_EQ(results.size(), problems.size() * backend.GetInstanceCount());
+
+    for(const auto& r : results)
+    {
+        const bool k4 = r.instance == "host_gemm<K4>";
+
+        EXPECT_EQ(r.supported, !k4 || r.problem.K % 4 == 0) << r.instance;
+        EXPECT_EQ(r.pass, r.instance != "host_gemm_wrong") << r.instance;
+        if(r.supported)
+        {
+            EXPECT_FLOAT_EQ(r.tflops, 2.f * r.problem.M * r.problem.N * r.problem.K / 1.E9f);
+        }
+    }
+
+    // default strides are resolved in the rows, explicit ones are kept
+    EXPECT_EQ(results[0].problem.StrideA, 12);
+    EXPECT_EQ(results[6].problem.StrideB, 6);
+
+    // 3 buffers, regrown only for the last (largest) problem
+    EXPECT_EQ(backend.GetAllocationCount(), std::size_t{6});
+
+    std::ostringstream csv;
+    ck::profiler::write_gemm_result_csv_header(csv);
+    for(const auto& r : results)
+        ck::profiler::write_gemm_result_csv(csv, r);
+
+    std::istringstream lines(csv.str());
+    std::string header, row;
+    std::getline(lines, header);
+    std::getline(lines, row);
+
+    EXPECT_EQ(header.rfind("problem_id,M,N,K,", 0), std::size_t{0});
+    EXPECT_EQ(row.rfind("0,16,8,12,12,8,8,\"host_gemm\",1,1,", 0), std::size_t{0}) << row;
+
+    // the result files get the rows as if each shape was profiled on its own
+    const auto result = ck::profiler::make_profile_result(results[0], "1 1 1 1 0 1", true, true);
+    EXPECT_EQ(result.problem, "1 1 1 1 0 1 16 8 12 12 8 8");
+    EXPECT_EQ(result.instance, "host_gemm");
+    EXPECT_EQ(result.verification, ck::profiler::VerificationStatus::Pass);
+    EXPECT_EQ(ck::profiler::make_profile_result(results[2], "", false, false).verification,
+              ck::profiler::VerificationStatus::NotRun);
+}
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_calibration.hpp"
+
+using ck::utils::CalibrationLayout;
+using ck::utils::CalibrationMethod;
+using ck::utils::CalibrationStats;
+
+namespace {
+
+// channel c of layout drawn from N(0, c + 1)
+std::vector<float> random_activation(const CalibrationLayout& layout, std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> dist(0.f, 1.f);
+
+    std::vector<float> x(layout.GetElementSize());
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        const std::size_t c = i / layout.inner % layout.num_channel;
+        x[i]                = dist(gen) * static_cast<float>(c + 1);
+    }
+
+    return x;
+}
+
+void check_stats(const CalibrationStats& stats,
+                 const std::vector<float>& x,
+                 const CalibrationLayout& layout)
+{
+    for(std::size_t c = 0; c < layout.num_channel; ++c)
+    {
+        float lo = INFINITY, hi = -INFINITY;
+        std::size_t count = 0;
+
+        for(std::size_t i = 0; i < x.size(); ++i)
+            if(i / layout.inner % layout.num_channel == c)
+            {
+                lo = std::min(lo, x[i]);
+                hi = std::max(hi, x[i]);
+                ++count;
+            }
+
+        ASSERT_EQ(stats.GetCount(c), count) << c;
+        ASSERT_FLOAT_EQ(stats.GetMin(c), lo) << c;
+        ASSERT_FLOAT_EQ(stats.GetMax(c), hi) << c;
+        ASSERT_FLOAT_EQ(stats.GetAmax(c), std::max(-lo, hi)) << c;
+
+        std::uint64_t hist_count = 0;
+        for(std::size_t b = 0; b < CalibrationStats::HistogramBinCount; ++b)
+            hist_count += stats.GetHistogram(c)[b];
+        ASSERT_EQ(hist_count, count) << c;
+    }
+}
+
+} // namespace
+
+TEST(HostCalibration, Observe)
+{
+    // per channel of an NHWC activation, per output channel of a weight and per tensor
+    for(const CalibrationLayout layout : {CalibrationLayout{3000, 16, 1},
+                                          CalibrationLayout{1, 16, 3000},
+                                          CalibrationLayout{7, 3, 1000},
+                                          CalibrationLayout{1, 1, 50000}})
+        for(std::size_t num_thread : {1, 4})
+        {
+            const auto x = random_activation(layout, 1);
+
+            CalibrationStats stats(layout.num_channel);
+            stats.Observe(x.data(), layout, num_thread);
+            check_stats(stats, x, layout);
+
+            // two batches merge into the statistics of one
+            const CalibrationLayout half{layout.outer, layout.num_channel, layout.inner / 2};
+            if(layout.inner % 2 == 0 && layout.outer == 1)
+            {
+                CalibrationStats a(layout.num_channel), b(layout.num_channel);
+                std::vector<float> x0, x1;
+                for(std::size_t i = 0; i < x.size(); ++i)
+                    (i % layout.inner < half.inner ? x0 : x1).push_back(x[i]);
+
+                a.Observe(x0.data(), half, num_thread);
+                b.Observe(x1.data(), half, num_thread);
+                a.Merge(b);
+
+                for(std::size_t c = 0; c < layout.num_channel; ++c)
+                    for(std::size_t k = 0; k < CalibrationStats::HistogramBinCount; ++k)
+                        ASSERT_EQ(a.GetHistogram(c)[k], stats.GetHistogram(c)[k]);
+            }
+        }
+
+    // half_t input, NaNs ignored
+    std::vector<ck::half_t> h = {ck::half_t{1}, ck::half_t{-3}, ck::half_t{NAN}, ck::half_t{2}};
+    CalibrationStats stats;
+    stats.Observe(h.data(), CalibrationLayout{1, 1, h.size()});
+    EXPECT_EQ(stats.GetCount(0), std::uint64_t{3});
+    EXPECT_FLOAT_EQ(stats.GetAmax(0), 3.f);
+    EXPECT_EQ(stats.GetHistogram(0)[0x3f8], std::uint64_t{1}); // 1.0
+}
+
+TEST(HostCalibration, Percentile)
+{
+    // 1, 2, ..., 10000
+    std::vector<float> x(10000);
+    for(std::size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<float>(i + 1);
+
+    CalibrationStats stats;
+    stats.Observe(x.data(), CalibrationLayout{1, 1, x.size()});
+
+    for(double p : {10.0, 50.0, 99.0, 99.9})
+        EXPECT_NEAR(stats.GetPercentile(0, p), p * 100, p * 100 * 0.02) << p;
+    EXPECT_FLOAT_EQ(stats.GetPercentile(0, 100), 10000.f);
+
+    // a single outlier sets the max but not the percentile threshold
+    x      = random_activation(CalibrationLayout{1, 1, 100000}, 3);
+    x[500] = 1000.f;
+
+    CalibrationStats outlier;
+    outlier.Observe(x.data(), CalibrationLayout{1, 1, x.size()});
+
+    const auto max_scale = outlier.GetScales<std::int8_t>(CalibrationMethod::Max);
+    const auto pct_scale = outlier.GetScales<std::int8_t>(CalibrationMethod::Percentile, 99.9);
+
+    EXPECT_FLOAT_EQ(max_scale[0], 1000.f / 127.f);
+    EXPECT_GT(pct_scale[0], 3.f / 127.f);
+    EXPECT_LT(pct_scale[0], 4.f / 127.f);
+
+    // channels with zeros only get a scale of 1
+    CalibrationStats zero(2);
+    const float zeros[2] = {0.f, -0.f};
+    zero.Observe(zeros, CalibrationLayout{1, 2, 1}, 1);
+    EXPECT_EQ(zero.GetScales<ck::f8_t>(CalibrationMethod::Max), std::vector<float>(2, 1.f));
+}
+
+TEST(HostCalibration, Quantize)
+{
+    const CalibrationLayout layout{600, 7, 1};
+    const auto x = random_activation(layout, 5);
+
+    std::vector<ck::half_t> x_half(x.size());
+    ck::utils::convert_n(x_half.data(), x.data(), x.size());
+
+    CalibrationStats stats(layout.num_channel);
+    stats.Observe(x_half.data(), layout);
+
+    const auto scale_i8 = stats.GetScales<std::int8_t>(CalibrationMethod::Percentile, 99.0);
+    const auto scale_f8 = stats.GetScales<ck::f8_t>(CalibrationMethod::Max);
+
+    std::vector<std::int8_t> q_i8(x.size());
+    std::vector<ck::f8_t> q_f8(x.size());
+    ck::utils::quantize_per_channel_n(q_i8.data(), x_half.data(), scale_i8.data(), layout, 3);
+    ck::utils::quantize_per_channel_n(q_f8.data(), x_half.data(), scale_f8.data(), layout, 3);
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        const float xi      = ck::type_convert<float>(x_half[i]);
+        const std::size_t c = i % layout.num_channel;
+
+        const float ref_i8 = std::clamp(std::nearbyint(xi / scale_i8[c]), -128.f, 127.f);
+        ASSERT_EQ(q_i8[i], static_cast<std::int8_t>(ref_i8)) << i;
+
+        const ck::f8_t ref_f8 = ck::f8_convert_rne<ck::f8_t>(xi / scale_f8[c]);
+        ASSERT_EQ(__builtin_bit_cast(std::uint8_t, q_f8[i]),
+                  __builtin_bit_cast(std::uint8_t, ref_f8))
+            << i;
+    }
+
+    // requantization scales and bias for Add_Activation_Mul2_Clamp
+    const std::vector<float> weight_scale = {0.5f, 0.25f};
+    const auto requant = ck::utils::get_requant_scales(weight_scale, 0.1f, 0.2f);
+    EXPECT_FLOAT_EQ(requant[0], 0.25f);
+    EXPECT_FLOAT_EQ(requant[1], 0.125f);
+
+    const std::vector<float> bias = {1.f, -1.f};
+    std::vector<std::int32_t> qb(bias.size());
+    ck::utils::quantize_bias_n(qb.data(), bias.data(), bias.size(), weight_scale, 0.1f);
+    EXPECT_EQ(qb[0], 20);
+    EXPECT_EQ(qb[1], -40);
+}
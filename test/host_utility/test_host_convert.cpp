@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_convert.hpp"
+
+using ck::bf8_t;
+using ck::f8_t;
+using ck::half_t;
+
+namespace {
+
+template <typename T>
+std::uint8_t bits(T x)
+{
+    return __builtin_bit_cast(std::uint8_t, x);
+}
+
+// every float with the given upper 16 bits and a few low halves, which covers all exponents,
+// every f8 tie and the values next to them
+std::vector<float> float_samples()
+{
+    std::vector<float> x;
+    for(std::uint32_t hi = 0; hi < 0x10000; ++hi)
+        for(std::uint32_t lo : {0x0u, 0x1u, 0x7fffu, 0x8000u, 0xffffu})
+        {
+            const std::uint32_t b = hi << 16 | lo;
+            x.push_back(__builtin_bit_cast(float, b));
+        }
+    return x;
+}
+
+std::vector<half_t> half_samples()
+{
+    std::vector<half_t> x;
+    for(std::uint32_t b = 0; b < 0x10000; ++b)
+        x.push_back(__builtin_bit_cast(half_t, static_cast<std::uint16_t>(b)));
+    return x;
+}
+
+template <typename F8, typename X>
+void check_rne(const std::vector<X>& x)
+{
+    std::vector<F8> y(x.size());
+    ck::utils::f8_convert_rne_n(y.data(), x.data(), x.size());
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+        ASSERT_EQ(bits(y[i]), bits(ck::f8_convert_rne<F8>(x[i]))) << static_cast<float>(x[i]);
+}
+
+template <typename F8, typename Y>
+void check_decode()
+{
+    std::vector<F8> x(256 * 3);
+    for(std::size_t i = 0; i < x.size(); ++i)
+        x[i] = __builtin_bit_cast(F8, static_cast<std::uint8_t>(i));
+
+    std::vector<Y> y(x.size());
+    ck::utils::cast_from_f8_n(y.data(), x.data(), x.size(), 2);
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        const Y ref = ck::type_convert<Y>(x[i]);
+        ASSERT_EQ(std::memcmp(&y[i], &ref, sizeof(Y)), 0) << i;
+    }
+}
+
+template <typename F8>
+void check_sr()
+{
+    constexpr std::uint64_t seed = 11939;
+
+    const auto x = float_samples();
+
+    std::vector<F8> y(x.size());
+    ck::utils::f8_convert_sr_n(y.data(), x.data(), x.size(), seed);
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        const std::uint32_t rng = ck::utils::Philox4x32::Generate(seed, i / 4)[i % 4];
+        ASSERT_EQ(bits(y[i]), bits(ck::utils::cast_to_f8<float, F8, true, true, true>(x[i], rng)))
+            << i;
+    }
+
+    // any split of the stream gives the same codes
+    for(std::size_t num_thread : {3, 7})
+    {
+        std::vector<F8> z(x.size());
+        ck::utils::f8_convert_sr_n(z.data(), x.data(), 1001, seed, 0, num_thread);
+        ck::utils::f8_convert_sr_n(
+            z.data() + 1001, x.data() + 1001, x.size() - 1001, seed, 1001, num_thread);
+
+        for(std::size_t i = 0; i < x.size(); ++i)
+            ASSERT_EQ(bits(z[i]), bits(y[i])) << i;
+    }
+}
+
+template <typename Y, typename X>
+void check_convert(const std::vector<X>& x)
+{
+    for(std::size_t num_thread : {1, 4})
+    {
+        // leave a tail shorter than a vector
+        const std::size_t n = x.size() - 3;
+
+        std::vector<Y> y(n);
+        ck::utils::convert_n(y.data(), x.data(), n, num_thread);
+
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const Y ref = ck::type_convert<Y>(x[i]);
+            ASSERT_EQ(std::memcmp(&y[i], &ref, sizeof(Y)), 0) << i;
+        }
+    }
+}
+
+} // namespace
+
+TEST(HostConvert, ConvertN)
+{
+    const auto f32 = float_samples();
+    const auto f16 = half_samples();
+
+    std::vector<ck::bhalf_t> bf16(0x10000);
+    for(std::size_t i = 0; i < bf16.size(); ++i)
+        bf16[i] = static_cast<ck::bhalf_t>(i);
+
+    check_convert<half_t>(f32);
+    check_convert<ck::bhalf_t>(f32);
+    check_convert<float>(f16);
+    check_convert<ck::bhalf_t>(f16);
+    check_convert<float>(bf16);
+    check_convert<half_t>(bf16);
+
+    check_convert<f8_t>(f32);
+    check_convert<bf8_t>(f16);
+
+    // element by element
+    check_convert<float>(std::vector<std::int8_t>{-128, -1, 0, 1, 127, 5, 6, 7, 8});
+    check_convert<std::int32_t>(std::vector<std::int32_t>{-7, 0, 7, 1 << 30});
+}
+
+TEST(HostConvert, F8EncodePath)
+{
+    // test_host_convert_rne builds this file with CK_USE_SR_F8_CONVERSION 0, where type_convert
+    // rounds to nearest even and ConvertN covers the vector encoder of convert_n
+    EXPECT_EQ((ck::utils::detail::is_vectorized_convert_v<f8_t, float>), !CK_USE_SR_F8_CONVERSION);
+    EXPECT_EQ((ck::utils::detail::is_vectorized_convert_v<bf8_t, half_t>),
+              !CK_USE_SR_F8_CONVERSION);
+}
+
+TEST(HostConvert, F8Decode)
+{
+    check_decode<f8_t, float>();
+    check_decode<f8_t, half_t>();
+    check_decode<bf8_t, float>();
+    check_decode<bf8_t, half_t>();
+}
+
+TEST(HostConvert, F8ConvertRne)
+{
+    check_rne<f8_t>(float_samples());
+    check_rne<bf8_t>(float_samples());
+    check_rne<f8_t>(half_samples());
+    check_rne<bf8_t>(half_samples());
+}
+
+TEST(HostConvert, F8ConvertSr)
+{
+    check_sr<f8_t>();
+    check_sr<bf8_t>();
+
+    // stochastic rounding is unbiased: 0.3 lies between the f8 values 0.28125 and 0.3125
+    std::vector<float> x(1 << 16, 0.3f);
+    std::vector<f8_t> y(x.size());
+    ck::utils::f8_convert_sr_n(y.data(), x.data(), x.size(), 7);
+
+    std::vector<float> z(x.size());
+    ck::utils::cast_from_f8_n(z.data(), y.data(), y.size());
+
+    double sum = 0;
+    for(float v : z)
+    {
+        ASSERT_TRUE(v > 0.28f && v < 0.32f) << v;
+        sum += v;
+    }
+    EXPECT_NEAR(sum / static_cast<double>(z.size()), 0.3, 1e-3);
+}
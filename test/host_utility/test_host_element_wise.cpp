@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_element_wise.hpp"
+
+namespace ew = ck::tensor_operation::element_wise;
+
+namespace {
+
+// distance in units in the last place, NaN matches NaN
+std::int64_t ulp_distance(float a, float b)
+{
+    if(std::isnan(a) || std::isnan(b))
+        return std::isnan(a) && std::isnan(b) ? 0 : std::numeric_limits<std::int64_t>::max();
+
+    auto ordered = [](float v) {
+        std::int32_t i;
+        std::memcpy(&i, &v, sizeof(i));
+        return static_cast<std::int64_t>(i < 0 ? std::numeric_limits<std::int32_t>::min() - i : i);
+    };
+    return std::abs(ordered(a) - ordered(b));
+}
+
+std::vector<float> make_inputs(float lo, float hi)
+{
+    std::vector<float> x;
+    std::mt19937 gen(11939);
+    std::uniform_real_distribution<float> dis(lo, hi);
+    for(int i = 0; i < 100003; ++i)
+        x.push_back(dis(gen));
+
+    for(float v : {0.f, -0.f, 1e-30f, -1e-30f, lo, hi})
+        x.push_back(v);
+
+    return x;
+}
+
+template <typename ElementOp>
+void check_unary(const ElementOp& op, float lo, float hi, std::int64_t max_ulp, float atol = 0.f)
+{
+    const auto x = make_inputs(lo, hi);
+    std::vector<float> y(x.size());
+
+    ck::utils::elementwise_n(op, y.data(), x.data(), x.size(), 4);
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        float ref;
+        op(ref, x[i]);
+        if(std::abs(y[i] - ref) > atol)
+        {
+            ASSERT_LE(ulp_distance(y[i], ref), max_ulp) << "x = " << x[i];
+        }
+    }
+}
+
+template <typename ElementOp>
+void check_binary(const ElementOp& op, std::int64_t max_ulp)
+{
+    const auto x0 = make_inputs(-20.f, 20.f);
+    auto x1       = x0;
+    std::reverse(x1.begin(), x1.end());
+    std::vector<float> y(x0.size());
+
+    ck::utils::elementwise_n(op, y.data(), x0.data(), x1.data(), x0.size(), 4);
+
+    for(std::size_t i = 0; i < x0.size(); ++i)
+    {
+        float ref;
+        op.template operator()<float, float, float>(ref, x0[i], x1[i]);
+        ASSERT_LE(ulp_distance(y[i], ref), max_ulp) << "x0 = " << x0[i] << ", x1 = " << x1[i];
+    }
+}
+
+} // namespace
+
+TEST(HostElementWise, ExactUnary)
+{
+    check_unary(ew::PassThrough{}, -100.f, 100.f, 0);
+    check_unary(ew::Scale{0.37f}, -100.f, 100.f, 0);
+    check_unary(ew::Relu{}, -100.f, 100.f, 0);
+    check_unary(ew::LeakyRelu{0.1f}, -100.f, 100.f, 0);
+    check_unary(ew::ClippedRelu{-2.f, 3.f}, -100.f, 100.f, 0);
+    check_unary(ew::UnarySquare{}, -100.f, 100.f, 0);
+    check_unary(ew::UnaryAbs{}, -100.f, 100.f, 0);
+}
+
+TEST(HostElementWise, TranscendentalUnary)
+{
+    check_unary(ew::Exp{}, -100.f, 100.f, 2);
+    check_unary(ew::Log{}, 0.f, 1e6f, 2);
+    check_unary(ew::TanH{}, -20.f, 20.f, 4);
+    check_unary(ew::Sigmoid{}, -100.f, 100.f, 4);
+    check_unary(ew::Silu{}, -100.f, 100.f, 4);
+    check_unary(ew::Swish{1.5f}, -100.f, 100.f, 4);
+    check_unary(ew::Elu{0.5f}, -100.f, 100.f, 4);
+    check_unary(ew::FastGelu{}, -20.f, 20.f, 4);
+    // the scalar forms of these round 1 + small before log or after erf, so they are only
+    // accurate to an absolute bound near those cancellations
+    check_unary(ew::SoftRelu{2.f}, -40.f, 40.f, 4, 1e-6f);
+    check_unary(ew::Gelu{}, -20.f, 20.f, 8, 1e-6f);
+}
+
+TEST(HostElementWise, Binary)
+{
+    check_binary(ew::Add{}, 0);
+    check_binary(ew::Multiply{}, 0);
+    check_binary(ew::Bilinear{0.5f, -2.f}, 0);
+    check_binary(ew::AddRelu{}, 0);
+    check_binary(ew::AddFastGelu{}, 4);
+    check_binary(ew::AddSilu{}, 4);
+}
+
+TEST(HostElementWise, ScalarFallback)
+{
+    // non fp32 data goes through the functor itself
+    const auto x = make_inputs(-10.f, 10.f);
+    std::vector<double> xd(x.begin(), x.end());
+    std::vector<double> y(x.size());
+
+    ck::utils::elementwise_n(ew::Scale{3.f}, y.data(), xd.data(), xd.size(), 3);
+
+    for(std::size_t i = 0; i < xd.size(); ++i)
+    {
+        double ref;
+        ew::Scale{3.f}(ref, xd[i]);
+        ASSERT_DOUBLE_EQ(y[i], ref);
+    }
+}
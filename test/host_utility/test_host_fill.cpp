@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/fill.hpp"
+
+TEST(HostFill, PhiloxKnownAnswer)
+{
+    // Random123 known answer for philox4x32-10 with zero key and counter
+    const auto r = ck::utils::Philox4x32::Generate(0, 0);
+    EXPECT_EQ(r[0], 0x6627e8d5u);
+    EXPECT_EQ(r[1], 0xe169c58du);
+    EXPECT_EQ(r[2], 0xbc57ac4cu);
+    EXPECT_EQ(r[3], 0x9b00dbd8u);
+
+    // the batched form produces the same blocks as the single block one
+    ck::utils::Philox4x32::Block blocks[8];
+    ck::utils::Philox4x32::Generate(42, (std::uint64_t{1} << 32) - 3, blocks);
+    for(std::uint64_t l = 0; l < 8; ++l)
+        EXPECT_EQ(blocks[l], ck::utils::Philox4x32::Generate(42, (std::uint64_t{1} << 32) - 3 + l));
+}
+
+TEST(HostFill, UniformRange)
+{
+    std::vector<float> v(100000);
+    ck::utils::FillUniformDistribution<float>{-2.f, 3.f}(v);
+
+    double mean = 0;
+    for(float x : v)
+    {
+        ASSERT_GE(x, -2.f);
+        ASSERT_LT(x, 3.f);
+        mean += x;
+    }
+    EXPECT_NEAR(mean / v.size(), 0.5, 0.02);
+}
+
+TEST(HostFill, IntegerValue)
+{
+    std::vector<float> v(10000);
+    ck::utils::FillUniformDistributionIntegerValue<float>{-5.f, 5.f}(v);
+
+    for(float x : v)
+    {
+        ASSERT_GE(x, -5.f);
+        ASSERT_LE(x, 5.f);
+        ASSERT_FLOAT_EQ(x, std::round(x));
+    }
+}
+
+TEST(HostFill, Reproducible)
+{
+    // large enough to be split over threads, compared against the serial list path
+    const std::size_t n = (1 << 20) + 7;
+
+    std::vector<float> parallel(n);
+    std::list<float> serial(n);
+    ck::utils::FillUniformDistribution<float>{}(parallel);
+    ck::utils::FillUniformDistribution<float>{}(serial);
+
+    std::size_t i = 0;
+    for(float x : serial)
+        ASSERT_EQ(std::memcmp(&x, &parallel[i++], sizeof(float)), 0) << "element " << i - 1;
+
+    // a different seed gives a different stream
+    std::vector<float> other(n);
+    ck::utils::FillUniformDistribution<float>{-5.f, 5.f, 7}(other);
+    EXPECT_NE(std::memcmp(other.data(), parallel.data(), n * sizeof(float)), 0);
+}
+
+TEST(HostFill, SubRange)
+{
+    std::vector<float> full(1000);
+    ck::utils::FillUniformDistribution<float>{}(full);
+
+    // regenerate [333, 777) on its own, offsets not on a block boundary included
+    std::vector<float> part(444);
+    ck::utils::FillUniformDistribution<float>{}(part.begin(), part.end(), 333);
+
+    for(std::size_t i = 0; i < part.size(); ++i)
+        ASSERT_EQ(std::memcmp(&part[i], &full[333 + i], sizeof(float)), 0) << "element " << i;
+}
+
+TEST(HostFill, Converted)
+{
+    // contiguous half_t/bhalf_t ranges are drawn as float tiles and converted in bulk, lists
+    // convert element by element
+    const std::size_t n = 50000;
+
+    std::vector<ck::half_t> tiled(n);
+    std::list<ck::half_t> serial(n);
+    ck::utils::FillUniformDistribution<ck::half_t>{}(tiled.begin(), tiled.end(), 123);
+    ck::utils::FillUniformDistribution<ck::half_t>{}(serial.begin(), serial.end(), 123);
+
+    std::size_t i = 0;
+    for(ck::half_t x : serial)
+        ASSERT_EQ(std::memcmp(&x, &tiled[i++], sizeof(x)), 0) << "element " << i - 1;
+
+    std::vector<ck::bhalf_t> tiled_int(n);
+    std::list<ck::bhalf_t> serial_int(n);
+    ck::utils::FillUniformDistributionIntegerValue<ck::bhalf_t>{}(tiled_int);
+    ck::utils::FillUniformDistributionIntegerValue<ck::bhalf_t>{}(serial_int);
+
+    i = 0;
+    for(ck::bhalf_t x : serial_int)
+        ASSERT_EQ(x, tiled_int[i++]) << "element " << i - 1;
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_permute.hpp"
+
+namespace {
+
+template <typename T>
+void fill_bits(Tensor<T>& t, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    auto* p_bytes = reinterpret_cast<unsigned char*>(t.mData.data());
+    for(std::size_t i = 0; i < t.mData.size() * sizeof(T); ++i)
+        p_bytes[i] = static_cast<unsigned char>(gen());
+}
+
+// multi-index of dst element with linear index i in row-major order of lengths
+std::vector<std::size_t> unravel(std::size_t i, const std::vector<std::size_t>& lengths)
+{
+    std::vector<std::size_t> idx(lengths.size());
+    for(std::size_t d = lengths.size(); d-- > 0;)
+    {
+        idx[d] = i % lengths[d];
+        i /= lengths[d];
+    }
+    return idx;
+}
+
+std::size_t offset(const std::vector<std::size_t>& idx, const std::vector<std::size_t>& strides)
+{
+    return std::inner_product(idx.begin(), idx.end(), strides.begin(), std::size_t{0});
+}
+
+// permute src into a dst with the given strides and compare every element bitwise against the
+// element-by-element definition
+template <typename T>
+void check_permute(const std::vector<std::size_t>& src_lengths,
+                   const std::vector<std::size_t>& src_strides,
+                   const std::vector<std::size_t>& new2old,
+                   std::vector<std::size_t> dst_strides = {},
+                   std::size_t num_thread               = 4)
+{
+    std::vector<std::size_t> dst_lengths(new2old.size());
+    for(std::size_t i = 0; i < new2old.size(); ++i)
+        dst_lengths[i] = src_lengths[new2old[i]];
+
+    Tensor<T> src(src_lengths, src_strides);
+    fill_bits(src, 7);
+
+    Tensor<T> dst = dst_strides.empty() ? Tensor<T>(dst_lengths)
+                                        : Tensor<T>(dst_lengths, dst_strides);
+    ck::utils::permute(dst, src, new2old, ck::utils::detail::PermuteConvert{}, num_thread);
+
+    const auto& d_strides = dst.mDesc.GetStrides();
+
+    std::size_t num_element = 1;
+    for(auto l : dst_lengths)
+        num_element *= l;
+
+    std::vector<std::size_t> src_idx(new2old.size());
+    for(std::size_t i = 0; i < num_element; ++i)
+    {
+        const auto dst_idx = unravel(i, dst_lengths);
+        for(std::size_t k = 0; k < new2old.size(); ++k)
+            src_idx[new2old[k]] = dst_idx[k];
+
+        ASSERT_EQ(std::memcmp(&dst.mData[offset(dst_idx, d_strides)],
+                              &src.mData[offset(src_idx, src_strides)],
+                              sizeof(T)),
+                  0)
+            << "element " << i;
+    }
+}
+
+std::vector<std::size_t> packed_strides(const std::vector<std::size_t>& lengths)
+{
+    std::vector<std::size_t> strides(lengths.size(), 1);
+    for(std::size_t d = lengths.size() - 1; d-- > 0;)
+        strides[d] = strides[d + 1] * lengths[d + 1];
+    return strides;
+}
+
+template <typename T>
+void check_shapes()
+{
+    // NCHW -> NHWC and back, with sizes off the register block grid
+    check_permute<T>({2, 37, 9, 15}, packed_strides({2, 37, 9, 15}), {0, 2, 3, 1});
+    check_permute<T>({2, 9, 15, 37}, packed_strides({2, 9, 15, 37}), {0, 3, 1, 2});
+    // plain 2D transpose, several tiles per panel
+    check_permute<T>({130, 200}, packed_strides({130, 200}), {1, 0});
+    // NCDHW -> NDHWC as in profile_transpose_impl
+    check_permute<T>({3, 16, 4, 5, 32}, packed_strides({3, 16, 4, 5, 32}), {0, 2, 3, 4, 1});
+    // innermost dimension unchanged, rows are copied
+    check_permute<T>({4, 6, 100}, packed_strides({4, 6, 100}), {1, 0, 2});
+    // identity with padded source rows
+    check_permute<T>({5, 70}, {80, 1}, {0, 1});
+    // layout conversion: same lengths, dst stored channel-last
+    check_permute<T>(
+        {2, 24, 7, 9}, packed_strides({2, 24, 7, 9}), {0, 1, 2, 3}, {1512, 1, 216, 24});
+    // unit and single element tensors
+    check_permute<T>({1, 1, 33}, packed_strides({1, 1, 33}), {2, 0, 1});
+    check_permute<T>({1}, {1}, {0});
+}
+
+} // namespace
+
+TEST(HostPermute, Int8) { check_shapes<int8_t>(); }
+
+TEST(HostPermute, Half) { check_shapes<ck::half_t>(); }
+
+TEST(HostPermute, Float) { check_shapes<float>(); }
+
+TEST(HostPermute, Double) { check_shapes<double>(); }
+
+TEST(HostPermute, Bundle)
+{
+    // 3 byte elements take the scalar path
+    struct Bundle
+    {
+        unsigned char v[3];
+    };
+    check_shapes<Bundle>();
+}
+
+TEST(HostPermute, ThreadCount)
+{
+    for(std::size_t num_thread : {1, 3, 16})
+        check_permute<float>(
+            {8, 64, 33, 17}, packed_strides({8, 64, 33, 17}), {0, 2, 3, 1}, {}, num_thread);
+}
+
+TEST(HostPermute, ElementOp)
+{
+    Tensor<float> src({3, 40, 50});
+    for(std::size_t i = 0; i < src.mData.size(); ++i)
+        src.mData[i] = static_cast<float>(i % 1000) * 0.25f;
+
+    Tensor<ck::half_t> converted({3, 50, 40});
+    ck::utils::permute(converted, src, std::vector<std::size_t>{0, 2, 1});
+
+    Tensor<float> scaled({3, 50, 40});
+    ck::utils::permute(
+        scaled, src, std::vector<std::size_t>{0, 2, 1}, [](float& y, const float& x) {
+            y = 2.f * x;
+        });
+
+    for(std::size_t n = 0; n < 3; ++n)
+        for(std::size_t w = 0; w < 50; ++w)
+            for(std::size_t h = 0; h < 40; ++h)
+            {
+                const float x = src(n, h, w);
+                ASSERT_FLOAT_EQ(ck::type_convert<float>(converted(n, w, h)),
+                                ck::type_convert<float>(ck::type_convert<ck::half_t>(x)));
+                ASSERT_FLOAT_EQ(scaled(n, w, h), 2.f * x);
+            }
+}
+
+TEST(HostPermute, Mismatch)
+{
+    Tensor<float> src({4, 5});
+    Tensor<float> dst({4, 5});
+
+    EXPECT_THROW(ck::utils::permute(dst, src, std::vector<std::size_t>{1, 0}), std::runtime_error);
+    EXPECT_THROW(ck::utils::permute(dst, src, std::vector<std::size_t>{0, 0}), std::runtime_error);
+    EXPECT_THROW(ck::utils::permute(dst, src, std::vector<std::size_t>{0}), std::runtime_error);
+}
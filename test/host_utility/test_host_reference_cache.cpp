@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_reference_cache.hpp"
+
+using ck::utils::ReferenceCache;
+using ck::utils::ReferenceCacheKey;
+
+namespace {
+
+const std::string cache_dir = "test_host_reference_cache";
+
+Tensor<float> make_tensor(std::size_t m, std::size_t n, float offset)
+{
+    Tensor<float> t(HostTensorDescriptor({m, n}));
+    for(std::size_t i = 0; i < t.mData.size(); ++i)
+        t.mData[i] = static_cast<float>(i) + offset;
+    return t;
+}
+
+ReferenceCacheKey make_key(const Tensor<float>& a, const Tensor<float>& out)
+{
+    return ReferenceCacheKey("Test").AddTensor(a).AddType<float>().AddDescriptor(out.mDesc);
+}
+
+} // namespace
+
+TEST(HostReferenceCache, HashBytes)
+{
+    std::vector<std::uint8_t> x((std::size_t{3} << 20) + 123);
+    std::iota(x.begin(), x.end(), std::uint8_t{0});
+
+    const std::uint64_t h = ck::utils::hash_bytes(x.data(), x.size(), 0, 1);
+
+    EXPECT_EQ(ck::utils::hash_bytes(x.data(), x.size(), 0, 4), h);
+    EXPECT_NE(ck::utils::hash_bytes(x.data(), x.size(), 1, 1), h);
+    EXPECT_NE(ck::utils::hash_bytes(x.data(), x.size() - 1, 0, 1), h);
+
+    x[x.size() / 2] ^= 1;
+    EXPECT_NE(ck::utils::hash_bytes(x.data(), x.size(), 0, 1), h);
+
+    // the empty range has a fixed hash too
+    EXPECT_EQ(ck::utils::hash_bytes(nullptr, 0), ck::utils::hash_bytes(x.data(), 0));
+}
+
+TEST(HostReferenceCache, Key)
+{
+    const auto a   = make_tensor(16, 8, 0.f);
+    const auto out = make_tensor(16, 4, 0.f);
+
+    const auto key = make_key(a, out);
+    EXPECT_EQ(key.GetDigest().size(), std::size_t{32});
+    EXPECT_EQ(key.GetDigest(), make_key(make_tensor(16, 8, 0.f), out).GetDigest());
+
+    // contents, shapes and output type all change the key
+    EXPECT_NE(key.GetDigest(), make_key(make_tensor(16, 8, 1.f), out).GetDigest());
+    EXPECT_NE(key.GetDigest(), make_key(make_tensor(8, 16, 0.f), out).GetDigest());
+    const auto key_double =
+        ReferenceCacheKey("Test").AddTensor(a).AddType<double>().AddDescriptor(out.mDesc);
+    EXPECT_NE(key.GetDescription(), key_double.GetDescription());
+}
+
+TEST(HostReferenceCache, LoadStore)
+{
+    std::filesystem::remove_all(cache_dir);
+    const ReferenceCache cache(cache_dir, std::uint64_t{1} << 30);
+
+    const auto a   = make_tensor(32, 32, 0.f);
+    auto out       = make_tensor(32, 16, 5.f);
+    const auto key = make_key(a, out);
+
+    auto result = make_tensor(32, 16, 0.f);
+    EXPECT_FALSE(cache.Load(key, result));
+
+    cache.Store(key, out);
+    EXPECT_TRUE(cache.Load(key, result));
+    EXPECT_EQ(result.mData, out.mData);
+
+    // another size or another key misses
+    auto small = make_tensor(16, 16, 0.f);
+    EXPECT_FALSE(cache.Load(key, small));
+    EXPECT_FALSE(cache.Load(make_key(make_tensor(32, 32, 1.f), out), result));
+
+    // compute is skipped on a hit, always run with the cache disabled
+    int num_compute = 0;
+    auto compute    = [&] { ++num_compute; };
+
+    EXPECT_TRUE(ck::utils::run_cached_reference(cache, result, [&] { return key; }, compute));
+    EXPECT_EQ(num_compute, 0);
+
+    const auto key2 = make_key(make_tensor(32, 32, 2.f), out);
+    EXPECT_FALSE(ck::utils::run_cached_reference(cache, result, [&] { return key2; }, compute));
+    EXPECT_TRUE(ck::utils::run_cached_reference(cache, result, [&] { return key2; }, compute));
+    EXPECT_EQ(num_compute, 1);
+
+    // the async variant runs the same lookup on a host thread
+    const auto key3 = make_key(make_tensor(32, 32, 3.f), out);
+    auto miss = ck::utils::run_cached_reference_async(cache, result, [&] { return key3; }, compute);
+    EXPECT_FALSE(miss.get());
+    auto hit = ck::utils::run_cached_reference_async(cache, result, [&] { return key3; }, compute);
+    EXPECT_TRUE(hit.get());
+    EXPECT_EQ(num_compute, 2);
+
+    const ReferenceCache disabled;
+    EXPECT_FALSE(disabled.IsEnabled());
+    EXPECT_FALSE(ck::utils::run_cached_reference(disabled, result, [&] { return key; }, compute));
+    EXPECT_EQ(num_compute, 3);
+
+    std::filesystem::remove_all(cache_dir);
+}
+
+TEST(HostReferenceCache, Evict)
+{
+    std::filesystem::remove_all(cache_dir);
+
+    // room for two 64 KiB entries but not three
+    const ReferenceCache cache(cache_dir, std::uint64_t{160} << 10);
+
+    const auto out = make_tensor(128, 128, 0.f);
+    std::vector<ReferenceCacheKey> keys;
+    for(int i = 0; i < 3; ++i)
+        keys.push_back(make_key(make_tensor(4, 4, static_cast<float>(i)), out));
+
+    auto result = make_tensor(128, 128, 0.f);
+
+    cache.Store(keys[0], out);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.Store(keys[1], out);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // a load makes entry 0 the most recently used, so entry 1 goes
+    EXPECT_TRUE(cache.Load(keys[0], result));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.Store(keys[2], out);
+
+    EXPECT_LE(cache.GetSize(), cache.GetMaxSize());
+    EXPECT_TRUE(cache.Load(keys[0], result));
+    EXPECT_FALSE(cache.Load(keys[1], result));
+    EXPECT_TRUE(cache.Load(keys[2], result));
+
+    std::filesystem::remove_all(cache_dir);
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdlib>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+
+namespace {
+
+template <typename T, typename G>
+Tensor<T> generate(G g, std::size_t num_thread)
+{
+    Tensor<T> t({3, 37, 129});
+    t.GenerateTensorValue(g, num_thread);
+    return t;
+}
+
+} // namespace
+
+TEST(HostTensorGenerator, ThreadCount)
+{
+    const GeneratorTensor_3<float> g{-1.f, 1.f};
+
+    const auto ref = generate<float>(g, 1);
+    for(std::size_t num_thread : {2, 5, 16})
+        EXPECT_EQ(generate<float>(g, num_thread).mData, ref.mData) << num_thread << " threads";
+
+    for(float v : ref.mData)
+    {
+        ASSERT_GE(v, -1.f);
+        ASSERT_LT(v, 1.f);
+    }
+}
+
+TEST(HostTensorGenerator, IntegerValue)
+{
+    const GeneratorTensor_2<int> g{-5, 5};
+
+    const auto ref = generate<int>(g, 1);
+    EXPECT_EQ(generate<int>(g, 8).mData, ref.mData);
+
+    const std::set<int> values(ref.mData.begin(), ref.mData.end());
+    EXPECT_EQ(values.size(), 10u);
+    EXPECT_EQ(*values.begin(), -5);
+    EXPECT_EQ(*values.rbegin(), 4);
+}
+
+TEST(HostTensorGenerator, Seed)
+{
+    // std::srand() selects the data, consecutive generators give different tensors
+    std::srand(1);
+    const auto a = generate<float>(GeneratorTensor_3<float>{}, 4);
+    const auto b = generate<float>(GeneratorTensor_3<float>{}, 4);
+
+    std::srand(1);
+    EXPECT_EQ(generate<float>(GeneratorTensor_3<float>{}, 1).mData, a.mData);
+    EXPECT_NE(a.mData, b.mData);
+}
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_weight_quantization.hpp"
+
+using ck::utils::GroupQuantDesc;
+using ck::utils::QuantScheme;
+
+namespace {
+
+std::vector<float> random_weight(std::size_t n, std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> dist(0.f, 0.02f);
+
+    std::vector<float> x(n);
+    for(auto& v : x)
+        v = dist(gen);
+
+    // a group of zeros and a group of positive values only
+    std::fill_n(x.begin(), 32, 0.f);
+    for(std::size_t i = 32; i < 64; ++i)
+        x[i] = std::abs(x[i]);
+
+    return x;
+}
+
+// scalar quantization of one group, the reference for the vector code
+void reference_quantize(std::vector<std::int8_t>& q,
+                        std::vector<float>& scale,
+                        std::vector<std::int8_t>& zero,
+                        const std::vector<float>& x,
+                        const GroupQuantDesc& desc)
+{
+    const float qmin = static_cast<float>(desc.GetQMin());
+    const float qmax = static_cast<float>(desc.GetQMax());
+
+    q.resize(x.size());
+    scale.clear();
+    zero.clear();
+
+    for(std::size_t r = 0; r < desc.num_row; ++r)
+        for(std::size_t k = 0; k < desc.row_length; k += desc.group_size)
+        {
+            const std::size_t end = std::min(k + desc.group_size, desc.row_length);
+            const float* p_x      = x.data() + r * desc.row_length;
+
+            float lo = 0.f, hi = 0.f;
+            for(std::size_t i = k; i < end; ++i)
+            {
+                lo = std::min(lo, p_x[i]);
+                hi = std::max(hi, p_x[i]);
+            }
+
+            float s = desc.scheme == QuantScheme::Symmetric ? std::max(-lo, hi) / qmax
+                                                            : (hi - lo) / (qmax - qmin);
+            s       = s > 0.f ? s : 1.f;
+
+            const float z = desc.scheme == QuantScheme::Symmetric
+                                ? 0.f
+                                : std::clamp(std::nearbyint(qmin - lo / s), qmin, qmax);
+
+            for(std::size_t i = k; i < end; ++i)
+                q[r * desc.row_length + i] = static_cast<std::int8_t>(
+                    std::clamp(std::nearbyint(p_x[i] / s) + z, qmin, qmax));
+
+            scale.push_back(s);
+            zero.push_back(static_cast<std::int8_t>(z));
+        }
+}
+
+} // namespace
+
+TEST(HostWeightQuantization, PackUnpackInt4)
+{
+    // every int4 pair, with odd lengths and tails shorter than a vector
+    std::vector<std::int8_t> x;
+    for(int rep = 0; rep < 97; ++rep)
+        for(int hi = -8; hi < 8; ++hi)
+            for(int lo = -8; lo < 8; ++lo)
+            {
+                x.push_back(static_cast<std::int8_t>(lo));
+                x.push_back(static_cast<std::int8_t>(hi));
+            }
+
+    for(std::size_t n : {x.size(), x.size() - 1, std::size_t{77}, std::size_t{1}})
+        for(std::size_t num_thread : {1, 3})
+        {
+            std::vector<std::uint8_t> packed((n + 1) / 2);
+            ck::utils::pack_int4_n(packed.data(), x.data(), n, num_thread);
+
+            for(std::size_t i = 0; i < packed.size(); ++i)
+            {
+                const int lo = x[2 * i] & 0xf;
+                const int hi = 2 * i + 1 < n ? x[2 * i + 1] & 0xf : 0;
+                ASSERT_EQ(packed[i], lo | hi << 4) << i;
+            }
+
+            std::vector<std::int8_t> y(n);
+            ck::utils::unpack_int4_n(y.data(), packed.data(), n, num_thread);
+
+            for(std::size_t i = 0; i < n; ++i)
+                ASSERT_EQ(y[i], x[i]) << i;
+        }
+}
+
+TEST(HostWeightQuantization, ToUnsignedWeight)
+{
+    std::vector<std::int8_t> x(1000);
+    for(std::size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<std::int8_t>(i);
+
+    std::vector<std::uint8_t> y(x.size());
+    ck::utils::to_unsigned_weight_n(y.data(), x.data(), x.size(), 2);
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+        ASSERT_EQ(y[i], x[i] + 128) << i;
+}
+
+TEST(HostWeightQuantization, GroupQuant)
+{
+    for(QuantScheme scheme : {QuantScheme::Symmetric, QuantScheme::Asymmetric})
+        for(int num_bit : {4, 8})
+        {
+            // the last group of each row is shorter
+            const GroupQuantDesc desc{37, 200, 64, num_bit, scheme};
+            const auto x = random_weight(desc.num_row * desc.row_length, 5);
+
+            std::vector<std::int8_t> ref_q, ref_zero;
+            std::vector<float> ref_scale;
+            reference_quantize(ref_q, ref_scale, ref_zero, x, desc);
+
+            std::vector<float> scale(desc.GetGroupCount());
+            std::vector<std::int8_t> zero(desc.GetGroupCount());
+            ck::utils::compute_group_quant_params(scale.data(), zero.data(), x.data(), desc, 3);
+
+            std::vector<std::int8_t> q(x.size());
+            ck::utils::quantize_group_n(q.data(), x.data(), scale.data(), zero.data(), desc, 3);
+
+            for(std::size_t g = 0; g < scale.size(); ++g)
+            {
+                ASSERT_FLOAT_EQ(scale[g], ref_scale[g]) << g;
+                ASSERT_EQ(zero[g], ref_zero[g]) << g;
+            }
+
+            for(std::size_t i = 0; i < q.size(); ++i)
+                ASSERT_EQ(q[i], ref_q[i]) << i;
+
+            // round trip error within half a step
+            std::vector<float> y(x.size());
+            ck::utils::dequantize_group_n(y.data(), q.data(), scale.data(), zero.data(), desc);
+
+            for(std::size_t i = 0; i < y.size(); ++i)
+            {
+                const std::size_t g = i / desc.row_length * desc.GetRowGroupCount() +
+                                      i % desc.row_length / desc.group_size;
+                ASSERT_LE(std::abs(y[i] - x[i]), scale[g] * 0.5001f) << i;
+            }
+        }
+}
+
+TEST(HostWeightQuantization, PackInt4Weight)
+{
+    const GroupQuantDesc desc{64, 256, 128, 4, QuantScheme::Asymmetric};
+    const auto x = random_weight(desc.num_row * desc.row_length, 7);
+
+    std::vector<ck::half_t> x_half(x.size());
+    ck::utils::convert_n(x_half.data(), x.data(), x.size());
+
+    const auto plain = ck::utils::pack_int4_weight<ck::half_t>(x_half.data(), desc);
+    const auto shuffled = ck::utils::pack_int4_weight<ck::half_t>(
+        x_half.data(), desc, ck::utils::int4_interleave_even_odd);
+
+    // scales are representable as half_t
+    for(float s : plain.scale)
+        ASSERT_FLOAT_EQ(s, ck::type_convert<float>(ck::type_convert<ck::half_t>(s)));
+
+    std::vector<std::int8_t> q(x.size());
+    ck::utils::quantize_group_n(
+        q.data(), x_half.data(), plain.scale.data(), plain.zero.data(), desc);
+
+    std::vector<std::int8_t> q_plain(x.size()), q_shuffled(x.size());
+    ck::utils::unpack_int4_weight(q_plain.data(), plain.GetView());
+    ck::utils::unpack_int4_weight(q_shuffled.data(), shuffled.GetView());
+
+    for(std::size_t i = 0; i < q.size(); ++i)
+    {
+        ASSERT_EQ(q_plain[i], q[i]) << i;
+        ASSERT_EQ(q_shuffled[i], q[i]) << i;
+    }
+
+    // elements 0, 2, 4, 6 in the low half of each 32-bit word
+    for(std::size_t w = 0; w < shuffled.data.size() / 4; ++w)
+        for(std::size_t j = 0; j < 8; ++j)
+        {
+            const int nibble = shuffled.data[4 * w + j / 2] >> (j % 2 * 4) & 0xf;
+            ASSERT_EQ(nibble, q[8 * w + ck::utils::int4_interleave_even_odd[j]] & 0xf) << w;
+        }
+
+    std::vector<float> y(x.size());
+    ck::utils::dequantize_int4_weight(y.data(), shuffled.GetView());
+
+    for(std::size_t i = 0; i < y.size(); ++i)
+    {
+        const std::size_t g = i / desc.group_size;
+        const float ref = static_cast<float>(q[i] - plain.zero[g]) * plain.scale[g];
+        ASSERT_FLOAT_EQ(y[i], ref) << i;
+    }
+
+    EXPECT_THROW(ck::utils::pack_int4_weight(
+                     x.data(), GroupQuantDesc{1, 20, 4, 4}, ck::utils::int4_interleave_even_odd),
+                 std::runtime_error);
+}
+
+TEST(HostWeightQuantization, PackedInt4WeightFile)
+{
+    const std::string path = "test_host_weight_quantization.bin";
+    const GroupQuantDesc desc{48, 128, 32, 4, QuantScheme::Symmetric};
+    const auto x = random_weight(desc.num_row * desc.row_length, 9);
+
+    const auto weight = ck::utils::pack_int4_weight(x.data(), desc);
+    ck::utils::PackedInt4WeightFile::Save(path, weight.GetView(), 42);
+
+    {
+        const ck::utils::PackedInt4WeightFile file(path);
+        const auto& view = file.GetView();
+
+        EXPECT_EQ(file.GetKey(), std::uint64_t{42});
+        EXPECT_TRUE(file.Matches(desc, ck::utils::int4_interleave_identity, 42));
+        EXPECT_FALSE(file.Matches(desc, ck::utils::int4_interleave_identity, 43));
+        EXPECT_FALSE(file.Matches(desc, ck::utils::int4_interleave_even_odd, 42));
+        EXPECT_EQ(std::memcmp(view.p_data, weight.data.data(), weight.data.size()), 0);
+        EXPECT_EQ(std::memcmp(view.p_scale, weight.scale.data(), weight.scale.size() * 4), 0);
+        EXPECT_EQ(std::memcmp(view.p_zero, weight.zero.data(), weight.zero.size()), 0);
+    }
+
+    // a matching cache is mapped without touching the source
+    {
+        const auto file =
+            ck::utils::load_or_pack_int4_weight<float, float>(path, 42, nullptr, desc);
+        EXPECT_EQ(std::memcmp(file.GetView().p_data, weight.data.data(), weight.data.size()), 0);
+    }
+
+    // a new key, or a truncated file, is packed again
+    {
+        const auto file = ck::utils::load_or_pack_int4_weight(path, 7, x.data(), desc);
+        EXPECT_EQ(file.GetKey(), std::uint64_t{7});
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write("CKINT4W", 8);
+    }
+    EXPECT_THROW(ck::utils::PackedInt4WeightFile{path}, std::runtime_error);
+    {
+        const auto file = ck::utils::load_or_pack_int4_weight(path, 7, x.data(), desc);
+        EXPECT_EQ(std::memcmp(file.GetView().p_zero, weight.zero.data(), weight.zero.size()), 0);
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "profiler/profile_result_compare.hpp"
+
+using ck::profiler::CompareVerdict;
+using ck::profiler::ProfileResult;
+using ck::profiler::VerificationStatus;
+
+namespace {
+
+ProfileResult make_result(const std::string& instance,
+                          float ave_time,
+                          const std::string& problem = "1 1 1 1 0 5 16 16 16")
+{
+    ProfileResult r;
+    r.op           = "gemm";
+    r.problem      = problem;
+    r.instance     = instance;
+    r.ave_time     = ave_time;
+    r.tflops       = 1.f;
+    r.gb_per_sec   = 1.f;
+    r.verification = VerificationStatus::Pass;
+    return r;
+}
+
+} // namespace
+
+TEST(ProfileResultCompare, ReadResults)
+{
+    std::ostringstream json, csv;
+    ck::profiler::JsonLinesResultSink json_sink(json);
+    ck::profiler::CsvResultSink csv_sink(csv);
+
+    std::vector<ProfileResult> written{make_result("DeviceGemm<256, \"x\", Default>", 0.5f),
+                                       make_result("b", 0.25f)};
+    written[1].tflops.reset();
+    written[1].params       = "KBatch 4";
+    written[1].verification = VerificationStatus::Fail;
+    for(const auto& r : written)
+    {
+        json_sink.Write(r);
+        csv_sink.Write(r);
+    }
+
+    for(const bool is_csv : {false, true})
+    {
+        std::istringstream is(is_csv ? csv.str() : json.str());
+        const auto read = ck::profiler::read_profile_results(is, is_csv);
+
+        ASSERT_EQ(read.size(), written.size());
+        for(std::size_t i = 0; i < read.size(); ++i)
+        {
+            EXPECT_EQ(read[i].op, written[i].op);
+            EXPECT_EQ(read[i].problem, written[i].problem);
+            EXPECT_EQ(read[i].instance, written[i].instance);
+            EXPECT_EQ(read[i].params, written[i].params);
+            EXPECT_FLOAT_EQ(read[i].ave_time, written[i].ave_time);
+            EXPECT_EQ(read[i].tflops.has_value(), written[i].tflops.has_value());
+            EXPECT_TRUE(read[i].verification == written[i].verification);
+        }
+    }
+
+    std::istringstream truncated("{\"op\":\"gemm\",\"problem\":\"16\"");
+    EXPECT_THROW(ck::profiler::read_profile_results(truncated, false), std::runtime_error);
+    std::istringstream missing("{\"op\":\"gemm\"}");
+    EXPECT_THROW(ck::profiler::read_profile_results(missing, false), std::runtime_error);
+    EXPECT_THROW(ck::profiler::read_profile_results("no_such_dir/result.csv"), std::runtime_error);
+
+    // the errors name the file, the line and what is wrong with it
+    auto error_of = [](const std::string& text, bool is_csv) {
+        std::istringstream is(text);
+        try
+        {
+            ck::profiler::read_profile_results(is, is_csv, "base.csv");
+        }
+        catch(const std::runtime_error& e)
+        {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+    const std::string header = "op,problem,instance,params,ave_time_ms,tflops,gb_per_sec,"
+                               "verification\n";
+    EXPECT_EQ(error_of(header + "\ngemm,16,a,,1,,1,pass\ngemm,16,b,,x,,1,pass\n", true),
+              "wrong! base.csv:4: bad ave_time_ms \"x\"");
+    EXPECT_EQ(error_of(header + "gemm,16,a,,1e99,,1,pass\n", true),
+              "wrong! base.csv:2: bad ave_time_ms \"1e99\"");
+    EXPECT_EQ(error_of(header + "gemm,16\n", true), "wrong! base.csv:2: expect 8 fields");
+    EXPECT_EQ(error_of("{\"op\":\"gemm\"}", false), "wrong! base.csv:1: no problem");
+}
+
+TEST(ProfileResultCompare, Stats)
+{
+    EXPECT_FLOAT_EQ(ck::profiler::get_median({3.f, 1.f, 2.f}), 2.f);
+    EXPECT_FLOAT_EQ(ck::profiler::get_median({4.f, 1.f, 3.f, 2.f}), 2.5f);
+
+    const auto stats = ck::profiler::get_sample_stats({1.f, 1.1f, 0.9f, 1.f, 5.f});
+    EXPECT_EQ(stats.count, std::size_t{5});
+    EXPECT_FLOAT_EQ(stats.median, 1.f);
+    EXPECT_NEAR(stats.mad, 0.1f, 1e-6f);
+
+    // the verify, init, log and time arguments do not take part in the match
+    auto r = make_result("a", 1.f, "1 1 0 2 1 50 16 16 16");
+    EXPECT_EQ(ck::profiler::get_problem_key(r), "gemm 1 1 16 16 16");
+    r.op = "conv_fwd";
+    EXPECT_EQ(ck::profiler::get_problem_key(r), "conv_fwd 1 1 0 2 1 50 16 16 16");
+}
+
+TEST(ProfileResultCompare, Verdicts)
+{
+    // one problem with two instances, plus problems only run on either side
+    std::vector<ProfileResult> base{make_result("a", 1.f),
+                                    make_result("b", 2.f),
+                                    make_result("a", 1.f, "1 1 1 1 0 5 32 32 32")};
+    std::vector<ProfileResult> test{make_result("a", 1.02f, "1 1 0 0 0 1 16 16 16"),
+                                    make_result("b", 0.5f),
+                                    make_result("a", 1.f, "1 1 1 1 0 5 64 64 64")};
+
+    // failed instances are not compared
+    test.push_back(make_result("c", 0.1f));
+    test.back().verification = VerificationStatus::Fail;
+
+    auto report = ck::profiler::compare_profile_results(base, test);
+    ASSERT_EQ(report.instances.size(), std::size_t{4});
+    EXPECT_TRUE(report.instances[0].verdict == CompareVerdict::Same);
+    EXPECT_TRUE(report.instances[1].verdict == CompareVerdict::Faster);
+
+    ASSERT_EQ(report.problems.size(), std::size_t{3});
+    EXPECT_EQ(report.problems[0].problem, "gemm 1 1 16 16 16");
+    EXPECT_EQ(report.problems[0].base_instance, "a");
+    EXPECT_EQ(report.problems[0].test_instance, "b");
+    EXPECT_TRUE(report.problems[0].verdict == CompareVerdict::Faster);
+    EXPECT_FLOAT_EQ(report.problems[0].speedup, 2.f);
+    EXPECT_TRUE(report.problems[1].verdict == CompareVerdict::BaseOnly);
+    EXPECT_TRUE(report.problems[2].verdict == CompareVerdict::TestOnly);
+    EXPECT_EQ(report.GetRegressionCount(), std::size_t{0});
+    EXPECT_FLOAT_EQ(report.GetGeomeanSpeedup(), 2.f);
+
+    // 10% slower is a regression when the samples are tight ...
+    base   = {make_result("a", 1.f), make_result("a", 1.01f), make_result("a", 0.99f)};
+    test   = {make_result("a", 1.1f), make_result("a", 1.11f), make_result("a", 1.09f)};
+    report = ck::profiler::compare_profile_results(base, test);
+    ASSERT_EQ(report.problems.size(), std::size_t{1});
+    EXPECT_TRUE(report.problems[0].verdict == CompareVerdict::Slower);
+    EXPECT_EQ(report.GetRegressionCount(), std::size_t{1});
+
+    std::ostringstream os;
+    ck::profiler::print_compare_report(os, report, true);
+    EXPECT_NE(os.str().find("REGRESSION"), std::string::npos);
+    EXPECT_NE(os.str().find("1 problems, 1 regressions"), std::string::npos);
+
+    // ... but not when they are noisy
+    base   = {make_result("a", 1.f), make_result("a", 1.2f), make_result("a", 0.8f)};
+    test   = {make_result("a", 1.1f), make_result("a", 1.3f), make_result("a", 0.9f)};
+    report = ck::profiler::compare_profile_results(base, test);
+    EXPECT_TRUE(report.problems[0].verdict == CompareVerdict::Same);
+
+    // and not when below the threshold
+    ck::profiler::CompareOptions options;
+    options.threshold = 0.2f;
+    test   = {make_result("a", 1.1f)};
+    base   = {make_result("a", 1.f)};
+    report = ck::profiler::compare_profile_results(base, test, options);
+    EXPECT_TRUE(report.problems[0].verdict == CompareVerdict::Same);
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "profiler/profile_result_sink.hpp"
+
+using ck::profiler::ProfileResult;
+using ck::profiler::VerificationStatus;
+
+namespace {
+
+std::vector<std::string> split_lines(const std::string& s)
+{
+    std::vector<std::string> lines;
+    std::istringstream is(s);
+    for(std::string line; std::getline(is, line);)
+        lines.push_back(line);
+    return lines;
+}
+
+ProfileResult make_result()
+{
+    ProfileResult r;
+    r.op           = "gemm";
+    r.problem      = "1 1 1 1 0 5 16 16 16";
+    r.instance     = "DeviceGemm<256, \"x\", Default>";
+    r.ave_time     = 0.5f;
+    r.tflops       = 2.f;
+    r.gb_per_sec   = 3.f;
+    r.verification = VerificationStatus::Pass;
+    return r;
+}
+
+} // namespace
+
+TEST(ProfileResultSink, Formats)
+{
+    std::ostringstream text, json, csv;
+    ck::profiler::TextResultSink text_sink(text);
+    ck::profiler::JsonLinesResultSink json_sink(json);
+    ck::profiler::CsvResultSink csv_sink(csv);
+
+    auto r = make_result();
+    text_sink.Write(r);
+    json_sink.Write(r);
+    csv_sink.Write(r);
+
+    r.tflops.reset();
+    r.params       = "KBatch 4";
+    r.verification = VerificationStatus::NotRun;
+    json_sink.Write(r);
+    csv_sink.Write(r);
+
+    // untimed results have no text line
+    r.timed = false;
+    text_sink.Write(r);
+
+    EXPECT_EQ(text.str(),
+              "Perf:        0.5 ms, 2 TFlops, 3 GB/s, DeviceGemm<256, \"x\", Default>\n");
+
+    const auto json_lines = split_lines(json.str());
+    ASSERT_EQ(json_lines.size(), std::size_t{2});
+    EXPECT_EQ(json_lines[0],
+              "{\"op\":\"gemm\",\"problem\":\"1 1 1 1 0 5 16 16 16\","
+              "\"instance\":\"DeviceGemm<256, \\\"x\\\", Default>\",\"params\":\"\","
+              "\"ave_time_ms\":0.5,\"tflops\":2,\"gb_per_sec\":3,\"verification\":\"pass\"}");
+    EXPECT_NE(json_lines[1].find("\"tflops\":null"), std::string::npos);
+    EXPECT_NE(json_lines[1].find("\"params\":\"KBatch 4\""), std::string::npos);
+    EXPECT_NE(json_lines[1].find("\"verification\":\"not_run\""), std::string::npos);
+
+    const auto csv_lines = split_lines(csv.str());
+    ASSERT_EQ(csv_lines.size(), std::size_t{3});
+    EXPECT_EQ(csv_lines[0],
+              "op,problem,instance,params,ave_time_ms,tflops,gb_per_sec,verification");
+    EXPECT_EQ(csv_lines[1],
+              "\"gemm\",\"1 1 1 1 0 5 16 16 16\",\"DeviceGemm<256, \"\"x\"\", Default>\",\"\","
+              "0.5,2,3,pass");
+    EXPECT_EQ(csv_lines[2].substr(csv_lines[2].find("\"KBatch 4\"")),
+              "\"KBatch 4\",0.5,,3,not_run");
+
+    // control characters are escaped, a missing file is an error
+    EXPECT_EQ(ck::profiler::detail::json_string("a\tb\n"), "\"a\\u0009b\\u000a\"");
+    EXPECT_THROW(ck::profiler::JsonLinesResultSink("no_such_dir/result.jsonl"),
+                 std::runtime_error);
+}
+
+TEST(ProfileResultSink, Reporter)
+{
+    // the sink outlives the process wide reporter
+    static std::ostringstream csv;
+
+    auto& reporter = ck::profiler::ProfileResultReporter::GetInstance();
+    reporter.AddSink(std::make_unique<ck::profiler::CsvResultSink>(csv));
+    reporter.SetProblem("gemm", "16 16 16");
+
+    // timed, then verified
+    ck::profiler::report_profile_result("a", 1.f, 1.f, 1.f);
+    EXPECT_TRUE(ck::profiler::report_verification(true));
+    EXPECT_FALSE(ck::profiler::report_verification(false));
+
+    // not verified
+    ck::profiler::report_profile_result("b", 1.f, 1.f);
+
+    // verified, then timed
+    ck::profiler::begin_profile_instance();
+    ck::profiler::report_verification(true);
+    ck::profiler::report_verification(true);
+    ck::profiler::report_profile_result("c", 1.f, 1.f, 1.f, "KBatch 2");
+
+    // the deferred sink only gets c once it is flushed
+    EXPECT_EQ(split_lines(csv.str()).size(), std::size_t{3});
+    reporter.Flush();
+
+    // not timed, then verified
+    ck::profiler::report_profile_result("d", 0.f, 0.f, false);
+    ck::profiler::report_verification(true);
+
+    // complete, written at once after d
+    ProfileResult e;
+    e.problem      = "32 32 32";
+    e.instance     = "e";
+    e.verification = VerificationStatus::Fail;
+    reporter.Record(e);
+
+    const auto lines = split_lines(csv.str());
+    ASSERT_EQ(lines.size(), std::size_t{6});
+    EXPECT_EQ(lines[1], "\"gemm\",\"16 16 16\",\"a\",\"\",1,1,1,fail");
+    EXPECT_EQ(lines[2], "\"gemm\",\"16 16 16\",\"b\",\"\",1,,1,not_run");
+    EXPECT_EQ(lines[3], "\"gemm\",\"16 16 16\",\"c\",\"KBatch 2\",1,1,1,pass");
+    EXPECT_EQ(lines[4], "\"gemm\",\"16 16 16\",\"d\",\"\",0,,0,pass");
+    EXPECT_EQ(lines[5], "\"gemm\",\"32 32 32\",\"e\",\"\",0,,0,fail");
+}
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/host_mapped_file.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sparse_embedding3_forward_layernorm.hpp"
+
+namespace {
+
+using IndexType = int64_t;
+
+template <typename EmbType>
+using ReferenceInstance =
+    ck::tensor_operation::host::ReferenceSparseEmbedding3ForwardLayernorm<EmbType,
+                                                                          IndexType,
+                                                                          EmbType,
+                                                                          EmbType,
+                                                                          float,
+                                                                          float>;
+
+template <typename EmbType>
+struct Problem
+{
+    Problem(std::size_t num_rows, std::size_t dim, std::size_t length)
+        : E(num_rows),
+          D(dim),
+          L(length),
+          embs(3, Tensor<EmbType>({num_rows, dim})),
+          indices(3, Tensor<IndexType>({length})),
+          gamma({dim}),
+          beta({dim})
+    {
+        std::mt19937 gen(11939);
+        std::uniform_real_distribution<float> values(-1.f, 1.f);
+        std::uniform_int_distribution<IndexType> rows(0, num_rows - 1);
+
+        for(auto& emb : embs)
+            for(auto& v : emb.mData)
+                v = ck::type_convert<EmbType>(values(gen));
+        for(auto& index : indices)
+            for(auto& v : index.mData)
+                v = rows(gen);
+        for(auto& v : gamma.mData)
+            v = ck::type_convert<EmbType>(values(gen));
+        for(auto& v : beta.mData)
+            v = ck::type_convert<EmbType>(values(gen));
+    }
+
+    Tensor<float> Run() const
+    {
+        Tensor<float> out({L, D});
+        auto argument = ReferenceInstance<EmbType>::MakeArgument(out,
+                                                                 embs[0],
+                                                                 embs[1],
+                                                                 embs[2],
+                                                                 indices[0],
+                                                                 indices[1],
+                                                                 indices[2],
+                                                                 gamma,
+                                                                 beta,
+                                                                 E,
+                                                                 D,
+                                                                 L,
+                                                                 epsilon);
+        ReferenceInstance<EmbType>::MakeInvoker().Run(argument);
+        return out;
+    }
+
+    // two pass layernorm in double precision
+    std::vector<double> RunNaive() const
+    {
+        std::vector<double> out(L * D);
+        std::vector<double> x(D);
+
+        for(std::size_t l = 0; l < L; ++l)
+        {
+            double mean = 0;
+            for(std::size_t d = 0; d < D; ++d)
+            {
+                x[d] = 0;
+                for(std::size_t i = 0; i < 3; ++i)
+                    x[d] += ck::type_convert<float>(embs[i](indices[i](l), d));
+                mean += x[d];
+            }
+            mean /= D;
+
+            double var = 0;
+            for(std::size_t d = 0; d < D; ++d)
+                var += (x[d] - mean) * (x[d] - mean);
+            var /= D;
+
+            for(std::size_t d = 0; d < D; ++d)
+                out[l * D + d] = (x[d] - mean) / std::sqrt(var + epsilon) *
+                                     ck::type_convert<float>(gamma(d)) +
+                                 ck::type_convert<float>(beta(d));
+        }
+
+        return out;
+    }
+
+    std::size_t E;
+    std::size_t D;
+    std::size_t L;
+    std::vector<Tensor<EmbType>> embs;
+    std::vector<Tensor<IndexType>> indices;
+    Tensor<EmbType> gamma;
+    Tensor<EmbType> beta;
+    float epsilon = 1e-4f;
+};
+
+template <typename EmbType>
+void check_against_naive(std::size_t num_rows, std::size_t dim, std::size_t length)
+{
+    const Problem<EmbType> problem(num_rows, dim, length);
+
+    const auto out = problem.Run();
+    const auto ref = problem.RunNaive();
+
+    for(std::size_t i = 0; i < ref.size(); ++i)
+    {
+        ASSERT_NEAR(out.mData[i], ref[i], 1e-4 * (1 + std::abs(ref[i])))
+            << "dim " << dim << ", element " << i;
+    }
+}
+
+} // namespace
+
+TEST(SparseEmbedding3ForwardLayernorm, Float)
+{
+    check_against_naive<float>(1000, 256, 300);
+    check_against_naive<float>(1000, 77, 300);
+    check_against_naive<float>(10, 3, 5);
+}
+
+TEST(SparseEmbedding3ForwardLayernorm, Half)
+{
+    check_against_naive<ck::half_t>(1000, 512, 300);
+    check_against_naive<ck::half_t>(1000, 45, 300);
+}
+
+TEST(SparseEmbedding3ForwardLayernorm, Double)
+{
+    // generic path without the fp32 vector kernels
+    const Problem<float> problem(100, 37, 50);
+    const auto ref = problem.RunNaive();
+
+    Tensor<float> out({problem.L, problem.D});
+    using Reference = ck::tensor_operation::host::
+        ReferenceSparseEmbedding3ForwardLayernorm<float, IndexType, float, float, double, float>;
+    auto argument = Reference::MakeArgument(out,
+                                            problem.embs[0],
+                                            problem.embs[1],
+                                            problem.embs[2],
+                                            problem.indices[0],
+                                            problem.indices[1],
+                                            problem.indices[2],
+                                            problem.gamma,
+                                            problem.beta,
+                                            problem.E,
+                                            problem.D,
+                                            problem.L,
+                                            problem.epsilon);
+    Reference::MakeInvoker().Run(argument);
+
+    for(std::size_t i = 0; i < ref.size(); ++i)
+    {
+        ASSERT_NEAR(out.mData[i], ref[i], 1e-5 * (1 + std::abs(ref[i]))) << "element " << i;
+    }
+}
+
+TEST(SparseEmbedding3ForwardLayernorm, MappedTables)
+{
+    using EmbType = ck::half_t;
+
+    const Problem<EmbType> problem(2000, 128, 500);
+    const auto expected = problem.Run();
+
+    // the three tables stored back to back in one file
+    const std::string path = "test_sparse_embedding_tables.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        for(const auto& emb : problem.embs)
+            file.write(reinterpret_cast<const char*>(emb.mData.data()),
+                       emb.mData.size() * sizeof(EmbType));
+    }
+
+    ck::utils::MappedFile tables(path);
+    ASSERT_EQ(tables.GetElementCount<EmbType>(), 3 * problem.E * problem.D);
+    tables.AdviseRandomAccess();
+
+    const std::size_t table_bytes = problem.E * problem.D * sizeof(EmbType);
+
+    Tensor<float> out({problem.L, problem.D});
+    const EmbType* p_emb_a = tables.GetData<EmbType>(0);
+    const EmbType* p_emb_b = tables.GetData<EmbType>(table_bytes);
+    const EmbType* p_emb_c = tables.GetData<EmbType>(2 * table_bytes);
+
+    auto argument = ReferenceInstance<EmbType>::MakeArgument(out,
+                                                             p_emb_a,
+                                                             p_emb_b,
+                                                             p_emb_c,
+                                                             problem.indices[0],
+                                                             problem.indices[1],
+                                                             problem.indices[2],
+                                                             problem.gamma,
+                                                             problem.beta,
+                                                             problem.E,
+                                                             problem.D,
+                                                             problem.L,
+                                                             problem.epsilon);
+    ReferenceInstance<EmbType>::MakeInvoker().Run(argument);
+
+    EXPECT_EQ(std::memcmp(out.mData.data(),
+                          expected.mData.data(),
+                          expected.mData.size() * sizeof(float)),
+              0);
+
+    std::remove(path.c_str());
+}
+
+TEST(SparseEmbedding3ForwardLayernorm, OutOfRange)
+{
+    Problem<float> problem(100, 16, 20);
+    problem.indices[1].mData[7] = 100;
+
+    EXPECT_THROW(problem.Run(), std::runtime_error);
+
+    problem.indices[1].mData[7] = -1;
+
+    EXPECT_THROW(problem.Run(), std::runtime_error);
+}
+
+TEST(MappedFile, MissingFile)
+{
+    EXPECT_THROW(ck::utils::MappedFile("this_file_does_not_exist.bin"), std::runtime_error);
+}
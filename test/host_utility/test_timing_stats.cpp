@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/host_utility/timing_stats.hpp"
+
+using ck::utility::TimingRecorder;
+
+TEST(TimingStats, Percentiles)
+{
+    const std::vector<float> sorted{1.f, 2.f, 3.f, 4.f, 5.f};
+    EXPECT_FLOAT_EQ(TimingRecorder::GetPercentile(sorted, 0), 1.f);
+    EXPECT_FLOAT_EQ(TimingRecorder::GetPercentile(sorted, 50), 3.f);
+    EXPECT_FLOAT_EQ(TimingRecorder::GetPercentile(sorted, 90), 4.6f);
+    EXPECT_FLOAT_EQ(TimingRecorder::GetPercentile(sorted, 100), 5.f);
+    EXPECT_FLOAT_EQ(TimingRecorder::GetPercentile({2.f}, 99), 2.f);
+
+    // a synthetic timer: iteration i takes i + 1 ms
+    TimingRecorder recorder;
+    const auto& stats = recorder.Record(100, [](int i) { return i + 1.f; }, 0);
+    EXPECT_EQ(stats.count, 100);
+    EXPECT_EQ(stats.outliers, 0);
+    EXPECT_FLOAT_EQ(stats.min, 1.f);
+    EXPECT_FLOAT_EQ(stats.max, 100.f);
+    EXPECT_FLOAT_EQ(stats.mean, 50.5f);
+    EXPECT_FLOAT_EQ(stats.median, 50.5f);
+    EXPECT_FLOAT_EQ(stats.p90, 90.1f);
+    EXPECT_FLOAT_EQ(stats.p99, 99.01f);
+    EXPECT_NEAR(stats.stddev, 29.0115f, 1e-3f);
+    EXPECT_EQ(recorder.GetSamples().size(), std::size_t{100});
+}
+
+TEST(TimingStats, Outliers)
+{
+    // a noisy timer: about 1 ms with a few preempted iterations
+    const std::vector<float> times{1.f, 1.02f, 0.98f, 1.01f, 0.99f, 9.f, 1.f, 1.03f, 0.97f, 20.f};
+
+    TimingRecorder recorder;
+    auto get_time = [&](int i) { return times[i]; };
+
+    const auto& unfiltered = recorder.Record(10, get_time, 0);
+    EXPECT_EQ(unfiltered.outliers, 0);
+    EXPECT_FLOAT_EQ(unfiltered.max, 20.f);
+
+    const auto& stats = recorder.Record(10, get_time, 3.5f);
+    EXPECT_EQ(stats.count, 8);
+    EXPECT_EQ(stats.outliers, 2);
+    EXPECT_FLOAT_EQ(stats.max, 1.03f);
+    EXPECT_FLOAT_EQ(stats.median, 1.f);
+    EXPECT_NEAR(stats.mean, 1.f, 1e-6f);
+    EXPECT_LT(stats.stddev, 0.03f);
+
+    // the samples stay in iteration order, the buffer is reused
+    EXPECT_FLOAT_EQ(recorder.GetSamples()[5], 9.f);
+    EXPECT_EQ(recorder.Record(3, get_time, 3.5f).count, 3);
+    EXPECT_EQ(recorder.GetSamples().size(), std::size_t{3});
+
+    // a zero MAD filters nothing, no samples give empty statistics
+    const auto& constant = recorder.Record(5, [](int i) { return i == 0 ? 5.f : 1.f; }, 3.5f);
+    EXPECT_EQ(constant.outliers, 0);
+    EXPECT_FLOAT_EQ(constant.max, 5.f);
+    EXPECT_EQ(recorder.Record(0, get_time, 3.5f).count, 0);
+
+    // a threshold so low that every sample would be an outlier filters nothing
+    const auto& all_outliers = recorder.Record(2, [](int i) { return i + 1.f; }, 0.5f);
+    EXPECT_EQ(all_outliers.count, 2);
+    EXPECT_EQ(all_outliers.outliers, 0);
+    EXPECT_FLOAT_EQ(all_outliers.min, 1.f);
+    EXPECT_FLOAT_EQ(all_outliers.max, 2.f);
+    EXPECT_FLOAT_EQ(all_outliers.mean, 1.5f);
+}
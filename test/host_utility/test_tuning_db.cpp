@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/library/utility/tuning_db.hpp"
+
+using ck::utils::TuningDb;
+using ck::utils::TuningKey;
+using ck::utils::TuningRecord;
+
+namespace {
+
+const TuningKey gemm_f16{"gfx942", "gemm", "1", "1"};
+
+TuningRecord make_record(const TuningKey& key,
+                         std::vector<std::int64_t> shape,
+                         float ave_time,
+                         const std::string& instance)
+{
+    TuningRecord r;
+    r.key      = key;
+    r.shape    = std::move(shape);
+    r.ave_time = ave_time;
+    r.instance = instance;
+    return r;
+}
+
+} // namespace
+
+TEST(TuningDb, Lookup)
+{
+    TuningDb db;
+    EXPECT_TRUE(db.Add(make_record(gemm_f16, {1024, 1024, 1024, -1, -1, -1}, 0.2f, "a")));
+    EXPECT_TRUE(db.Add(make_record(gemm_f16, {4096, 4096, 4096, -1, -1, -1}, 2.f, "b")));
+    EXPECT_TRUE(db.Add(make_record(gemm_f16, {16, 4096, 4096, -1, -1, -1}, 0.1f, "c")));
+
+    // only a faster record of the same shape replaces the current one
+    EXPECT_FALSE(db.Add(make_record(gemm_f16, {4096, 4096, 4096, -1, -1, -1}, 3.f, "d")));
+    EXPECT_TRUE(db.Add(make_record(gemm_f16, {4096, 4096, 4096, -1, -1, -1}, 1.f, "e")));
+    EXPECT_EQ(db.GetRecordCount(), std::size_t{3});
+
+    // exact match, default strides match any stride
+    const auto* exact = db.Find(gemm_f16, {4096, 4096, 4096, 4096, 4096, 4096});
+    ASSERT_NE(exact, nullptr);
+    EXPECT_EQ(exact->instance, "e");
+
+    // nearest shape in log space, then the others by distance
+    const auto nearest = db.Lookup(gemm_f16, {32, 3000, 5000, -1, -1, -1});
+    ASSERT_EQ(nearest.size(), std::size_t{3});
+    EXPECT_EQ(nearest[0]->instance, "c");
+    EXPECT_EQ(nearest[1]->instance, "a");
+    EXPECT_EQ(nearest[2]->instance, "e");
+
+    // other keys and ranks do not match
+    EXPECT_EQ(db.Find({"gfx90a", "gemm", "1", "1"}, {1024, 1024, 1024, -1, -1, -1}), nullptr);
+    EXPECT_EQ(db.Find({"gfx942", "gemm", "1", "0"}, {1024, 1024, 1024, -1, -1, -1}), nullptr);
+    EXPECT_EQ(db.Find(gemm_f16, {1024, 1024, 1024}), nullptr);
+
+    EXPECT_NEAR(TuningDb::GetShapeDistance({2, 8}, {8, 2}), std::sqrt(8.), 1e-12);
+    EXPECT_NEAR(TuningDb::GetShapeDistance({2, -1}, {2, 7}), 0., 1e-12);
+    EXPECT_LT(TuningDb::GetShapeDistance({2}, {2, 2}), 0.);
+}
+
+TEST(TuningDb, Serialization)
+{
+    TuningDb db;
+    db.Add(make_record(gemm_f16, {1024, 1024, 1024, -1, -1, -1}, 0.123456f, "DeviceGemm<256>"));
+    auto splitk   = make_record({"gfx942", "gemm_splitk", "1", "0"}, {16, 16, 4096}, 1.f, "x");
+    splitk.params = "KBatch 4";
+    db.Add(splitk);
+
+    std::stringstream ss;
+    db.Save(ss);
+
+    TuningDb loaded;
+    loaded.Load(ss);
+    EXPECT_EQ(loaded.GetRecordCount(), std::size_t{2});
+
+    const auto* r = loaded.Find(gemm_f16, {1024, 1024, 1024, -1, -1, -1});
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->instance, "DeviceGemm<256>");
+    EXPECT_FLOAT_EQ(r->ave_time, 0.123456f);
+    EXPECT_EQ(r->params, "");
+
+    r = loaded.Find({"gfx942", "gemm_splitk", "1", "0"}, {16, 16, 4096});
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->params, "KBatch 4");
+
+    // saving again gives the same file
+    std::stringstream again;
+    loaded.Save(again);
+    EXPECT_EQ(again.str(), ss.str());
+
+    std::istringstream bad_shape("gfx942\tgemm\t1\t1\t16 x 16\t1\ta\t\n");
+    EXPECT_THROW(loaded.Load(bad_shape), std::runtime_error);
+    std::istringstream missing_field("gfx942\tgemm\t1\t1\t16 16 16\t1\ta\n");
+    EXPECT_THROW(loaded.Load(missing_field), std::runtime_error);
+    EXPECT_THROW(loaded.Load("no_such_dir/tuning.db"), std::runtime_error);
+}